@@ -103,6 +103,7 @@ void BindNodeVisitor::Visit(const parser::DeleteStatement *node) {
 
 void BindNodeVisitor::Visit(const parser::LimitDescription *) {}
 void BindNodeVisitor::Visit(const parser::CopyStatement *) {}
+void BindNodeVisitor::Visit(const parser::AnalyzeStatement *) {}
 void BindNodeVisitor::Visit(const parser::CreateStatement *) {}
 void BindNodeVisitor::Visit(const parser::InsertStatement *) {}
 void BindNodeVisitor::Visit(const parser::DropStatement *) {}
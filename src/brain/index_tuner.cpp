@@ -109,8 +109,14 @@ void IndexTuner::BuildIndex(storage::DataTable* table,
         new storage::Tuple(table_schema, true));
 
     auto tile_group = table->GetTileGroup(index_tile_group_offset);
-    auto tile_group_id = tile_group->GetTileGroupId();
-    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+    // Tile groups dropped by compaction have nothing to index
+    oid_t tile_group_id = INVALID_OID;
+    oid_t active_tuple_count = 0;
+    if (tile_group != nullptr) {
+      tile_group_id = tile_group->GetTileGroupId();
+      active_tuple_count = tile_group->GetNextTupleSlot();
+    }
 
     for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
       // Setup container tuple
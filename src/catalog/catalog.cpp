@@ -19,6 +19,7 @@
 #include "expression/string_functions.h"
 #include "expression/date_functions.h"
 #include "index/index_factory.h"
+#include "optimizer/table_stats.h"
 #include "util/string_util.h"
 
 namespace peloton {
@@ -62,6 +63,11 @@ void Catalog::CreateMetricsCatalog() {
   auto query_metrics_catalog = CreateMetricsCatalog(default_db_oid,
       QUERY_METRIC_NAME);
   default_db->AddTable(query_metrics_catalog.release(), true);
+
+  // Create table for the phase latencies of each statement type
+  auto phase_metrics_catalog = CreateMetricsCatalog(default_db_oid,
+      PHASE_METRIC_NAME);
+  default_db->AddTable(phase_metrics_catalog.release(), true);
   LOG_TRACE("Metrics tables created");
 }
 
@@ -323,6 +329,7 @@ ResultType Catalog::DropDatabaseWithName(std::string database_name,
     for (auto database : databases_) {
       if (database->GetDBName() == database_name) {
         LOG_TRACE("Deleting database object in database vector");
+        DropDatabaseStats(database->GetOid());
         delete database;
         break;
       }
@@ -353,6 +360,7 @@ void Catalog::DropDatabaseWithOid(const oid_t database_oid) {
     for (auto database : databases_) {
       if (database->GetOid() == database_oid) {
         LOG_TRACE("Deleting database object in database vector");
+        DropDatabaseStats(database->GetOid());
         delete database;
         break;
       }
@@ -386,6 +394,7 @@ ResultType Catalog::DropTable(std::string database_name, std::string table_name,
               TABLE_CATALOG_NAME), table_id, txn);
       LOG_TRACE("Deleting table!");
       database->DropTableWithOid(table_id);
+      SetTableStats(database->GetOid(), table_id, nullptr);
       return ResultType::SUCCESS;
     } else {
       LOG_TRACE("Could not find table");
@@ -519,6 +528,8 @@ std::unique_ptr<storage::DataTable> Catalog::CreateMetricsCatalog(
     schema = InitializeDatabaseMetricsSchema().release();
   } else if (table_name == INDEX_METRIC_NAME) {
     schema = InitializeIndexMetricsSchema().release();
+  } else if (table_name == PHASE_METRIC_NAME) {
+    schema = InitializePhaseMetricsSchema().release();
   }
 
   std::unique_ptr<storage::DataTable> table(
@@ -744,6 +755,54 @@ std::unique_ptr<catalog::Schema> Catalog::InitializeQueryMetricsSchema() {
   return database_schema;
 }
 
+// Initialize phase catalog schema
+std::unique_ptr<catalog::Schema> Catalog::InitializePhaseMetricsSchema() {
+  const std::string not_null_constraint_name = "not_null";
+  catalog::Constraint not_null_constraint(ConstraintType::NOTNULL,
+      not_null_constraint_name);
+  oid_t integer_type_size = type::Type::GetTypeSize(type::Type::INTEGER);
+  oid_t decimal_type_size = type::Type::GetTypeSize(type::Type::DECIMAL);
+  oid_t varchar_type_size = type::Type::GetTypeSize(type::Type::VARCHAR);
+
+  type::Type::TypeId integer_type = type::Type::INTEGER;
+  type::Type::TypeId decimal_type = type::Type::DECIMAL;
+  type::Type::TypeId varchar_type = type::Type::VARCHAR;
+
+  auto statement_type_column = catalog::Column(varchar_type,
+      varchar_type_size, "statement_type", false);
+  statement_type_column.AddConstraint(not_null_constraint);
+  auto phase_column = catalog::Column(varchar_type, varchar_type_size,
+      "phase", false);
+  phase_column.AddConstraint(not_null_constraint);
+
+  // Latencies of the interval, in milliseconds
+  auto count_column = catalog::Column(integer_type, integer_type_size,
+      "count", true);
+  count_column.AddConstraint(not_null_constraint);
+  auto average_column = catalog::Column(decimal_type, decimal_type_size,
+      "average", true);
+  average_column.AddConstraint(not_null_constraint);
+  auto median_column = catalog::Column(decimal_type, decimal_type_size,
+      "median", true);
+  median_column.AddConstraint(not_null_constraint);
+  auto perc_99th_column = catalog::Column(decimal_type, decimal_type_size,
+      "perc_99th", true);
+  perc_99th_column.AddConstraint(not_null_constraint);
+  auto max_column = catalog::Column(decimal_type, decimal_type_size, "max",
+      true);
+  max_column.AddConstraint(not_null_constraint);
+
+  // MAX_INT only tracks the number of seconds since epoch until 2037
+  auto timestamp_column = catalog::Column(integer_type, integer_type_size,
+      "time_stamp", true);
+  timestamp_column.AddConstraint(not_null_constraint);
+
+  std::unique_ptr<catalog::Schema> phase_schema(new catalog::Schema( {
+      statement_type_column, phase_column, count_column, average_column,
+      median_column, perc_99th_column, max_column, timestamp_column }));
+  return phase_schema;
+}
+
 void Catalog::PrintCatalogs() {
 }
 
@@ -782,6 +841,34 @@ void Catalog::RemoveFunction(const std::string &name) {
   functions_.erase(name);
 }
 
+void Catalog::SetTableStats(
+    const oid_t database_oid, const oid_t table_oid,
+    std::shared_ptr<optimizer::TableStats> table_stats) {
+  std::lock_guard<std::mutex> lock(table_stats_mutex_);
+  if (table_stats == nullptr) {
+    table_stats_.erase(std::make_pair(database_oid, table_oid));
+  } else {
+    table_stats_[std::make_pair(database_oid, table_oid)] = table_stats;
+  }
+}
+
+std::shared_ptr<optimizer::TableStats> Catalog::GetTableStats(
+    const oid_t database_oid, const oid_t table_oid) const {
+  std::lock_guard<std::mutex> lock(table_stats_mutex_);
+  auto itr = table_stats_.find(std::make_pair(database_oid, table_oid));
+  if (itr == table_stats_.end()) {
+    return nullptr;
+  }
+  return itr->second;
+}
+
+void Catalog::DropDatabaseStats(const oid_t database_oid) {
+  std::lock_guard<std::mutex> lock(table_stats_mutex_);
+  table_stats_.erase(
+      table_stats_.lower_bound(std::make_pair(database_oid, 0U)),
+      table_stats_.lower_bound(std::make_pair(database_oid + 1, 0U)));
+}
+
 void Catalog::InitializeFunctions() {
   /**
    * string functions
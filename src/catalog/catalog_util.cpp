@@ -247,6 +247,41 @@ std::unique_ptr<storage::Tuple> GetQueryMetricsCatalogTuple(
   return std::move(tuple);
 }
 
+/**
+ * Generate a phase metric tuple
+ * Input: The table schema, the statement type, the phase, its latency
+ * measurements in milliseconds, the timestamp
+ * Returns: The generated tuple
+ */
+std::unique_ptr<storage::Tuple> GetPhaseMetricsCatalogTuple(
+    const catalog::Schema *schema, StatementType statement_type,
+    QueryPhaseType phase, const stats::LatencyMeasurements &measurements,
+    int64_t time_stamp, type::AbstractPool *pool) {
+  std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+
+  auto val1 = type::ValueFactory::GetVarcharValue(
+      StatementTypeToString(statement_type), nullptr);
+  auto val2 = type::ValueFactory::GetVarcharValue(
+      QueryPhaseTypeToString(phase), nullptr);
+  auto val3 = type::ValueFactory::GetIntegerValue(measurements.count_);
+  auto val4 = type::ValueFactory::GetDecimalValue(measurements.average_);
+  auto val5 = type::ValueFactory::GetDecimalValue(measurements.median_);
+  auto val6 = type::ValueFactory::GetDecimalValue(measurements.perc_99th_);
+  auto val7 = type::ValueFactory::GetDecimalValue(measurements.max_);
+  auto val8 = type::ValueFactory::GetIntegerValue(time_stamp);
+
+  tuple->SetValue(0, val1, pool);
+  tuple->SetValue(1, val2, pool);
+  tuple->SetValue(2, val3, nullptr);
+  tuple->SetValue(3, val4, nullptr);
+  tuple->SetValue(4, val5, nullptr);
+  tuple->SetValue(5, val6, nullptr);
+  tuple->SetValue(6, val7, nullptr);
+  tuple->SetValue(7, val8, nullptr);
+
+  return std::move(tuple);
+}
+
 /**
  * Generate a table catalog tuple
  * Input: The table schema, the table id, the table name, the database id, and
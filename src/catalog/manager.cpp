@@ -14,8 +14,11 @@
 #include "common/logger.h"
 #include "catalog/manager.h"
 #include "catalog/foreign_key.h"
+#include "configuration/configuration.h"
 #include "storage/database.h"
+#include "storage/anti_cache_manager.h"
 #include "storage/data_table.h"
+#include "storage/tile_group.h"
 #include "concurrency/transaction_manager_factory.h"
 
 namespace peloton {
@@ -45,16 +48,37 @@ void Manager::DropTileGroup(const oid_t oid) {
   
   // drop the catalog reference to the tile group
   tile_group_locator_.Erase(oid, empty_tile_group_);
+
+  // the tile group may be sitting in the anti-cache
+  auto &anti_cache_manager = storage::AntiCacheManager::GetInstance();
+  if (anti_cache_manager.GetEvictedTileGroupCount() > 0) {
+    anti_cache_manager.DiscardTileGroup(oid);
+  }
 }
 
 std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
   std::shared_ptr<storage::TileGroup> location;
   
   location = tile_group_locator_.Find(oid);
+  if (FLAGS_anti_caching == false) {
+    return location;
+  }
+
+  auto &anti_cache_manager = storage::AntiCacheManager::GetInstance();
+  if (location != nullptr) {
+    location->RecordAccess(anti_cache_manager.GetClock());
+  } else if (anti_cache_manager.GetEvictedTileGroupCount() > 0) {
+    location = anti_cache_manager.FetchTileGroup(oid);
+  }
 
   return location;
 }
 
+std::shared_ptr<storage::TileGroup> Manager::GetResidentTileGroup(
+    const oid_t oid) {
+  return tile_group_locator_.Find(oid);
+}
+
 // used for logging test
 void Manager::ClearTileGroup() {
 
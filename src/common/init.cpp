@@ -20,7 +20,10 @@
 #include "brain/layout_tuner.h"
 #include "concurrency/epoch_manager_factory.h"
 #include "gc/gc_manager_factory.h"
+#include "gc/tile_group_compactor.h"
+#include "storage/anti_cache_manager.h"
 #include "storage/data_table.h"
+#include "storage/tile_group_freezer.h"
 
 #include <google/protobuf/stubs/common.h>
 
@@ -50,6 +53,28 @@ void PelotonInit::Initialize() {
   // start GC.
   gc::GCManagerFactory::GetInstance().StartGC();
 
+  // start tile group compactor
+  if (FLAGS_tile_group_compaction == true) {
+    auto& tile_group_compactor = gc::TileGroupCompactor::GetInstance();
+    tile_group_compactor.SetOccupancyThreshold(
+        FLAGS_tile_group_compaction_threshold);
+    tile_group_compactor.Start();
+  }
+
+  // start tile group freezer
+  if (FLAGS_tile_group_freezing == true) {
+    auto& tile_group_freezer = storage::TileGroupFreezer::GetInstance();
+    tile_group_freezer.Start();
+  }
+
+  // start anti-cache
+  if (FLAGS_anti_caching == true) {
+    auto& anti_cache_manager = storage::AntiCacheManager::GetInstance();
+    anti_cache_manager.SetFile(FLAGS_anti_caching_file);
+    anti_cache_manager.SetColdPasses(FLAGS_anti_caching_cold_passes);
+    anti_cache_manager.Start();
+  }
+
   // start index tuner
   if (FLAGS_index_tuner == true) {
     // Set the default visibility flag for all indexes to false
@@ -82,6 +107,24 @@ void PelotonInit::Shutdown() {
     layout_tuner.Stop();
   }
 
+  // shut down anti-cache
+  if (FLAGS_anti_caching == true) {
+    auto& anti_cache_manager = storage::AntiCacheManager::GetInstance();
+    anti_cache_manager.Stop();
+  }
+
+  // shut down tile group freezer
+  if (FLAGS_tile_group_freezing == true) {
+    auto& tile_group_freezer = storage::TileGroupFreezer::GetInstance();
+    tile_group_freezer.Stop();
+  }
+
+  // shut down tile group compactor
+  if (FLAGS_tile_group_compaction == true) {
+    auto& tile_group_compactor = gc::TileGroupCompactor::GetInstance();
+    tile_group_compactor.Stop();
+  }
+
   // shut down GC.
   gc::GCManagerFactory::GetInstance().StopGC();
 
@@ -0,0 +1,178 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.cpp
+//
+// Identification: src/concurrency/optimistic_transaction_manager.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/optimistic_transaction_manager.h"
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "common/platform.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction.h"
+
+namespace peloton {
+namespace concurrency {
+
+OptimisticTransactionManager &OptimisticTransactionManager::GetInstance() {
+  static OptimisticTransactionManager txn_manager;
+  return txn_manager;
+}
+
+// only the latest version can be owned. unlike under timestamp ordering, a
+// writer's commit id may be larger than our begin commit id, so any end
+// commit id means that the version has been replaced.
+bool OptimisticTransactionManager::IsOwnable(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  WaitForOwner(current_txn, tile_group_header, tuple_id);
+
+  auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+  auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+  if (tuple_txn_id != INITIAL_TXN_ID) {
+    current_txn->SetAbortCause(AbortCauseType::OWNERSHIP_CONFLICT,
+                               tile_group_header, tuple_id);
+    return false;
+  }
+  if (tuple_end_cid != MAX_CID) {
+    current_txn->SetAbortCause(AbortCauseType::VISIBILITY, tile_group_header,
+                               tuple_id);
+    return false;
+  }
+  return true;
+}
+
+// readers do not leave a mark on the tuple, so the ownership can be acquired
+// as long as no other transaction owns the tuple. the readers that are
+// affected by the new version will fail their validation.
+bool OptimisticTransactionManager::AcquireOwnership(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  auto txn_id = current_txn->GetTransactionId();
+
+  if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
+    current_txn->SetAbortCause(AbortCauseType::OWNERSHIP_CONFLICT,
+                               tile_group_header, tuple_id);
+    return false;
+  }
+
+  // the previous owner may have replaced the version right before it
+  // released the tuple.
+  if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+    tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+    current_txn->SetAbortCause(AbortCauseType::VISIBILITY, tile_group_header,
+                               tuple_id);
+    return false;
+  }
+  return true;
+}
+
+bool OptimisticTransactionManager::PerformRead(Transaction *const current_txn,
+                                               const ItemPointer &location,
+                                               bool acquire_ownership) {
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    // Ignore read validation for all readonly transactions
+    return true;
+  }
+
+  oid_t tile_group_id = location.block;
+  oid_t tuple_id = location.offset;
+
+  LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(tile_group_id);
+  auto tile_group_header = tile_group->GetHeader();
+
+  // Check if it's select for update before we check the ownership
+  if (acquire_ownership == true &&
+      IsOwner(current_txn, tile_group_header, tuple_id) == false) {
+    // Acquire ownership if we haven't
+    if (IsOwnable(current_txn, tile_group_header, tuple_id) == false) {
+      // Can not own
+      return false;
+    }
+    if (AcquireOwnership(current_txn, tile_group_header, tuple_id) == false) {
+      // Can not acquire ownership
+      return false;
+    }
+    // Promote to RWType::READ_OWN
+    current_txn->RecordReadOwn(location);
+  }
+
+  // if the current transaction does not own this tuple, then only remember
+  // the version for the validation at commit time.
+  if (IsOwner(current_txn, tile_group_header, tuple_id) == false) {
+    current_txn->RecordRead(location);
+  }
+
+  // Increment table read op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementTableReads(
+        location.block);
+  }
+  return true;
+}
+
+bool OptimisticTransactionManager::ValidateReadSet(
+    Transaction *const current_txn, const cid_t end_commit_id) {
+  auto &manager = catalog::Manager::GetInstance();
+
+  auto &rw_set = current_txn->GetReadWriteSet();
+
+  for (auto &tile_group_entry : rw_set) {
+    auto tile_group_header =
+        manager.GetTileGroup(tile_group_entry.first)->GetHeader();
+
+    for (auto &tuple_entry : tile_group_entry.second) {
+      if (tuple_entry.second != RWType::READ) {
+        continue;
+      }
+      auto tuple_slot = tuple_entry.first;
+
+      // the version must not be owned by a concurrent writer, and it must not
+      // have been invalidated by a transaction that committed before us.
+      if (tile_group_header->GetTransactionId(tuple_slot) != INITIAL_TXN_ID ||
+          tile_group_header->GetEndCommitId(tuple_slot) <= end_commit_id) {
+        LOG_TRACE("Validation failed on (%u, %u)", tile_group_entry.first,
+                  tuple_slot);
+        current_txn->SetAbortCause(AbortCauseType::VALIDATION,
+                                   tile_group_header, tuple_slot);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+ResultType OptimisticTransactionManager::CommitTransaction(
+    Transaction *const current_txn) {
+  LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
+
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    EndReadonlyTransaction(current_txn);
+    return ResultType::SUCCESS;
+  }
+
+  // the commit id is taken before the validation. a writer that replaced a
+  // version we have read either still owns it, or has installed it with its
+  // own commit id, which then must be larger than ours.
+  cid_t end_commit_id = EpochManagerFactory::GetInstance().GetCommitId();
+
+  if (ValidateReadSet(current_txn, end_commit_id) == false) {
+    return AbortTransaction(current_txn);
+  }
+
+  return InstallTransaction(current_txn, end_commit_id);
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
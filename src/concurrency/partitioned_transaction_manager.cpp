@@ -0,0 +1,234 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// partitioned_transaction_manager.cpp
+//
+// Identification: src/concurrency/partitioned_transaction_manager.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/partitioned_transaction_manager.h"
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "common/platform.h"
+#include "concurrency/transaction.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace concurrency {
+
+PartitionedTransactionManager::PartitionedTransactionManager()
+    : partition_count_(1),
+      partition_latches_(new std::shared_timed_mutex[1]) {}
+
+PartitionedTransactionManager &PartitionedTransactionManager::GetInstance() {
+  static PartitionedTransactionManager txn_manager;
+  return txn_manager;
+}
+
+void PartitionedTransactionManager::SetPartitionCount(
+    const size_t partition_count) {
+  PL_ASSERT(partition_count > 0);
+  partition_latches_.reset(new std::shared_timed_mutex[partition_count]);
+  partition_count_ = partition_count;
+}
+
+oid_t PartitionedTransactionManager::GetPartitionId(
+    const type::Value &partition_key) const {
+  return static_cast<oid_t>(partition_key.Hash() % partition_count_);
+}
+
+// nobody else can own a tuple of our partition, so there is nothing to wait
+// for. the tuples of the other partitions and of the tables without a
+// partition column are shared with the other single-partition transactions.
+bool PartitionedTransactionManager::IsOwnable(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  if (IsInOwnPartition(current_txn, tile_group_header, tuple_id) == false) {
+    return TimestampOrderingTransactionManager::IsOwnable(
+        current_txn, tile_group_header, tuple_id);
+  }
+
+  auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+  auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+  if (tuple_txn_id == INITIAL_TXN_ID &&
+      tuple_end_cid > current_txn->GetBeginCommitId()) {
+    return true;
+  }
+  current_txn->SetAbortCause(AbortCauseType::VISIBILITY, tile_group_header,
+                             tuple_id);
+  return false;
+}
+
+// the transactions that ran on the partition before us have all finished and
+// have smaller timestamps, so neither the last reader nor a CAS is needed.
+// any other tuple may be contended, and it is taken with a CAS.
+bool PartitionedTransactionManager::AcquireOwnership(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  if (IsInOwnPartition(current_txn, tile_group_header, tuple_id) == false) {
+    return TimestampOrderingTransactionManager::AcquireOwnership(
+        current_txn, tile_group_header, tuple_id);
+  }
+
+  PL_ASSERT(GetLastReaderCommitId(tile_group_header, tuple_id) <=
+            current_txn->GetBeginCommitId());
+  tile_group_header->SetTransactionId(tuple_id,
+                                      current_txn->GetTransactionId());
+  return true;
+}
+
+void PartitionedTransactionManager::PerformInsert(
+    Transaction *const current_txn, const ItemPointer &location,
+    ItemPointer *index_entry_ptr) {
+  PL_ASSERT(IsInPartition(current_txn, location) == true);
+  TimestampOrderingTransactionManager::PerformInsert(current_txn, location,
+                                                     index_entry_ptr);
+}
+
+bool PartitionedTransactionManager::PerformRead(
+    Transaction *const current_txn, const ItemPointer &location,
+    bool acquire_ownership) {
+  if (IsInOwnPartition(current_txn, location) == false) {
+    return TimestampOrderingTransactionManager::PerformRead(
+        current_txn, location, acquire_ownership);
+  }
+
+  LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroup(location.block)->GetHeader();
+  oid_t tuple_id = location.offset;
+
+  if (IsOwner(current_txn, tile_group_header, tuple_id) == false) {
+    if (acquire_ownership == true) {
+      if (IsOwnable(current_txn, tile_group_header, tuple_id) == false) {
+        return false;
+      }
+      AcquireOwnership(current_txn, tile_group_header, tuple_id);
+      // Promote to RWType::READ_OWN
+      current_txn->RecordReadOwn(location);
+    } else {
+      // no later writer can have an older timestamp, so the read does not
+      // have to be published on the tuple.
+      current_txn->RecordRead(location);
+    }
+  }
+
+  // Increment table read op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementTableReads(
+        location.block);
+  }
+  return true;
+}
+
+void PartitionedTransactionManager::PerformUpdate(
+    Transaction *const current_txn, const ItemPointer &old_location,
+    const ItemPointer &new_location) {
+  PL_ASSERT(IsInPartition(current_txn, old_location) == true);
+  TimestampOrderingTransactionManager::PerformUpdate(current_txn, old_location,
+                                                     new_location);
+}
+
+void PartitionedTransactionManager::PerformDelete(
+    Transaction *const current_txn, const ItemPointer &old_location,
+    const ItemPointer &new_location) {
+  PL_ASSERT(IsInPartition(current_txn, old_location) == true);
+  TimestampOrderingTransactionManager::PerformDelete(current_txn, old_location,
+                                                     new_location);
+}
+
+// a multi-partition transaction waits for the single-partition ones to
+// leave. the partitions are taken before the timestamp, so the transactions
+// that hold a partition in turn also get increasing timestamps.
+Transaction *PartitionedTransactionManager::BeginTransaction(
+    const size_t thread_id) {
+  for (size_t partition_itr = 0; partition_itr < partition_count_;
+       partition_itr++) {
+    partition_latches_[partition_itr].lock_shared();
+  }
+  return TimestampOrderingTransactionManager::BeginTransaction(thread_id);
+}
+
+Transaction *PartitionedTransactionManager::BeginSinglePartitionTransaction(
+    const type::Value &partition_key, const size_t thread_id) {
+  oid_t partition_id = GetPartitionId(partition_key);
+  partition_latches_[partition_id].lock();
+
+  auto txn = TimestampOrderingTransactionManager::BeginTransaction(thread_id);
+  txn->SetPartitionId(partition_id);
+  return txn;
+}
+
+// the partitions are released after the versions have been installed.
+void PartitionedTransactionManager::EndTransaction(Transaction *current_txn) {
+  oid_t partition_id = current_txn->GetPartitionId();
+
+  TimestampOrderingTransactionManager::EndTransaction(current_txn);
+
+  if (partition_id != INVALID_OID) {
+    partition_latches_[partition_id].unlock();
+  } else {
+    for (size_t partition_itr = 0; partition_itr < partition_count_;
+         partition_itr++) {
+      partition_latches_[partition_itr].unlock_shared();
+    }
+  }
+}
+
+bool PartitionedTransactionManager::IsInPartition(
+    Transaction *const current_txn, const ItemPointer &location) {
+  if (current_txn->IsSinglePartition() == false) {
+    return true;
+  }
+
+  oid_t partition_id = GetTuplePartitionId(location);
+  return partition_id == INVALID_OID ||
+         partition_id == current_txn->GetPartitionId();
+}
+
+bool PartitionedTransactionManager::IsInOwnPartition(
+    Transaction *const current_txn, const ItemPointer &location) {
+  if (current_txn->IsSinglePartition() == false) {
+    return false;
+  }
+  return GetTuplePartitionId(location) == current_txn->GetPartitionId();
+}
+
+bool PartitionedTransactionManager::IsInOwnPartition(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  if (current_txn->IsSinglePartition() == false) {
+    return false;
+  }
+  ItemPointer location(tile_group_header->GetTileGroup()->GetTileGroupId(),
+                       tuple_id);
+  return GetTuplePartitionId(location) == current_txn->GetPartitionId();
+}
+
+oid_t PartitionedTransactionManager::GetTuplePartitionId(
+    const ItemPointer &location) const {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(location.block);
+  auto table =
+      dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+  if (table == nullptr || table->GetPartitionColumn() == INVALID_OID) {
+    return INVALID_OID;
+  }
+
+  auto partition_key =
+      tile_group->GetValue(location.offset, table->GetPartitionColumn());
+  return GetPartitionId(partition_key);
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -0,0 +1,330 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// ssi_transaction_manager.cpp
+//
+// Identification: src/concurrency/ssi_transaction_manager.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/ssi_transaction_manager.h"
+
+#include <algorithm>
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "common/platform.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace concurrency {
+
+static inline uint64_t GetSireadKey(const ItemPointer &location) {
+  return ((uint64_t)location.block << 32) | location.offset;
+}
+
+SsiTransactionManager &SsiTransactionManager::GetInstance() {
+  static SsiTransactionManager txn_manager;
+  return txn_manager;
+}
+
+Transaction *SsiTransactionManager::BeginTransaction(const size_t thread_id) {
+  Transaction *txn =
+      OptimisticTransactionManager::BeginTransaction(thread_id);
+
+  ContextPtr context(new SsiTxnContext(txn->GetBeginCommitId()));
+  txn_table_.Insert(txn->GetTransactionId(), context);
+
+  return txn;
+}
+
+void SsiTransactionManager::EndTransaction(Transaction *current_txn) {
+  auto current = GetContext(current_txn->GetTransactionId());
+
+  if (current != nullptr) {
+    current->lock.Lock();
+    bool committed = (current->state == SsiTxnState::COMMITTED);
+    if (committed == false) {
+      current->state = SsiTxnState::ABORTED;
+    }
+    current->lock.Unlock();
+
+    if (committed == true) {
+      // the readers and writers that overlap a committed transaction still
+      // need to find it.
+      finished_lock_.Lock();
+      finished_contexts_.push_back(current);
+      finished_lock_.Unlock();
+    } else {
+      // nobody has to see the conflicts of an aborted transaction.
+      ReleaseContext(current);
+    }
+  }
+
+  OptimisticTransactionManager::EndTransaction(current_txn);
+
+  RetireContexts();
+}
+
+// a writer finds the concurrent readers of the tuple through their SIREAD
+// locks.
+bool SsiTransactionManager::AcquireOwnership(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  if (OptimisticTransactionManager::AcquireOwnership(
+          current_txn, tile_group_header, tuple_id) == false) {
+    return false;
+  }
+
+  auto current = GetContext(current_txn->GetTransactionId());
+  PL_ASSERT(current != nullptr);
+
+  ItemPointer location(tile_group_header->GetTileGroup()->GetTileGroupId(),
+                       tuple_id);
+
+  for (auto reader_cid : GetReaders(location)) {
+    if (reader_cid == current->begin_cid) {
+      continue;
+    }
+    auto reader = GetContext(reader_cid);
+    if (reader == nullptr) {
+      continue;
+    }
+    if (AddConflict(current, reader, false) == false) {
+      LOG_TRACE("Dangerous structure on (%u, %u)", location.block,
+                location.offset);
+      tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+      current_txn->SetAbortCause(AbortCauseType::VALIDATION, tile_group_header,
+                                 tuple_id);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SsiTransactionManager::PerformRead(Transaction *const current_txn,
+                                        const ItemPointer &location,
+                                        bool acquire_ownership) {
+  if (OptimisticTransactionManager::PerformRead(current_txn, location,
+                                                acquire_ownership) == false) {
+    return false;
+  }
+
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return true;
+  }
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroup(location.block)->GetHeader();
+  oid_t tuple_id = location.offset;
+
+  if (IsOwner(current_txn, tile_group_header, tuple_id) == true) {
+    return true;
+  }
+
+  auto current = GetContext(current_txn->GetTransactionId());
+  PL_ASSERT(current != nullptr);
+
+  // take the SIREAD lock before looking for a writer. a writer that acquires
+  // the tuple concurrently then either finds the lock, or is found here.
+  AddReader(location, current);
+
+  // the version is being replaced by a running writer, or has already been
+  // replaced by a writer that committed after we began.
+  ContextPtr writer;
+  txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+  if (tuple_txn_id != INITIAL_TXN_ID && tuple_txn_id != INVALID_TXN_ID) {
+    writer = GetContext(tuple_txn_id);
+  } else {
+    cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+    if (tuple_end_cid != MAX_CID) {
+      writer = GetContext(tuple_end_cid);
+    }
+  }
+
+  if (writer != nullptr && AddConflict(current, writer, true) == false) {
+    LOG_TRACE("Dangerous structure on (%u, %u)", location.block,
+              location.offset);
+    current_txn->SetAbortCause(AbortCauseType::VALIDATION, tile_group_header,
+                               tuple_id);
+    return false;
+  }
+  return true;
+}
+
+ResultType SsiTransactionManager::CommitTransaction(
+    Transaction *const current_txn) {
+  LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
+
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    EndReadonlyTransaction(current_txn);
+    return ResultType::SUCCESS;
+  }
+
+  auto current = GetContext(current_txn->GetTransactionId());
+  PL_ASSERT(current != nullptr);
+
+  cid_t end_commit_id = EpochManagerFactory::GetInstance().GetCommitId();
+
+  // once committed, the conflicts that show up later abort the other side.
+  current->lock.Lock();
+  if (current->in_conflict == true && current->out_conflict == true) {
+    current->lock.Unlock();
+    current_txn->SetAbortCause(AbortCauseType::VALIDATION, INVALID_OID,
+                               INVALID_ITEMPOINTER);
+    return AbortTransaction(current_txn);
+  }
+  current->state = SsiTxnState::COMMITTED;
+  current->commit_cid = end_commit_id;
+  current->lock.Unlock();
+
+  // the readers of a replaced version find its writer by the end commit id.
+  txn_table_.Insert(end_commit_id, current);
+
+  return InstallTransaction(current_txn, end_commit_id);
+}
+
+SsiTransactionManager::ContextPtr SsiTransactionManager::GetContext(
+    const cid_t cid) {
+  ContextPtr context;
+  if (txn_table_.Find(cid, context) == false) {
+    return nullptr;
+  }
+  return context;
+}
+
+// A dangerous structure is reader -> pivot -> writer, where both edges are
+// rw-antidependencies between concurrent transactions. The pivot is aborted
+// if it is still running, otherwise the current transaction is.
+bool SsiTransactionManager::AddConflict(const ContextPtr &current,
+                                        const ContextPtr &other,
+                                        const bool current_is_reader) {
+  bool dangerous = false;
+
+  other->lock.Lock();
+  if (other->state == SsiTxnState::ABORTED ||
+      (other->state == SsiTxnState::COMMITTED &&
+       other->commit_cid < current->begin_cid)) {
+    // the other transaction is not concurrent with the current one.
+    other->lock.Unlock();
+    return true;
+  }
+  if (current_is_reader == true) {
+    other->in_conflict = true;
+    dangerous = (other->state == SsiTxnState::COMMITTED &&
+                 other->out_conflict == true);
+  } else {
+    other->out_conflict = true;
+    dangerous = (other->state == SsiTxnState::COMMITTED &&
+                 other->in_conflict == true);
+  }
+  other->lock.Unlock();
+
+  current->lock.Lock();
+  if (current_is_reader == true) {
+    current->out_conflict = true;
+  } else {
+    current->in_conflict = true;
+  }
+  dangerous = dangerous ||
+              (current->in_conflict == true && current->out_conflict == true);
+  current->lock.Unlock();
+
+  return dangerous == false;
+}
+
+void SsiTransactionManager::AddReader(const ItemPointer &location,
+                                      const ContextPtr &reader) {
+  uint64_t key = GetSireadKey(location);
+  auto &partition = siread_partitions_[key % SIREAD_PARTITION_COUNT];
+
+  partition.lock.Lock();
+  auto &readers = partition.readers[key];
+  bool inserted = false;
+  if (std::find(readers.begin(), readers.end(), reader->begin_cid) ==
+      readers.end()) {
+    readers.push_back(reader->begin_cid);
+    inserted = true;
+  }
+  partition.lock.Unlock();
+
+  // only the owner of the context touches its read set until it ends.
+  if (inserted == true) {
+    reader->read_set.push_back(location);
+  }
+}
+
+std::vector<cid_t> SsiTransactionManager::GetReaders(
+    const ItemPointer &location) {
+  uint64_t key = GetSireadKey(location);
+  auto &partition = siread_partitions_[key % SIREAD_PARTITION_COUNT];
+
+  std::vector<cid_t> readers;
+  partition.lock.Lock();
+  auto itr = partition.readers.find(key);
+  if (itr != partition.readers.end()) {
+    readers = itr->second;
+  }
+  partition.lock.Unlock();
+  return readers;
+}
+
+void SsiTransactionManager::RemoveReader(const ItemPointer &location,
+                                         const cid_t reader_cid) {
+  uint64_t key = GetSireadKey(location);
+  auto &partition = siread_partitions_[key % SIREAD_PARTITION_COUNT];
+
+  partition.lock.Lock();
+  auto itr = partition.readers.find(key);
+  if (itr != partition.readers.end()) {
+    auto &readers = itr->second;
+    readers.erase(std::remove(readers.begin(), readers.end(), reader_cid),
+                  readers.end());
+    if (readers.empty()) {
+      partition.readers.erase(itr);
+    }
+  }
+  partition.lock.Unlock();
+}
+
+void SsiTransactionManager::ReleaseContext(const ContextPtr &context) {
+  for (auto &location : context->read_set) {
+    RemoveReader(location, context->begin_cid);
+  }
+  txn_table_.Erase(context->begin_cid);
+  if (context->commit_cid != MAX_CID) {
+    txn_table_.Erase(context->commit_cid);
+  }
+}
+
+void SsiTransactionManager::RetireContexts() {
+  std::vector<ContextPtr> retired_contexts;
+
+  if (finished_lock_.TryLock() == false) {
+    return;
+  }
+  if (finished_contexts_.size() >= RETIRE_THRESHOLD) {
+    // every transaction that began before this commit id has ended.
+    cid_t max_committed_cid =
+        EpochManagerFactory::GetInstance().GetMaxCommittedCid();
+    while (finished_contexts_.empty() == false &&
+           finished_contexts_.front()->commit_cid <= max_committed_cid) {
+      retired_contexts.push_back(finished_contexts_.front());
+      finished_contexts_.pop_front();
+    }
+  }
+  finished_lock_.Unlock();
+
+  for (auto &context : retired_contexts) {
+    ReleaseContext(context);
+  }
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
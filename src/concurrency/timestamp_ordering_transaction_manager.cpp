@@ -12,14 +12,20 @@
 
 #include "concurrency/timestamp_ordering_transaction_manager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 #include "catalog/manager.h"
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/platform.h"
 #include "concurrency/transaction.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
 #include "logging/log_manager.h"
 #include "logging/records/transaction_record.h"
+#include "storage/undo_buffer.h"
 
 namespace peloton {
 namespace concurrency {
@@ -134,11 +140,11 @@ void TimestampOrderingTransactionManager::EndTransaction(
   if (current_txn->GetResult() == ResultType::SUCCESS) {
     if (current_txn->IsGCSetEmpty() != true) {
       gc::GCManagerFactory::GetInstance().
-          RecycleTransaction(current_txn->GetGCSetPtr(), current_txn->GetBeginCommitId());
+          RecycleTransaction(current_txn->GetGCSetPtr(), current_txn->GetEndCommitId());
     }
     // Log the transaction's commit
-    // For time stamp ordering, every transaction only has one timestamp
-    log_manager.LogCommitTransaction(current_txn->GetBeginCommitId());
+    // For time stamp ordering, the end commit id is the begin commit id
+    log_manager.LogCommitTransaction(current_txn->GetEndCommitId());
   } else {
     if (current_txn->IsGCSetEmpty() != true) {
       gc::GCManagerFactory::GetInstance().
@@ -296,6 +302,12 @@ VisibilityType TimestampOrderingTransactionManager::IsVisible(
     } else if (tuple_end_cid == INVALID_CID) {
       // tuple being deleted by current txn
       return VisibilityType::DELETED;
+    } else if (current_txn->GetRWType(ItemPointer(tile_group_id, tuple_id)) ==
+                   RWType::UPDATE &&
+               tile_group_header->GetPrevItemPointer(tuple_id).IsNull() ==
+                   true) {
+      // tuple being updated in place by current txn
+      return VisibilityType::OK;
     } else {
       // old version of the tuple that is being updated by current txn
       return VisibilityType::INVISIBLE;
@@ -311,6 +323,9 @@ VisibilityType TimestampOrderingTransactionManager::IsVisible(
         // the older version may be visible.
         if (activated && !invalidated) {
           return VisibilityType::OK;
+        } else if (!invalidated &&
+                   IsUndoVisible(current_txn, tile_group_header, tuple_id)) {
+          return VisibilityType::OK;
         } else {
           return VisibilityType::INVISIBLE;
         }
@@ -319,6 +334,9 @@ VisibilityType TimestampOrderingTransactionManager::IsVisible(
       // if the tuple is not owned by any transaction.
       if (activated && !invalidated) {
         return VisibilityType::OK;
+      } else if (!invalidated &&
+                 IsUndoVisible(current_txn, tile_group_header, tuple_id)) {
+        return VisibilityType::OK;
       } else {
         return VisibilityType::INVISIBLE;
       }
@@ -326,6 +344,94 @@ VisibilityType TimestampOrderingTransactionManager::IsVisible(
   }
 }
 
+// a tuple that was updated in place after the transaction began is still
+// visible to it if one of its undo records goes back far enough.
+bool TimestampOrderingTransactionManager::IsUndoVisible(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  if (FLAGS_delta_versions == false) {
+    return false;
+  }
+  // a record is only reclaimed after every snapshot that could follow the
+  // chain past it has ended.
+  for (auto record = tile_group_header->GetUndoRecord(tuple_id);
+       record != nullptr; record = record->next) {
+    if (record->begin_cid <= current_txn->GetBeginCommitId()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// copy the version of the tuple that is visible to the transaction. if the
+// tuple was updated in place since, the version is rebuilt from the values in
+// the tuple slot and the undo records of the tuple.
+VisibilityType TimestampOrderingTransactionManager::ReadVersion(
+    Transaction *const current_txn, storage::TileGroup *tile_group,
+    const oid_t &tuple_id, std::vector<type::Value> &values) {
+  auto tile_group_header = tile_group->GetHeader();
+  auto column_count =
+      tile_group->GetAbstractTable()->GetSchema()->GetColumnCount();
+  cid_t snapshot_cid = current_txn->GetBeginCommitId();
+
+  while (true) {
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
+    cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+    auto head = tile_group_header->GetUndoRecord(tuple_id);
+    cid_t head_end_cid = (head != nullptr) ? head->end_cid.load() : MAX_CID;
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    values.clear();
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      values.push_back(tile_group->GetValue(tuple_id, column_itr));
+    }
+
+    // an update in place that went on during the copy may have torn it, so
+    // the copy only counts if the header has not moved in the meantime.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (tile_group_header->GetTransactionId(tuple_id) != tuple_txn_id ||
+        tile_group_header->GetBeginCommitId(tuple_id) != tuple_begin_cid ||
+        tile_group_header->GetEndCommitId(tuple_id) != tuple_end_cid ||
+        tile_group_header->GetUndoRecord(tuple_id) != head ||
+        (head != nullptr && head->end_cid.load() != head_end_cid)) {
+      continue;
+    }
+
+    if (head == nullptr || tuple_txn_id == current_txn->GetTransactionId() ||
+        tuple_txn_id == INVALID_TXN_ID || tuple_begin_cid == MAX_CID ||
+        snapshot_cid >= tuple_end_cid) {
+      // the values in the tuple slot are the ones of the version.
+      return IsVisible(current_txn, tile_group_header, tuple_id);
+    }
+
+    cid_t version_begin_cid;
+    auto record = head;
+    if (head_end_cid == MAX_CID) {
+      // the values in the tuple slot are not committed yet.
+      head->Apply(values);
+      version_begin_cid = head->begin_cid;
+      record = head->next;
+    } else {
+      // the begin commit id of the tuple lags behind while the update that
+      // made the head record commits.
+      version_begin_cid = head_end_cid;
+    }
+    if (version_begin_cid <= snapshot_cid) {
+      return VisibilityType::OK;
+    }
+
+    for (; record != nullptr; record = record->next) {
+      record->Apply(values);
+      if (record->begin_cid <= snapshot_cid) {
+        return VisibilityType::OK;
+      }
+    }
+    return VisibilityType::INVISIBLE;
+  }
+}
+
 // check whether the current transaction owns the tuple.
 // this function is called by update/delete executors.
 bool TimestampOrderingTransactionManager::IsOwner(
@@ -354,10 +460,63 @@ bool TimestampOrderingTransactionManager::IsOwnable(
     Transaction *const current_txn,
     const storage::TileGroupHeader *const tile_group_header,
     const oid_t &tuple_id) {
+  WaitForOwner(current_txn, tile_group_header, tuple_id);
+
   auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
   auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
-  return tuple_txn_id == INITIAL_TXN_ID &&
-         tuple_end_cid > current_txn->GetBeginCommitId();
+  if (tuple_txn_id != INITIAL_TXN_ID) {
+    current_txn->SetAbortCause(AbortCauseType::OWNERSHIP_CONFLICT,
+                               tile_group_header, tuple_id);
+    return false;
+  }
+  if (tuple_end_cid <= current_txn->GetBeginCommitId()) {
+    // a newer version has been committed in the meantime.
+    current_txn->SetAbortCause(AbortCauseType::VISIBILITY, tile_group_header,
+                               tuple_id);
+    return false;
+  }
+  return true;
+}
+
+// a short conflict on a hot tuple is cheaper to wait out than to abort and
+// re-execute the whole transaction. only a transaction that is older than
+// the owner waits, and a younger one fails right away (wait-die), so no two
+// transactions can wait for each other.
+bool TimestampOrderingTransactionManager::WaitForOwner(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  if (TransactionManagerFactory::GetConflictAvoidance() !=
+      ConflictAvoidanceType::WAIT) {
+    return false;
+  }
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::microseconds(
+                      static_cast<int64_t>(CONFLICT_WAIT_TIMEOUT));
+  size_t round = 0;
+  while (true) {
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    if (tuple_txn_id == INITIAL_TXN_ID) {
+      return true;
+    }
+    if (tuple_txn_id == INVALID_TXN_ID ||
+        tuple_txn_id == current_txn->GetTransactionId() ||
+        tuple_txn_id < current_txn->GetTransactionId()) {
+      // not a live owner, or an older one that we must not wait for.
+      return false;
+    }
+
+    if (++round < CONFLICT_SPIN_ROUNDS) {
+      _mm_pause();
+      continue;
+    }
+    if (std::chrono::steady_clock::now() > deadline) {
+      LOG_TRACE("Gave up waiting for txn %lu", tuple_txn_id);
+      return false;
+    }
+    std::this_thread::yield();
+  }
 }
 
 bool TimestampOrderingTransactionManager::AcquireOwnership(
@@ -376,15 +535,28 @@ bool TimestampOrderingTransactionManager::AcquireOwnership(
   if (last_reader_cid > current_txn->GetBeginCommitId()) {
     GetSpinlockField(tile_group_header, tuple_id)->Unlock();
 
+    current_txn->SetAbortCause(AbortCauseType::READ_TIMESTAMP,
+                               tile_group_header, tuple_id);
     return false;
   } else {
     if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
       GetSpinlockField(tile_group_header, tuple_id)->Unlock();
 
+      current_txn->SetAbortCause(AbortCauseType::OWNERSHIP_CONFLICT,
+                                 tile_group_header, tuple_id);
       return false;
     } else {
       GetSpinlockField(tile_group_header, tuple_id)->Unlock();
 
+      if (FLAGS_delta_versions == true &&
+          tile_group_header->GetBeginCommitId(tuple_id) >
+              current_txn->GetBeginCommitId()) {
+        // an update in place has committed since the tuple was read.
+        tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+        current_txn->SetAbortCause(AbortCauseType::VISIBILITY,
+                                   tile_group_header, tuple_id);
+        return false;
+      }
       return true;
     }
   }
@@ -453,8 +625,15 @@ bool TimestampOrderingTransactionManager::PerformRead(
   }
   // if the current transaction does not own this tuple, then attemp to set last
   // reader cid.
-  if (SetLastReaderCommitId(tile_group_header, tuple_id,
-                            current_txn->GetBeginCommitId()) == true) {
+  bool read_success = SetLastReaderCommitId(tile_group_header, tuple_id,
+                                            current_txn->GetBeginCommitId());
+  if (read_success == false &&
+      WaitForOwner(current_txn, tile_group_header, tuple_id) == true) {
+    // the owner is gone, try again.
+    read_success = SetLastReaderCommitId(tile_group_header, tuple_id,
+                                         current_txn->GetBeginCommitId());
+  }
+  if (read_success == true) {
     current_txn->RecordRead(location);
     // Increment table read op stats
     if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
@@ -466,6 +645,8 @@ bool TimestampOrderingTransactionManager::PerformRead(
     // if the tuple has been owned by some concurrent transactions, then read
     // fails.
     LOG_TRACE("Transaction read failed");
+    current_txn->SetAbortCause(AbortCauseType::OWNERSHIP_CONFLICT,
+                               tile_group_header, tuple_id);
     return false;
   }
 }
@@ -757,6 +938,104 @@ void TimestampOrderingTransactionManager::PerformDelete(
   }
 }
 
+// the txn keeps one undo record per tuple, with the values that the updated
+// columns had before its first update. the record goes in front of the
+// chain before the caller overwrites the tuple slot.
+void TimestampOrderingTransactionManager::PerformInPlaceUpdate(
+    Transaction *const current_txn, const ItemPointer &location,
+    const std::vector<oid_t> &column_ids) {
+  PL_ASSERT(current_txn->IsDeclaredReadOnly() == false);
+
+  oid_t tuple_id = location.offset;
+  auto txn_id = current_txn->GetTransactionId();
+
+  auto tile_group =
+      catalog::Manager::GetInstance().GetTileGroup(location.block);
+  auto tile_group_header = tile_group->GetHeader();
+
+  PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) == txn_id);
+  PL_ASSERT(tile_group_header->GetPrevItemPointer(tuple_id).IsNull() == true);
+
+  auto head = tile_group_header->GetUndoRecord(tuple_id);
+  // only the owner of the tuple leaves an uncommitted record in front.
+  bool own_head = (head != nullptr && head->end_cid.load() == MAX_CID);
+  PL_ASSERT(own_head == false || head->txn_id == txn_id);
+
+  std::vector<oid_t> new_column_ids;
+  for (auto column_id : column_ids) {
+    if (own_head == false ||
+        std::find(head->column_ids.begin(), head->column_ids.end(),
+                  column_id) == head->column_ids.end()) {
+      new_column_ids.push_back(column_id);
+    }
+  }
+
+  if (new_column_ids.empty() == false) {
+    auto &undo_buffer = storage::UndoBuffer::GetInstance();
+    storage::UndoRecord *undo_record = nullptr;
+    if (own_head == true) {
+      // records are never changed once they are published, so the columns
+      // of the earlier update go into a new record.
+      undo_record = undo_buffer.NewRecord(txn_id, head->begin_cid, location,
+                                          head->next);
+      undo_record->column_ids = head->column_ids;
+      undo_record->values = head->values;
+    } else {
+      undo_record = undo_buffer.NewRecord(
+          txn_id, tile_group_header->GetBeginCommitId(tuple_id), location,
+          head);
+    }
+    for (auto column_id : new_column_ids) {
+      undo_record->column_ids.push_back(column_id);
+      undo_record->values.push_back(tile_group->GetValue(tuple_id, column_id));
+    }
+
+    tile_group_header->SetUndoRecord(tuple_id, undo_record);
+
+    // readers must find the record before the tuple slot changes.
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (own_head == true) {
+      // the replaced record is left behind as an empty version.
+      head->end_cid.store(head->begin_cid);
+    }
+    if (head != nullptr) {
+      storage::UndoBuffer::Unlink(head);
+    }
+  }
+
+  current_txn->RecordUpdate(location);
+
+  // Increment table update op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementTableUpdates(
+        location.block);
+  }
+}
+
+// readers apply the record until it turns into an empty version, so the
+// values are written back first.
+void TimestampOrderingTransactionManager::RevertInPlaceUpdate(
+    Transaction *const current_txn, storage::TileGroup *tile_group,
+    const oid_t &tuple_id) {
+  auto undo_record = tile_group->GetHeader()->GetUndoRecord(tuple_id);
+  if (undo_record == nullptr || undo_record->end_cid.load() != MAX_CID) {
+    // the txn did not update the tuple in place.
+    return;
+  }
+  PL_ASSERT(undo_record->txn_id == current_txn->GetTransactionId());
+
+  for (oid_t column_itr = 0; column_itr < undo_record->column_ids.size();
+       column_itr++) {
+    auto value = undo_record->values[column_itr];
+    tile_group->SetValue(value, tuple_id, undo_record->column_ids[column_itr]);
+  }
+
+  COMPILER_MEMORY_FENCE;
+
+  undo_record->end_cid.store(undo_record->begin_cid);
+}
+
 ResultType TimestampOrderingTransactionManager::CommitTransaction(
     Transaction *const current_txn) {
   LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
@@ -766,11 +1045,18 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
     return ResultType::SUCCESS;
   }
 
+  // every transaction only has one timestamp
+  return InstallTransaction(current_txn, current_txn->GetBeginCommitId());
+}
+
+// install the write set of a transaction with the given end commit id, and
+// end the transaction.
+ResultType TimestampOrderingTransactionManager::InstallTransaction(
+    Transaction *const current_txn, const cid_t end_commit_id) {
   auto &manager = catalog::Manager::GetInstance();
   auto &log_manager = logging::LogManager::GetInstance();
 
-  // generate transaction id.
-  cid_t end_commit_id = current_txn->GetBeginCommitId();
+  current_txn->SetEndCommitId(end_commit_id);
   log_manager.LogBeginTransaction(end_commit_id);
 
   auto &rw_set = current_txn->GetReadWriteSet();
@@ -800,7 +1086,36 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
         // update/delete yet
         // Yield the ownership
         YieldOwnership(current_txn, tile_group_id, tuple_slot);
+      } else if (tuple_entry.second == RWType::UPDATE &&
+                 tile_group_header->GetPrevItemPointer(tuple_slot).IsNull() ==
+                     true) {
+        // the tuple was updated in place, and its undo record becomes the
+        // version that ends here.
+        auto undo_record = tile_group_header->GetUndoRecord(tuple_slot);
+        PL_ASSERT(undo_record != nullptr &&
+                  undo_record->txn_id == current_txn->GetTransactionId());
+        undo_record->end_cid.store(end_commit_id);
+
+        COMPILER_MEMORY_FENCE;
+
+        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+
+        // we should set the version before releasing the lock.
+        COMPILER_MEMORY_FENCE;
+
+        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+        // nothing to be added to gc set.
+
+        // add to log manager
+        log_manager.LogUpdate(end_commit_id,
+                              ItemPointer(tile_group_id, tuple_slot),
+                              ItemPointer(tile_group_id, tuple_slot));
+
       } else if (tuple_entry.second == RWType::UPDATE) {
+        // the new version carries the values that the txn wrote in place.
+        RevertInPlaceUpdate(current_txn, tile_group.get(), tuple_slot);
+
         // we must guarantee that, at any time point, only one version is
         // visible.
         ItemPointer new_version =
@@ -835,6 +1150,8 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
             end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
 
       } else if (tuple_entry.second == RWType::DELETE) {
+        RevertInPlaceUpdate(current_txn, tile_group.get(), tuple_slot);
+
         ItemPointer new_version =
             tile_group_header->GetPrevItemPointer(tuple_slot);
 
@@ -953,7 +1270,22 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
         // update/delete yet
         // Yield the ownership
         YieldOwnership(current_txn, tile_group_id, tuple_slot);
+      } else if (tuple_entry.second == RWType::UPDATE &&
+                 tile_group_header->GetPrevItemPointer(tuple_slot).IsNull() ==
+                     true) {
+        // the tuple was updated in place.
+        RevertInPlaceUpdate(current_txn, tile_group.get(), tuple_slot);
+
+        // we should set the version before releasing the lock.
+        COMPILER_MEMORY_FENCE;
+
+        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+        // nothing to be added to gc set.
+
       } else if (tuple_entry.second == RWType::UPDATE) {
+        RevertInPlaceUpdate(current_txn, tile_group.get(), tuple_slot);
+
         ItemPointer new_version =
             tile_group_header->GetPrevItemPointer(tuple_slot);
 
@@ -1012,6 +1344,8 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
         gc_set->operator[](new_version.block)[new_version.offset] = false;
 
       } else if (tuple_entry.second == RWType::DELETE) {
+        RevertInPlaceUpdate(current_txn, tile_group.get(), tuple_slot);
+
         ItemPointer new_version =
             tile_group_header->GetPrevItemPointer(tuple_slot);
 
@@ -1094,6 +1428,14 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
   }
 
   current_txn->SetResult(ResultType::ABORTED);
+
+  // Count the abort by cause, while the txn is still around
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->RecordAbortCause(
+        current_txn->GetAbortCause(), current_txn->GetAbortTableId(),
+        current_txn->GetAbortLocation());
+  }
+
   EndTransaction(current_txn);
 
   // Increment # txns aborted metric
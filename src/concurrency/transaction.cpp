@@ -16,6 +16,8 @@
 #include "common/logger.h"
 #include "common/platform.h"
 #include "common/macros.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
 
 #include <chrono>
 #include <thread>
@@ -177,6 +179,18 @@ bool Transaction::RecordDelete(const ItemPointer &location) {
   return false;
 }
 
+void Transaction::SetAbortCause(
+    const AbortCauseType cause,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t tuple_id) {
+  if (abort_cause_ != AbortCauseType::INVALID) {
+    return;
+  }
+  auto tile_group = tile_group_header->GetTileGroup();
+  SetAbortCause(cause, tile_group->GetTableId(),
+                ItemPointer(tile_group->GetTileGroupId(), tuple_id));
+}
+
 const std::string Transaction::GetInfo() const {
   std::ostringstream os;
 
@@ -19,5 +19,7 @@ ConcurrencyType TransactionManagerFactory::protocol_ =
     ConcurrencyType::TIMESTAMP_ORDERING;
 IsolationLevelType TransactionManagerFactory::isolation_level_ =
     IsolationLevelType::FULL;
+ConflictAvoidanceType TransactionManagerFactory::conflict_avoidance_ =
+    ConflictAvoidanceType::ABORT;
 }
 }
@@ -36,7 +36,19 @@ void PrintConfiguration(){
   LOG_INFO("%30s: %10lu","Port", FLAGS_port);
   LOG_INFO("%30s: %10s","Socket Family", FLAGS_socket_family.c_str());
   LOG_INFO("%30s: %10lu","Statistics", FLAGS_stats_mode);
+  LOG_INFO("%30s: %10lu","Statistics Port", FLAGS_stats_port);
   LOG_INFO("%30s: %10lu","Max Connections", FLAGS_max_connections);
+  LOG_INFO("%30s: %10d","Tile Huge Pages", FLAGS_tile_huge_pages);
+  LOG_INFO("%30s: %10d","Tile NUMA Binding", FLAGS_tile_numa_binding);
+  LOG_INFO("%30s: %10d","Tile Group Compaction", FLAGS_tile_group_compaction);
+  LOG_INFO("%30s: %10.2f","Compaction Threshold",
+           FLAGS_tile_group_compaction_threshold);
+  LOG_INFO("%30s: %10d","Anti-Caching", FLAGS_anti_caching);
+  LOG_INFO("%30s: %10s","Anti-Caching File", FLAGS_anti_caching_file.c_str());
+  LOG_INFO("%30s: %10lu","Anti-Caching Cold Passes",
+           FLAGS_anti_caching_cold_passes);
+  LOG_INFO("%30s: %10d","Tile Group Freezing", FLAGS_tile_group_freezing);
+  LOG_INFO("%30s: %10d","Delta Versions", FLAGS_delta_versions);
 
   LOG_INFO(" ");
   LOG_INFO("%30s", "//===---------------------------------------------------===//");
@@ -70,6 +82,47 @@ DEFINE_string(socket_family,
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
 
+DEFINE_bool(tile_huge_pages,
+            false,
+            "Allocate tile groups from huge page regions (default: false)");
+
+DEFINE_bool(tile_numa_binding,
+            false,
+            "Bind tile groups to the NUMA node of their inserting threads "
+            "(default: false)");
+
+DEFINE_bool(tile_group_compaction,
+            false,
+            "Compact sparsely populated tile groups (default: false)");
+
+DEFINE_double(tile_group_compaction_threshold,
+              0.2,
+              "Occupancy below which a tile group is compacted (default: 0.2)");
+
+DEFINE_bool(anti_caching,
+            false,
+            "Evict cold tile groups to secondary storage (default: false)");
+
+DEFINE_string(anti_caching_file,
+              "peloton_anti_cache.data",
+              "File for evicted tile groups "
+              "(default: peloton_anti_cache.data)");
+
+DEFINE_uint64(anti_caching_cold_passes,
+              10,
+              "Eviction passes a tile group must stay untouched to be evicted "
+              "(default: 10)");
+
+DEFINE_bool(tile_group_freezing,
+            false,
+            "Compress tile groups whose tuples are visible to every "
+            "transaction (default: false)");
+
+DEFINE_bool(delta_versions,
+            false,
+            "Update tuples in place and keep their older versions as column "
+            "deltas in undo buffers (default: false)");
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
@@ -94,6 +147,11 @@ DEFINE_uint64(stats_mode,
               peloton::STATS_TYPE_INVALID,
               "Enable statistics collection (default: 0)");
 
+DEFINE_uint64(stats_port,
+              0,
+              "Port to serve the statistics on in the Prometheus text format "
+              "at /metrics, 0 to disable (default: 0)");
+
 //===----------------------------------------------------------------------===//
 // AI
 //===----------------------------------------------------------------------===//
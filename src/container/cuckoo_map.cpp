@@ -25,6 +25,10 @@ namespace storage {
 class TileGroup;
 }
 
+namespace concurrency {
+struct SsiTxnContext;
+}
+
 namespace stats {
 class BackendStatsContext;
 class IndexMetric;
@@ -100,4 +104,6 @@ template class CuckooMap<std::thread::id,
 
 template class CuckooMap<oid_t, std::shared_ptr<stats::IndexMetric>>;
 
+template class CuckooMap<cid_t, std::shared_ptr<concurrency::SsiTxnContext>>;
+
 }  // End peloton namespace
@@ -12,6 +12,7 @@
 
 #include "type/value.h"
 #include "common/logger.h"
+#include "common/timer.h"
 #include "executor/abstract_executor.h"
 #include "executor/executor_context.h"
 #include "planner/abstract_plan.h"
@@ -90,11 +91,36 @@ bool AbstractExecutor::Execute() {
   // TODO In the future, we might want to pass some kind of executor state to
   // GetNextTile. e.g. params for prepared plans.
 
+  if (profiling_ == false) {
+    return DExecute();
+  }
+
+  Timer<std::ratio<1, 1000>> timer;
+  timer.Start();
   bool status = DExecute();
+  timer.Stop();
+
+  stats_.execute_count++;
+  stats_.time_ms += timer.GetDuration();
+  if (status == true && output != nullptr) {
+    stats_.tile_count++;
+    stats_.tuple_count += output->GetTupleCount();
+  }
 
   return status;
 }
 
+/**
+ * @brief Turns on the runtime statistics of this executor and of all its
+ * children. This must be done before the tree runs.
+ */
+void AbstractExecutor::EnableProfiling() {
+  profiling_ = true;
+  for (auto child : children_) {
+    child->EnableProfiling();
+  }
+}
+
 void AbstractExecutor::SetContext(type::Value &value) {
   executor_context_->SetParams(value);
 }
@@ -49,6 +49,8 @@ bool AbstractJoinExecutor::DInit() {
 
   // NOTE: predicate can be null for cartesian product
   predicate_ = node.GetPredicate();
+  compiled_predicate_ =
+      expression::CompiledExpression::Compile(predicate_, executor_context_);
   proj_info_ = node.GetProjInfo();
   join_type_ = node.GetJoinType();
   proj_schema_ = node.GetSchema();
@@ -18,12 +18,18 @@
 #include <vector>
 
 #include "type/types.h"
+#include "catalog/schema.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/join_bloom_filter.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "expression/abstract_expression.h"
+#include "expression/tuple_value_expression.h"
 #include "common/container_tuple.h"
 #include "storage/data_table.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
+#include "storage/zone_map.h"
 
 #include "common/logger.h"
 
@@ -50,12 +56,158 @@ bool AbstractScanExecutor::DInit() {
   const planner::AbstractScan &node = GetPlanNode<planner::AbstractScan>();
 
   predicate_ = node.GetPredicate();
+  compiled_predicate_ =
+      expression::CompiledExpression::Compile(predicate_, executor_context_);
   // auto column_ids = node.GetColumnIds();
 
   column_ids_ = std::move(node.GetColumnIds());
 
+  copy_versions_ = concurrency::TransactionManagerFactory::IsDeltaVersioning();
+
+  return true;
+}
+
+bool AbstractScanExecutor::ExtractColumnPredicates(
+    const expression::AbstractExpression *predicate) {
+  auto expression_type = predicate->GetExpressionType();
+  if (expression_type == ExpressionType::CONJUNCTION_AND) {
+    bool left_only = ExtractColumnPredicates(predicate->GetChild(0));
+    bool right_only = ExtractColumnPredicates(predicate->GetChild(1));
+    return left_only && right_only;
+  }
+
+  switch (expression_type) {
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      break;
+    default:
+      return false;
+  }
+  auto comparison_type = expression_type;
+
+  // Put the column on the left
+  auto column_expr = predicate->GetChild(0);
+  auto value_expr = predicate->GetChild(1);
+  if (column_expr->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+    std::swap(column_expr, value_expr);
+    switch (comparison_type) {
+      case ExpressionType::COMPARE_LESSTHAN:
+        comparison_type = ExpressionType::COMPARE_GREATERTHAN;
+        break;
+      case ExpressionType::COMPARE_GREATERTHAN:
+        comparison_type = ExpressionType::COMPARE_LESSTHAN;
+        break;
+      case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+        comparison_type = ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+        break;
+      case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        comparison_type = ExpressionType::COMPARE_LESSTHANOREQUALTO;
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (column_expr->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+      (value_expr->GetExpressionType() != ExpressionType::VALUE_CONSTANT &&
+       value_expr->GetExpressionType() != ExpressionType::VALUE_PARAMETER)) {
+    return false;
+  }
+
+  auto tuple_value_expr =
+      static_cast<const expression::TupleValueExpression *>(column_expr);
+  if (tuple_value_expr->GetTupleId() != 0 ||
+      tuple_value_expr->GetColumnId() < 0) {
+    return false;
+  }
+
+  column_predicates_.push_back(
+      {static_cast<oid_t>(tuple_value_expr->GetColumnId()), comparison_type,
+       value_expr});
   return true;
 }
 
+bool AbstractScanExecutor::CanSkipTileGroup(
+    storage::TileGroup *tile_group) const {
+  auto zone_map = tile_group->GetZoneMap();
+  for (auto &column_predicate : column_predicates_) {
+    auto constant =
+        column_predicate.value->Evaluate(nullptr, nullptr, executor_context_);
+    if (zone_map->MayMatch(column_predicate.column_id,
+                           column_predicate.comparison_type,
+                           constant) == false) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void AbstractScanExecutor::SetBloomFilter(
+    const JoinBloomFilter *bloom_filter,
+    const std::vector<oid_t> &key_column_offsets) {
+  std::vector<oid_t> key_column_ids;
+  for (auto key_column_offset : key_column_offsets) {
+    // Without projection the scan produces all the columns of the table
+    if (column_ids_.empty() == true) {
+      key_column_ids.push_back(key_column_offset);
+    } else if (key_column_offset < column_ids_.size()) {
+      key_column_ids.push_back(column_ids_[key_column_offset]);
+    } else {
+      return;
+    }
+  }
+
+  bloom_filter_ = bloom_filter;
+  bloom_filter_column_ids_ = std::move(key_column_ids);
+}
+
+bool AbstractScanExecutor::MayMatchBloomFilter(storage::TileGroup *tile_group,
+                                               const oid_t &tuple_id) const {
+  if (bloom_filter_ == nullptr) {
+    return true;
+  }
+
+  // Hash the key the same way the hash table does
+  expression::ContainerTuple<storage::TileGroup> key(tile_group, tuple_id,
+                                                     &bloom_filter_column_ids_);
+  return bloom_filter_->MayContain(key.HashCode());
+}
+
+bool AbstractScanExecutor::MayMatchBloomFilter(
+    const std::vector<type::Value> &values) const {
+  if (bloom_filter_ == nullptr) {
+    return true;
+  }
+
+  std::vector<type::Value> key_values;
+  for (auto column_id : bloom_filter_column_ids_) {
+    key_values.push_back(values[column_id]);
+  }
+  expression::ContainerTuple<std::vector<type::Value>> key(&key_values);
+  return bloom_filter_->MayContain(key.HashCode());
+}
+
+LogicalTile *AbstractScanExecutor::BuildVersionTile(
+    const catalog::Schema *table_schema, const std::vector<oid_t> &column_ids,
+    const std::vector<std::vector<type::Value>> &versions) const {
+  std::unique_ptr<catalog::Schema> schema(
+      catalog::Schema::CopySchema(table_schema, column_ids));
+  std::shared_ptr<storage::Tile> tile(
+      storage::TileFactory::GetTempTile(*schema, versions.size()));
+
+  for (oid_t tuple_itr = 0; tuple_itr < versions.size(); tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < column_ids.size(); column_itr++) {
+      tile->SetValue(versions[tuple_itr][column_ids[column_itr]], tuple_itr,
+                     column_itr);
+    }
+  }
+
+  return LogicalTileFactory::WrapTiles({tile});
+}
+
 }  // namespace executor
 }  // namespace peloton
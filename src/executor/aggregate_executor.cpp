@@ -182,6 +182,8 @@ bool AggregateExecutor::DExecute() {
        tile_group_itr++) {
     auto tile_group = output_table->GetTileGroup(tile_group_itr);
     PL_ASSERT(tile_group != nullptr);
+    stats_.memory_bytes += tile_group->GetAllocatedTupleCount() *
+                           output_table->GetSchema()->GetLength();
     LOG_TRACE("\n%s", tile_group->GetInfo().c_str());
 
     // Get the logical tiles corresponding to the given tile group
@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_executor.cpp
+//
+// Identification: src/executor/analyze_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/analyze_executor.h"
+
+#include "catalog/catalog.h"
+#include "common/logger.h"
+#include "concurrency/transaction.h"
+#include "executor/executor_context.h"
+#include "optimizer/stats_collector.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+
+namespace peloton {
+namespace executor {
+
+AnalyzeExecutor::AnalyzeExecutor(const planner::AbstractPlan *node,
+                                 ExecutorContext *executor_context)
+    : AbstractExecutor(node, executor_context) {}
+
+bool AnalyzeExecutor::DInit() {
+  LOG_TRACE("Initializing Analyze Executor...");
+  return true;
+}
+
+bool AnalyzeExecutor::DExecute() {
+  LOG_TRACE("Executing Analyze...");
+  const planner::AnalyzePlan &node = GetPlanNode<planner::AnalyzePlan>();
+  auto current_txn = executor_context_->GetTransaction();
+
+  auto target_table = node.GetTable();
+  if (target_table != nullptr) {
+    optimizer::StatsCollector::AnalyzeTable(target_table, current_txn);
+  } else {
+    try {
+      auto database = catalog::Catalog::GetInstance()->GetDatabaseWithName(
+          node.GetDatabaseName());
+      auto table_count = database->GetTableCount();
+      for (oid_t table_offset = 0; table_offset < table_count;
+           table_offset++) {
+        optimizer::StatsCollector::AnalyzeTable(
+            database->GetTable(table_offset), current_txn);
+      }
+    } catch (CatalogException &e) {
+      LOG_TRACE("Could not find database %s", node.GetDatabaseName().c_str());
+      current_txn->SetResult(ResultType::FAILURE);
+      return false;
+    }
+  }
+
+  current_txn->SetResult(ResultType::SUCCESS);
+  return false;
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -19,6 +19,7 @@
 #include "catalog/manager.h"
 #include "common/container_tuple.h"
 #include "common/logger.h"
+#include "executor/abstract_scan_executor.h"
 #include "executor/logical_tile.h"
 #include "storage/data_table.h"
 #include "storage/tile.h"
@@ -56,6 +57,12 @@ bool DeleteExecutor::DInit() {
   target_table_ = node.GetTable();
   PL_ASSERT(target_table_);
 
+  // The positions of the tuples are needed to delete them
+  auto scan_executor = dynamic_cast<AbstractScanExecutor *>(children_[0]);
+  if (scan_executor != nullptr) {
+    scan_executor->SetCopyVersions(false);
+  }
+
   return true;
 }
 
@@ -80,6 +80,7 @@ bool HashExecutor::DExecute() {
 
     // Construct the hash table by going over each child logical tile and
     // hashing
+    size_t tuple_count = 0;
     for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
          child_tile_itr++) {
       auto tile = child_tiles_[child_tile_itr].get();
@@ -96,9 +97,24 @@ bool HashExecutor::DExecute() {
         }
         hash_table_[key].insert(
                     std::make_pair(child_tile_itr, tuple_id));
+        tuple_count++;
       }
     }
 
+    // Summarize the keys for the scans on the probe side
+    bloom_filter_.reset(new JoinBloomFilter(hash_table_.size()));
+    auto hasher = hash_table_.hash_function();
+    for (auto &entry : hash_table_) {
+      bloom_filter_->Insert(hasher(entry.first));
+    }
+
+    // Buckets and keys of the hash table, one (tile, tuple) offset per tuple
+    // (the node overheads are not counted), and the bloom filter
+    stats_.memory_bytes = hash_table_.bucket_count() * sizeof(void *) +
+                          hash_table_.size() * sizeof(HashMapType::value_type) +
+                          tuple_count * sizeof(std::pair<size_t, oid_t>) +
+                          bloom_filter_->GetSize();
+
     done_ = true;
   }
 
@@ -17,6 +17,7 @@
 #include "common/logger.h"
 #include "executor/logical_tile_factory.h"
 #include "executor/hash_join_executor.h"
+#include "executor/abstract_scan_executor.h"
 #include "expression/abstract_expression.h"
 #include "common/container_tuple.h"
 
@@ -45,6 +46,31 @@ bool HashJoinExecutor::DInit() {
   return true;
 }
 
+void HashJoinExecutor::PushDownBloomFilter() {
+  // Left rows without a match are part of the output of left and full outer
+  // joins
+  if (join_type_ == JoinType::LEFT || join_type_ == JoinType::OUTER) {
+    return;
+  }
+
+  auto bloom_filter = hash_executor_->GetBloomFilter();
+  auto probe_scan = dynamic_cast<AbstractScanExecutor *>(children_[0]);
+  if (bloom_filter == nullptr || probe_scan == nullptr) {
+    return;
+  }
+
+  probe_scan->SetBloomFilter(bloom_filter, GetProbeKeyIds());
+}
+
+const std::vector<oid_t> &HashJoinExecutor::GetProbeKeyIds() {
+  auto &outer_hash_ids =
+      GetPlanNode<planner::HashJoinPlan>().GetOuterHashIds();
+  if (outer_hash_ids.empty() == false) {
+    return outer_hash_ids;
+  }
+  return hash_executor_->GetHashKeyIds();
+}
+
 /**
  * @brief Creates logical tiles from the two input logical tiles after applying
  * join predicate.
@@ -78,6 +104,7 @@ bool HashJoinExecutor::DExecute() {
         BufferRightTile(children_[1]->GetOutput());
       }
       right_child_done_ = true;
+      PushDownBloomFilter();
     }
 
     // Get next tile from LEFT child
@@ -103,7 +130,7 @@ bool HashJoinExecutor::DExecute() {
 
     // Get the hash table from the hash executor
     auto &hash_table = hash_executor_->GetHashTable();
-    auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
+    auto &hashed_col_ids = GetProbeKeyIds();
 
     oid_t prev_tile = INVALID_OID;
     std::unique_ptr<LogicalTile> output_tile;
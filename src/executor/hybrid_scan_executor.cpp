@@ -128,9 +128,11 @@ bool HybridScanExecutor::DInit() {
         tile_group = table_->GetTileGroup(table_tile_group_count_ - 1);
       }
 
-      oid_t tuple_id = 0;
-      ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
-      block_threshold = location.block;
+      if (tile_group != nullptr) {
+        oid_t tuple_id = 0;
+        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+        block_threshold = location.block;
+      }
     }
 
     result_itr_ = START_OID;
@@ -170,6 +172,11 @@ bool HybridScanExecutor::DInit() {
     throw Exception("Invalid hybrid scan type : " + HybridScanTypeToString(type_));
   }
 
+  column_predicates_.clear();
+  if (predicate_ != nullptr) {
+    ExtractColumnPredicates(predicate_);
+  }
+
   return true;
 }
 
@@ -191,6 +198,15 @@ bool HybridScanExecutor::SeqScanUtil() {
   while (current_tile_group_offset_ < table_tile_group_count_) {
     LOG_TRACE("Current tile group offset : %u", current_tile_group_offset_);
     auto tile_group = table_->GetTileGroup(current_tile_group_offset_++);
+    // skip tile groups dropped by compaction
+    if (tile_group == nullptr) {
+      continue;
+    }
+    // skip tile groups whose zone map rules out the predicate
+    if (column_predicates_.empty() == false &&
+        CanSkipTileGroup(tile_group.get()) == true) {
+      continue;
+    }
     auto tile_group_header = tile_group->GetHeader();
 
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
@@ -222,8 +238,8 @@ bool HybridScanExecutor::SeqScanUtil() {
         } else {
           expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
                                                                tuple_id);
-          auto eval =
-              predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
+          auto eval = compiled_predicate_->EvaluatePredicate(&tuple, nullptr,
+                                                             executor_context_);
           if (eval == true) {
             position_list.push_back(tuple_id);
           }
@@ -231,8 +247,8 @@ bool HybridScanExecutor::SeqScanUtil() {
       } else {
         expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
                                                              tuple_id);
-        auto eval =
-            predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
+        auto eval = compiled_predicate_->EvaluatePredicate(&tuple, nullptr,
+                                                           executor_context_);
         if (eval == true) {
           position_list.push_back(tuple_id);
           auto res = transaction_manager.PerformRead(current_txn, location,
@@ -12,6 +12,8 @@
 
 #include "executor/index_scan_executor.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -32,12 +34,16 @@
 #include "storage/masked_tuple.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
+#include "storage/tuple.h"
 #include "type/types.h"
 #include "type/value.h"
 
 namespace peloton {
 namespace executor {
 
+// How many item pointers ahead of the one being read to prefetch
+static const size_t prefetch_distance = 8;
+
 /**
  * @brief Constructor for indexscan executor.
  * @param node Indexscan node corresponding to this executor.
@@ -88,6 +94,7 @@ bool IndexScanExecutor::DInit() {
   limit_number_ = node.GetLimitNumber();
   limit_offset_ = node.GetLimitOffset();
   descend_ = node.GetDescend();
+  keep_key_order_ = node.GetKeepKeyOrder();
 
   if (runtime_keys_.size() != 0) {
     PL_ASSERT(runtime_keys_.size() == values_.size());
@@ -195,6 +202,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
     LOG_TRACE("tuple_location_ptrs:%lu", tuple_location_ptrs.size());
   }
 
+  stats_.index_probe_count++;
+
   if (tuple_location_ptrs.size() == 0) {
     LOG_TRACE("no tuple is retrieved from index.");
     return false;
@@ -206,15 +215,18 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   auto current_txn = executor_context_->GetTransaction();
   auto &manager = catalog::Manager::GetInstance();
   std::vector<ItemPointer> visible_tuple_locations;
-  std::map<oid_t, std::vector<oid_t>> visible_tuples;
 
 #ifdef LOG_TRACE_ENABLED
   int num_tuples_examined = 0;
 #endif
 
   // for every tuple that is found in the index.
-  for (auto tuple_location_ptr : tuple_location_ptrs) {
-    ItemPointer tuple_location = *tuple_location_ptr;
+  for (size_t i = 0; i < tuple_location_ptrs.size(); i++) {
+    // The item pointers are scattered over the heap
+    if (i + prefetch_distance < tuple_location_ptrs.size()) {
+      PL_PREFETCH(tuple_location_ptrs[i + prefetch_distance]);
+    }
+    ItemPointer tuple_location = *tuple_location_ptrs[i];
     auto tile_group = manager.GetTileGroup(tuple_location.block);
     auto tile_group_header = tile_group.get()->GetHeader();
     size_t chain_length = 0;
@@ -243,14 +255,21 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         LOG_TRACE("perform read: %u, %u", tuple_location.block,
                   tuple_location.offset);
 
-        bool eval = true;
-        // if having predicate, then perform evaluation.
-        if (predicate_ != nullptr) {
-          LOG_TRACE("perform prediate evaluate");
-          expression::ContainerTuple<storage::TileGroup> tuple(
-              tile_group.get(), tuple_location.offset);
-          eval =
-              predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
+        bool eval;
+        if (copy_versions_ == true) {
+          eval = EvaluateVersion(tile_group.get(), tuple_location.offset);
+        } else {
+          // drop the tuples that cannot join with the build side of a hash
+          // join
+          eval = MayMatchBloomFilter(tile_group.get(), tuple_location.offset);
+          // if having predicate, then perform evaluation.
+          if (eval == true && predicate_ != nullptr) {
+            LOG_TRACE("perform prediate evaluate");
+            expression::ContainerTuple<storage::TileGroup> tuple(
+                tile_group.get(), tuple_location.offset);
+            eval = compiled_predicate_->EvaluatePredicate(&tuple, nullptr,
+                                                          executor_context_);
+          }
         }
         // if passed evaluation, then perform write.
         if (eval == true) {
@@ -309,6 +328,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
           // if we have traversed through the chain and still can not fulfill
           // one of the above conditions,
           // then return result_failure.
+          current_txn->SetAbortCause(AbortCauseType::VISIBILITY,
+                                     tile_group_header, old_item.offset);
           transaction_manager.SetTransactionResult(current_txn,
                                                    ResultType::FAILURE);
           return false;
@@ -333,29 +354,13 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   // Check whether the boundaries satisfy the required condition
   CheckOpenRangeWithReturnedTuples(visible_tuple_locations);
 
+  stats_.filtered_count +=
+      tuple_location_ptrs.size() - visible_tuple_locations.size();
+
   LOG_TRACE("%ld tuples after pruning boundaries",
             visible_tuple_locations.size());
 
-  for (auto &visible_tuple_location : visible_tuple_locations) {
-    visible_tuples[visible_tuple_location.block]
-        .push_back(visible_tuple_location.offset);
-  }
-
-  // Construct a logical tile for each block
-  for (auto tuples : visible_tuples) {
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuples.first);
-
-    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-    // Add relevant columns to logical tile
-    logical_tile->AddColumns(tile_group, full_column_ids_);
-    logical_tile->AddPositionList(std::move(tuples.second));
-    if (column_ids_.size() != 0) {
-      logical_tile->ProjectColumns(full_column_ids_, column_ids_);
-    }
-
-    result_.push_back(logical_tile.release());
-  }
+  BuildResultTiles(visible_tuple_locations);
 
   done_ = true;
 
@@ -407,6 +412,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
     }
   }
 
+  stats_.index_probe_count++;
+
   if (tuple_location_ptrs.size() == 0) {
     LOG_TRACE("no tuple is retrieved from index.");
     return false;
@@ -418,7 +425,6 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   auto current_txn = executor_context_->GetTransaction();
 
   std::vector<ItemPointer> visible_tuple_locations;
-  std::map<oid_t, std::vector<oid_t>> visible_tuples;
   auto &manager = catalog::Manager::GetInstance();
 
   // Quickie Hack
@@ -435,8 +441,12 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   int num_blocks_reused = 0;
 #endif
 
-  for (auto tuple_location_ptr : tuple_location_ptrs) {
-    ItemPointer tuple_location = *tuple_location_ptr;
+  for (size_t i = 0; i < tuple_location_ptrs.size(); i++) {
+    // The item pointers are scattered over the heap
+    if (i + prefetch_distance < tuple_location_ptrs.size()) {
+      PL_PREFETCH(tuple_location_ptrs[i + prefetch_distance]);
+    }
+    ItemPointer tuple_location = *tuple_location_ptrs[i];
     if (tuple_location.block != last_block) {
       tile_group = manager.GetTileGroup(tuple_location.block);
       tile_group_header = tile_group.get()->GetHeader();
@@ -489,11 +499,18 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
           break;
         }
 
-        bool eval = true;
-        // if having predicate, then perform evaluation.
-        if (predicate_ != nullptr) {
-          eval = predicate_->Evaluate(&candidate_tuple, nullptr,
-                                      executor_context_).IsTrue();
+        bool eval;
+        if (copy_versions_ == true) {
+          eval = EvaluateVersion(tile_group.get(), tuple_location.offset);
+        } else {
+          // drop the tuples that cannot join with the build side of a hash
+          // join
+          eval = MayMatchBloomFilter(tile_group.get(), tuple_location.offset);
+          // if having predicate, then perform evaluation.
+          if (eval == true && predicate_ != nullptr) {
+            eval = compiled_predicate_->EvaluatePredicate(
+                &candidate_tuple, nullptr, executor_context_);
+          }
         }
         // if passed evaluation, then perform write.
         if (eval == true) {
@@ -559,6 +576,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
           // if we have traversed through the chain and still can not fulfill
           // one of the above conditions,
           // then return result_failure.
+          current_txn->SetAbortCause(AbortCauseType::VISIBILITY,
+                                     tile_group_header, old_item.offset);
           transaction_manager.SetTransactionResult(current_txn,
                                                    ResultType::FAILURE);
           return false;
@@ -579,16 +598,283 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   // Check whether the boundaries satisfy the required condition
   CheckOpenRangeWithReturnedTuples(visible_tuple_locations);
 
-  for (auto &visible_tuple_location : visible_tuple_locations) {
-    visible_tuples[visible_tuple_location.block]
-        .push_back(visible_tuple_location.offset);
+  stats_.filtered_count +=
+      tuple_location_ptrs.size() - visible_tuple_locations.size();
+
+  BuildResultTiles(visible_tuple_locations);
+
+  done_ = true;
+
+  LOG_TRACE("Result tiles : %lu", result_.size());
+
+  return true;
+}
+
+bool IndexScanExecutor::CanExecuteKeyBatch(
+    const std::vector<oid_t> &column_ids) const {
+  if (limit_ == true) {
+    return false;
+  }
+
+  std::vector<oid_t> key_column_ids;
+  for (auto column_id : column_ids) {
+    if (column_id >= column_ids_.size()) {
+      return false;
+    }
+    key_column_ids.push_back(column_ids_[column_id]);
+  }
+
+  // Every index column has to get its value from the batch, and the plan must
+  // not restrict any other column through the index
+  auto &indexed_columns = index_->GetKeySchema()->GetIndexedColumns();
+  if (indexed_columns.size() != key_column_ids.size()) {
+    return false;
+  }
+  for (auto indexed_column : indexed_columns) {
+    if (std::find(key_column_ids.begin(), key_column_ids.end(),
+                  indexed_column) == key_column_ids.end()) {
+      return false;
+    }
+  }
+  for (auto key_column_id : key_column_ids_) {
+    if (std::find(key_column_ids.begin(), key_column_ids.end(),
+                  key_column_id) == key_column_ids.end()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool IndexScanExecutor::ExecuteKeyBatch(
+    const std::vector<oid_t> &column_ids,
+    const std::vector<std::vector<type::Value>> &keys,
+    std::vector<std::unique_ptr<LogicalTile>> &result_tiles,
+    std::vector<std::vector<size_t>> &tile_keys) {
+  PL_ASSERT(CanExecuteKeyBatch(column_ids) == true);
+
+  std::vector<oid_t> key_column_ids;
+  for (auto column_id : column_ids) {
+    key_column_ids.push_back(column_ids_[column_id]);
+  }
+
+  // Lay the values of each key out in the order of the index key
+  auto key_schema = index_->GetKeySchema();
+  auto &indexed_columns = key_schema->GetIndexedColumns();
+  std::vector<size_t> key_positions;
+  for (auto indexed_column : indexed_columns) {
+    key_positions.push_back(std::find(key_column_ids.begin(),
+                                      key_column_ids.end(), indexed_column) -
+                            key_column_ids.begin());
+  }
+
+  auto pool = executor_context_->GetPool();
+  std::vector<std::unique_ptr<storage::Tuple>> key_tuples;
+  std::vector<const storage::Tuple *> key_tuple_ptrs;
+  for (auto &key : keys) {
+    std::unique_ptr<storage::Tuple> key_tuple(
+        new storage::Tuple(key_schema, true));
+    for (oid_t column_itr = 0; column_itr < key_positions.size();
+         column_itr++) {
+      key_tuple->SetValue(column_itr, key[key_positions[column_itr]], pool);
+    }
+    key_tuple_ptrs.push_back(key_tuple.get());
+    key_tuples.push_back(std::move(key_tuple));
+  }
+
+  std::vector<ItemPointer *> tuple_location_ptrs;
+  std::vector<size_t> offsets;
+  index_->ScanKeyBatch(key_tuple_ptrs, tuple_location_ptrs, offsets);
+  stats_.index_probe_count++;
+
+  bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto &manager = catalog::Manager::GetInstance();
+
+  // The visible matches of each block, with the key they matched
+  std::map<oid_t, std::pair<std::vector<oid_t>, std::vector<size_t>>>
+      visible_tuples;
+  size_t visible_count = 0;
+
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    for (size_t i = offsets[key_itr]; i < offsets[key_itr + 1]; i++) {
+      // The item pointers are scattered over the heap
+      if (i + prefetch_distance < tuple_location_ptrs.size()) {
+        PL_PREFETCH(tuple_location_ptrs[i + prefetch_distance]);
+      }
+      ItemPointer tuple_location = *tuple_location_ptrs[i];
+      auto tile_group = manager.GetTileGroup(tuple_location.block);
+      if (GetVisibleVersion(tuple_location, tile_group) == false) {
+        return false;
+      }
+      if (tuple_location.IsNull()) {
+        continue;
+      }
+
+      // The visible version may have another key, and the index may only
+      // keep a prefix of the key
+      expression::ContainerTuple<storage::TileGroup> tuple(
+          tile_group.get(), tuple_location.offset);
+      bool eval = true;
+      for (size_t column_itr = 0; eval && column_itr < key_column_ids.size();
+           column_itr++) {
+        eval = tuple.GetValue(key_column_ids[column_itr])
+                   .CompareEquals(keys[key_itr][column_itr]) ==
+               type::CMP_TRUE;
+      }
+
+      if (copy_versions_ == true) {
+        eval = eval && EvaluateVersion(tile_group.get(), tuple_location.offset);
+      } else {
+        // drop the tuples that cannot join with the build side of a hash
+        // join
+        eval = eval &&
+               MayMatchBloomFilter(tile_group.get(), tuple_location.offset);
+        if (eval == true && predicate_ != nullptr) {
+          eval = compiled_predicate_->EvaluatePredicate(&tuple, nullptr,
+                                                        executor_context_);
+        }
+      }
+      if (eval == false) {
+        continue;
+      }
+
+      if (transaction_manager.PerformRead(current_txn, tuple_location,
+                                          acquire_owner) == false) {
+        transaction_manager.SetTransactionResult(current_txn,
+                                                 ResultType::FAILURE);
+        return false;
+      }
+      auto &block_tuples = visible_tuples[tuple_location.block];
+      block_tuples.first.push_back(tuple_location.offset);
+      block_tuples.second.push_back(key_itr);
+      visible_count++;
+    }
   }
 
+  stats_.filtered_count += tuple_location_ptrs.size() - visible_count;
+
   // Construct a logical tile for each block
-  for (auto tuples : visible_tuples) {
-    auto &manager = catalog::Manager::GetInstance();
+  for (auto &block_tuples : visible_tuples) {
+    auto tile_group = manager.GetTileGroup(block_tuples.first);
+
+    std::unique_ptr<LogicalTile> logical_tile;
+    if (copy_versions_ == true) {
+      logical_tile.reset(
+          CopyVersions(tile_group.get(), block_tuples.second.first));
+    } else {
+      logical_tile.reset(LogicalTileFactory::GetTile());
+      logical_tile->AddColumns(tile_group, full_column_ids_);
+      logical_tile->AddPositionList(std::move(block_tuples.second.first));
+      if (column_ids_.size() != 0) {
+        logical_tile->ProjectColumns(full_column_ids_, column_ids_);
+      }
+    }
+
+    stats_.tile_count++;
+    stats_.tuple_count += logical_tile->GetTupleCount();
+    result_tiles.push_back(std::move(logical_tile));
+    tile_keys.push_back(std::move(block_tuples.second.second));
+  }
+
+  return true;
+}
+
+bool IndexScanExecutor::GetVisibleVersion(
+    ItemPointer &tuple_location,
+    std::shared_ptr<storage::TileGroup> &tile_group) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = tile_group->GetHeader();
+  size_t chain_length = 0;
+
+  while (true) {
+    ++chain_length;
+
+    auto visibility = transaction_manager.IsVisible(
+        current_txn, tile_group_header, tuple_location.offset);
+
+    if (visibility == VisibilityType::OK) {
+      return true;
+    }
+    if (visibility == VisibilityType::DELETED) {
+      tuple_location = INVALID_ITEMPOINTER;
+      return true;
+    }
+    PL_ASSERT(visibility == VisibilityType::INVISIBLE);
+
+    // Another transaction has replaced the versions that we can see, so
+    // start over from the head of the chain
+    bool is_acquired = (tile_group_header->GetTransactionId(
+                            tuple_location.offset) == INITIAL_TXN_ID);
+    bool is_alive = (tile_group_header->GetEndCommitId(tuple_location.offset) <=
+                     current_txn->GetBeginCommitId());
+    if (is_acquired && is_alive) {
+      tuple_location =
+          *(tile_group_header->GetIndirection(tuple_location.offset));
+      tile_group = manager.GetTileGroup(tuple_location.block);
+      tile_group_header = tile_group->GetHeader();
+      chain_length = 0;
+      continue;
+    }
+
+    ItemPointer old_item = tuple_location;
+    tuple_location = tile_group_header->GetNextItemPointer(old_item.offset);
+
+    if (tuple_location.IsNull()) {
+      // An aborted version that is alone in its chain
+      if (chain_length == 1) {
+        return true;
+      }
+
+      current_txn->SetAbortCause(AbortCauseType::VISIBILITY,
+                                 tile_group_header, old_item.offset);
+      transaction_manager.SetTransactionResult(current_txn,
+                                               ResultType::FAILURE);
+      return false;
+    }
+
+    tile_group = manager.GetTileGroup(tuple_location.block);
+    tile_group_header = tile_group->GetHeader();
+  }
+}
+
+void IndexScanExecutor::BuildResultTiles(
+    const std::vector<ItemPointer> &tuple_locations) {
+  std::vector<std::pair<oid_t, std::vector<oid_t>>> tile_positions;
+  if (keep_key_order_) {
+    // Start a new tile whenever the block changes, so that reading the tiles
+    // one after the other gives the tuples in key order
+    for (auto &tuple_location : tuple_locations) {
+      if (tile_positions.empty() ||
+          tile_positions.back().first != tuple_location.block) {
+        tile_positions.emplace_back(tuple_location.block,
+                                    std::vector<oid_t>());
+      }
+      tile_positions.back().second.push_back(tuple_location.offset);
+    }
+  } else {
+    std::map<oid_t, std::vector<oid_t>> visible_tuples;
+    for (auto &tuple_location : tuple_locations) {
+      visible_tuples[tuple_location.block].push_back(tuple_location.offset);
+    }
+    tile_positions.assign(visible_tuples.begin(), visible_tuples.end());
+  }
+
+  // Construct a logical tile for each run of positions
+  auto &manager = catalog::Manager::GetInstance();
+  for (auto &tuples : tile_positions) {
     auto tile_group = manager.GetTileGroup(tuples.first);
 
+    if (copy_versions_ == true) {
+      result_.push_back(CopyVersions(tile_group.get(), tuples.second));
+      continue;
+    }
+
     std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
     // Add relevant columns to logical tile
     logical_tile->AddColumns(tile_group, full_column_ids_);
@@ -599,12 +885,43 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
     result_.push_back(logical_tile.release());
   }
+}
 
-  done_ = true;
+bool IndexScanExecutor::EvaluateVersion(storage::TileGroup *tile_group,
+                                        const oid_t &tuple_id) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
 
-  LOG_TRACE("Result tiles : %lu", result_.size());
+  std::vector<type::Value> values;
+  if (transaction_manager.ReadVersion(current_txn, tile_group, tuple_id,
+                                      values) != VisibilityType::OK ||
+      MayMatchBloomFilter(values) == false) {
+    return false;
+  }
+  if (predicate_ == nullptr) {
+    return true;
+  }
+  expression::ContainerTuple<std::vector<type::Value>> tuple(&values);
+  return compiled_predicate_->EvaluatePredicate(&tuple, nullptr,
+                                                executor_context_);
+}
 
-  return true;
+LogicalTile *IndexScanExecutor::CopyVersions(
+    storage::TileGroup *tile_group, const std::vector<oid_t> &tuple_ids) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+
+  std::vector<std::vector<type::Value>> versions(tuple_ids.size());
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_ids.size(); tuple_itr++) {
+    transaction_manager.ReadVersion(current_txn, tile_group,
+                                    tuple_ids[tuple_itr], versions[tuple_itr]);
+  }
+
+  return BuildVersionTile(tile_group->GetAbstractTable()->GetSchema(),
+                          column_ids_.empty() ? full_column_ids_ : column_ids_,
+                          versions);
 }
 
 void IndexScanExecutor::CheckOpenRangeWithReturnedTuples(
@@ -113,6 +113,8 @@ bool InsertExecutor::DExecute() {
       // tuple.
       // in this case, abort the transaction.
       if (location.block == INVALID_OID) {
+        current_txn->SetAbortCause(AbortCauseType::CONSTRAINT,
+                                   target_table->GetOid(), INVALID_ITEMPOINTER);
         transaction_manager.SetTransactionResult(
             current_txn, peloton::ResultType::FAILURE);
         return false;
@@ -174,6 +176,8 @@ bool InsertExecutor::DExecute() {
 
       if (location.block == INVALID_OID) {
         LOG_TRACE("Failed to Insert. Set txn failure.");
+        current_txn->SetAbortCause(AbortCauseType::CONSTRAINT,
+                                   target_table->GetOid(), INVALID_ITEMPOINTER);
         transaction_manager.SetTransactionResult(current_txn,
                                                  ResultType::FAILURE);
         return false;
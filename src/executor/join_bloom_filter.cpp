@@ -0,0 +1,33 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_bloom_filter.cpp
+//
+// Identification: src/executor/join_bloom_filter.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/join_bloom_filter.h"
+
+namespace peloton {
+namespace executor {
+
+// Bits spent on each key, which gives a false positive rate of a few percent
+static const size_t bits_per_key = 16;
+
+JoinBloomFilter::JoinBloomFilter(const size_t &key_count) {
+  // Round the number of words up to a power of two, so that a mask picks one
+  size_t word_count = 1;
+  while (word_count * 64 < key_count * bits_per_key) {
+    word_count <<= 1;
+  }
+
+  words_.assign(word_count, 0);
+  word_mask_ = word_count - 1;
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <algorithm>
 #include <vector>
 
 #include "type/types.h"
@@ -24,8 +25,8 @@ namespace peloton {
 namespace executor {
 
 /**
- * @brief Constructor for nested loop join executor.
- * @param node Nested loop join node corresponding to this executor.
+ * @brief Constructor for merge join executor.
+ * @param node Merge join node corresponding to this executor.
  */
 MergeJoinExecutor::MergeJoinExecutor(const planner::AbstractPlan *node,
                                      ExecutorContext *executor_context)
@@ -46,243 +47,308 @@ bool MergeJoinExecutor::DInit() {
   return true;
 }
 
+static bool HasNullKey(const std::vector<type::Value> &key) {
+  for (auto &value : key) {
+    if (value.IsNull()) return true;
+  }
+  return false;
+}
+
+static bool KeysEqual(const std::vector<type::Value> &left_key,
+                      const std::vector<type::Value> &right_key) {
+  for (size_t i = 0; i < left_key.size(); i++) {
+    if (left_key[i].CompareEquals(right_key[i]) != type::CMP_TRUE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Keys must not be null
+static int CompareKeys(const std::vector<type::Value> &left_key,
+                       const std::vector<type::Value> &right_key) {
+  for (size_t i = 0; i < left_key.size(); i++) {
+    if (left_key[i].CompareLessThan(right_key[i]) == type::CMP_TRUE) {
+      return -1;
+    }
+    if (left_key[i].CompareGreaterThan(right_key[i]) == type::CMP_TRUE) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
 /**
  * @brief Creates logical tiles from the two input logical tiles after applying
  * join predicate.
  * @return true on success, false otherwise.
  */
 bool MergeJoinExecutor::DExecute() {
-  LOG_TRACE(
-      "********** Merge Join executor :: 2 children "
-      "left:: start: %lu, end: %lu, done: %d "
-      "right:: start: %lu, end: %lu, done: %d",
-      left_start_row, left_end_row, left_child_done_, right_start_row,
-      right_end_row, right_child_done_);
-
-  // Build outer join output when done
-  if (right_child_done_ && left_child_done_) {
-    return BuildOuterJoinOutput();
+  LOG_TRACE("********** Merge Join executor :: 2 children");
+
+  while (buffered_output_tiles_.empty()) {
+    // Build outer join output when done
+    if (merge_done_) {
+      return BuildOuterJoinOutput();
+    }
+    MergeNextKey();
   }
 
-  //===--------------------------------------------------------------------===//
-  // Pick right and left tiles
-  //===--------------------------------------------------------------------===//
-
-  // Try to get next tile from RIGHT child
-  if (((right_child_done_ == false) && (right_start_row == right_end_row)) ||
-      (left_child_done_ == true)) {
-    if (children_[1]->Execute() == false) {
-      LOG_TRACE("Did not get right tile ");
-      right_child_done_ = true;
-      // Try again
-      return DExecute();
+  SetOutput(buffered_output_tiles_.front().release());
+  buffered_output_tiles_.pop_front();
+  return true;
+}
+
+/**
+ * @brief Moves past the smaller of the current keys of the children, or joins
+ * the runs of rows of both children when the keys are equal
+ */
+void MergeJoinExecutor::MergeNextKey() {
+  // Pull the right child first, so that an empty right side is found before
+  // the left child is run
+  bool has_right = HasRow(false);
+  bool has_left = HasRow(true);
+
+  if (has_left == false || has_right == false) {
+    if (has_left == false) {
+      // The remaining right rows are only output by right and full outer
+      // joins
+      if (join_type_ == JoinType::RIGHT || join_type_ == JoinType::OUTER) {
+        while (FetchTile(false)) {
+        }
+      }
+    } else if (right_result_tiles_.empty() == false ||
+               join_type_ == JoinType::LEFT || join_type_ == JoinType::OUTER) {
+      // Run the left child to the end, nothing can match an empty right side
+      // of an inner or right join though
+      while (FetchTile(true)) {
+      }
     }
 
-    LOG_TRACE("Got right tile ");
+    FlushPendingOutput();
+    merge_done_ = true;
+    return;
+  }
+
+  ReleaseConsumedTiles();
 
-    auto right_tile = children_[1]->GetOutput();
-    BufferRightTile(right_tile);
+  std::vector<type::Value> left_key;
+  std::vector<type::Value> right_key;
+  GetJoinKey(true, left_row_, left_key);
+  GetJoinKey(false, right_row_, right_key);
 
-    right_start_row = 0;
-    right_end_row = Advance(right_tile, right_start_row, false);
-    LOG_TRACE("size of right tiles: %lu", right_result_tiles_.size());
+  // Null keys never match
+  if (HasNullKey(left_key)) {
+    left_row_++;
+    return;
+  }
+  if (HasNullKey(right_key)) {
+    right_row_++;
+    return;
   }
 
-  // Try to get next tile from LEFT child
-  if (((left_child_done_ == false) && (left_start_row == left_end_row)) ||
-      (right_child_done_ == true)) {
-    if (children_[0]->Execute() == false) {
-      LOG_TRACE("Did not get left tile ");
-      left_child_done_ = true;
-      // if we know the join type is left join, we don't have to get the
-      // tiles from right child anymore.
-      if (join_type_ == JoinType::LEFT || join_type_ == JoinType::INNER) {
-        return BuildOuterJoinOutput();
-      } else {
-        // otherwise, try again
-        return DExecute();
-      }
+  auto comparison = CompareKeys(left_key, right_key);
+  if (comparison < 0) {
+    LOG_TRACE("left < right, advance left ");
+    left_row_++;
+    return;
+  }
+  if (comparison > 0) {
+    LOG_TRACE("left > right, advance right ");
+    right_row_++;
+    return;
+  }
 
-      // Try again
-      return DExecute();
-    }
+  // Keys are equal, join every row of the two runs
+  std::vector<RowRange> left_run;
+  std::vector<RowRange> right_run;
+  CollectRun(true, left_key, left_run);
+  CollectRun(false, right_key, right_run);
+  JoinRuns(left_run, right_run);
+}
+
+/**
+ * @brief Buffers the next tile of a child
+ * @return false if the child has no more tiles
+ */
+bool MergeJoinExecutor::FetchTile(bool is_left) {
+  bool &child_done = is_left ? left_child_done_ : right_child_done_;
+  if (child_done) {
+    return false;
+  }
 
-    LOG_TRACE("Got left tile ");
+  auto child = children_[is_left ? 0 : 1];
+  if (child->Execute() == false) {
+    LOG_TRACE("Did not get %s tile ", is_left ? "left" : "right");
+    child_done = true;
+    return false;
+  }
+
+  auto tile = child->GetOutput();
+  if (is_left) {
+    BufferLeftTile(tile);
+    left_row_ = 0;
+  } else {
+    BufferRightTile(tile);
+    right_row_ = 0;
+  }
+  return true;
+}
 
-    auto left_tile = children_[0]->GetOutput();
-    BufferLeftTile(left_tile);
+/**
+ * @brief Makes sure the next row of a child is in its last buffered tile
+ * @return false if the child has no more rows
+ */
+bool MergeJoinExecutor::HasRow(bool is_left) {
+  auto &tiles = is_left ? left_result_tiles_ : right_result_tiles_;
+  size_t &row = is_left ? left_row_ : right_row_;
 
-    left_start_row = 0;
-    left_end_row = Advance(left_tile, left_start_row, true);
-    LOG_TRACE("size of left tiles: %lu", left_result_tiles_.size());
+  while (tiles.empty() || row >= tiles.back()->GetTupleCount()) {
+    if (FetchTile(is_left) == false) {
+      return false;
+    }
   }
+  return true;
+}
 
-  // Check if we have logical tiles to process
-  if (left_result_tiles_.empty() || right_result_tiles_.empty()) {
-    return BuildOuterJoinOutput();
+/**
+ * @brief Evaluates the join clauses of a child on a row of its last tile
+ */
+void MergeJoinExecutor::GetJoinKey(bool is_left, size_t row,
+                                   std::vector<type::Value> &key) {
+  auto tile = is_left ? left_result_tiles_.back().get()
+                      : right_result_tiles_.back().get();
+  expression::ContainerTuple<executor::LogicalTile> tuple(tile, row);
+
+  key.clear();
+  for (auto &clause : *join_clauses_) {
+    auto expr = is_left ? clause.left_.get() : clause.right_.get();
+    key.push_back(expr->Evaluate(&tuple, &tuple, executor_context_));
   }
+}
 
-  LogicalTile *left_tile = left_result_tiles_.back().get();
-  LogicalTile *right_tile = right_result_tiles_.back().get();
-
-  //===--------------------------------------------------------------------===//
-  // Build Join Tile
-  //===--------------------------------------------------------------------===//
-
-  // Build output logical tile
-  auto output_tile = BuildOutputLogicalTile(left_tile, right_tile);
-
-  // Build position lists
-  LogicalTile::PositionListsBuilder pos_lists_builder(left_tile, right_tile);
-
-  while ((left_end_row > left_start_row) && (right_end_row > right_start_row)) {
-    expression::ContainerTuple<executor::LogicalTile> left_tuple(
-        left_tile, left_start_row);
-    expression::ContainerTuple<executor::LogicalTile> right_tuple(
-        right_tile, right_start_row);
-    bool not_matching_tuple_pair = false;
-
-    // Evaluate and compare the join clauses
-    for (auto &clause : *join_clauses_) {
-      auto left_value =
-          clause.left_->Evaluate(&left_tuple, &right_tuple, nullptr);
-      auto right_value =
-          clause.right_->Evaluate(&left_tuple, &right_tuple, nullptr);
-
-      // Left key < Right key, advance left
-      if (left_value.CompareLessThan(right_value) == type::CMP_TRUE) {
-        LOG_TRACE("left < right, advance left ");
-        left_start_row = left_end_row;
-        left_end_row = Advance(left_tile, left_start_row, true);
-        not_matching_tuple_pair = true;
-        break;
-      }
-      // Left key > Right key, advance right
-      else if (left_value.CompareGreaterThan(right_value) == type::CMP_TRUE) {
-        LOG_TRACE("left > right, advance right ");
-        right_start_row = right_end_row;
-        right_end_row = Advance(right_tile, right_start_row, false);
-        not_matching_tuple_pair = true;
+/**
+ * @brief Moves a child past the rows that have the given key, pulling more
+ * tiles while the run goes on
+ */
+void MergeJoinExecutor::CollectRun(bool is_left,
+                                   const std::vector<type::Value> &key,
+                                   std::vector<RowRange> &run) {
+  auto &tiles = is_left ? left_result_tiles_ : right_result_tiles_;
+  size_t &row = is_left ? left_row_ : right_row_;
+  std::vector<type::Value> row_key;
+
+  while (HasRow(is_left)) {
+    size_t tile_offset = tiles.size() - 1;
+    size_t tuple_count = tiles.back()->GetTupleCount();
+    size_t begin_row = row;
+    while (row < tuple_count) {
+      GetJoinKey(is_left, row, row_key);
+      if (HasNullKey(row_key) || KeysEqual(row_key, key) == false) {
         break;
       }
-
-      // Left key == Right key, go and check next join clause
+      row++;
     }
 
-    // At least one of the join clauses don't match
-    // One of the tile has been advanced
-    if (not_matching_tuple_pair) {
-      continue;
+    if (row > begin_row) {
+      run.push_back({tile_offset, begin_row, row});
     }
 
-    // Join clauses matched, try to match predicate
-    LOG_TRACE("one pair of tuples matches join clause ");
-
-    // Join predicate exists
-    if (predicate_ != nullptr) {
-      auto eval = predicate_->Evaluate(&left_tuple,
-                                      &right_tuple, executor_context_);
-      if (eval.IsFalse()) {
-      //if (predicate_->Evaluate(&left_tuple, &right_tuple, executor_context_)
-      //        .IsFalse()) {
-        // Join predicate is false. Advance both.
-        left_start_row = left_end_row;
-        left_end_row = Advance(left_tile, left_start_row, true);
-
-        right_start_row = right_end_row;
-        right_end_row = Advance(right_tile, right_start_row, false);
-      }
+    // The run ends inside this tile
+    if (row < tuple_count) {
+      break;
     }
+  }
 
-    // Sub tile matched, do a Cartesian product
-    // Go over every pair of tuples in left and right logical tiles
-    for (size_t left_tile_row_itr = left_start_row;
-         left_tile_row_itr < left_end_row; left_tile_row_itr++) {
-      for (size_t right_tile_row_itr = right_start_row;
-           right_tile_row_itr < right_end_row; right_tile_row_itr++) {
-        // Insert a tuple into the output logical tile
-        pos_lists_builder.AddRow(left_tile_row_itr, right_tile_row_itr);
-
-        RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_row_itr);
-        RecordMatchedRightRow(right_result_tiles_.size() - 1,
-                              right_tile_row_itr);
-      }
-    }
+  LOG_TRACE("Collected a %s run over %lu tiles", is_left ? "left" : "right",
+            run.size());
+}
 
-    // Then, advance both if necessary
-    right_start_row = right_end_row;
-    right_end_row = Advance(right_tile, right_start_row, false);
+/**
+ * @brief Adds every pair of rows of the two runs that satisfies the join
+ * predicate to the output. Pairs from the same two tiles share an output tile.
+ */
+void MergeJoinExecutor::JoinRuns(const std::vector<RowRange> &left_run,
+                                 const std::vector<RowRange> &right_run) {
+  for (auto &left_range : left_run) {
+    auto left_tile = left_result_tiles_[left_range.tile_offset].get();
+    for (auto &right_range : right_run) {
+      auto right_tile = right_result_tiles_[right_range.tile_offset].get();
+
+      if (pending_output_tile_ != nullptr &&
+          (pending_left_tile_ != left_range.tile_offset ||
+           pending_right_tile_ != right_range.tile_offset)) {
+        FlushPendingOutput();
+      }
+      if (pending_output_tile_ == nullptr) {
+        pending_output_tile_ = BuildOutputLogicalTile(left_tile, right_tile);
+        pending_pos_lists_builder_ =
+            LogicalTile::PositionListsBuilder(left_tile, right_tile);
+        pending_left_tile_ = left_range.tile_offset;
+        pending_right_tile_ = right_range.tile_offset;
+      }
 
-    if (right_start_row != right_end_row) {
-      left_start_row = left_end_row;
-      left_end_row = Advance(left_tile, left_start_row, true);
+      for (size_t left_row = left_range.begin_row;
+           left_row < left_range.end_row; left_row++) {
+        for (size_t right_row = right_range.begin_row;
+             right_row < right_range.end_row; right_row++) {
+          // Join predicate exists
+          if (predicate_ != nullptr) {
+            expression::ContainerTuple<executor::LogicalTile> left_tuple(
+                left_tile, left_row);
+            expression::ContainerTuple<executor::LogicalTile> right_tuple(
+                right_tile, right_row);
+            if (compiled_predicate_->EvaluatePredicate(
+                    &left_tuple, &right_tuple, executor_context_) == false) {
+              continue;
+            }
+          }
+
+          pending_pos_lists_builder_.AddRow(left_row, right_row);
+          RecordMatchedLeftRow(left_range.tile_offset, left_row);
+          RecordMatchedRightRow(right_range.tile_offset, right_row);
+        }
+      }
     }
   }
+}
 
-  // Check if we have any join tuples.
-  if (pos_lists_builder.Size() > 0) {
-    output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
-    SetOutput(output_tile.release());
-    return true;
-  }
-  // Try again
-  else {
-    // If we are out of any more pairs of child tiles to examine,
-    // then we will return false earlier in this function
-    // So, no need to return false here
-    DExecute();
+void MergeJoinExecutor::FlushPendingOutput() {
+  if (pending_output_tile_ == nullptr) {
+    return;
   }
 
-  return true;
+  if (pending_pos_lists_builder_.Size() > 0) {
+    pending_output_tile_->SetPositionListsAndVisibility(
+        pending_pos_lists_builder_.Release());
+    buffered_output_tiles_.push_back(std::move(pending_output_tile_));
+  }
+  pending_output_tile_.reset();
 }
 
 /**
- * @brief Advance the row iterator until value changes in terms of the join
- * clauses
- * @return the end row number, [start_row, end_row) are the rows of the same
- * value
- *         if the end_row == start_row, the subset is empty
+ * @brief Drops the child tiles the merge has moved past. The output tiles
+ * refer to the base tiles directly, so they stay valid.
  */
-size_t MergeJoinExecutor::Advance(LogicalTile *tile, size_t start_row,
-                                  bool is_left) {
-  size_t end_row = start_row + 1;
-  size_t this_row = start_row;
-  size_t tuple_count = tile->GetTupleCount();
-  if (start_row >= tuple_count) return start_row;
-
-  while (end_row < tuple_count) {
-    expression::ContainerTuple<executor::LogicalTile> this_tuple(tile,
-                                                                 this_row);
-    expression::ContainerTuple<executor::LogicalTile> next_tuple(tile, end_row);
-
-    bool diff = false;
-
-    for (auto &clause : *join_clauses_) {
-      // Go through each join clauses
-      auto expr = is_left ? clause.left_.get() : clause.right_.get();
-      auto this_value =
-          expr->Evaluate(&this_tuple, &this_tuple, executor_context_);
-      auto next_value =
-          expr->Evaluate(&next_tuple, &next_tuple, executor_context_);
-
-      if (!(this_value.CompareEquals(next_value) == type::CMP_TRUE)) {
-        diff = true;
-        break;
-      }
-    }
-
-    if (diff) {
-      break;
-    }
+void MergeJoinExecutor::ReleaseConsumedTiles() {
+  // Outer joins output their unmatched rows at the end
+  if (join_type_ != JoinType::INNER) {
+    return;
+  }
 
-    // the two tuples are the same, we advance by 1
-    this_row = end_row;
-    end_row++;
+  size_t left_keep = left_result_tiles_.size() - 1;
+  size_t right_keep = right_result_tiles_.size() - 1;
+  if (pending_output_tile_ != nullptr) {
+    left_keep = std::min(left_keep, pending_left_tile_);
+    right_keep = std::min(right_keep, pending_right_tile_);
   }
 
-  LOG_TRACE("Advanced %s with subset size %lu ", is_left ? "left" : "right",
-            end_row - start_row);
-  return end_row;
+  for (; released_left_tiles_ < left_keep; released_left_tiles_++) {
+    left_result_tiles_[released_left_tiles_].reset();
+  }
+  for (; released_right_tiles_ < right_keep; released_right_tiles_++) {
+    right_result_tiles_[released_right_tiles_].reset();
+  }
 }
 
 }  // namespace executor
@@ -10,7 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 #include <vector>
 #include <unordered_set>
 
@@ -53,6 +55,16 @@ bool NestedLoopJoinExecutor::DInit() {
 
   PL_ASSERT(left_result_tiles_.empty());
 
+  const planner::NestedLoopJoinPlan &node =
+      GetPlanNode<planner::NestedLoopJoinPlan>();
+  auto index_scan_executor = dynamic_cast<IndexScanExecutor *>(children_[1]);
+  batched_lookup_ = node.GetJoinColumnsLeft().empty() == false &&
+                    index_scan_executor != nullptr;
+  key_batch_lookup_ =
+      batched_lookup_ == true &&
+      index_scan_executor->CanExecuteKeyBatch(node.GetJoinColumnsRight());
+  buffered_output_tiles_.clear();
+
   return true;
 }
 
@@ -93,6 +105,10 @@ bool NestedLoopJoinExecutor::DExecute() {
   const std::vector<oid_t> &join_column_ids_left = node.GetJoinColumnsLeft();
   const std::vector<oid_t> &join_column_ids_right = node.GetJoinColumnsRight();
 
+  if (batched_lookup_) {
+    return ExecuteBatchedLookup(join_column_ids_left, join_column_ids_right);
+  }
+
   // We should first deal with the current result. Otherwise we will cache a lot
   // data which is not good to utilize memory. After that we call child execute.
   // Since is the high level idea, each time we get tile from left, we should
@@ -142,6 +158,16 @@ bool NestedLoopJoinExecutor::DExecute() {
 
         // Go over every pair of tuples in left and right logical tiles
         for (auto right_tile_row_itr : *right_tile) {
+          // Join predicate exists
+          if (predicate_ != nullptr) {
+            expression::ContainerTuple<executor::LogicalTile> right_tuple(
+                right_tile.get(), right_tile_row_itr);
+            if (compiled_predicate_->Evaluate(&left_tuple, &right_tuple,
+                                              executor_context_).IsFalse()) {
+              continue;
+            }
+          }
+
           // Insert a tuple into the output logical tile
           // First, copy the elements in left logical tile's tuple
           LOG_TRACE("Insert a tuple into the output logical tile");
@@ -210,5 +236,179 @@ bool NestedLoopJoinExecutor::DExecute() {
 
   }  // end the very beginning for loop
 }
+bool NestedLoopJoinExecutor::ExecuteBatchedLookup(
+    const std::vector<oid_t> &join_column_ids_left,
+    const std::vector<oid_t> &join_column_ids_right) {
+  for (;;) {
+    if (buffered_output_tiles_.empty() == false) {
+      SetOutput(buffered_output_tiles_.front().release());
+      buffered_output_tiles_.pop_front();
+      return true;
+    }
+
+    if (left_child_done_ == true || children_[0]->Execute() == false) {
+      LOG_TRACE("Left child is exhausted.");
+      left_child_done_ = true;
+      return false;
+    }
+
+    left_tile_.reset(children_[0]->GetOutput());
+    JoinLeftTile(join_column_ids_left, join_column_ids_right);
+  }
+}
+
+// Lexicographic order of join keys
+static bool KeyLessThan(const std::vector<type::Value> &left,
+                        const std::vector<type::Value> &right) {
+  for (size_t i = 0; i < left.size(); i++) {
+    if (left[i].CompareLessThan(right[i]) == type::CMP_TRUE) return true;
+    if (left[i].CompareGreaterThan(right[i]) == type::CMP_TRUE) return false;
+  }
+  return false;
+}
+
+static bool KeyEquals(const std::vector<type::Value> &left,
+                      const std::vector<type::Value> &right) {
+  for (size_t i = 0; i < left.size(); i++) {
+    if (left[i].CompareEquals(right[i]) != type::CMP_TRUE) return false;
+  }
+  return true;
+}
+
+void NestedLoopJoinExecutor::JoinLeftTile(
+    const std::vector<oid_t> &join_column_ids_left,
+    const std::vector<oid_t> &join_column_ids_right) {
+  // Gather the keys of the left tile. A null key matches nothing.
+  std::vector<oid_t> left_rows;
+  std::vector<std::vector<type::Value>> keys;
+  for (auto left_tile_row_itr : *left_tile_) {
+    expression::ContainerTuple<executor::LogicalTile> left_tuple(
+        left_tile_.get(), left_tile_row_itr);
+    std::vector<type::Value> key;
+    bool has_null = false;
+    for (auto column_id : join_column_ids_left) {
+      key.push_back(left_tuple.GetValue(column_id));
+      has_null = has_null || key.back().IsNull();
+    }
+    if (has_null) continue;
+    left_rows.push_back(left_tile_row_itr);
+    keys.push_back(std::move(key));
+  }
+
+  // Look the keys up in index order, so that consecutive lookups share the
+  // upper levels of the index in the cache and duplicates are looked up once
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&keys](size_t left, size_t right) {
+    return KeyLessThan(keys[left], keys[right]);
+  });
+
+  // The runs of equal keys
+  std::vector<size_t> run_begins;
+  for (size_t i = 0; i < order.size(); i++) {
+    if (i == 0 || KeyEquals(keys[order[i - 1]], keys[order[i]]) == false) {
+      run_begins.push_back(i);
+    }
+  }
+  run_begins.push_back(order.size());
+
+  if (key_batch_lookup_ == true) {
+    JoinKeyBatch(join_column_ids_right, left_rows, keys, order, run_begins);
+    return;
+  }
+
+  for (size_t run = 0; run + 1 < run_begins.size(); run++) {
+    size_t begin = run_begins[run];
+    size_t end = run_begins[run + 1];
+
+    children_[1]->UpdatePredicate(join_column_ids_right, keys[order[begin]]);
+    while (children_[1]->Execute() == true) {
+      std::unique_ptr<LogicalTile> right_tile(children_[1]->GetOutput());
+      auto output_tile =
+          BuildOutputLogicalTile(left_tile_.get(), right_tile.get());
+      LogicalTile::PositionListsBuilder pos_lists_builder(left_tile_.get(),
+                                                          right_tile.get());
+
+      // Every left row with this key joins every right row that was found
+      for (size_t i = begin; i < end; i++) {
+        auto left_tile_row_itr = left_rows[order[i]];
+        expression::ContainerTuple<executor::LogicalTile> left_tuple(
+            left_tile_.get(), left_tile_row_itr);
+        for (auto right_tile_row_itr : *right_tile) {
+          if (predicate_ != nullptr) {
+            expression::ContainerTuple<executor::LogicalTile> right_tuple(
+                right_tile.get(), right_tile_row_itr);
+            if (compiled_predicate_->Evaluate(&left_tuple, &right_tuple,
+                                              executor_context_).IsFalse()) {
+              continue;
+            }
+          }
+          pos_lists_builder.AddRow(left_tile_row_itr, right_tile_row_itr);
+        }
+      }
+
+      if (pos_lists_builder.Size() > 0) {
+        output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+        buffered_output_tiles_.push_back(std::move(output_tile));
+      }
+    }
+    children_[1]->ResetState();
+  }
+}
+
+void NestedLoopJoinExecutor::JoinKeyBatch(
+    const std::vector<oid_t> &join_column_ids_right,
+    const std::vector<oid_t> &left_rows,
+    const std::vector<std::vector<type::Value>> &keys,
+    const std::vector<size_t> &order, const std::vector<size_t> &run_begins) {
+  // Look every distinct key up at once
+  std::vector<std::vector<type::Value>> distinct_keys;
+  for (size_t run = 0; run + 1 < run_begins.size(); run++) {
+    distinct_keys.push_back(keys[order[run_begins[run]]]);
+  }
+
+  std::vector<std::unique_ptr<LogicalTile>> right_tiles;
+  std::vector<std::vector<size_t>> right_tile_keys;
+  auto index_scan_executor = static_cast<IndexScanExecutor *>(children_[1]);
+  if (index_scan_executor->ExecuteKeyBatch(join_column_ids_right,
+                                           distinct_keys, right_tiles,
+                                           right_tile_keys) == false) {
+    return;
+  }
+
+  for (size_t tile_itr = 0; tile_itr < right_tiles.size(); tile_itr++) {
+    auto right_tile = right_tiles[tile_itr].get();
+    auto &right_keys = right_tile_keys[tile_itr];
+    auto output_tile = BuildOutputLogicalTile(left_tile_.get(), right_tile);
+    LogicalTile::PositionListsBuilder pos_lists_builder(left_tile_.get(),
+                                                        right_tile);
+
+    // Every right row joins the left rows with the key it was found by
+    size_t row_itr = 0;
+    for (auto right_tile_row_itr : *right_tile) {
+      auto run = right_keys[row_itr++];
+      expression::ContainerTuple<executor::LogicalTile> right_tuple(
+          right_tile, right_tile_row_itr);
+      for (size_t i = run_begins[run]; i < run_begins[run + 1]; i++) {
+        auto left_tile_row_itr = left_rows[order[i]];
+        if (predicate_ != nullptr) {
+          expression::ContainerTuple<executor::LogicalTile> left_tuple(
+              left_tile_.get(), left_tile_row_itr);
+          if (compiled_predicate_->Evaluate(&left_tuple, &right_tuple,
+                                            executor_context_).IsFalse()) {
+            continue;
+          }
+        }
+        pos_lists_builder.AddRow(left_tile_row_itr, right_tile_row_itr);
+      }
+    }
+
+    if (pos_lists_builder.Size() > 0) {
+      output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+      buffered_output_tiles_.push_back(std::move(output_tile));
+    }
+  }
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -180,6 +180,9 @@ bool OrderByExecutor::DoSort() {
 
   PL_ASSERT(count == sort_buffer_.size());
 
+  stats_.memory_bytes = count * (sizeof(sort_buffer_entry_t) +
+                                 sort_key_tuple_schema_->GetLength());
+
   // If the underlying result has the same order, it is not necessary to sort
   // the result again. Instead, go to the end.
   if (underling_ordered_) {
@@ -14,10 +14,15 @@
 #include <vector>
 
 #include "common/logger.h"
+#include "common/timer.h"
+#include "configuration/configuration.h"
 #include "executor/executor_context.h"
 #include "executor/executors.h"
 #include "optimizer/util.h"
+#include "planner/plan_util.h"
+#include "statistics/backend_stats_context.h"
 #include "storage/tuple_iterator.h"
+#include "util/string_util.h"
 
 namespace peloton {
 namespace bridge {
@@ -34,6 +39,11 @@ executor::AbstractExecutor *BuildExecutorTree(
 
 void CleanExecutorTree(executor::AbstractExecutor *root);
 
+void GetExplainAnalyzeInfo(const executor::AbstractExecutor *executor,
+                           const std::string &prefix,
+                           std::vector<std::string> &lines,
+                           executor::ExecutorStats &total_stats);
+
 /**
  * @brief Build a executor tree and execute it.
  * Use std::vector<type::Value> as params to make it more elegant for
@@ -58,6 +68,12 @@ peloton_status PlanExecutor::ExecutePlan(
   LOG_TRACE("Txn ID = %lu ", txn->GetTransactionId());
   LOG_TRACE("Building the executor tree");
 
+  stats::BackendStatsContext *stats_context = nullptr;
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats_context = stats::BackendStatsContext::GetInstance();
+    stats_context->StartPhase(QueryPhaseType::BUILD);
+  }
+
   // Use const std::vector<type::Value> &params to make it more elegant for
   // network
   std::unique_ptr<executor::ExecutorContext> executor_context(
@@ -72,10 +88,18 @@ peloton_status PlanExecutor::ExecutePlan(
   // Initialize the executor tree
   status = executor_tree->Init();
 
+  if (stats_context != nullptr) {
+    stats_context->EndPhase(QueryPhaseType::BUILD);
+  }
+
   if (status == true) {
     LOG_TRACE("Running the executor tree");
     result.clear();
 
+    if (stats_context != nullptr) {
+      stats_context->StartPhase(QueryPhaseType::EXECUTE);
+    }
+
     // Execute the tree until we get result tiles from root node
     while (status == true) {
       status = executor_tree->Execute();
@@ -105,6 +129,10 @@ peloton_status PlanExecutor::ExecutePlan(
       }
     }
 
+    if (stats_context != nullptr) {
+      stats_context->EndPhase(QueryPhaseType::EXECUTE);
+    }
+
     // Set the result
     p_status.m_processed = executor_context->num_processed;
     // success so far
@@ -121,6 +149,66 @@ peloton_status PlanExecutor::ExecutePlan(
   return p_status;
 }
 
+/**
+ * @brief Build a profiled executor tree and run it, dropping its output.
+ * @return status of execution, and the annotated plan tree in the result.
+ */
+peloton_status PlanExecutor::ExplainAnalyzePlan(
+    const planner::AbstractPlan *plan, concurrency::Transaction *txn,
+    const std::vector<type::Value> &params,
+    std::vector<StatementResult> &result) {
+  peloton_status p_status;
+  if (plan == nullptr) return p_status;
+
+  PL_ASSERT(txn);
+
+  std::unique_ptr<executor::ExecutorContext> executor_context(
+      BuildExecutorContext(params, txn));
+
+  std::unique_ptr<executor::AbstractExecutor> executor_tree(
+      BuildExecutorTree(nullptr, plan, executor_context.get()));
+
+  executor_tree->EnableProfiling();
+
+  Timer<std::ratio<1, 1000>> timer;
+  timer.Start();
+  bool status = executor_tree->Init();
+  if (status == false) {
+    p_status.m_result = ResultType::FAILURE;
+    CleanExecutorTree(executor_tree.get());
+    return p_status;
+  }
+  while (executor_tree->Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> logical_tile(
+        executor_tree->GetOutput());
+  }
+  timer.Stop();
+
+  std::vector<std::string> lines;
+  executor::ExecutorStats total_stats;
+  GetExplainAnalyzeInfo(executor_tree.get(), "", lines, total_stats);
+  lines.push_back(StringUtil::Format(
+      "Total: time=%.3f ms, filtered=%lu, probes=%lu, memory=%lu bytes, "
+      "pool=%lu bytes",
+      timer.GetDuration(), total_stats.filtered_count,
+      total_stats.index_probe_count, total_stats.memory_bytes,
+      executor_context->GetPool()->GetAllocatedBytes()));
+
+  result.clear();
+  for (auto &line : lines) {
+    auto res = StatementResult();
+    PlanExecutor::copyFromTo(line, res.second);
+    result.push_back(std::move(res));
+  }
+
+  p_status.m_processed = lines.size();
+  p_status.m_result = ResultType::SUCCESS;
+
+  CleanExecutorTree(executor_tree.get());
+
+  return p_status;
+}
+
 /**
  * @brief Build a executor tree and execute it.
  * Use std::vector<type::Value> as params to make it more elegant for
@@ -339,6 +427,10 @@ executor::AbstractExecutor *BuildExecutorTree(
       LOG_TRACE("Adding Copy Executer");
       child_executor = new executor::CopyExecutor(plan, executor_context);
       break;
+    case PlanNodeType::ANALYZE:
+      LOG_TRACE("Adding Analyze Executer");
+      child_executor = new executor::AnalyzeExecutor(plan, executor_context);
+      break;
     case PlanNodeType::POPULATE_INDEX:
       LOG_TRACE("Adding PopulateIndex Executor");
       child_executor = new executor::PopulateIndexExecutor(plan, executor_context);
@@ -383,5 +475,51 @@ void CleanExecutorTree(executor::AbstractExecutor *root) {
   }
 }
 
+/**
+ * @brief Describe the runtime statistics of the executor tree.
+ * @param The executor tree
+ * @param The indentation of the tree
+ * @param The lines to add to, one per executor
+ * @param The statistics summed over the whole tree
+ */
+void GetExplainAnalyzeInfo(const executor::AbstractExecutor *executor,
+                           const std::string &prefix,
+                           std::vector<std::string> &lines,
+                           executor::ExecutorStats &total_stats) {
+  auto &stats = executor->GetStats();
+
+  // The time of an executor includes the time of its children
+  double self_time_ms = stats.time_ms;
+  for (auto child : executor->GetChildren()) {
+    self_time_ms -= child->GetStats().time_ms;
+  }
+
+  std::string line = StringUtil::Format(
+      "%s%s (time=%.3f ms, self=%.3f ms, calls=%lu, tiles=%lu, tuples=%lu",
+      prefix.c_str(),
+      planner::PlanUtil::GetNodeInfo(executor->GetRawNode()).c_str(),
+      stats.time_ms, std::max(self_time_ms, 0.0), stats.execute_count,
+      stats.tile_count, stats.tuple_count);
+  if (stats.filtered_count > 0) {
+    line += StringUtil::Format(", filtered=%lu", stats.filtered_count);
+  }
+  if (stats.index_probe_count > 0) {
+    line += StringUtil::Format(", probes=%lu", stats.index_probe_count);
+  }
+  if (stats.memory_bytes > 0) {
+    line += StringUtil::Format(", memory=%lu bytes", stats.memory_bytes);
+  }
+  lines.push_back(line + ")");
+
+  total_stats.filtered_count += stats.filtered_count;
+  total_stats.index_probe_count += stats.index_probe_count;
+  total_stats.memory_bytes += stats.memory_bytes;
+
+  std::string child_prefix = prefix.empty() ? "  ->  " : "      " + prefix;
+  for (auto child : executor->GetChildren()) {
+    GetExplainAnalyzeInfo(child, child_prefix, lines, total_stats);
+  }
+}
+
 }  // namespace bridge
 }  // namespace peloton
@@ -15,6 +15,7 @@
 
 #include "common/logger.h"
 #include "type/value.h"
+#include "executor/abstract_scan_executor.h"
 #include "executor/logical_tile.h"
 #include "executor/populate_index_executor.h"
 #include "executor/executor_context.h"
@@ -48,6 +49,12 @@ bool PopulateIndexExecutor::DInit() {
   column_ids_ = node.GetColumnIds();
   done_ = false;
 
+  // The positions of the tuples go into the index
+  auto scan_executor = dynamic_cast<AbstractScanExecutor *>(children_[0]);
+  if (scan_executor != nullptr) {
+    scan_executor->SetCopyVersions(false);
+  }
+
   return true;
 }
 
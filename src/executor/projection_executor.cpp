@@ -43,6 +43,7 @@ bool ProjectionExecutor::DInit() {
   // Grab settings from plan node
   const planner::ProjectionPlan &node = GetPlanNode<planner::ProjectionPlan>();
   this->project_info_ = node.GetProjectInfo();
+  compiled_targets_ = project_info_->CompileTargetList(executor_context_);
   this->schema_ = node.GetSchema();
 
   return true;
@@ -81,7 +82,8 @@ bool ProjectionExecutor::DExecute() {
       storage::Tuple *buffer = new storage::Tuple(schema_, true);
       expression::ContainerTuple<LogicalTile> tuple(source_tile.get(),
                                                     old_tuple_id);
-      project_info_->Evaluate(buffer, &tuple, nullptr, executor_context_);
+      project_info_->Evaluate(buffer, &tuple, nullptr, executor_context_,
+                              &compiled_targets_);
 
       // Insert projected tuple into the new tile
       dest_tile.get()->InsertTuple(new_tuple_id, buffer);
@@ -22,8 +22,10 @@
 #include "executor/logical_tile_factory.h"
 #include "executor/executor_context.h"
 #include "expression/abstract_expression.h"
+#include "expression/tuple_value_expression.h"
 #include "common/container_tuple.h"
 #include "planner/create_plan.h"
+#include "storage/compressed_column.h"
 #include "storage/data_table.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
@@ -67,6 +69,33 @@ bool SeqScanExecutor::DInit() {
     }
   }
 
+  column_predicates_.clear();
+  if (predicate_ != nullptr) {
+    column_predicates_only_ = ExtractColumnPredicates(predicate_);
+  }
+
+  return true;
+}
+
+bool SeqScanExecutor::EvaluateColumnPredicates(storage::TileGroup *tile_group,
+                                               std::vector<bool> &selection) {
+  selection.assign(tile_group->GetAllocatedTupleCount(), true);
+
+  for (auto &column_predicate : column_predicates_) {
+    oid_t tile_offset, tile_column_id;
+    tile_group->LocateTileAndColumn(column_predicate.column_id, tile_offset,
+                                    tile_column_id);
+    auto tile = tile_group->GetTile(tile_offset);
+    if (tile->IsCompressed() == false) {
+      return false;
+    }
+
+    auto constant =
+        column_predicate.value->Evaluate(nullptr, nullptr, executor_context_);
+    tile->GetCompressedColumn(tile_column_id)
+        ->Filter(column_predicate.comparison_type, constant, selection);
+  }
+
   return true;
 }
 
@@ -97,11 +126,13 @@ bool SeqScanExecutor::DExecute() {
         // Invalidate tuples that don't satisfy the predicate.
         for (oid_t tuple_id : *tile) {
           expression::ContainerTuple<LogicalTile> tuple(tile.get(), tuple_id);
-          auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
+          auto eval = compiled_predicate_->Evaluate(&tuple, nullptr,
+                                                    executor_context_);
           if (eval.IsFalse()) {
             // if (predicate_->Evaluate(&tuple, nullptr, executor_context_)
             //        .IsFalse()) {
             tile->RemoveVisibility(tuple_id);
+            stats_.filtered_count++;
           }
         }
       }
@@ -152,23 +183,92 @@ bool SeqScanExecutor::DExecute() {
     while (current_tile_group_offset_ < table_tile_group_count_) {
       auto tile_group =
           target_table_->GetTileGroup(current_tile_group_offset_++);
+      // skip tile groups dropped by compaction
+      if (tile_group == nullptr) {
+        continue;
+      }
+      // skip tile groups whose zone map rules out the predicate
+      if (column_predicates_.empty() == false &&
+          CanSkipTileGroup(tile_group.get()) == true) {
+        continue;
+      }
       auto tile_group_header = tile_group->GetHeader();
 
       oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
+      // Copy the visible versions, as the tuples that were updated in place
+      // may hold values that the transaction must not see
+      if (copy_versions_ == true) {
+        std::vector<std::vector<type::Value>> versions;
+        std::vector<type::Value> values;
+        for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+          auto visibility = transaction_manager.ReadVersion(
+              current_txn, tile_group.get(), tuple_id, values);
+          if (visibility != VisibilityType::OK ||
+              MayMatchBloomFilter(values) == false) {
+            continue;
+          }
+          if (predicate_ != nullptr) {
+            expression::ContainerTuple<std::vector<type::Value>> tuple(
+                &values);
+            if (compiled_predicate_->EvaluatePredicate(
+                    &tuple, nullptr, executor_context_) == false) {
+              continue;
+            }
+          }
+
+          ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+          auto res = transaction_manager.PerformRead(current_txn, location,
+                                                     acquire_owner);
+          if (!res) {
+            transaction_manager.SetTransactionResult(current_txn,
+                                                     ResultType::FAILURE);
+            return res;
+          }
+          versions.push_back(values);
+        }
+
+        stats_.filtered_count += active_tuple_count - versions.size();
+
+        // Don't return empty tiles
+        if (versions.size() == 0) {
+          continue;
+        }
+
+        SetOutput(BuildVersionTile(target_table_->GetSchema(), column_ids_,
+                                   versions));
+        return true;
+      }
+
+      // Evaluate the simple terms of the predicate directly on the
+      // compressed columns of frozen tile groups
+      std::vector<bool> selection;
+      bool use_selection = false;
+      if (column_predicates_.empty() == false &&
+          tile_group_header->IsFrozen() == true) {
+        use_selection = EvaluateColumnPredicates(tile_group.get(), selection);
+      }
+      bool skip_predicate = (use_selection && column_predicates_only_);
+
       // Construct position list by looping through tile group
       // and applying the predicate.
       std::vector<oid_t> position_list;
       for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+        if (use_selection && selection[tuple_id] == false) {
+          continue;
+        }
+
         ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
 
         auto visibility = transaction_manager.IsVisible(
             current_txn, tile_group_header, tuple_id);
 
-        // check transaction visibility
-        if (visibility == VisibilityType::OK) {
+        // check transaction visibility, and drop the tuples that cannot
+        // join with the build side of a hash join
+        if (visibility == VisibilityType::OK &&
+            MayMatchBloomFilter(tile_group.get(), tuple_id) == true) {
           // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
+          if (predicate_ == nullptr || skip_predicate) {
             position_list.push_back(tuple_id);
             auto res = transaction_manager.PerformRead(current_txn, location,
                                                        acquire_owner);
@@ -181,10 +281,10 @@ bool SeqScanExecutor::DExecute() {
             expression::ContainerTuple<storage::TileGroup> tuple(
                 tile_group.get(), tuple_id);
             LOG_TRACE("Evaluate predicate for a tuple");
-            auto eval =
-                predicate_->Evaluate(&tuple, nullptr, executor_context_);
-            LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
-            if (eval.IsTrue()) {
+            bool eval = compiled_predicate_->EvaluatePredicate(
+                &tuple, nullptr, executor_context_);
+            LOG_TRACE("Evaluation result: %d", eval);
+            if (eval == true) {
               position_list.push_back(tuple_id);
               auto res = transaction_manager.PerformRead(current_txn, location,
                                                          acquire_owner);
@@ -200,6 +300,8 @@ bool SeqScanExecutor::DExecute() {
         }
       }
 
+      stats_.filtered_count += active_tuple_count - position_list.size();
+
       // Don't return empty tiles
       if (position_list.size() == 0) {
         continue;
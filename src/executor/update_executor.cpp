@@ -11,17 +11,23 @@
 //===----------------------------------------------------------------------===//
 
 #include "executor/update_executor.h"
+
+#include <algorithm>
+
 #include "planner/update_plan.h"
 #include "common/logger.h"
 #include "catalog/manager.h"
+#include "executor/abstract_scan_executor.h"
 #include "executor/logical_tile.h"
 #include "executor/executor_context.h"
 #include "common/container_tuple.h"
+#include "index/index.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/data_table.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
+#include "storage/tile_group.h"
 
 namespace peloton {
 namespace executor {
@@ -51,6 +57,43 @@ bool UpdateExecutor::DInit() {
   PL_ASSERT(target_table_);
   PL_ASSERT(project_info_);
 
+  // The positions of the tuples are needed to update them
+  auto scan_executor = dynamic_cast<AbstractScanExecutor *>(children_[0]);
+  if (scan_executor != nullptr) {
+    scan_executor->SetCopyVersions(false);
+  }
+
+  // Tuples can only be updated in place if the update writes inlined columns
+  // that no index covers, and keeps the other columns as they are
+  in_place_column_ids_.clear();
+  if (concurrency::TransactionManagerFactory::IsDeltaVersioning() == true &&
+      node.GetUpdatePrimaryKey() == false &&
+      project_info_->GetTargetList().empty() == false) {
+    auto schema = target_table_->GetSchema();
+    bool in_place = true;
+    for (auto &target : project_info_->GetTargetList()) {
+      in_place = in_place && schema->IsInlined(target.first);
+      in_place_column_ids_.push_back(target.first);
+    }
+    for (auto &direct_map : project_info_->GetDirectMapList()) {
+      in_place = in_place && direct_map.second.first == 0 &&
+                 direct_map.first == direct_map.second.second;
+    }
+    for (oid_t index_itr = 0; index_itr < target_table_->GetIndexCount();
+         index_itr++) {
+      auto index = target_table_->GetIndex(index_itr);
+      for (auto column_id : index->GetKeySchema()->GetIndexedColumns()) {
+        in_place = in_place &&
+                   std::find(in_place_column_ids_.begin(),
+                             in_place_column_ids_.end(),
+                             column_id) == in_place_column_ids_.end();
+      }
+    }
+    if (in_place == false) {
+      in_place_column_ids_.clear();
+    }
+  }
+
   return true;
 }
 
@@ -112,6 +155,8 @@ bool UpdateExecutor::PerformUpdatePrimaryKey(bool is_owner, oid_t tile_group_id,
   // tuple.
   // in this case, abort the transaction.
   if (location.block == INVALID_OID) {
+    current_txn->SetAbortCause(AbortCauseType::CONSTRAINT,
+                               target_table_->GetOid(), INVALID_ITEMPOINTER);
     transaction_manager.SetTransactionResult(current_txn,
                                              peloton::ResultType::FAILURE);
     return false;
@@ -241,6 +286,33 @@ bool UpdateExecutor::DExecute() {
           }
         }
 
+        // Update the latest version in place, unless its tile group is
+        // frozen. The old values of the columns go into an undo record.
+        else if (in_place_column_ids_.empty() == false &&
+                 tile_group_header->GetPrevItemPointer(physical_tuple_id)
+                         .IsNull() == true &&
+                 tile_group_header->IsFrozen() == false) {
+          // evaluate all the targets before any column changes
+          expression::ContainerTuple<storage::TileGroup> old_tuple(
+              tile_group, physical_tuple_id);
+          std::vector<type::Value> values;
+          for (auto &target : project_info_->GetTargetList()) {
+            values.push_back(target.second->Evaluate(&old_tuple, nullptr,
+                                                     executor_context_));
+          }
+
+          transaction_manager.PerformInPlaceUpdate(current_txn, old_location,
+                                                   in_place_column_ids_);
+
+          for (oid_t column_itr = 0; column_itr < values.size();
+               column_itr++) {
+            tile_group->SetValue(values[column_itr], physical_tuple_id,
+                                 in_place_column_ids_[column_itr]);
+          }
+
+          executor_context_->num_processed += 1;  // updated one
+        }
+
         // Normal update (no primary key)
         else {
           // if it is the latest version and not locked by other threads, then
@@ -288,6 +360,8 @@ bool UpdateExecutor::DExecute() {
               transaction_manager.YieldOwnership(current_txn, tile_group_id,
                                                  physical_tuple_id);
             }
+            current_txn->SetAbortCause(AbortCauseType::CONSTRAINT,
+                                       tile_group_header, physical_tuple_id);
             transaction_manager.SetTransactionResult(current_txn,
                                                      ResultType::FAILURE);
             return false;
@@ -0,0 +1,836 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression.cpp
+//
+// Identification: src/expression/compiled_expression.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/compiled_expression.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/abstract_tuple.h"
+#include "common/exception.h"
+#include "executor/executor_context.h"
+#include "expression/abstract_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace expression {
+
+static bool IsIntegerType(const type::Type::TypeId &type_id) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool IsNumericType(const type::Type::TypeId &type_id) {
+  return IsIntegerType(type_id) || type_id == type::Type::DECIMAL;
+}
+
+static void ThrowOutOfRange() {
+  throw Exception(EXCEPTION_TYPE_OUT_OF_RANGE, "Numeric value out of range.");
+}
+
+static void ThrowDivideByZero() {
+  throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+}
+
+//===--------------------------------------------------------------------===//
+// Compilation
+//===--------------------------------------------------------------------===//
+
+std::unique_ptr<CompiledExpression> CompiledExpression::Compile(
+    const AbstractExpression *expression, executor::ExecutorContext *context) {
+  if (expression == nullptr) {
+    return nullptr;
+  }
+
+  std::unique_ptr<CompiledExpression> compiled(
+      new CompiledExpression(expression));
+  uint8_t result;
+  type::Type::TypeId result_type;
+  if (compiled->CompileNode(expression, context, result, result_type) ==
+      false) {
+    LOG_TRACE("Expression %s is evaluated as a tree",
+              ExpressionTypeToString(expression->GetExpressionType()).c_str());
+    compiled->instructions_.clear();
+    compiled->initial_registers_.clear();
+    compiled->is_constant_.clear();
+    return compiled;
+  }
+
+  compiled->is_compiled_ = true;
+  compiled->result_register_ = result;
+  compiled->result_type_ = result_type;
+  return compiled;
+}
+
+bool CompiledExpression::CompileNode(const AbstractExpression *expression,
+                                     executor::ExecutorContext *context,
+                                     uint8_t &result,
+                                     type::Type::TypeId &result_type) {
+  auto expression_type = expression->GetExpressionType();
+  switch (expression_type) {
+    case ExpressionType::VALUE_TUPLE: {
+      auto tuple_value_expr =
+          static_cast<const TupleValueExpression *>(expression);
+      auto tuple_idx = tuple_value_expr->GetTupleId();
+      auto column_id = tuple_value_expr->GetColumnId();
+      if ((tuple_idx != 0 && tuple_idx != 1) || column_id < 0) {
+        return false;
+      }
+
+      result_type = expression->GetValueType();
+      Opcode opcode;
+      switch (result_type) {
+        case type::Type::TINYINT:
+          opcode = Opcode::LOAD_TINYINT;
+          break;
+        case type::Type::SMALLINT:
+          opcode = Opcode::LOAD_SMALLINT;
+          break;
+        case type::Type::INTEGER:
+          opcode = Opcode::LOAD_INTEGER;
+          break;
+        case type::Type::BIGINT:
+          opcode = Opcode::LOAD_BIGINT;
+          break;
+        case type::Type::BOOLEAN:
+          opcode = Opcode::LOAD_BOOLEAN;
+          break;
+        case type::Type::DECIMAL:
+          opcode = Opcode::LOAD_DECIMAL;
+          break;
+        default:
+          return false;
+      }
+      if (AllocateRegister(result, false) == false) {
+        return false;
+      }
+      Emit({opcode, result_type, result, static_cast<uint8_t>(tuple_idx), 0,
+            static_cast<uint32_t>(column_id)});
+      return true;
+    }
+
+    case ExpressionType::VALUE_CONSTANT:
+      return CompileConstant(expression->Evaluate(nullptr, nullptr, nullptr),
+                             result, result_type);
+
+    case ExpressionType::VALUE_PARAMETER: {
+      // Parameters are only known once there is an execution
+      if (context == nullptr) {
+        return false;
+      }
+      auto parameter_expr =
+          static_cast<const ParameterValueExpression *>(expression);
+      auto &params = context->GetParams();
+      if (parameter_expr->GetValueIdx() < 0 ||
+          static_cast<size_t>(parameter_expr->GetValueIdx()) >=
+              params.size()) {
+        return false;
+      }
+      return CompileConstant(params[parameter_expr->GetValueIdx()], result,
+                             result_type);
+    }
+
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO: {
+      uint8_t left, right;
+      type::Type::TypeId left_type, right_type;
+      if (CompileNode(expression->GetChild(0), context, left, left_type) ==
+              false ||
+          CompileNode(expression->GetChild(1), context, right, right_type) ==
+              false) {
+        return false;
+      }
+      result_type = type::Type::BOOLEAN;
+      return CompileComparison(expression_type, left, left_type, right,
+                               right_type, result);
+    }
+
+    case ExpressionType::CONJUNCTION_AND:
+    case ExpressionType::CONJUNCTION_OR:
+      result_type = type::Type::BOOLEAN;
+      return CompileConjunction(expression, context, result);
+
+    case ExpressionType::OPERATOR_NOT: {
+      uint8_t child;
+      type::Type::TypeId child_type;
+      if (CompileNode(expression->GetChild(0), context, child, child_type) ==
+              false ||
+          child_type != type::Type::BOOLEAN ||
+          AllocateRegister(result, false) == false) {
+        return false;
+      }
+      result_type = type::Type::BOOLEAN;
+      Emit({Opcode::NOT, result_type, result, child, child, 0});
+      return true;
+    }
+
+    case ExpressionType::OPERATOR_PLUS:
+    case ExpressionType::OPERATOR_MINUS:
+    case ExpressionType::OPERATOR_MULTIPLY:
+    case ExpressionType::OPERATOR_DIVIDE:
+    case ExpressionType::OPERATOR_MOD: {
+      uint8_t left, right;
+      type::Type::TypeId left_type, right_type;
+      if (CompileNode(expression->GetChild(0), context, left, left_type) ==
+              false ||
+          CompileNode(expression->GetChild(1), context, right, right_type) ==
+              false) {
+        return false;
+      }
+      return CompileArithmetic(expression_type, left, left_type, right,
+                               right_type, result, result_type);
+    }
+
+    case ExpressionType::OPERATOR_UNARY_MINUS: {
+      // Evaluated as 0 - child, like the tree does
+      uint8_t zero, child;
+      type::Type::TypeId zero_type, child_type;
+      if (CompileConstant(type::ValueFactory::GetIntegerValue(0), zero,
+                          zero_type) == false ||
+          CompileNode(expression->GetChild(0), context, child, child_type) ==
+              false) {
+        return false;
+      }
+      return CompileArithmetic(ExpressionType::OPERATOR_MINUS, zero,
+                               zero_type, child, child_type, result,
+                               result_type);
+    }
+
+    default:
+      return false;
+  }
+}
+
+bool CompiledExpression::CompileConstant(const type::Value &value,
+                                         uint8_t &result,
+                                         type::Type::TypeId &result_type) {
+  Register reg;
+  reg.integer = 0;
+  reg.is_null = value.IsNull();
+
+  result_type = value.GetTypeId();
+  switch (result_type) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT:
+      if (reg.is_null == false) reg.integer = value.GetAs<int8_t>();
+      break;
+    case type::Type::SMALLINT:
+      if (reg.is_null == false) reg.integer = value.GetAs<int16_t>();
+      break;
+    case type::Type::PARAMETER_OFFSET:
+    case type::Type::INTEGER:
+      result_type = type::Type::INTEGER;
+      if (reg.is_null == false) reg.integer = value.GetAs<int32_t>();
+      break;
+    case type::Type::BIGINT:
+      if (reg.is_null == false) reg.integer = value.GetAs<int64_t>();
+      break;
+    case type::Type::DECIMAL:
+      reg.decimal = 0;
+      if (reg.is_null == false) reg.decimal = value.GetAs<double>();
+      break;
+    default:
+      return false;
+  }
+
+  if (AllocateRegister(result, true) == false) {
+    return false;
+  }
+  initial_registers_[result] = reg;
+  return true;
+}
+
+bool CompiledExpression::CompileArithmetic(
+    const ExpressionType &expression_type, uint8_t left,
+    type::Type::TypeId left_type, uint8_t right, type::Type::TypeId right_type,
+    uint8_t &result, type::Type::TypeId &result_type) {
+  if (IsNumericType(left_type) == false || IsNumericType(right_type) == false) {
+    return false;
+  }
+
+  // Integers of different widths give the wider type, and anything with a
+  // decimal gives a decimal
+  result_type = std::max(left_type, right_type);
+  bool is_decimal = result_type == type::Type::DECIMAL;
+  if (is_decimal == true) {
+    for (auto operand : {&left, &right}) {
+      auto operand_type = operand == &left ? left_type : right_type;
+      if (operand_type == type::Type::DECIMAL) {
+        continue;
+      }
+      uint8_t converted;
+      if (AllocateRegister(converted, false) == false) {
+        return false;
+      }
+      Emit({Opcode::INTEGER_TO_DECIMAL, type::Type::DECIMAL, converted,
+            *operand, *operand, 0});
+      *operand = converted;
+    }
+  }
+
+  Opcode opcode;
+  switch (expression_type) {
+    case ExpressionType::OPERATOR_PLUS:
+      opcode = is_decimal ? Opcode::ADD_DECIMAL : Opcode::ADD_INTEGER;
+      break;
+    case ExpressionType::OPERATOR_MINUS:
+      opcode =
+          is_decimal ? Opcode::SUBTRACT_DECIMAL : Opcode::SUBTRACT_INTEGER;
+      break;
+    case ExpressionType::OPERATOR_MULTIPLY:
+      opcode =
+          is_decimal ? Opcode::MULTIPLY_DECIMAL : Opcode::MULTIPLY_INTEGER;
+      break;
+    case ExpressionType::OPERATOR_DIVIDE:
+      opcode = is_decimal ? Opcode::DIVIDE_DECIMAL : Opcode::DIVIDE_INTEGER;
+      break;
+    case ExpressionType::OPERATOR_MOD:
+      opcode = is_decimal ? Opcode::MODULO_DECIMAL : Opcode::MODULO_INTEGER;
+      break;
+    default:
+      return false;
+  }
+
+  if (AllocateRegister(result, false) == false) {
+    return false;
+  }
+  Emit({opcode, result_type, result, left, right, 0});
+  return true;
+}
+
+bool CompiledExpression::CompileComparison(
+    const ExpressionType &expression_type, uint8_t left,
+    type::Type::TypeId left_type, uint8_t right, type::Type::TypeId right_type,
+    uint8_t &result) {
+  bool is_decimal;
+  if (left_type == type::Type::BOOLEAN && right_type == type::Type::BOOLEAN) {
+    is_decimal = false;
+  } else if (IsNumericType(left_type) == true &&
+             IsNumericType(right_type) == true) {
+    is_decimal = left_type == type::Type::DECIMAL ||
+                 right_type == type::Type::DECIMAL;
+  } else {
+    return false;
+  }
+
+  if (is_decimal == true) {
+    for (auto operand : {&left, &right}) {
+      auto operand_type = operand == &left ? left_type : right_type;
+      if (operand_type == type::Type::DECIMAL) {
+        continue;
+      }
+      uint8_t converted;
+      if (AllocateRegister(converted, false) == false) {
+        return false;
+      }
+      Emit({Opcode::INTEGER_TO_DECIMAL, type::Type::DECIMAL, converted,
+            *operand, *operand, 0});
+      *operand = converted;
+    }
+  }
+
+  Opcode opcode;
+  switch (expression_type) {
+    case ExpressionType::COMPARE_EQUAL:
+      opcode = is_decimal ? Opcode::EQUAL_DECIMAL : Opcode::EQUAL_INTEGER;
+      break;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      opcode =
+          is_decimal ? Opcode::NOT_EQUAL_DECIMAL : Opcode::NOT_EQUAL_INTEGER;
+      break;
+    case ExpressionType::COMPARE_LESSTHAN:
+      opcode =
+          is_decimal ? Opcode::LESS_THAN_DECIMAL : Opcode::LESS_THAN_INTEGER;
+      break;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      opcode = is_decimal ? Opcode::LESS_THAN_OR_EQUAL_DECIMAL
+                          : Opcode::LESS_THAN_OR_EQUAL_INTEGER;
+      break;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      opcode = is_decimal ? Opcode::GREATER_THAN_DECIMAL
+                          : Opcode::GREATER_THAN_INTEGER;
+      break;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      opcode = is_decimal ? Opcode::GREATER_THAN_OR_EQUAL_DECIMAL
+                          : Opcode::GREATER_THAN_OR_EQUAL_INTEGER;
+      break;
+    default:
+      return false;
+  }
+
+  if (AllocateRegister(result, false) == false) {
+    return false;
+  }
+  Emit({opcode, type::Type::BOOLEAN, result, left, right, 0});
+  return true;
+}
+
+bool CompiledExpression::CompileConjunction(
+    const AbstractExpression *expression, executor::ExecutorContext *context,
+    uint8_t &result) {
+  bool is_and = expression->GetExpressionType() ==
+                ExpressionType::CONJUNCTION_AND;
+
+  uint8_t left;
+  type::Type::TypeId left_type;
+  if (CompileNode(expression->GetChild(0), context, left, left_type) ==
+          false ||
+      left_type != type::Type::BOOLEAN) {
+    return false;
+  }
+
+  // A constant that decides the conjunction leaves out the other side
+  bool left_is_constant = is_constant_[left];
+  if (left_is_constant == true) {
+    auto &reg = initial_registers_[left];
+    if (reg.is_null == false && reg.integer == (is_and ? 0 : 1)) {
+      result = left;
+      return true;
+    }
+  }
+
+  if (AllocateRegister(result, false) == false) {
+    return false;
+  }
+
+  // Skip the right side when the left one decides
+  size_t jump = instructions_.size();
+  if (left_is_constant == false) {
+    instructions_.push_back(
+        {is_and ? Opcode::AND_SHORT_CIRCUIT : Opcode::OR_SHORT_CIRCUIT,
+         type::Type::BOOLEAN, result, left, left, 0});
+  }
+
+  uint8_t right;
+  type::Type::TypeId right_type;
+  if (CompileNode(expression->GetChild(1), context, right, right_type) ==
+          false ||
+      right_type != type::Type::BOOLEAN) {
+    return false;
+  }
+
+  Emit({is_and ? Opcode::AND : Opcode::OR, type::Type::BOOLEAN, result, left,
+        right, 0});
+  if (left_is_constant == false) {
+    instructions_[jump].operand = instructions_.size();
+  }
+  return true;
+}
+
+bool CompiledExpression::AllocateRegister(uint8_t &reg,
+                                          const bool &is_constant) {
+  if (initial_registers_.size() >= max_register_count) {
+    return false;
+  }
+  reg = initial_registers_.size();
+  Register initial_register;
+  initial_register.integer = 0;
+  initial_register.is_null = false;
+  initial_registers_.push_back(initial_register);
+  is_constant_.push_back(is_constant);
+  return true;
+}
+
+void CompiledExpression::Emit(const Instruction &instruction) {
+  bool foldable;
+  switch (instruction.opcode) {
+    case Opcode::LOAD_TINYINT:
+    case Opcode::LOAD_SMALLINT:
+    case Opcode::LOAD_INTEGER:
+    case Opcode::LOAD_BIGINT:
+    case Opcode::LOAD_BOOLEAN:
+    case Opcode::LOAD_DECIMAL:
+    case Opcode::AND_SHORT_CIRCUIT:
+    case Opcode::OR_SHORT_CIRCUIT:
+      foldable = false;
+      break;
+    default:
+      foldable = is_constant_[instruction.left] &&
+                 is_constant_[instruction.right];
+      break;
+  }
+
+  if (foldable == true) {
+    // An error is left for the evaluation to raise, since the tree only
+    // raises it when there is a tuple to evaluate
+    try {
+      Run(&instruction, &instruction + 1, initial_registers_.data(), nullptr,
+          nullptr);
+      is_constant_[instruction.result] = true;
+      return;
+    } catch (Exception &) {
+    }
+  }
+  instructions_.push_back(instruction);
+}
+
+//===--------------------------------------------------------------------===//
+// Evaluation
+//===--------------------------------------------------------------------===//
+
+// Store an integer result, which must fit its type. The smallest value of a
+// type is its null, as in type::Value.
+static inline void SetInteger(int64_t &result, bool &is_null,
+                              const type::Type::TypeId &type_id,
+                              const int64_t &value) {
+  int64_t null_value, max_value;
+  switch (type_id) {
+    case type::Type::TINYINT:
+      null_value = type::PELOTON_INT8_NULL;
+      max_value = type::PELOTON_INT8_MAX;
+      break;
+    case type::Type::SMALLINT:
+      null_value = type::PELOTON_INT16_NULL;
+      max_value = type::PELOTON_INT16_MAX;
+      break;
+    case type::Type::INTEGER:
+      null_value = type::PELOTON_INT32_NULL;
+      max_value = type::PELOTON_INT32_MAX;
+      break;
+    default:
+      null_value = type::PELOTON_INT64_NULL;
+      max_value = type::PELOTON_INT64_MAX;
+      break;
+  }
+  if (value < null_value || value > max_value) {
+    ThrowOutOfRange();
+  }
+  result = value;
+  is_null = value == null_value;
+}
+
+static inline void SetDecimal(double &result, bool &is_null,
+                              const double &value) {
+  result = value;
+  is_null = value == type::PELOTON_DECIMAL_NULL;
+}
+
+bool CompiledExpression::Run(const Instruction *begin, const Instruction *end,
+                             Register *registers, const AbstractTuple *tuple1,
+                             const AbstractTuple *tuple2) const {
+  const Instruction *pc = begin;
+  while (pc < end) {
+    auto &instruction = *pc;
+    auto &result = registers[instruction.result];
+    auto &left = registers[instruction.left];
+    auto &right = registers[instruction.right];
+
+    switch (instruction.opcode) {
+      case Opcode::LOAD_TINYINT:
+      case Opcode::LOAD_SMALLINT:
+      case Opcode::LOAD_INTEGER:
+      case Opcode::LOAD_BIGINT:
+      case Opcode::LOAD_BOOLEAN:
+      case Opcode::LOAD_DECIMAL: {
+        auto tuple = instruction.left == 0 ? tuple1 : tuple2;
+        PL_ASSERT(tuple != nullptr);
+        auto value = tuple->GetValue(instruction.operand);
+        if (value.GetTypeId() != instruction.type) {
+          return false;
+        }
+        result.is_null = value.IsNull();
+        switch (instruction.opcode) {
+          case Opcode::LOAD_TINYINT:
+          case Opcode::LOAD_BOOLEAN:
+            result.integer = value.GetAs<int8_t>();
+            break;
+          case Opcode::LOAD_SMALLINT:
+            result.integer = value.GetAs<int16_t>();
+            break;
+          case Opcode::LOAD_INTEGER:
+            result.integer = value.GetAs<int32_t>();
+            break;
+          case Opcode::LOAD_BIGINT:
+            result.integer = value.GetAs<int64_t>();
+            break;
+          default:
+            result.decimal = value.GetAs<double>();
+            break;
+        }
+        break;
+      }
+
+      case Opcode::INTEGER_TO_DECIMAL:
+        result.is_null = left.is_null;
+        result.decimal = left.integer;
+        break;
+
+      case Opcode::ADD_INTEGER: {
+        if (left.is_null || right.is_null) {
+          result.is_null = true;
+          break;
+        }
+        int64_t value;
+        if (__builtin_add_overflow(left.integer, right.integer, &value)) {
+          ThrowOutOfRange();
+        }
+        SetInteger(result.integer, result.is_null, instruction.type, value);
+        break;
+      }
+      case Opcode::SUBTRACT_INTEGER: {
+        if (left.is_null || right.is_null) {
+          result.is_null = true;
+          break;
+        }
+        int64_t value;
+        if (__builtin_sub_overflow(left.integer, right.integer, &value)) {
+          ThrowOutOfRange();
+        }
+        SetInteger(result.integer, result.is_null, instruction.type, value);
+        break;
+      }
+      case Opcode::MULTIPLY_INTEGER: {
+        if (left.is_null || right.is_null) {
+          result.is_null = true;
+          break;
+        }
+        int64_t value;
+        if (__builtin_mul_overflow(left.integer, right.integer, &value)) {
+          ThrowOutOfRange();
+        }
+        SetInteger(result.integer, result.is_null, instruction.type, value);
+        break;
+      }
+      case Opcode::DIVIDE_INTEGER:
+        if (left.is_null || right.is_null) {
+          result.is_null = true;
+          break;
+        }
+        if (right.integer == 0) {
+          ThrowDivideByZero();
+        }
+        if (right.integer == -1 && left.integer == type::PELOTON_INT64_NULL) {
+          ThrowOutOfRange();
+        }
+        SetInteger(result.integer, result.is_null, instruction.type,
+                   left.integer / right.integer);
+        break;
+      case Opcode::MODULO_INTEGER:
+        if (left.is_null || right.is_null) {
+          result.is_null = true;
+          break;
+        }
+        if (right.integer == 0) {
+          ThrowDivideByZero();
+        }
+        SetInteger(result.integer, result.is_null, instruction.type,
+                   right.integer == -1 ? 0 : left.integer % right.integer);
+        break;
+
+      case Opcode::ADD_DECIMAL:
+        if (left.is_null || right.is_null) {
+          result.is_null = true;
+          break;
+        }
+        SetDecimal(result.decimal, result.is_null,
+                   left.decimal + right.decimal);
+        break;
+      case Opcode::SUBTRACT_DECIMAL:
+        if (left.is_null || right.is_null) {
+          result.is_null = true;
+          break;
+        }
+        SetDecimal(result.decimal, result.is_null,
+                   left.decimal - right.decimal);
+        break;
+      case Opcode::MULTIPLY_DECIMAL:
+        if (left.is_null || right.is_null) {
+          result.is_null = true;
+          break;
+        }
+        SetDecimal(result.decimal, result.is_null,
+                   left.decimal * right.decimal);
+        break;
+      case Opcode::DIVIDE_DECIMAL:
+        if (left.is_null || right.is_null) {
+          result.is_null = true;
+          break;
+        }
+        if (right.decimal == 0) {
+          ThrowDivideByZero();
+        }
+        SetDecimal(result.decimal, result.is_null,
+                   left.decimal / right.decimal);
+        break;
+      case Opcode::MODULO_DECIMAL:
+        if (left.is_null || right.is_null) {
+          result.is_null = true;
+          break;
+        }
+        if (right.decimal == 0) {
+          ThrowDivideByZero();
+        }
+        SetDecimal(result.decimal, result.is_null,
+                   left.decimal - std::trunc(left.decimal / right.decimal) *
+                                      right.decimal);
+        break;
+
+      case Opcode::EQUAL_INTEGER:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.integer == right.integer;
+        break;
+      case Opcode::NOT_EQUAL_INTEGER:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.integer != right.integer;
+        break;
+      case Opcode::LESS_THAN_INTEGER:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.integer < right.integer;
+        break;
+      case Opcode::LESS_THAN_OR_EQUAL_INTEGER:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.integer <= right.integer;
+        break;
+      case Opcode::GREATER_THAN_INTEGER:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.integer > right.integer;
+        break;
+      case Opcode::GREATER_THAN_OR_EQUAL_INTEGER:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.integer >= right.integer;
+        break;
+
+      case Opcode::EQUAL_DECIMAL:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.decimal == right.decimal;
+        break;
+      case Opcode::NOT_EQUAL_DECIMAL:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.decimal != right.decimal;
+        break;
+      case Opcode::LESS_THAN_DECIMAL:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.decimal < right.decimal;
+        break;
+      case Opcode::LESS_THAN_OR_EQUAL_DECIMAL:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.decimal <= right.decimal;
+        break;
+      case Opcode::GREATER_THAN_DECIMAL:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.decimal > right.decimal;
+        break;
+      case Opcode::GREATER_THAN_OR_EQUAL_DECIMAL:
+        result.is_null = left.is_null || right.is_null;
+        result.integer = left.decimal >= right.decimal;
+        break;
+
+      case Opcode::AND: {
+        bool left_false = left.is_null == false && left.integer == 0;
+        bool right_false = right.is_null == false && right.integer == 0;
+        result.is_null =
+            !left_false && !right_false && (left.is_null || right.is_null);
+        result.integer = !left_false && !right_false;
+        break;
+      }
+      case Opcode::OR: {
+        bool left_true = left.is_null == false && left.integer != 0;
+        bool right_true = right.is_null == false && right.integer != 0;
+        result.is_null =
+            !left_true && !right_true && (left.is_null || right.is_null);
+        result.integer = left_true || right_true;
+        break;
+      }
+      case Opcode::NOT:
+        result.is_null = left.is_null;
+        result.integer = left.integer == 0;
+        break;
+
+      case Opcode::AND_SHORT_CIRCUIT:
+        if (left.is_null == false && left.integer == 0) {
+          result.is_null = false;
+          result.integer = 0;
+          pc = begin + instruction.operand;
+          continue;
+        }
+        break;
+      case Opcode::OR_SHORT_CIRCUIT:
+        if (left.is_null == false && left.integer != 0) {
+          result.is_null = false;
+          result.integer = 1;
+          pc = begin + instruction.operand;
+          continue;
+        }
+        break;
+    }
+    pc++;
+  }
+  return true;
+}
+
+type::Value CompiledExpression::GetResult(const Register &reg) const {
+  if (reg.is_null == true) {
+    return type::ValueFactory::GetNullValueByType(result_type_);
+  }
+  switch (result_type_) {
+    case type::Type::BOOLEAN:
+      return type::ValueFactory::GetBooleanValue(reg.integer != 0);
+    case type::Type::TINYINT:
+      return type::ValueFactory::GetTinyIntValue(
+          static_cast<int8_t>(reg.integer));
+    case type::Type::SMALLINT:
+      return type::ValueFactory::GetSmallIntValue(
+          static_cast<int16_t>(reg.integer));
+    case type::Type::INTEGER:
+      return type::ValueFactory::GetIntegerValue(
+          static_cast<int32_t>(reg.integer));
+    case type::Type::BIGINT:
+      return type::ValueFactory::GetBigIntValue(reg.integer);
+    default:
+      return type::ValueFactory::GetDecimalValue(reg.decimal);
+  }
+}
+
+type::Value CompiledExpression::Evaluate(
+    const AbstractTuple *tuple1, const AbstractTuple *tuple2,
+    executor::ExecutorContext *context) const {
+  if (is_compiled_ == true) {
+    Register registers[max_register_count];
+    std::copy(initial_registers_.begin(), initial_registers_.end(), registers);
+    if (Run(instructions_.data(), instructions_.data() + instructions_.size(),
+            registers, tuple1, tuple2) == true) {
+      return GetResult(registers[result_register_]);
+    }
+  }
+  return expression_->Evaluate(tuple1, tuple2, context);
+}
+
+bool CompiledExpression::EvaluatePredicate(
+    const AbstractTuple *tuple1, const AbstractTuple *tuple2,
+    executor::ExecutorContext *context) const {
+  if (is_compiled_ == true && result_type_ == type::Type::BOOLEAN) {
+    Register registers[max_register_count];
+    std::copy(initial_registers_.begin(), initial_registers_.end(), registers);
+    if (Run(instructions_.data(), instructions_.data() + instructions_.size(),
+            registers, tuple1, tuple2) == true) {
+      auto &result = registers[result_register_];
+      return result.is_null == false && result.integer != 0;
+    }
+  }
+  return expression_->Evaluate(tuple1, tuple2, context).IsTrue();
+}
+
+}  // End expression namespace
+}  // End peloton namespace
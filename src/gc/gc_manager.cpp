@@ -37,6 +37,10 @@ void GCManager::CheckAndReclaimVarlenColumns(storage::TileGroup *tg, oid_t tuple
 
           storage::Tile *tile = tg->GetTile(tile_itr);
         PL_ASSERT(tile);
+        // The varlen data of a compressed tile lives in its dictionary
+        if (tile->IsCompressed() == true) {
+          continue;
+        }
         for (oid_t tile_col_itr = 0; tile_col_itr < tile_col_count; ++tile_col_itr) {
             type_id = schema.GetType(tile_col_itr);
 
@@ -0,0 +1,257 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.cpp
+//
+// Identification: src/gc/tile_group_compactor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "gc/tile_group_compactor.h"
+
+#include <algorithm>
+
+#include "catalog/manager.h"
+#include "catalog/schema.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace gc {
+
+TileGroupCompactor &TileGroupCompactor::GetInstance() {
+  static TileGroupCompactor tile_group_compactor;
+  return tile_group_compactor;
+}
+
+TileGroupCompactor::TileGroupCompactor()
+    : compaction_stop_(true), dropped_tile_group_count_(0) {}
+
+TileGroupCompactor::~TileGroupCompactor() {}
+
+void TileGroupCompactor::Start() {
+  // Set signal
+  compaction_stop_ = false;
+
+  // Launch thread
+  compactor_thread_ = std::thread(&gc::TileGroupCompactor::Compact, this);
+
+  LOG_INFO("Started tile group compactor");
+}
+
+void TileGroupCompactor::Stop() {
+  // Stop compacting
+  compaction_stop_ = true;
+
+  // Stop thread
+  compactor_thread_.join();
+
+  LOG_INFO("Stopped tile group compactor");
+}
+
+void TileGroupCompactor::AddTable(storage::DataTable *table) {
+  {
+    std::lock_guard<std::mutex> lock(compactor_mutex_);
+    LOG_TRACE("Tile group compactor adding table : %p", table);
+
+    tables_.push_back(table);
+  }
+}
+
+void TileGroupCompactor::DropTable(const oid_t &table_oid) {
+  {
+    std::lock_guard<std::mutex> lock(compactor_mutex_);
+    tables_.erase(std::remove_if(tables_.begin(), tables_.end(),
+                                 [&table_oid](storage::DataTable *table) {
+                                   return table->GetOid() == table_oid;
+                                 }),
+                  tables_.end());
+  }
+}
+
+void TileGroupCompactor::ClearTables() {
+  {
+    std::lock_guard<std::mutex> lock(compactor_mutex_);
+    tables_.clear();
+  }
+}
+
+void TileGroupCompactor::Compact() {
+  // Continue till signal is not false
+  while (compaction_stop_ == false) {
+    {
+      std::lock_guard<std::mutex> lock(compactor_mutex_);
+      for (auto table : tables_) {
+        CompactTable(table);
+      }
+    }
+
+    // Sleep a bit
+    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_duration_));
+  }
+}
+
+size_t TileGroupCompactor::CompactTable(storage::DataTable *table) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  size_t dropped_count = 0;
+
+  auto tile_group_count = table->GetTileGroupCount();
+  for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    if (tile_group == nullptr) {
+      continue;
+    }
+
+    auto tile_group_id = tile_group->GetTileGroupId();
+    auto tile_group_header = tile_group->GetHeader();
+
+    if (tile_group_header->IsCompacting() == false) {
+      // Leave the tile groups that are still being filled alone
+      if (tile_group_header->GetCurrentNextTupleSlot() <
+          tile_group->GetAllocatedTupleCount()) {
+        continue;
+      }
+
+      if (GetOccupancy(tile_group.get()) >= occupancy_threshold_) {
+        continue;
+      }
+
+      LOG_TRACE("Compacting tile group : %u", tile_group_id);
+      tile_group_header->SetCompacting();
+    }
+
+    // An insert may have grabbed a recycled slot of this tile group right
+    // before it was marked. Such a transaction began no later than the first
+    // transaction that moved tuples out, so wait until that one is no longer
+    // visible to anybody before trusting that the tile group is drained.
+    bool grace_period_over = false;
+    auto entry = compacting_tile_groups_.find(tile_group_id);
+    if (entry != compacting_tile_groups_.end()) {
+      auto max_committed_cid = txn_manager.GetMaxCommittedCid();
+      grace_period_over =
+          (max_committed_cid != MAX_CID && max_committed_cid > entry->second);
+    }
+
+    auto txn = txn_manager.BeginTransaction();
+    compacting_tile_groups_.emplace(tile_group_id, txn->GetBeginCommitId());
+
+    bool all_moved = MoveTuples(table, tile_group.get(), txn);
+    if (txn->GetResult() == ResultType::SUCCESS) {
+      txn_manager.CommitTransaction(txn);
+    } else {
+      txn_manager.AbortTransaction(txn);
+      all_moved = false;
+    }
+
+    // Old versions are still around until the GC reclaims them
+    if (all_moved == false || grace_period_over == false ||
+        IsDrained(tile_group.get()) == false) {
+      continue;
+    }
+
+    if (table->DropTileGroup(tile_group_id) == true) {
+      LOG_TRACE("Dropped compacted tile group : %u", tile_group_id);
+      compacting_tile_groups_.erase(tile_group_id);
+      dropped_count++;
+    }
+  }
+
+  dropped_tile_group_count_ += dropped_count;
+  return dropped_count;
+}
+
+double TileGroupCompactor::GetOccupancy(storage::TileGroup *tile_group) {
+  auto tile_group_header = tile_group->GetHeader();
+  auto allocated_tuple_count = tile_group->GetAllocatedTupleCount();
+  if (allocated_tuple_count == 0) {
+    return 1.0;
+  }
+
+  oid_t live_tuple_count = 0;
+  for (oid_t tuple_id = 0; tuple_id < allocated_tuple_count; tuple_id++) {
+    if (tile_group_header->GetTransactionId(tuple_id) != INVALID_TXN_ID &&
+        tile_group_header->GetEndCommitId(tuple_id) == MAX_CID) {
+      live_tuple_count++;
+    }
+  }
+
+  return static_cast<double>(live_tuple_count) / allocated_tuple_count;
+}
+
+bool TileGroupCompactor::MoveTuples(storage::DataTable *table,
+                                    storage::TileGroup *tile_group,
+                                    concurrency::Transaction *txn) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto tile_group_header = tile_group->GetHeader();
+  auto column_count = table->GetSchema()->GetColumnCount();
+  auto next_tuple_slot = tile_group_header->GetCurrentNextTupleSlot();
+  bool all_moved = true;
+
+  for (oid_t tuple_id = 0; tuple_id < next_tuple_slot; tuple_id++) {
+    auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    if (tuple_txn_id == INVALID_TXN_ID) {
+      continue;
+    }
+
+    // Older versions and deleted tuples are left to the GC
+    if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+      continue;
+    }
+
+    // Tuples that are being inserted or updated are moved in a later pass
+    if (txn_manager.IsVisible(txn, tile_group_header, tuple_id) !=
+            VisibilityType::OK ||
+        txn_manager.IsOwnable(txn, tile_group_header, tuple_id) == false ||
+        txn_manager.AcquireOwnership(txn, tile_group_header, tuple_id) ==
+            false) {
+      all_moved = false;
+      continue;
+    }
+
+    // The free slots of this tile group are no longer handed out, so the new
+    // version always ends up in another tile group
+    ItemPointer old_location(tile_group_id, tuple_id);
+    ItemPointer new_location = table->AcquireVersion();
+    if (new_location.IsNull() == true) {
+      txn_manager.YieldOwnership(txn, tile_group_id, tuple_id);
+      txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+      return false;
+    }
+
+    auto new_tile_group = manager.GetTileGroup(new_location.block);
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      auto value = tile_group->GetValue(tuple_id, column_itr);
+      new_tile_group->SetValue(value, new_location.offset, column_itr);
+    }
+
+    txn_manager.PerformUpdate(txn, old_location, new_location);
+  }
+
+  return all_moved;
+}
+
+bool TileGroupCompactor::IsDrained(storage::TileGroup *tile_group) {
+  auto tile_group_header = tile_group->GetHeader();
+  auto next_tuple_slot = tile_group_header->GetCurrentNextTupleSlot();
+
+  for (oid_t tuple_id = 0; tuple_id < next_tuple_slot; tuple_id++) {
+    if (tile_group_header->GetTransactionId(tuple_id) != INVALID_TXN_ID) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // End gc namespace
+}  // End peloton namespace
@@ -14,6 +14,7 @@
 #include "storage/tuple.h"
 #include "storage/database.h"
 #include "storage/tile_group.h"
+#include "storage/undo_buffer.h"
 #include "catalog/manager.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "common/container_tuple.h"
@@ -24,7 +25,7 @@ namespace gc {
 
 bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group = manager.GetTileGroup(location.block).get();
+  auto tile_group = manager.GetTileGroup(location.block);
 
   auto tile_group_header = tile_group->GetHeader();
 
@@ -34,13 +35,14 @@ bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
   tile_group_header->SetEndCommitId(location.offset, MAX_CID);
   tile_group_header->SetPrevItemPointer(location.offset, INVALID_ITEMPOINTER);
   tile_group_header->SetNextItemPointer(location.offset, INVALID_ITEMPOINTER);
+  storage::UndoBuffer::Unlink(tile_group_header, location.offset);
 
   PL_MEMSET(
     tile_group_header->GetReservedFieldRef(location.offset), 0,
     storage::TileGroupHeader::GetReservedSize());
 
   // Reclaim the varlen pool
-  CheckAndReclaimVarlenColumns(tile_group, location.offset);
+  CheckAndReclaimVarlenColumns(tile_group.get(), location.offset);
 
   LOG_TRACE("Garbage tuple(%u, %u) is reset", location.block, location.offset);
   return true;
@@ -220,7 +222,19 @@ ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
   PL_ASSERT(recycle_queue_map_.find(table_id) != recycle_queue_map_.end());
   auto recycle_queue = recycle_queue_map_[table_id];
 
-  if (recycle_queue->Dequeue(location) == true) {
+  auto &manager = catalog::Manager::GetInstance();
+  while (recycle_queue->Dequeue(location) == true) {
+    // Slots of tile groups that are being compacted (or have already been
+    // dropped) must not be reused, otherwise the tile group never drains.
+    // Frozen tile groups are read-only.
+    auto tile_group = manager.GetTileGroup(location.block);
+    if (tile_group == nullptr || tile_group->GetHeader()->IsCompacting() ||
+        tile_group->GetHeader()->IsFrozen()) {
+      LOG_TRACE("Skip tuple(%u, %u) of compacted or frozen tile group",
+                location.block, location.offset);
+      continue;
+    }
+
     LOG_TRACE("Reuse tuple(%u, %u) in table %u", location.block,
               location.offset, table_id);
     return location;
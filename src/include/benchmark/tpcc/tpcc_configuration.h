@@ -158,6 +158,12 @@ class configuration {
   // epoch type
   EpochType epoch;
 
+  // concurrency control protocol
+  ConcurrencyType protocol;
+
+  // wait for the owner of a tuple instead of aborting
+  bool wait_on_conflict;
+
   // scale factor
   double scale_factor;
 
@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <map>
+#include <mutex>
+
 #include "catalog/catalog_util.h"
 #include "catalog/schema.h"
 #include "type/types.h"
@@ -31,6 +34,7 @@
 #define TABLE_METRIC_NAME "table_metric"
 #define INDEX_METRIC_NAME "index_metric"
 #define QUERY_METRIC_NAME "query_metric"
+#define PHASE_METRIC_NAME "phase_metric"
 
 #define QUERY_NUM_PARAM_COL_NAME "num_params"
 #define QUERY_PARAM_TYPE_COL_NAME "param_types"
@@ -47,6 +51,10 @@ namespace storage {
 class DataTable;
 }
 
+namespace optimizer {
+class TableStats;
+}
+
 namespace catalog {
 
 //===--------------------------------------------------------------------===//
@@ -161,6 +169,9 @@ class Catalog {
   // Initialize the schema of the query metrics table
   std::unique_ptr<catalog::Schema> InitializeQueryMetricsSchema();
 
+  // Initialize the schema of the phase metrics table
+  std::unique_ptr<catalog::Schema> InitializePhaseMetricsSchema();
+
   // Get table from a database with its name
   storage::DataTable *GetTableWithName(std::string database_name,
                                        std::string table_name);
@@ -193,6 +204,18 @@ class Catalog {
 
   void RemoveFunction(const std::string &name);
 
+  //===--------------------------------------------------------------------===//
+  // TABLE STATS
+  //===--------------------------------------------------------------------===//
+
+  // Replace the stats of a table collected by ANALYZE
+  void SetTableStats(const oid_t database_oid, const oid_t table_oid,
+                     std::shared_ptr<optimizer::TableStats> table_stats);
+
+  // Returns nullptr if the table has not been analyzed
+  std::shared_ptr<optimizer::TableStats> GetTableStats(
+      const oid_t database_oid, const oid_t table_oid) const;
+
   // Deconstruct the catalog database when destroy the catalog.
   ~Catalog();
 
@@ -201,6 +224,9 @@ class Catalog {
                                          std::string &database_name,
                                          concurrency::Transaction *txn);
 
+  // Forget the stats of all the tables of a dropped database
+  void DropDatabaseStats(const oid_t database_oid);
+
   // A vector of the database pointers in the catalog
   std::vector<storage::Database *> databases_;
 
@@ -216,6 +242,12 @@ class Catalog {
   // function ptr, return type)
   std::unordered_map<std::string, FunctionData> functions_;
 
+  // Stats of the analyzed tables, keyed by the database and table oids
+  std::map<std::pair<oid_t, oid_t>, std::shared_ptr<optimizer::TableStats>>
+      table_stats_;
+
+  mutable std::mutex table_stats_mutex_;
+
  public:
 
   // The pool for new varlen tuple fields
@@ -17,6 +17,7 @@
 #include "executor/executor_context.h"
 #include "executor/insert_executor.h"
 #include "planner/insert_plan.h"
+#include "statistics/latency_metric.h"
 #include "storage/data_table.h"
 #include "storage/data_table.h"
 #include "storage/database.h"
@@ -76,5 +77,10 @@ std::unique_ptr<storage::Tuple> GetQueryMetricsCatalogTuple(
     stats::QueryMetric::QueryParamBuf val_buf, int64_t reads, int64_t updates,
     int64_t deletes, int64_t inserts, int64_t latency, int64_t cpu_time,
     int64_t time_stamp, type::AbstractPool *pool);
+
+std::unique_ptr<storage::Tuple> GetPhaseMetricsCatalogTuple(
+    const catalog::Schema *schema, StatementType statement_type,
+    QueryPhaseType phase, const stats::LatencyMeasurements &measurements,
+    int64_t time_stamp, type::AbstractPool *pool);
 }
 }
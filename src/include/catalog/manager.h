@@ -60,8 +60,12 @@ class Manager {
 
   void DropTileGroup(const oid_t oid);
 
+  // Faults the tile group back in if it was evicted by the anti-cache
   std::shared_ptr<storage::TileGroup> GetTileGroup(const oid_t oid);
 
+  // Neither records the access nor faults the tile group back in
+  std::shared_ptr<storage::TileGroup> GetResidentTileGroup(const oid_t oid);
+
   void ClearTileGroup(void);
 
 
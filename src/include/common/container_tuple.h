@@ -270,6 +270,24 @@ class ContainerTuple<storage::TileGroup> : public AbstractTuple {
     return nullptr;
   }
 
+  /** @brief Compute the hash value based on all valid columns and a given seed.
+   */
+  size_t HashCode(size_t seed = 0) const {
+    if (column_ids_) {
+      for (auto &column_itr : *column_ids_) {
+        type::Value value = GetValue(column_itr);
+        value.HashCombine(seed);
+      }
+    } else {
+      oid_t column_count = container_->GetColumnMap().size();
+      for (size_t column_itr = 0; column_itr < column_count; column_itr++) {
+        type::Value value = GetValue(column_itr);
+        value.HashCombine(seed);
+      }
+    }
+    return seed;
+  }
+
   // Get a string representation for debugging
   const std::string GetInfo() const {
     std::stringstream os;
@@ -47,6 +47,13 @@ namespace peloton {
 #define PL_MEMSET memset
 #endif
 
+//===--------------------------------------------------------------------===//
+// prefetch
+//===--------------------------------------------------------------------===//
+
+// Hint that the cache line holding addr will be read soon
+#define PL_PREFETCH(addr) __builtin_prefetch(addr)
+
 //===--------------------------------------------------------------------===//
 // packed
 //===--------------------------------------------------------------------===//
@@ -59,6 +59,13 @@ class Statement : public Printable {
 
   std::string GetQueryType() const;
 
+  // type of the parsed statement, INVALID until it is parsed
+  inline StatementType GetStatementType() const { return (statement_type_); }
+
+  inline void SetStatementType(StatementType statement_type) {
+    statement_type_ = statement_type;
+  }
+
   void SetParamTypes(const std::vector<int32_t>& param_types);
 
   std::vector<int32_t> GetParamTypes() const;
@@ -77,6 +84,17 @@ class Statement : public Printable {
 
   inline void SetNeedsPlan(bool replan) { needs_replan_ = replan; }
 
+  // EXPLAIN returns the plan tree instead of running it, and EXPLAIN ANALYZE
+  // runs it and returns the plan tree with its runtime statistics
+  inline bool IsExplain() const { return (explain_); }
+
+  inline bool IsExplainAnalyze() const { return (explain_analyze_); }
+
+  inline void SetExplain(bool analyze) {
+    explain_ = true;
+    explain_analyze_ = analyze;
+  }
+
   // Get a string representation for debugging
   const std::string GetInfo() const;
 
@@ -90,6 +108,9 @@ class Statement : public Printable {
   // first token in query
   std::string query_type_;
 
+  // type of the parsed statement
+  StatementType statement_type_ = StatementType::INVALID;
+
   // format codes of the parameters
   std::vector<int32_t> param_types_;
 
@@ -105,6 +126,10 @@ class Statement : public Printable {
 
   // If this flag is true, then somebody wants us to replan this query
   bool needs_replan_ = false;
+
+  // Whether this is an EXPLAIN [ANALYZE] of the planned statement
+  bool explain_ = false;
+  bool explain_analyze_ = false;
 };
 
 }  // namespace peloton
@@ -99,6 +99,12 @@ public:
     return (max_committed_eid << 32) | 0xFFFFFFFF;
   }
 
+  virtual cid_t GetCommitId() override {
+    uint64_t epoch_id = GetCurrentGlobalEpoch();
+    uint32_t next_txn_id = GetNextTransactionId();
+    return (epoch_id << 32) | next_txn_id;
+  }
+
   virtual uint64_t GetMaxCommittedEpochId() override;
 
 private:
@@ -51,6 +51,10 @@ public:
 
   virtual cid_t GetMaxCommittedCid() = 0;
 
+  // a fresh commit id, drawn from the same sequence as the begin ids handed
+  // out by EnterEpoch().
+  virtual cid_t GetCommitId() = 0;
+
   virtual uint64_t GetMaxCommittedEpochId() = 0;
 
 };
@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.h
+//
+// Identification: src/include/concurrency/optimistic_transaction_manager.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "concurrency/timestamp_ordering_transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// optimistic multi-version concurrency control
+//===--------------------------------------------------------------------===//
+
+// Unlike timestamp ordering, a read leaves the tuple header alone: the
+// transaction only records the version it has read, and at commit time it
+// checks that none of these versions has been replaced by a transaction that
+// committed in the meantime. Writers still take the ownership of a tuple, so
+// write-write conflicts are detected as early as under timestamp ordering.
+class OptimisticTransactionManager
+    : public TimestampOrderingTransactionManager {
+ public:
+  OptimisticTransactionManager() {}
+
+  virtual ~OptimisticTransactionManager() {}
+
+  static OptimisticTransactionManager &GetInstance();
+
+  virtual bool IsOwnable(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool AcquireOwnership(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool PerformRead(Transaction *const current_txn,
+                           const ItemPointer &location,
+                           bool acquire_ownership = false);
+
+  virtual ResultType CommitTransaction(Transaction *const current_txn);
+
+ private:
+  // Check that every version in the read set is still the latest one as of
+  // the end commit id.
+  bool ValidateReadSet(Transaction *const current_txn,
+                       const cid_t end_commit_id);
+};
+}
+}
@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// partitioned_transaction_manager.h
+//
+// Identification: src/include/concurrency/partitioned_transaction_manager.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <shared_mutex>
+
+#include "concurrency/timestamp_ordering_transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// partitioned execution
+//===--------------------------------------------------------------------===//
+
+// the data is split into partitions by the partition column of each table.
+// a transaction that only touches one partition holds that partition for its
+// whole lifetime, so it runs alone on it: it takes the ownership of a tuple
+// of that partition without a CAS and leaves no last reader mark. the tuples
+// of the other partitions and of the tables without a partition column go
+// through timestamp ordering, as several single-partition transactions may
+// get at them at once. any other transaction is a multi-partition one. it
+// holds all the partitions in shared mode, which keeps the single-partition
+// transactions out, and runs under timestamp ordering with the other
+// multi-partition transactions.
+//
+// a single-partition transaction may read anything and write the tables
+// without a partition column, but it must only update or delete tuples of
+// its own partition in the partitioned tables.
+class PartitionedTransactionManager
+    : public TimestampOrderingTransactionManager {
+ public:
+  PartitionedTransactionManager();
+
+  virtual ~PartitionedTransactionManager() {}
+
+  static PartitionedTransactionManager &GetInstance();
+
+  // must be set while no transaction is running
+  void SetPartitionCount(const size_t partition_count);
+
+  size_t GetPartitionCount() const { return partition_count_; }
+
+  // the partition that a value of a partition column belongs to
+  oid_t GetPartitionId(const type::Value &partition_key) const;
+
+  virtual bool IsOwnable(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool AcquireOwnership(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual void PerformInsert(Transaction *const current_txn,
+                             const ItemPointer &location,
+                             ItemPointer *index_entry_ptr = nullptr);
+
+  virtual bool PerformRead(Transaction *const current_txn,
+                           const ItemPointer &location,
+                           bool acquire_ownership = false);
+
+  virtual void PerformUpdate(Transaction *const current_txn,
+                             const ItemPointer &old_location,
+                             const ItemPointer &new_location);
+
+  virtual void PerformDelete(Transaction *const current_txn,
+                             const ItemPointer &old_location,
+                             const ItemPointer &new_location);
+
+  using TimestampOrderingTransactionManager::PerformUpdate;
+
+  using TimestampOrderingTransactionManager::PerformDelete;
+
+  virtual Transaction *BeginTransaction(const size_t thread_id = 0);
+
+  virtual Transaction *BeginSinglePartitionTransaction(
+      const type::Value &partition_key, const size_t thread_id = 0);
+
+  virtual void EndTransaction(Transaction *current_txn);
+
+ private:
+  // whether a single-partition transaction may write a tuple, i.e. the tuple
+  // lies in its partition or in a table without a partition column
+  bool IsInPartition(Transaction *const current_txn,
+                     const ItemPointer &location);
+
+  // whether a single-partition transaction holds the tuple's partition, so
+  // that it can skip the timestamp ordering bookkeeping
+  bool IsInOwnPartition(Transaction *const current_txn,
+                        const ItemPointer &location);
+
+  bool IsInOwnPartition(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  // the partition of a tuple, or INVALID_OID if its table is not partitioned
+  oid_t GetTuplePartitionId(const ItemPointer &location) const;
+
+  size_t partition_count_;
+
+  std::unique_ptr<std::shared_timed_mutex[]> partition_latches_;
+};
+}
+}
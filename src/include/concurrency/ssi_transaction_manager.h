@@ -0,0 +1,127 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// ssi_transaction_manager.h
+//
+// Identification: src/include/concurrency/ssi_transaction_manager.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "concurrency/optimistic_transaction_manager.h"
+#include "container/cuckoo_map.h"
+
+namespace peloton {
+namespace concurrency {
+
+enum class SsiTxnState { RUNNING, COMMITTED, ABORTED };
+
+// What SSI remembers about a transaction. It outlives the transaction until
+// no concurrent transaction is left.
+struct SsiTxnContext {
+  SsiTxnContext(const cid_t begin_cid) : begin_cid(begin_cid) {}
+
+  const cid_t begin_cid;
+
+  cid_t commit_cid = MAX_CID;
+
+  SsiTxnState state = SsiTxnState::RUNNING;
+
+  // a concurrent transaction has read a version that this one replaces
+  bool in_conflict = false;
+
+  // this transaction has read a version that a concurrent one replaces
+  bool out_conflict = false;
+
+  // the tuples this transaction holds SIREAD locks on
+  std::vector<ItemPointer> read_set;
+
+  // protects the state and the conflict flags
+  Spinlock lock;
+};
+
+//===--------------------------------------------------------------------===//
+// serializable snapshot isolation
+//===--------------------------------------------------------------------===//
+
+// Transactions read their snapshot and install their writes with a commit id,
+// like under the optimistic manager, but the read set is not validated.
+// Instead every read leaves a SIREAD lock, and the rw-antidependencies between
+// concurrent transactions are tracked as they appear. A transaction is only
+// aborted when it would become the pivot of a dangerous structure, i.e. it
+// has both an incoming and an outgoing rw-antidependency.
+class SsiTransactionManager : public OptimisticTransactionManager {
+  typedef std::shared_ptr<SsiTxnContext> ContextPtr;
+
+ public:
+  SsiTransactionManager() {}
+
+  virtual ~SsiTransactionManager() {}
+
+  static SsiTransactionManager &GetInstance();
+
+  virtual Transaction *BeginTransaction(const size_t thread_id = 0);
+
+  virtual void EndTransaction(Transaction *current_txn);
+
+  virtual bool AcquireOwnership(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool PerformRead(Transaction *const current_txn,
+                           const ItemPointer &location,
+                           bool acquire_ownership = false);
+
+  virtual ResultType CommitTransaction(Transaction *const current_txn);
+
+ private:
+  // Find the context by begin commit id, or by the commit id once committed
+  ContextPtr GetContext(const cid_t cid);
+
+  // Record a rw-antidependency between the current transaction and another
+  // one. Returns false if the current transaction has to abort.
+  bool AddConflict(const ContextPtr &current, const ContextPtr &other,
+                   const bool current_is_reader);
+
+  void AddReader(const ItemPointer &location, const ContextPtr &reader);
+
+  std::vector<cid_t> GetReaders(const ItemPointer &location);
+
+  void RemoveReader(const ItemPointer &location, const cid_t reader_cid);
+
+  // Release the SIREAD locks and forget the context
+  void ReleaseContext(const ContextPtr &context);
+
+  // Release the committed contexts that no running transaction overlaps
+  void RetireContexts();
+
+  static const size_t SIREAD_PARTITION_COUNT = 256;
+
+  static const size_t RETIRE_THRESHOLD = 128;
+
+  // SIREAD locks: the readers of each tuple, keyed by its location
+  struct SireadPartition {
+    Spinlock lock;
+    std::unordered_map<uint64_t, std::vector<cid_t>> readers;
+  };
+
+  SireadPartition siread_partitions_[SIREAD_PARTITION_COUNT];
+
+  CuckooMap<cid_t, ContextPtr> txn_table_;
+
+  // committed contexts, waiting for their concurrent transactions to finish
+  Spinlock finished_lock_;
+  std::deque<ContextPtr> finished_contexts_;
+};
+}
+}
@@ -96,6 +96,15 @@ class TimestampOrderingTransactionManager : public TransactionManager {
   virtual void PerformDelete(Transaction *const current_txn,
                              const ItemPointer &location);
 
+  virtual void PerformInPlaceUpdate(Transaction *const current_txn,
+                                    const ItemPointer &location,
+                                    const std::vector<oid_t> &column_ids);
+
+  virtual VisibilityType ReadVersion(Transaction *const current_txn,
+                                     storage::TileGroup *tile_group,
+                                     const oid_t &tuple_id,
+                                     std::vector<type::Value> &values);
+
   virtual ResultType CommitTransaction(Transaction *const current_txn);
 
   virtual ResultType AbortTransaction(Transaction *const current_txn);
@@ -108,7 +117,35 @@ class TimestampOrderingTransactionManager : public TransactionManager {
 
   virtual void EndReadonlyTransaction(Transaction *current_txn);
 
-private:
+protected:
+  // Install the write set with the given end commit id and end the txn.
+  ResultType InstallTransaction(Transaction *const current_txn,
+                                const cid_t end_commit_id);
+
+  // Whether an undo record of the tuple leads back to a version that is
+  // visible to the txn (see FLAGS_delta_versions).
+  bool IsUndoVisible(Transaction *const current_txn,
+                     const storage::TileGroupHeader *const tile_group_header,
+                     const oid_t &tuple_id);
+
+  // Write back the values that the txn overwrote in place, and leave an
+  // empty version in its undo record.
+  void RevertInPlaceUpdate(Transaction *const current_txn,
+                           storage::TileGroup *tile_group,
+                           const oid_t &tuple_id);
+
+  // Wait for the owner of the tuple to release it, under the WAIT conflict
+  // avoidance. Returns true if the tuple is not owned by another txn anymore.
+  bool WaitForOwner(Transaction *const current_txn,
+                    const storage::TileGroupHeader *const tile_group_header,
+                    const oid_t &tuple_id);
+
+  // Rounds of busy waiting before the waiter starts to yield its core
+  static const size_t CONFLICT_SPIN_ROUNDS = 128;
+
+  // How long a transaction waits for an owner at most (in microseconds)
+  static const size_t CONFLICT_WAIT_TIMEOUT = 1000;
+
   static const int LOCK_OFFSET = 0;
   static const int LAST_READER_OFFSET = (LOCK_OFFSET + 8);
 
@@ -24,6 +24,11 @@
 #include "type/types.h"
 
 namespace peloton {
+
+namespace storage {
+class TileGroupHeader;
+}
+
 namespace concurrency {
 
 //===--------------------------------------------------------------------===//
@@ -55,6 +60,9 @@ class Transaction : public Printable {
     declared_readonly_ = readonly;
 
     end_cid_ = MAX_CID;
+    partition_id_ = INVALID_OID;
+    abort_cause_ = AbortCauseType::INVALID;
+    abort_table_id_ = INVALID_OID;
     is_written_ = false;
     insert_count_ = 0;
     gc_set_.reset(new GCSet());
@@ -76,6 +84,17 @@ class Transaction : public Printable {
 
   inline void SetEndCommitId(cid_t eid) { end_cid_ = eid; }
 
+  // the only partition a single-partition transaction may touch
+  inline oid_t GetPartitionId() const { return partition_id_; }
+
+  inline void SetPartitionId(const oid_t partition_id) {
+    partition_id_ = partition_id;
+  }
+
+  inline bool IsSinglePartition() const {
+    return partition_id_ != INVALID_OID;
+  }
+
   void RecordRead(const ItemPointer &);
 
   void RecordReadOwn(const ItemPointer &);
@@ -106,6 +125,32 @@ class Transaction : public Printable {
   // Get result and status
   inline ResultType GetResult() const { return result_; }
 
+  // Remember why the transaction has to abort. Only the first conflict is
+  // kept, the later ones are usually a consequence of it.
+  inline void SetAbortCause(const AbortCauseType cause, const oid_t table_id,
+                            const ItemPointer &location) {
+    if (abort_cause_ != AbortCauseType::INVALID) {
+      return;
+    }
+    abort_cause_ = cause;
+    abort_table_id_ = table_id;
+    abort_location_ = location;
+  }
+
+  // Same, for a conflict on the given tuple
+  void SetAbortCause(const AbortCauseType cause,
+                     const storage::TileGroupHeader *const tile_group_header,
+                     const oid_t tuple_id);
+
+  inline AbortCauseType GetAbortCause() const { return abort_cause_; }
+
+  inline oid_t GetAbortTableId() const { return abort_table_id_; }
+
+  // the tuple the conflict happened on, INVALID_ITEMPOINTER if unknown
+  inline const ItemPointer &GetAbortLocation() const {
+    return abort_location_;
+  }
+
   inline bool IsReadOnly() const {
     return is_written_ == false && insert_count_ == 0;
   }
@@ -130,6 +175,9 @@ class Transaction : public Printable {
   // end commit id
   cid_t end_cid_;
 
+  // partition of a single-partition transaction
+  oid_t partition_id_;
+
   ReadWriteSet rw_set_;
 
   // this set contains data location that needs to be gc'd in the transaction.
@@ -138,6 +186,11 @@ class Transaction : public Printable {
   // result of the transaction
   ResultType result_ = peloton::ResultType::SUCCESS;
 
+  // first conflict that made the transaction abort
+  AbortCauseType abort_cause_;
+  oid_t abort_table_id_;
+  ItemPointer abort_location_;
+
   bool is_written_;
   size_t insert_count_;
 
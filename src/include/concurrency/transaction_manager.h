@@ -17,11 +17,13 @@
 #include <unordered_map>
 #include <list>
 #include <utility>
+#include <vector>
 
 #include "storage/tile_group_header.h"
 #include "concurrency/transaction.h"
 #include "concurrency/epoch_manager_factory.h"
 #include "common/logger.h"
+#include "type/value.h"
 
 namespace peloton {
 
@@ -29,6 +31,7 @@ class ItemPointer;
 
 namespace storage {
 class DataTable;
+class TileGroup;
 class TileGroupHeader;
 }
 
@@ -123,6 +126,20 @@ class TransactionManager {
   virtual void PerformDelete(Transaction *const current_txn, 
                              const ItemPointer &location) = 0;
 
+  // Keep the current values of the given columns of an owned tuple in an
+  // undo record, before the caller overwrites them in the tuple slot.
+  virtual void PerformInPlaceUpdate(Transaction *const current_txn,
+                                    const ItemPointer &location,
+                                    const std::vector<oid_t> &column_ids) = 0;
+
+  // Copy the values of the version of a tuple that is visible to the
+  // transaction, rebuilding it from the undo records of the tuple if the
+  // tuple has been updated in place since.
+  virtual VisibilityType ReadVersion(Transaction *const current_txn,
+                                     storage::TileGroup *tile_group,
+                                     const oid_t &tuple_id,
+                                     std::vector<type::Value> &values) = 0;
+
   void SetTransactionResult(Transaction *const current_txn, const ResultType result) {
     current_txn->SetResult(result);
   }
@@ -136,6 +153,14 @@ class TransactionManager {
 
   virtual Transaction *BeginReadonlyTransaction(const size_t thread_id = 0) = 0;
 
+  // Begin a transaction that only touches the partition of the given key.
+  // Protocols without partitioned execution run it like any other one.
+  virtual Transaction *BeginSinglePartitionTransaction(
+      UNUSED_ATTRIBUTE const type::Value &partition_key,
+      const size_t thread_id = 0) {
+    return BeginTransaction(thread_id);
+  }
+
   virtual void EndTransaction(Transaction *current_txn) = 0;
 
   virtual void EndReadonlyTransaction(Transaction *current_txn) = 0;
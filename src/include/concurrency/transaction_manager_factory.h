@@ -13,7 +13,11 @@
 
 #pragma once
 
+#include "concurrency/optimistic_transaction_manager.h"
+#include "concurrency/partitioned_transaction_manager.h"
+#include "concurrency/ssi_transaction_manager.h"
 #include "concurrency/timestamp_ordering_transaction_manager.h"
+#include "configuration/configuration.h"
 
 namespace peloton {
 namespace concurrency {
@@ -25,24 +29,48 @@ class TransactionManagerFactory {
       case ConcurrencyType::TIMESTAMP_ORDERING:
         return TimestampOrderingTransactionManager::GetInstance();
 
+      case ConcurrencyType::OPTIMISTIC:
+        return OptimisticTransactionManager::GetInstance();
+
+      case ConcurrencyType::SSI:
+        return SsiTransactionManager::GetInstance();
+
+      case ConcurrencyType::PARTITIONED:
+        return PartitionedTransactionManager::GetInstance();
+
       default:
         return TimestampOrderingTransactionManager::GetInstance();
     }
   }
 
-  static void Configure(ConcurrencyType protocol,
-                        IsolationLevelType level = IsolationLevelType::FULL) {
+  static void Configure(
+      ConcurrencyType protocol,
+      IsolationLevelType level = IsolationLevelType::FULL,
+      ConflictAvoidanceType conflict = ConflictAvoidanceType::ABORT) {
     protocol_ = protocol;
     isolation_level_ = level;
+    conflict_avoidance_ = conflict;
   }
 
   static ConcurrencyType GetProtocol() { return protocol_; }
 
   static IsolationLevelType GetIsolationLevel() { return isolation_level_; }
 
+  static ConflictAvoidanceType GetConflictAvoidance() {
+    return conflict_avoidance_;
+  }
+
+  // Whether updates overwrite tuples in place (see FLAGS_delta_versions),
+  // which only the timestamp ordering protocol supports
+  static bool IsDeltaVersioning() {
+    return FLAGS_delta_versions == true &&
+           protocol_ == ConcurrencyType::TIMESTAMP_ORDERING;
+  }
+
  private:
   static ConcurrencyType protocol_;
   static IsolationLevelType isolation_level_;
+  static ConflictAvoidanceType conflict_avoidance_;
 };
 }
 }
\ No newline at end of file
@@ -35,6 +35,33 @@ DECLARE_string(socket_family);
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
 
+// Allocate in-memory tile groups from huge page backed regions
+DECLARE_bool(tile_huge_pages);
+
+// Bind tile groups to the NUMA node of the threads inserting into them
+DECLARE_bool(tile_numa_binding);
+
+// Move tuples out of sparsely populated tile groups and drop them
+DECLARE_bool(tile_group_compaction);
+
+// Occupancy below which a tile group gets compacted
+DECLARE_double(tile_group_compaction_threshold);
+
+// Evict cold tile groups to a file on secondary storage
+DECLARE_bool(anti_caching);
+
+// File that evicted tile groups are written to
+DECLARE_string(anti_caching_file);
+
+// Number of eviction passes a tile group must stay untouched to be evicted
+DECLARE_uint64(anti_caching_cold_passes);
+
+// Compress full tile groups once every tuple in them is visible to everyone
+DECLARE_bool(tile_group_freezing);
+
+// Update tuples in place and keep their older versions as column deltas
+DECLARE_bool(delta_versions);
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
@@ -57,6 +84,9 @@ DECLARE_bool(display_configuration);
 // Enable or disable statistics collection
 DECLARE_uint64(stats_mode);
 
+// Port to serve the statistics on over HTTP, 0 to not serve them
+DECLARE_uint64(stats_port);
+
 //===----------------------------------------------------------------------===//
 // AI
 //===----------------------------------------------------------------------===//
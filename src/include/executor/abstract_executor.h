@@ -31,6 +31,32 @@ class ExecutorContext;
 
 namespace executor {
 
+/**
+ * Runtime statistics of an executor for EXPLAIN ANALYZE. The time and the
+ * produced tiles are only measured when the executor tree is profiled, the
+ * executors keep the other counters themselves.
+ */
+struct ExecutorStats {
+  // Number of calls to Execute()
+  size_t execute_count = 0;
+
+  // Wall time spent in Execute() (in ms), including the children
+  double time_ms = 0;
+
+  // Tiles and tuples produced
+  size_t tile_count = 0;
+  size_t tuple_count = 0;
+
+  // Tuples read but dropped by a predicate or a visibility check
+  size_t filtered_count = 0;
+
+  // Number of index lookups
+  size_t index_probe_count = 0;
+
+  // Bytes held by the buffers of the executor
+  size_t memory_bytes = 0;
+};
+
 class AbstractExecutor {
  public:
   AbstractExecutor(const AbstractExecutor &) = delete;
@@ -80,6 +106,15 @@ class AbstractExecutor {
   // Used to reset the state. For now it's overloaded by index scan executor
   virtual void ResetState() {}
 
+  //===--------------------------------------------------------------------===//
+  // Profiling
+  //===--------------------------------------------------------------------===//
+
+  // Measure every call to Execute() of this executor and its children
+  void EnableProfiling();
+
+  const ExecutorStats &GetStats() const { return stats_; }
+
  protected:
   // NOTE: The reason why we keep the plan node separate from the executor
   // context is because we might want to reuse the plan multiple times
@@ -111,6 +146,9 @@ class AbstractExecutor {
   /** @brief Children nodes of this executor in the executor tree. */
   std::vector<AbstractExecutor *> children_;
 
+  /** @brief Runtime statistics, reported by EXPLAIN ANALYZE. */
+  ExecutorStats stats_;
+
  private:
   // Output logical tile
   // This is where we will write the results of the plan node's execution
@@ -119,6 +157,9 @@ class AbstractExecutor {
   /** @brief Plan node corresponding to this executor. */
   const planner::AbstractPlan *node_ = nullptr;
 
+  /** @brief Whether Execute() fills in the runtime statistics. */
+  bool profiling_ = false;
+
  protected:
   // Executor context
   ExecutorContext *executor_context_ = nullptr;
@@ -14,6 +14,7 @@
 
 #include "catalog/schema.h"
 #include "executor/abstract_executor.h"
+#include "expression/compiled_expression.h"
 #include "planner/project_info.h"
 
 #include <vector>
@@ -171,6 +172,9 @@ class AbstractJoinExecutor : public AbstractExecutor {
   /** @brief Join predicate. */
   const expression::AbstractExpression *predicate_ = nullptr;
 
+  /** @brief Join predicate compiled into bytecode. */
+  std::unique_ptr<expression::CompiledExpression> compiled_predicate_;
+
   /** @brief Projection info */
   const planner::ProjectInfo *proj_info_ = nullptr;
 
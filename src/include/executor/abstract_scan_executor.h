@@ -12,13 +12,28 @@
 
 #pragma once
 
+#include <memory>
+
+#include "expression/compiled_expression.h"
 #include "planner/abstract_scan_plan.h"
 #include "type/types.h"
 #include "executor/abstract_executor.h"
 
 namespace peloton {
+
+namespace catalog {
+class Schema;
+}
+
+namespace storage {
+class TileGroup;
+}
+
 namespace executor {
 
+class JoinBloomFilter;
+class LogicalTile;
+
 /**
  * Super class for different kinds of scan executor.
  * It provides common codes for all kinds of scan:
@@ -41,11 +56,48 @@ class AbstractScanExecutor : public AbstractExecutor {
 
   virtual void ResetState() {}
 
+  // Only produce the tuples whose join key may be in the bloom filter. The
+  // key columns are offsets into the output columns of the scan.
+  void SetBloomFilter(const JoinBloomFilter *bloom_filter,
+                      const std::vector<oid_t> &key_column_offsets);
+
+  // Produce copies of the visible versions instead of positions in the tile
+  // groups, which only the executors that write through the positions need
+  // to turn off (see FLAGS_delta_versions)
+  void SetCopyVersions(bool copy_versions) { copy_versions_ = copy_versions; }
+
  protected:
   bool DInit();
 
   virtual bool DExecute() = 0;
 
+  // A term of the predicate of the form "column <cmp> constant"
+  struct ColumnPredicate {
+    oid_t column_id;
+    ExpressionType comparison_type;
+    const expression::AbstractExpression *value;
+  };
+
+  // Collect the terms of a conjunctive predicate that only compare a column
+  // with a constant. Returns false if some term was left out.
+  bool ExtractColumnPredicates(const expression::AbstractExpression *predicate);
+
+  // Whether the zone map of the tile group rules out every column predicate
+  bool CanSkipTileGroup(storage::TileGroup *tile_group) const;
+
+  // Whether the join key of the tuple may be in the bloom filter
+  bool MayMatchBloomFilter(storage::TileGroup *tile_group,
+                           const oid_t &tuple_id) const;
+
+  // Whether the join key of a copied version may be in the bloom filter
+  bool MayMatchBloomFilter(const std::vector<type::Value> &values) const;
+
+  // Wrap copies of versions, each with a value for every table column, in a
+  // logical tile with the given columns
+  LogicalTile *BuildVersionTile(
+      const catalog::Schema *table_schema, const std::vector<oid_t> &column_ids,
+      const std::vector<std::vector<type::Value>> &versions) const;
+
  protected:
   //===--------------------------------------------------------------------===//
   // Plan Info
@@ -54,8 +106,27 @@ class AbstractScanExecutor : public AbstractExecutor {
   /** @brief Selection predicate. */
   const expression::AbstractExpression *predicate_ = nullptr;
 
+  /** @brief Selection predicate compiled into bytecode. */
+  std::unique_ptr<expression::CompiledExpression> compiled_predicate_;
+
   /** @brief Columns from tile group to be added to logical tile output. */
   std::vector<oid_t> column_ids_;
+
+  /** @brief Terms of the predicate checked against zone maps and evaluated
+   * on frozen tile groups. */
+  std::vector<ColumnPredicate> column_predicates_;
+
+  /** @brief Whether the column predicates make up the whole predicate. */
+  bool column_predicates_only_ = false;
+
+  /** @brief Bloom filter pushed down by a hash join, if any. */
+  const JoinBloomFilter *bloom_filter_ = nullptr;
+
+  /** @brief Table columns that make up the join key. */
+  std::vector<oid_t> bloom_filter_column_ids_;
+
+  /** @brief Whether to produce copies of the visible versions. */
+  bool copy_versions_ = false;
 };
 
 }  // namespace executor
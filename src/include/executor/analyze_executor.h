@@ -0,0 +1,44 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_executor.h
+//
+// Identification: src/include/executor/analyze_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "executor/abstract_executor.h"
+#include "planner/analyze_plan.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * Collects the column stats of one table, or of every table of a database,
+ * and stores them in the catalog for the optimizer.
+ */
+class AnalyzeExecutor : public AbstractExecutor {
+ public:
+  AnalyzeExecutor(const AnalyzeExecutor &) = delete;
+  AnalyzeExecutor &operator=(const AnalyzeExecutor &) = delete;
+  AnalyzeExecutor(AnalyzeExecutor &&) = delete;
+  AnalyzeExecutor &operator=(AnalyzeExecutor &&) = delete;
+
+  AnalyzeExecutor(const planner::AbstractPlan *node,
+                  ExecutorContext *executor_context);
+
+  ~AnalyzeExecutor() {}
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+};
+
+}  // namespace executor
+}  // namespace peloton
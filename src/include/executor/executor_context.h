@@ -13,7 +13,7 @@
 
 #pragma once
 
-#include "type/ephemeral_pool.h"
+#include "type/arena_pool.h"
 #include "type/value.h"
 
 namespace peloton {
@@ -52,8 +52,10 @@ class ExecutorContext {
 
   void ClearParams();
 
-  // Get a pool
-  type::EphemeralPool *GetPool();
+  // Get the pool used for the varlen temporaries of this query.
+  // It is released as a whole when the context is destroyed at the end of
+  // the statement, and must only be used by the thread executing the query.
+  type::ArenaPool *GetPool();
 
   // num of tuple processed
   uint32_t num_processed = 0;
@@ -70,7 +72,7 @@ class ExecutorContext {
   std::vector<type::Value> params_;
 
   // pool
-  std::unique_ptr<type::EphemeralPool> pool_;
+  std::unique_ptr<type::ArenaPool> pool_;
 
 };
 
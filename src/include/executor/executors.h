@@ -32,5 +32,6 @@
 #include "executor/hash_set_op_executor.h"
 #include "executor/append_executor.h"
 #include "executor/projection_executor.h"
+#include "executor/analyze_executor.h"
 #include "executor/copy_executor.h"
 #include "executor/populate_index_executor.h"
@@ -18,6 +18,7 @@
 
 #include "type/types.h"
 #include "executor/abstract_executor.h"
+#include "executor/join_bloom_filter.h"
 #include "executor/logical_tile.h"
 #include "common/container_tuple.h"
 
@@ -54,6 +55,11 @@ class HashExecutor : public AbstractExecutor {
     return this->column_ids_;
   }
 
+  /** @brief Bloom filter over the hash keys, once the table is built */
+  inline const JoinBloomFilter *GetBloomFilter() const {
+    return this->bloom_filter_.get();
+  }
+
  protected:
   bool DInit();
 
@@ -63,6 +69,9 @@ class HashExecutor : public AbstractExecutor {
   /** @brief Hash table */
   HashMapType hash_table_;
 
+  /** @brief Bloom filter over the keys of the hash table */
+  std::unique_ptr<JoinBloomFilter> bloom_filter_;
+
   /** @brief Input tiles from child node */
   std::vector<std::unique_ptr<LogicalTile>> child_tiles_;
 
@@ -37,6 +37,13 @@ class HashJoinExecutor : public AbstractJoinExecutor {
   bool DExecute();
 
  private:
+  // Hand the bloom filter of the hash table to the scan on the probe side
+  void PushDownBloomFilter();
+
+  // Offsets of the join keys in the left tiles. They are the offsets of the
+  // hash keys in the right tiles unless the plan says otherwise.
+  const std::vector<oid_t> &GetProbeKeyIds();
+
   HashExecutor *hash_executor_ = nullptr;
 
   bool hashed_ = false;
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "executor/abstract_scan_executor.h"
@@ -25,6 +26,7 @@ class Index;
 
 namespace storage {
 class AbstractTable;
+class TileGroup;
 }
 
 namespace executor {
@@ -44,6 +46,19 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   void ResetState();
 
+  // Whether the given output columns cover the whole index key, so that
+  // their values can be looked up with ExecuteKeyBatch()
+  bool CanExecuteKeyBatch(const std::vector<oid_t> &column_ids) const;
+
+  // Looks a batch of keys up on the given output columns with a single index
+  // call and a single pass over the version chains. Each result tile holds
+  // the matches within one block, and tile_keys gives for each of its rows
+  // the position of the key it matched.
+  bool ExecuteKeyBatch(const std::vector<oid_t> &column_ids,
+                       const std::vector<std::vector<type::Value>> &keys,
+                       std::vector<std::unique_ptr<LogicalTile>> &result_tiles,
+                       std::vector<std::vector<size_t>> &tile_keys);
+
  protected:
   bool DInit();
 
@@ -67,6 +82,25 @@ class IndexScanExecutor : public AbstractScanExecutor {
   // conditions on key columns
   bool CheckKeyConditions(const ItemPointer &tuple_location);
 
+  // Follow the version chain of an index entry to the version the transaction
+  // sees, or to a null location if it sees none. Returns false if the
+  // transaction has to abort.
+  bool GetVisibleVersion(ItemPointer &tuple_location,
+                         std::shared_ptr<storage::TileGroup> &tile_group);
+
+  // Put the visible tuples into logical tiles, one per block unless the key
+  // order has to be kept
+  void BuildResultTiles(const std::vector<ItemPointer> &tuple_locations);
+
+  // Whether the version of the tuple that the transaction sees passes the
+  // bloom filter and the predicate, checked on a copy of the version
+  bool EvaluateVersion(storage::TileGroup *tile_group, const oid_t &tuple_id);
+
+  // Wrap copies of the versions of the tuples that the transaction sees in a
+  // logical tile
+  LogicalTile *CopyVersions(storage::TileGroup *tile_group,
+                            const std::vector<oid_t> &tuple_ids);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -129,6 +163,9 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   // whether order by is descending
   bool descend_ = false;
+
+  // whether the tiles must come out in the order of the index keys
+  bool keep_key_order_ = false;
 };
 
 }  // namespace executor
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_bloom_filter.h
+//
+// Identification: src/include/executor/join_bloom_filter.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "type/types.h"
+
+namespace peloton {
+namespace executor {
+
+//===--------------------------------------------------------------------===//
+// Join Bloom Filter
+//===--------------------------------------------------------------------===//
+
+/**
+ * Bloom filter over the join key hashes of the build side of a hash join.
+ * It is handed to the scan on the probe side, which drops the tuples whose
+ * keys cannot be in the hash table before they are put into logical tiles.
+ *
+ * The keys are the hash codes the hash table itself uses, so there are no
+ * false negatives w.r.t. the hash join. Each key sets three bits of a single
+ * 64-bit word, which keeps a lookup to one cache miss.
+ */
+class JoinBloomFilter {
+ public:
+  JoinBloomFilter(const JoinBloomFilter &) = delete;
+  JoinBloomFilter &operator=(const JoinBloomFilter &) = delete;
+
+  // Size the filter for the expected number of keys
+  explicit JoinBloomFilter(const size_t &key_count);
+
+  inline void Insert(const size_t &key_hash) {
+    auto hash = Mix(key_hash);
+    words_[hash & word_mask_] |= GetBits(hash);
+  }
+
+  inline bool MayContain(const size_t &key_hash) const {
+    auto hash = Mix(key_hash);
+    auto bits = GetBits(hash);
+    return (words_[hash & word_mask_] & bits) == bits;
+  }
+
+  size_t GetSize() const { return words_.size() * sizeof(uint64_t); }
+
+ private:
+  // The hash table hashes are not necessarily well distributed
+  inline static uint64_t Mix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  // The word is picked with the low bits, the bits within it with the high
+  inline static uint64_t GetBits(const uint64_t &hash) {
+    return (1ULL << ((hash >> 40) & 63)) | (1ULL << ((hash >> 46) & 63)) |
+           (1ULL << ((hash >> 52) & 63));
+  }
+
+  std::vector<uint64_t> words_;
+
+  uint64_t word_mask_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <deque>
 #include <vector>
 
 #include "executor/abstract_join_executor.h"
@@ -21,6 +22,12 @@
 namespace peloton {
 namespace executor {
 
+/**
+ * Joins two children that return their tuples sorted on the join clauses.
+ * Both children are read once, side by side, and only the tiles holding the
+ * current run of equal keys are kept for inner joins, so a run of duplicates
+ * may span any number of tiles without either input being materialized.
+ */
 class MergeJoinExecutor : public AbstractJoinExecutor {
   MergeJoinExecutor(const MergeJoinExecutor &) = delete;
   MergeJoinExecutor &operator=(const MergeJoinExecutor &) = delete;
@@ -35,17 +42,52 @@ class MergeJoinExecutor : public AbstractJoinExecutor {
   bool DExecute();
 
  private:
-  size_t Advance(LogicalTile *tile, size_t start_row, bool is_left);
+  /** @brief Rows [begin_row, end_row) of a buffered child tile */
+  struct RowRange {
+    size_t tile_offset;
+    size_t begin_row;
+    size_t end_row;
+  };
+
+  void MergeNextKey();
+
+  bool FetchTile(bool is_left);
+
+  bool HasRow(bool is_left);
+
+  void GetJoinKey(bool is_left, size_t row, std::vector<type::Value> &key);
+
+  void CollectRun(bool is_left, const std::vector<type::Value> &key,
+                  std::vector<RowRange> &run);
+
+  void JoinRuns(const std::vector<RowRange> &left_run,
+                const std::vector<RowRange> &right_run);
+
+  void FlushPendingOutput();
+
+  void ReleaseConsumedTiles();
 
   /** @brief a vector of join clauses
    * Get this from plan node during initialization */
   const std::vector<planner::MergeJoinPlan::JoinClause> *join_clauses_;
 
-  size_t left_start_row = 0;
-  size_t right_start_row = 0;
+  /** @brief Next row of the last buffered tile of each child */
+  size_t left_row_ = 0;
+  size_t right_row_ = 0;
+
+  /** @brief Tiles before these offsets have been released */
+  size_t released_left_tiles_ = 0;
+  size_t released_right_tiles_ = 0;
+
+  bool merge_done_ = false;
+
+  /** @brief Output of the runs joined from the same pair of tiles */
+  std::unique_ptr<LogicalTile> pending_output_tile_;
+  LogicalTile::PositionListsBuilder pending_pos_lists_builder_;
+  size_t pending_left_tile_ = 0;
+  size_t pending_right_tile_ = 0;
 
-  size_t left_end_row = 0;
-  size_t right_end_row = 0;
+  std::deque<std::unique_ptr<LogicalTile>> buffered_output_tiles_;
 };
 
 }  // namespace executor
@@ -14,6 +14,7 @@
 
 #include "executor/abstract_join_executor.h"
 
+#include <deque>
 #include <vector>
 
 namespace peloton {
@@ -32,6 +33,34 @@ class NestedLoopJoinExecutor : public AbstractJoinExecutor {
   bool DExecute();
 
  private:
+  // Join a whole left tile at a time when the right child is an index scan:
+  // the keys of the left tile are sorted, the index is looked up once per
+  // distinct key in key order, and the matches are buffered as output tiles.
+  // When the join columns give the whole index key, all the distinct keys of
+  // the tile go to the index in a single batch
+  bool ExecuteBatchedLookup(const std::vector<oid_t> &join_column_ids_left,
+                            const std::vector<oid_t> &join_column_ids_right);
+
+  void JoinLeftTile(const std::vector<oid_t> &join_column_ids_left,
+                    const std::vector<oid_t> &join_column_ids_right);
+
+  // Join the left rows with the matches of a single batch lookup. The left
+  // rows in order[run_begins[i]] to order[run_begins[i + 1]] share a key.
+  void JoinKeyBatch(const std::vector<oid_t> &join_column_ids_right,
+                    const std::vector<oid_t> &left_rows,
+                    const std::vector<std::vector<type::Value>> &keys,
+                    const std::vector<size_t> &order,
+                    const std::vector<size_t> &run_begins);
+
+  // Whether the right child is looked up with batches of keys
+  bool batched_lookup_ = false;
+
+  // Whether the right child takes all the keys of a left tile at once
+  bool key_batch_lookup_ = false;
+
+  // Joined tiles not returned yet
+  std::deque<std::unique_ptr<LogicalTile>> buffered_output_tiles_;
+
   // Right child's result tiles iterator
   size_t right_result_itr_ = 0;
 
@@ -84,6 +84,16 @@ class PlanExecutor {
                                     std::vector<StatementResult> &result,
                                     const std::vector<int> &result_format);
 
+  /*
+   * @brief Run the plan like ExecutePlan() with every executor profiled, and
+   * return the plan tree annotated with their runtime statistics instead of
+   * the result tuples (EXPLAIN ANALYZE). One text column per result row.
+   */
+  static peloton_status ExplainAnalyzePlan(
+      const planner::AbstractPlan *plan, concurrency::Transaction *txn,
+      const std::vector<type::Value> &params,
+      std::vector<StatementResult> &result);
+
   /*
    * @brief When a peloton node recvs a query plan, this function is invoked
    * @param plan and params
@@ -42,6 +42,10 @@ class ProjectionExecutor : public AbstractExecutor {
   /** @brief Projection Info.            */
   const planner::ProjectInfo *project_info_ = nullptr;
 
+  /** @brief Target list of the projection compiled into bytecode. */
+  std::vector<std::unique_ptr<expression::CompiledExpression>>
+      compiled_targets_;
+
   /** @brief Schema of projected tuples. */
   const catalog::Schema *schema_ = nullptr;
 };
@@ -36,6 +36,11 @@ class SeqScanExecutor : public AbstractScanExecutor {
   bool DExecute();
 
  private:
+  // Evaluate the column predicates on the compressed tiles of a frozen tile
+  // group. Returns false if the tile group is not compressed (yet).
+  bool EvaluateColumnPredicates(storage::TileGroup *tile_group,
+                                std::vector<bool> &selection);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -42,6 +42,10 @@ class UpdateExecutor : public AbstractExecutor {
  private:
   storage::DataTable *target_table_ = nullptr;
   const planner::ProjectInfo *project_info_ = nullptr;
+
+  // Columns that the update writes, if it can write them in place (see
+  // FLAGS_delta_versions)
+  std::vector<oid_t> in_place_column_ids_;
 };
 
 }  // namespace executor
@@ -0,0 +1,203 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression.h
+//
+// Identification: src/include/expression/compiled_expression.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+class AbstractTuple;
+
+namespace executor {
+class ExecutorContext;
+}
+
+namespace expression {
+
+class AbstractExpression;
+
+//===----------------------------------------------------------------------===//
+// CompiledExpression
+//
+// An expression tree flattened into register bytecode. Every node writes its
+// result to a register of its own, and the instructions are specialized on
+// the types deduced at compile time, so evaluating a tuple is a single loop
+// over a switch instead of a virtual call and a type::Value per node.
+//
+// Integers and booleans live in registers as int64 and decimals as double.
+// Subtrees that do not depend on the tuples are folded into constants, and
+// parameters are bound as constants when the executor context is known.
+//
+// Only numeric and boolean arithmetic, comparisons and logic are compiled.
+// Any other expression keeps the tree, and so does a tuple whose column
+// turns out to have another type than the one compiled for. Evaluate() is
+// therefore always safe to call, and behaves like the tree it came from.
+//
+// A compiled expression is read-only once built, and the registers are on
+// the stack of the evaluating thread.
+//===----------------------------------------------------------------------===//
+
+class CompiledExpression {
+ public:
+  CompiledExpression(const CompiledExpression &) = delete;
+  CompiledExpression &operator=(const CompiledExpression &) = delete;
+
+  // Compile the expression. The parameters of the context, if any, are bound
+  // into the bytecode, so the result must not outlive that execution.
+  static std::unique_ptr<CompiledExpression> Compile(
+      const AbstractExpression *expression,
+      executor::ExecutorContext *context = nullptr);
+
+  type::Value Evaluate(const AbstractTuple *tuple1, const AbstractTuple *tuple2,
+                       executor::ExecutorContext *context) const;
+
+  // Whether the expression evaluates to true
+  bool EvaluatePredicate(const AbstractTuple *tuple1,
+                         const AbstractTuple *tuple2,
+                         executor::ExecutorContext *context) const;
+
+  // Whether the expression runs as bytecode rather than as a tree
+  bool IsCompiled() const { return is_compiled_; }
+
+  size_t GetInstructionCount() const { return instructions_.size(); }
+
+  // The registers of an evaluation are on the stack
+  static const size_t max_register_count = 64;
+
+ private:
+  enum class Opcode : uint8_t {
+    // Load a column of tuple1 or tuple2
+    LOAD_TINYINT,
+    LOAD_SMALLINT,
+    LOAD_INTEGER,
+    LOAD_BIGINT,
+    LOAD_BOOLEAN,
+    LOAD_DECIMAL,
+
+    INTEGER_TO_DECIMAL,
+
+    // Checked against the range of the result type
+    ADD_INTEGER,
+    SUBTRACT_INTEGER,
+    MULTIPLY_INTEGER,
+    DIVIDE_INTEGER,
+    MODULO_INTEGER,
+
+    ADD_DECIMAL,
+    SUBTRACT_DECIMAL,
+    MULTIPLY_DECIMAL,
+    DIVIDE_DECIMAL,
+    MODULO_DECIMAL,
+
+    EQUAL_INTEGER,
+    NOT_EQUAL_INTEGER,
+    LESS_THAN_INTEGER,
+    LESS_THAN_OR_EQUAL_INTEGER,
+    GREATER_THAN_INTEGER,
+    GREATER_THAN_OR_EQUAL_INTEGER,
+
+    EQUAL_DECIMAL,
+    NOT_EQUAL_DECIMAL,
+    LESS_THAN_DECIMAL,
+    LESS_THAN_OR_EQUAL_DECIMAL,
+    GREATER_THAN_DECIMAL,
+    GREATER_THAN_OR_EQUAL_DECIMAL,
+
+    // Three-valued logic
+    AND,
+    OR,
+    NOT,
+
+    // Set the result and jump if the left operand decides the conjunction
+    AND_SHORT_CIRCUIT,
+    OR_SHORT_CIRCUIT
+  };
+
+  struct Register {
+    union {
+      int64_t integer;
+      double decimal;
+    };
+    bool is_null;
+  };
+
+  struct Instruction {
+    Opcode opcode;
+    // Result type of the arithmetic, the type of the loaded column
+    type::Type::TypeId type;
+    uint8_t result;
+    uint8_t left;
+    uint8_t right;
+    // Column id of a load, target of a jump
+    uint32_t operand;
+  };
+
+  CompiledExpression(const AbstractExpression *expression)
+      : expression_(expression) {}
+
+  // Emit the code of a subtree. Returns false if it cannot be compiled.
+  bool CompileNode(const AbstractExpression *expression,
+                   executor::ExecutorContext *context, uint8_t &result,
+                   type::Type::TypeId &result_type);
+
+  bool CompileConstant(const type::Value &value, uint8_t &result,
+                       type::Type::TypeId &result_type);
+
+  bool CompileArithmetic(const ExpressionType &expression_type,
+                         uint8_t left, type::Type::TypeId left_type,
+                         uint8_t right, type::Type::TypeId right_type,
+                         uint8_t &result, type::Type::TypeId &result_type);
+
+  bool CompileComparison(const ExpressionType &expression_type,
+                         uint8_t left, type::Type::TypeId left_type,
+                         uint8_t right, type::Type::TypeId right_type,
+                         uint8_t &result);
+
+  bool CompileConjunction(const AbstractExpression *expression,
+                          executor::ExecutorContext *context, uint8_t &result);
+
+  bool AllocateRegister(uint8_t &reg, const bool &is_constant);
+
+  // Emit an instruction, or run it right away if its operands are constant
+  void Emit(const Instruction &instruction);
+
+  // Returns false if a tuple did not have the type compiled for
+  bool Run(const Instruction *begin, const Instruction *end,
+           Register *registers, const AbstractTuple *tuple1,
+           const AbstractTuple *tuple2) const;
+
+  type::Value GetResult(const Register &reg) const;
+
+  // The tree, for the expressions that are not compiled
+  const AbstractExpression *expression_;
+
+  bool is_compiled_ = false;
+
+  std::vector<Instruction> instructions_;
+
+  // Every evaluation starts from these, with the constants filled in
+  std::vector<Register> initial_registers_;
+
+  std::vector<bool> is_constant_;
+
+  uint8_t result_register_ = 0;
+
+  type::Type::TypeId result_type_ = type::Type::INVALID;
+};
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -0,0 +1,138 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.h
+//
+// Identification: src/include/gc/tile_group_compactor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "type/types.h"
+
+namespace peloton {
+
+namespace concurrency {
+class Transaction;
+}
+
+namespace storage {
+class DataTable;
+class TileGroup;
+}
+
+namespace gc {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor
+//===--------------------------------------------------------------------===//
+
+/**
+ * The GC recycles the slots of dead versions, but a tile group whose tuples
+ * were mostly deleted keeps its memory forever. The compactor looks for full
+ * tile groups whose occupancy dropped below a threshold and:
+ *
+ *  1. marks them as compacting, so that the GC stops handing out their
+ *     free slots;
+ *  2. moves every live tuple into the active tile groups of the table through
+ *     a regular update, so that indexes (which point to the indirection
+ *     array) stay valid and concurrent readers see a consistent snapshot;
+ *  3. drops the tile group once the GC reclaimed all of its old versions and
+ *     every transaction that could have started an insert into it is gone.
+ */
+class TileGroupCompactor {
+ public:
+  TileGroupCompactor(const TileGroupCompactor &) = delete;
+  TileGroupCompactor &operator=(const TileGroupCompactor &) = delete;
+  TileGroupCompactor(TileGroupCompactor &&) = delete;
+  TileGroupCompactor &operator=(TileGroupCompactor &&) = delete;
+
+  TileGroupCompactor();
+
+  ~TileGroupCompactor();
+
+  // Singleton
+  static TileGroupCompactor &GetInstance();
+
+  // Start compacting
+  void Start();
+
+  // Stop compacting
+  void Stop();
+
+  // Tables are registered by the database they belong to
+  void AddTable(storage::DataTable *table);
+
+  void DropTable(const oid_t &table_oid);
+
+  // Clear list
+  void ClearTables();
+
+  // Run one compaction pass over a table. Returns the number of tile groups
+  // that were dropped.
+  size_t CompactTable(storage::DataTable *table);
+
+  // Tile groups with a lower fraction of live tuples get compacted
+  void SetOccupancyThreshold(const double &occupancy_threshold) {
+    occupancy_threshold_ = occupancy_threshold;
+  }
+
+  // Number of tile groups dropped so far
+  size_t GetDroppedTileGroupCount() const { return dropped_tile_group_count_; }
+
+ private:
+  void Compact();
+
+  // Fraction of the allocated slots that hold the latest version of a tuple
+  double GetOccupancy(storage::TileGroup *tile_group);
+
+  // Move the live tuples out of the tile group as part of the given
+  // transaction. Returns true if no live tuple is left behind.
+  bool MoveTuples(storage::DataTable *table, storage::TileGroup *tile_group,
+                  concurrency::Transaction *txn);
+
+  // Whether every slot of the tile group has been reclaimed by the GC
+  bool IsDrained(storage::TileGroup *tile_group);
+
+  // Tables whose tile groups must be compacted
+  std::vector<storage::DataTable *> tables_;
+
+  // Tile groups being compacted, with the commit id of the transaction that
+  // started moving their tuples. They can be dropped once every transaction
+  // up to that commit id has finished.
+  std::unordered_map<oid_t, cid_t> compacting_tile_groups_;
+
+  // Protects the table list. Held for the duration of a pass so that a table
+  // cannot be dropped under our feet.
+  std::mutex compactor_mutex_;
+
+  // Stop signal
+  std::atomic<bool> compaction_stop_;
+
+  // Compactor thread
+  std::thread compactor_thread_;
+
+  std::atomic<size_t> dropped_tile_group_count_;
+
+  //===--------------------------------------------------------------------===//
+  // Compactor Parameters
+  //===--------------------------------------------------------------------===//
+
+  double occupancy_threshold_ = 0.2;
+
+  // Sleeping period between passes (in ms)
+  oid_t sleep_duration_ = 1000;
+};
+
+}  // End gc namespace
+}  // End peloton namespace
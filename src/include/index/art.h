@@ -0,0 +1,1502 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// art.h
+//
+// Identification: src/include/index/art.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace index {
+
+//===--------------------------------------------------------------------===//
+// ARTEpochManager
+//===--------------------------------------------------------------------===//
+
+/*
+ * class ARTEpochManager - Frees the nodes unlinked from an ART once no
+ *                         thread can still be reading them
+ *
+ * A thread takes a slot for the duration of an operation and writes the
+ * global epoch into it. Memory unlinked during epoch e is freed once every
+ * occupied slot holds an epoch later than e, since the threads that joined
+ * after it was unlinked cannot reach it.
+ */
+class ARTEpochManager {
+ public:
+  ARTEpochManager() : global_epoch_{1}, garbage_count_{0} {
+    for (auto &slot : slots_) {
+      slot.epoch.store(0);
+    }
+  }
+
+  ~ARTEpochManager() {
+    for (auto &slot : slots_) {
+      for (auto &garbage : slot.garbage) {
+        garbage.deleter(garbage.owner, garbage.pointer);
+      }
+    }
+  }
+
+  /*
+   * JoinEpoch() - Marks the calling thread as reading and returns its slot
+   */
+  size_t JoinEpoch() {
+    size_t slot_id =
+        std::hash<std::thread::id>()(std::this_thread::get_id()) % slot_count;
+    while (true) {
+      uint64_t free_slot = 0;
+      if (slots_[slot_id].epoch.compare_exchange_strong(free_slot,
+                                                        global_epoch_.load())) {
+        return slot_id;
+      }
+      slot_id = (slot_id + 1) % slot_count;
+    }
+  }
+
+  void LeaveEpoch(size_t slot_id) { slots_[slot_id].epoch.store(0); }
+
+  /*
+   * Retire() - Frees the pointer with the deleter once it is safe
+   *
+   * The caller must be in an epoch, holding the given slot
+   */
+  void Retire(size_t slot_id, void *owner, void *pointer,
+              void (*deleter)(void *, void *)) {
+    auto &slot = slots_[slot_id];
+    {
+      std::lock_guard<std::mutex> guard(slot.garbage_lock);
+      slot.garbage.push_back({global_epoch_.load(), owner, pointer, deleter});
+    }
+    garbage_count_.fetch_add(1);
+  }
+
+  bool NeedGC() const { return garbage_count_.load() >= gc_threshold; }
+
+  bool HasGarbage() const { return garbage_count_.load() != 0; }
+
+  /*
+   * PerformGC() - Starts a new epoch and frees what no thread can reach
+   */
+  void PerformGC() {
+    uint64_t safe_epoch = global_epoch_.fetch_add(1) + 1;
+    for (auto &slot : slots_) {
+      uint64_t epoch = slot.epoch.load();
+      if (epoch != 0 && epoch < safe_epoch) {
+        safe_epoch = epoch;
+      }
+    }
+
+    for (auto &slot : slots_) {
+      std::vector<Garbage> garbage;
+      {
+        std::lock_guard<std::mutex> guard(slot.garbage_lock);
+        auto it = std::partition(slot.garbage.begin(), slot.garbage.end(),
+                                 [safe_epoch](const Garbage &entry) {
+          return entry.epoch >= safe_epoch;
+        });
+        garbage.assign(it, slot.garbage.end());
+        slot.garbage.erase(it, slot.garbage.end());
+      }
+      for (auto &entry : garbage) {
+        entry.deleter(entry.owner, entry.pointer);
+      }
+      garbage_count_.fetch_sub(garbage.size());
+    }
+  }
+
+ private:
+  // Number of threads that can be in an epoch at the same time
+  static const size_t slot_count = 64;
+
+  // Garbage entries that make a thread collect after its operation
+  static const size_t gc_threshold = 1024;
+
+  struct Garbage {
+    uint64_t epoch;
+    void *owner;
+    void *pointer;
+    void (*deleter)(void *, void *);
+  };
+
+  // The padding keeps the epochs of two slots on different cache lines
+  struct Slot {
+    std::atomic<uint64_t> epoch;
+    char padding[64 - sizeof(std::atomic<uint64_t>)];
+    std::mutex garbage_lock;
+    std::vector<Garbage> garbage;
+  };
+
+  Slot slots_[slot_count];
+
+  std::atomic<uint64_t> global_epoch_;
+
+  std::atomic<size_t> garbage_count_;
+};
+
+//===--------------------------------------------------------------------===//
+// ARTNode
+//===--------------------------------------------------------------------===//
+
+enum class ARTNodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+/*
+ * class ARTNode - Inner node of an adaptive radix tree
+ *
+ * Every node has a version for optimistic lock coupling. Readers remember
+ * the version, read the node without locking it, and restart if the
+ * version changed meanwhile. Writers upgrade the version they read to a
+ * lock, so they also restart if the node changed since they read it.
+ *
+ *   bit 0     - the node was replaced and must not be used any more
+ *   bit 1     - the node is locked
+ *   bits 2-63 - incremented by every unlock
+ *
+ * Only the first max_stored_prefix_length bytes of the compressed prefix
+ * are kept in the node. The rest is read from the key of any leaf below it.
+ *
+ * A child pointer with the lowest bit set is a leaf, which the tree that
+ * owns the node knows how to read.
+ */
+class ARTNode {
+ public:
+  static const uint32_t max_stored_prefix_length = 8;
+
+  ARTNode(ARTNodeType type, const unsigned char *prefix,
+          uint32_t prefix_length)
+      : version_{0}, type_(type), count_{0} {
+    SetPrefix(prefix, prefix_length);
+  }
+
+  inline ARTNodeType GetType() const { return type_; }
+
+  inline uint16_t GetCount() const { return count_.load(); }
+
+  inline uint32_t GetPrefixLength() const { return prefix_length_.load(); }
+
+  inline const unsigned char *GetPrefix() const { return prefix_; }
+
+  // The number of bytes of a prefix of this length kept in the node
+  static inline uint32_t GetStoredLength(uint32_t prefix_length) {
+    return prefix_length < max_stored_prefix_length ? prefix_length
+                                                    : max_stored_prefix_length;
+  }
+
+  inline void SetPrefix(const unsigned char *prefix, uint32_t prefix_length) {
+    if (prefix_length > 0) {
+      PL_MEMCPY(prefix_, prefix, GetStoredLength(prefix_length));
+    }
+    prefix_length_.store(prefix_length);
+  }
+
+  /*
+   * AddPrefixBefore() - Prepends the prefix of a removed parent and the
+   *                     byte that led to this node
+   */
+  void AddPrefixBefore(const ARTNode *parent, unsigned char key) {
+    unsigned char prefix[max_stored_prefix_length];
+    uint32_t length = GetStoredLength(parent->GetPrefixLength());
+    PL_MEMCPY(prefix, parent->GetPrefix(), length);
+    if (length < max_stored_prefix_length) {
+      prefix[length++] = key;
+    }
+    uint32_t own_length = GetStoredLength(GetPrefixLength());
+    own_length = std::min(own_length, max_stored_prefix_length - length);
+    PL_MEMCPY(prefix + length, prefix_, own_length);
+    length += own_length;
+
+    PL_MEMCPY(prefix_, prefix, length);
+    prefix_length_.store(parent->GetPrefixLength() + 1 + GetPrefixLength());
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Optimistic lock coupling
+  //===--------------------------------------------------------------------===//
+
+  inline uint64_t ReadLockOrRestart(bool &need_restart) const {
+    uint64_t version = version_.load();
+    while (IsLocked(version)) {
+      std::this_thread::yield();
+      version = version_.load();
+    }
+    if (IsObsolete(version)) {
+      need_restart = true;
+    }
+    return version;
+  }
+
+  inline void CheckOrRestart(uint64_t version, bool &need_restart) const {
+    ReadUnlockOrRestart(version, need_restart);
+  }
+
+  inline void ReadUnlockOrRestart(uint64_t version, bool &need_restart) const {
+    if (version != version_.load()) {
+      need_restart = true;
+    }
+  }
+
+  inline void UpgradeToWriteLockOrRestart(uint64_t &version,
+                                          bool &need_restart) {
+    if (version_.compare_exchange_strong(version, version + 0b10)) {
+      version += 0b10;
+    } else {
+      need_restart = true;
+    }
+  }
+
+  inline void WriteLockOrRestart(bool &need_restart) {
+    while (true) {
+      uint64_t version = ReadLockOrRestart(need_restart);
+      if (need_restart) {
+        return;
+      }
+      UpgradeToWriteLockOrRestart(version, need_restart);
+      if (need_restart == false) {
+        return;
+      }
+      need_restart = false;
+    }
+  }
+
+  inline void WriteUnlock() { version_.fetch_add(0b10); }
+
+  inline void WriteUnlockObsolete() { version_.fetch_add(0b11); }
+
+  //===--------------------------------------------------------------------===//
+  // Children
+  //===--------------------------------------------------------------------===//
+
+  typedef std::pair<unsigned char, ARTNode *> ChildEntry;
+
+  inline bool IsFull() const;
+
+  // Whether a removal should move the node to the smaller type
+  inline bool IsUnderfull() const;
+
+  inline ARTNode *GetChild(unsigned char key) const;
+
+  // Appends the children in key order
+  inline void GetChildren(std::vector<ChildEntry> &children) const;
+
+  inline ARTNode *GetAnyChild() const;
+
+  inline void Insert(unsigned char key, ARTNode *child);
+
+  inline void Change(unsigned char key, ARTNode *child);
+
+  inline void Remove(unsigned char key);
+
+  // The node of the next larger or smaller type, with the same children
+  inline ARTNode *Grow() const;
+
+  inline ARTNode *Shrink() const;
+
+  static inline size_t GetSize(ARTNodeType type);
+
+  static inline void Delete(ARTNode *node);
+
+ protected:
+  static inline bool IsLocked(uint64_t version) {
+    return (version & 0b10) != 0;
+  }
+
+  static inline bool IsObsolete(uint64_t version) {
+    return (version & 0b01) != 0;
+  }
+
+  inline void CopyTo(ARTNode *node) const {
+    std::vector<ChildEntry> children;
+    GetChildren(children);
+    for (auto &child : children) {
+      node->Insert(child.first, child.second);
+    }
+  }
+
+  std::atomic<uint64_t> version_;
+
+  ARTNodeType type_;
+
+  std::atomic<uint16_t> count_;
+
+  std::atomic<uint32_t> prefix_length_;
+
+  unsigned char prefix_[max_stored_prefix_length];
+};
+
+/*
+ * class ARTSortedNode - Node of up to Capacity children, in key order
+ */
+template <uint16_t Capacity>
+class ARTSortedNode : public ARTNode {
+ public:
+  ARTSortedNode(ARTNodeType type, const unsigned char *prefix,
+                uint32_t prefix_length)
+      : ARTNode(type, prefix, prefix_length) {}
+
+  inline ARTNode *GetChild(unsigned char key) const {
+    uint16_t count = std::min(GetCount(), Capacity);
+    for (uint16_t i = 0; i < count; i++) {
+      if (keys_[i].load() == key) {
+        return children_[i].load();
+      }
+    }
+    return nullptr;
+  }
+
+  inline void GetChildren(std::vector<ChildEntry> &children) const {
+    uint16_t count = std::min(GetCount(), Capacity);
+    for (uint16_t i = 0; i < count; i++) {
+      children.emplace_back(keys_[i].load(), children_[i].load());
+    }
+  }
+
+  inline ARTNode *GetAnyChild() const {
+    return GetCount() == 0 ? nullptr : children_[0].load();
+  }
+
+  // Returns the child other than the given one of a node with two children
+  inline ChildEntry GetSecondChild(unsigned char key) const {
+    uint16_t pos = keys_[0].load() == key ? 1 : 0;
+    return ChildEntry(keys_[pos].load(), children_[pos].load());
+  }
+
+  inline void Insert(unsigned char key, ARTNode *child) {
+    uint16_t count = GetCount();
+    uint16_t pos = 0;
+    while (pos < count && keys_[pos].load() < key) {
+      pos++;
+    }
+    for (uint16_t i = count; i > pos; i--) {
+      keys_[i].store(keys_[i - 1].load());
+      children_[i].store(children_[i - 1].load());
+    }
+    keys_[pos].store(key);
+    children_[pos].store(child);
+    count_.store(count + 1);
+  }
+
+  inline void Change(unsigned char key, ARTNode *child) {
+    for (uint16_t i = 0; i < GetCount(); i++) {
+      if (keys_[i].load() == key) {
+        children_[i].store(child);
+        return;
+      }
+    }
+  }
+
+  inline void Remove(unsigned char key) {
+    uint16_t count = GetCount();
+    for (uint16_t pos = 0; pos < count; pos++) {
+      if (keys_[pos].load() == key) {
+        for (uint16_t i = pos; i + 1 < count; i++) {
+          keys_[i].store(keys_[i + 1].load());
+          children_[i].store(children_[i + 1].load());
+        }
+        count_.store(count - 1);
+        return;
+      }
+    }
+  }
+
+ private:
+  std::atomic<unsigned char> keys_[Capacity];
+
+  std::atomic<ARTNode *> children_[Capacity];
+};
+
+class ARTNode4 : public ARTSortedNode<4> {
+ public:
+  ARTNode4(const unsigned char *prefix, uint32_t prefix_length)
+      : ARTSortedNode<4>(ARTNodeType::NODE4, prefix, prefix_length) {}
+};
+
+class ARTNode16 : public ARTSortedNode<16> {
+ public:
+  ARTNode16(const unsigned char *prefix, uint32_t prefix_length)
+      : ARTSortedNode<16>(ARTNodeType::NODE16, prefix, prefix_length) {}
+};
+
+/*
+ * class ARTNode48 - Node of up to 48 children, indexed by key byte
+ */
+class ARTNode48 : public ARTNode {
+ public:
+  ARTNode48(const unsigned char *prefix, uint32_t prefix_length)
+      : ARTNode(ARTNodeType::NODE48, prefix, prefix_length) {
+    for (auto &index : child_index_) {
+      index.store(empty_marker);
+    }
+    for (auto &child : children_) {
+      child.store(nullptr);
+    }
+  }
+
+  inline ARTNode *GetChild(unsigned char key) const {
+    uint8_t index = child_index_[key].load();
+    return index == empty_marker ? nullptr : children_[index].load();
+  }
+
+  inline void GetChildren(std::vector<ChildEntry> &children) const {
+    for (unsigned key = 0; key < 256; key++) {
+      uint8_t index = child_index_[key].load();
+      if (index != empty_marker) {
+        ARTNode *child = children_[index].load();
+        if (child != nullptr) {
+          children.emplace_back(key, child);
+        }
+      }
+    }
+  }
+
+  inline ARTNode *GetAnyChild() const {
+    for (auto &child : children_) {
+      ARTNode *node = child.load();
+      if (node != nullptr) {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  inline void Insert(unsigned char key, ARTNode *child) {
+    uint8_t pos = 0;
+    while (children_[pos].load() != nullptr) {
+      pos++;
+    }
+    children_[pos].store(child);
+    child_index_[key].store(pos);
+    count_.store(GetCount() + 1);
+  }
+
+  inline void Change(unsigned char key, ARTNode *child) {
+    children_[child_index_[key].load()].store(child);
+  }
+
+  inline void Remove(unsigned char key) {
+    uint8_t index = child_index_[key].load();
+    child_index_[key].store(empty_marker);
+    children_[index].store(nullptr);
+    count_.store(GetCount() - 1);
+  }
+
+ private:
+  static const uint8_t empty_marker = 48;
+
+  std::atomic<uint8_t> child_index_[256];
+
+  std::atomic<ARTNode *> children_[48];
+};
+
+/*
+ * class ARTNode256 - Node with a child pointer for every key byte
+ */
+class ARTNode256 : public ARTNode {
+ public:
+  ARTNode256(const unsigned char *prefix, uint32_t prefix_length)
+      : ARTNode(ARTNodeType::NODE256, prefix, prefix_length) {
+    for (auto &child : children_) {
+      child.store(nullptr);
+    }
+  }
+
+  inline ARTNode *GetChild(unsigned char key) const {
+    return children_[key].load();
+  }
+
+  inline void GetChildren(std::vector<ChildEntry> &children) const {
+    for (unsigned key = 0; key < 256; key++) {
+      ARTNode *child = children_[key].load();
+      if (child != nullptr) {
+        children.emplace_back(key, child);
+      }
+    }
+  }
+
+  inline ARTNode *GetAnyChild() const {
+    for (auto &child : children_) {
+      ARTNode *node = child.load();
+      if (node != nullptr) {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  inline void Insert(unsigned char key, ARTNode *child) {
+    children_[key].store(child);
+    count_.store(GetCount() + 1);
+  }
+
+  inline void Change(unsigned char key, ARTNode *child) {
+    children_[key].store(child);
+  }
+
+  inline void Remove(unsigned char key) {
+    children_[key].store(nullptr);
+    count_.store(GetCount() - 1);
+  }
+
+ private:
+  std::atomic<ARTNode *> children_[256];
+};
+
+// Dispatches a member call on the type of the node
+#define ART_NODE_DISPATCH(node, call)                                      \
+  switch ((node)->GetType()) {                                             \
+    case ARTNodeType::NODE4:                                               \
+      return static_cast<ARTNode4 *>(node)->call;                          \
+    case ARTNodeType::NODE16:                                              \
+      return static_cast<ARTNode16 *>(node)->call;                         \
+    case ARTNodeType::NODE48:                                              \
+      return static_cast<ARTNode48 *>(node)->call;                         \
+    case ARTNodeType::NODE256:                                             \
+      return static_cast<ARTNode256 *>(node)->call;                        \
+  }
+
+inline bool ARTNode::IsFull() const {
+  switch (type_) {
+    case ARTNodeType::NODE4:
+      return GetCount() == 4;
+    case ARTNodeType::NODE16:
+      return GetCount() == 16;
+    case ARTNodeType::NODE48:
+      return GetCount() == 48;
+    case ARTNodeType::NODE256:
+      return false;
+  }
+  return false;
+}
+
+inline bool ARTNode::IsUnderfull() const {
+  switch (type_) {
+    case ARTNodeType::NODE4:
+      return false;
+    case ARTNodeType::NODE16:
+      return GetCount() == 3;
+    case ARTNodeType::NODE48:
+      return GetCount() == 12;
+    case ARTNodeType::NODE256:
+      return GetCount() == 37;
+  }
+  return false;
+}
+
+inline ARTNode *ARTNode::GetChild(unsigned char key) const {
+  const ARTNode *node = this;
+  switch (node->GetType()) {
+    case ARTNodeType::NODE4:
+      return static_cast<const ARTNode4 *>(node)->GetChild(key);
+    case ARTNodeType::NODE16:
+      return static_cast<const ARTNode16 *>(node)->GetChild(key);
+    case ARTNodeType::NODE48:
+      return static_cast<const ARTNode48 *>(node)->GetChild(key);
+    case ARTNodeType::NODE256:
+      return static_cast<const ARTNode256 *>(node)->GetChild(key);
+  }
+  return nullptr;
+}
+
+inline void ARTNode::GetChildren(std::vector<ChildEntry> &children) const {
+  const ARTNode *node = this;
+  switch (node->GetType()) {
+    case ARTNodeType::NODE4:
+      return static_cast<const ARTNode4 *>(node)->GetChildren(children);
+    case ARTNodeType::NODE16:
+      return static_cast<const ARTNode16 *>(node)->GetChildren(children);
+    case ARTNodeType::NODE48:
+      return static_cast<const ARTNode48 *>(node)->GetChildren(children);
+    case ARTNodeType::NODE256:
+      return static_cast<const ARTNode256 *>(node)->GetChildren(children);
+  }
+}
+
+inline ARTNode *ARTNode::GetAnyChild() const {
+  const ARTNode *node = this;
+  switch (node->GetType()) {
+    case ARTNodeType::NODE4:
+      return static_cast<const ARTNode4 *>(node)->GetAnyChild();
+    case ARTNodeType::NODE16:
+      return static_cast<const ARTNode16 *>(node)->GetAnyChild();
+    case ARTNodeType::NODE48:
+      return static_cast<const ARTNode48 *>(node)->GetAnyChild();
+    case ARTNodeType::NODE256:
+      return static_cast<const ARTNode256 *>(node)->GetAnyChild();
+  }
+  return nullptr;
+}
+
+inline void ARTNode::Insert(unsigned char key, ARTNode *child) {
+  ART_NODE_DISPATCH(this, Insert(key, child));
+}
+
+inline void ARTNode::Change(unsigned char key, ARTNode *child) {
+  ART_NODE_DISPATCH(this, Change(key, child));
+}
+
+inline void ARTNode::Remove(unsigned char key) {
+  ART_NODE_DISPATCH(this, Remove(key));
+}
+
+inline ARTNode *ARTNode::Grow() const {
+  ARTNode *node = nullptr;
+  switch (type_) {
+    case ARTNodeType::NODE4:
+      node = new ARTNode16(prefix_, GetPrefixLength());
+      break;
+    case ARTNodeType::NODE16:
+      node = new ARTNode48(prefix_, GetPrefixLength());
+      break;
+    case ARTNodeType::NODE48:
+    case ARTNodeType::NODE256:
+      node = new ARTNode256(prefix_, GetPrefixLength());
+      break;
+  }
+  CopyTo(node);
+  return node;
+}
+
+inline ARTNode *ARTNode::Shrink() const {
+  ARTNode *node = nullptr;
+  switch (type_) {
+    case ARTNodeType::NODE4:
+    case ARTNodeType::NODE16:
+      node = new ARTNode4(prefix_, GetPrefixLength());
+      break;
+    case ARTNodeType::NODE48:
+      node = new ARTNode16(prefix_, GetPrefixLength());
+      break;
+    case ARTNodeType::NODE256:
+      node = new ARTNode48(prefix_, GetPrefixLength());
+      break;
+  }
+  CopyTo(node);
+  return node;
+}
+
+inline size_t ARTNode::GetSize(ARTNodeType type) {
+  switch (type) {
+    case ARTNodeType::NODE4:
+      return sizeof(ARTNode4);
+    case ARTNodeType::NODE16:
+      return sizeof(ARTNode16);
+    case ARTNodeType::NODE48:
+      return sizeof(ARTNode48);
+    case ARTNodeType::NODE256:
+      return sizeof(ARTNode256);
+  }
+  return 0;
+}
+
+inline void ARTNode::Delete(ARTNode *node) {
+  switch (node->GetType()) {
+    case ARTNodeType::NODE4:
+      delete static_cast<ARTNode4 *>(node);
+      break;
+    case ARTNodeType::NODE16:
+      delete static_cast<ARTNode16 *>(node);
+      break;
+    case ARTNodeType::NODE48:
+      delete static_cast<ARTNode48 *>(node);
+      break;
+    case ARTNodeType::NODE256:
+      delete static_cast<ARTNode256 *>(node);
+      break;
+  }
+}
+
+#undef ART_NODE_DISPATCH
+
+//===--------------------------------------------------------------------===//
+// ART
+//===--------------------------------------------------------------------===//
+
+/*
+ * class ART - Adaptive radix tree with optimistic lock coupling
+ *
+ * KeyType must be a fixed-length key whose bytes compare like the keys do
+ * (CompactIntsKey and NormalizedKey), and it is followed byte by byte from
+ * the root. Inner nodes grow from 4 to 16, 48 and 256 children as needed,
+ * and a path without branches is compressed into the prefix of the next
+ * node. Since all keys have the same length none is a prefix of another,
+ * and a subtree with a single key is just its leaf.
+ *
+ * Like BwTree this is a multimap. A leaf holds a key and all its values; it
+ * is never changed but replaced by a copy, so a reader that found it sees a
+ * consistent set of values. Replaced nodes and leaves are freed through the
+ * epoch manager.
+ *
+ * The root is a node of 256 children without a prefix, which is never
+ * replaced, so every other node has a parent to lock when it is.
+ */
+template <typename KeyType, typename ValueType, typename ValueEqualityChecker>
+class ART {
+ public:
+  static constexpr size_t key_length = KeyType::key_size_byte;
+
+  ART()
+      : root_(new ARTNode256(nullptr, 0)),
+        memory_footprint_{sizeof(ARTNode256)} {}
+
+  ~ART() { DeleteSubtree(root_); }
+
+  /*
+   * Insert() - Inserts a key-value pair
+   *
+   * Returns false if the pair is already there
+   */
+  bool Insert(const KeyType &key, const ValueType &value) {
+    return InsertValue(key, value, nullptr, nullptr);
+  }
+
+  /*
+   * ConditionalInsert() - Inserts a key-value pair unless the predicate is
+   *                       true for one of the values of the key
+   */
+  bool ConditionalInsert(const KeyType &key, const ValueType &value,
+                         std::function<bool(const void *)> predicate,
+                         bool *predicate_satisfied) {
+    *predicate_satisfied = false;
+    return InsertValue(key, value, &predicate, predicate_satisfied);
+  }
+
+  /*
+   * Delete() - Removes a key-value pair. Returns false if it is not there
+   */
+  bool Delete(const KeyType &key, const ValueType &value) {
+    bool ret;
+    {
+      EpochGuard guard(this);
+      bool need_restart;
+      do {
+        need_restart = false;
+        ret = TryDelete(guard, key, value, need_restart);
+      } while (need_restart);
+    }
+    CollectGarbage();
+    return ret;
+  }
+
+  /*
+   * GetValue() - Appends the values of the key
+   */
+  void GetValue(const KeyType &key, std::vector<ValueType> &result) {
+    EpochGuard guard(this);
+    size_t result_size = result.size();
+    bool need_restart;
+    do {
+      need_restart = false;
+      result.resize(result_size);
+      TryLookup(key, result, need_restart);
+    } while (need_restart);
+  }
+
+  /*
+   * ScanRange() - Appends the values of the keys between the bounds
+   *
+   * The bounds are inclusive, and either can be null for no bound. The
+   * values come in key order, or in reverse key order if forward is false.
+   */
+  void ScanRange(const KeyType *low_key, const KeyType *high_key,
+                 bool forward, std::vector<ValueType> &result) {
+    EpochGuard guard(this);
+    size_t result_size = result.size();
+    std::vector<ARTNode::ChildEntry> children;
+    bool need_restart;
+    do {
+      need_restart = false;
+      result.resize(result_size);
+      children.clear();
+      CollectRange(root_, 0,
+                   low_key == nullptr ? nullptr : low_key->GetRawData(),
+                   high_key == nullptr ? nullptr : high_key->GetRawData(),
+                   forward, children, result, need_restart);
+    } while (need_restart);
+  }
+
+  bool NeedGarbageCollection() const { return epoch_manager_.HasGarbage(); }
+
+  void PerformGarbageCollection() { epoch_manager_.PerformGC(); }
+
+  size_t GetMemoryFootprint() const { return memory_footprint_.load(); }
+
+ private:
+  struct Leaf {
+    KeyType key;
+    uint32_t value_count;
+    ValueType values[1];
+  };
+
+  /*
+   * class EpochGuard - Keeps the calling thread in an epoch while in scope
+   */
+  class EpochGuard {
+   public:
+    EpochGuard(ART *tree)
+        : tree_(tree), slot_id_(tree->epoch_manager_.JoinEpoch()) {}
+
+    ~EpochGuard() { tree_->epoch_manager_.LeaveEpoch(slot_id_); }
+
+    void Retire(ARTNode *node) const {
+      if (IsLeaf(node)) {
+        tree_->epoch_manager_.Retire(slot_id_, tree_, GetLeaf(node),
+                                     &ART::FreeLeaf);
+      } else {
+        tree_->epoch_manager_.Retire(slot_id_, tree_, node, &ART::FreeNode);
+      }
+    }
+
+   private:
+    ART *tree_;
+    size_t slot_id_;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // Leaves
+  //===--------------------------------------------------------------------===//
+
+  static inline bool IsLeaf(const ARTNode *node) {
+    return (reinterpret_cast<uintptr_t>(node) & 1) != 0;
+  }
+
+  static inline Leaf *GetLeaf(const ARTNode *node) {
+    return reinterpret_cast<Leaf *>(reinterpret_cast<uintptr_t>(node) &
+                                    ~static_cast<uintptr_t>(1));
+  }
+
+  static inline ARTNode *TagLeaf(Leaf *leaf) {
+    return reinterpret_cast<ARTNode *>(reinterpret_cast<uintptr_t>(leaf) | 1);
+  }
+
+  static inline size_t GetLeafSize(uint32_t value_count) {
+    return offsetof(Leaf, values) + value_count * sizeof(ValueType);
+  }
+
+  /*
+   * NewLeaf() - A leaf with the values, except the one at skip_pos if it is
+   *             in range, and then the new value if there is one
+   */
+  inline Leaf *NewLeaf(const KeyType &key, const ValueType *values,
+                       uint32_t value_count, uint32_t skip_pos,
+                       const ValueType *new_value) {
+    uint32_t leaf_value_count = value_count;
+    if (skip_pos < value_count) leaf_value_count--;
+    if (new_value != nullptr) leaf_value_count++;
+
+    size_t size = GetLeafSize(leaf_value_count);
+    Leaf *leaf = static_cast<Leaf *>(malloc(size));
+    PL_MEMCPY(&leaf->key, &key, sizeof(KeyType));
+    leaf->value_count = leaf_value_count;
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < value_count; i++) {
+      if (i != skip_pos) {
+        leaf->values[pos++] = values[i];
+      }
+    }
+    if (new_value != nullptr) {
+      leaf->values[pos] = *new_value;
+    }
+    memory_footprint_.fetch_add(size);
+    return leaf;
+  }
+
+  inline Leaf *NewLeaf(const KeyType &key, const ValueType &value) {
+    return NewLeaf(key, nullptr, 0, 0, &value);
+  }
+
+  static void FreeLeaf(void *tree, void *leaf) {
+    static_cast<ART *>(tree)->memory_footprint_.fetch_sub(
+        GetLeafSize(static_cast<Leaf *>(leaf)->value_count));
+    free(leaf);
+  }
+
+  static void FreeNode(void *tree, void *node) {
+    auto art_node = static_cast<ARTNode *>(node);
+    static_cast<ART *>(tree)->memory_footprint_.fetch_sub(
+        ARTNode::GetSize(art_node->GetType()));
+    ARTNode::Delete(art_node);
+  }
+
+  inline ARTNode *NewNode(ARTNode *node) {
+    memory_footprint_.fetch_add(ARTNode::GetSize(node->GetType()));
+    return node;
+  }
+
+  static inline bool KeyEquals(const KeyType &lhs, const KeyType &rhs) {
+    return memcmp(lhs.GetRawData(), rhs.GetRawData(), key_length) == 0;
+  }
+
+  // The key of any leaf below the node, to read the prefix it does not keep
+  static const unsigned char *LoadAnyKey(const ARTNode *node,
+                                         bool &need_restart) {
+    while (node != nullptr && IsLeaf(node) == false) {
+      node = node->GetAnyChild();
+    }
+    if (node == nullptr) {
+      need_restart = true;
+      return nullptr;
+    }
+    return GetLeaf(node)->key.GetRawData();
+  }
+
+  void CollectGarbage() {
+    if (epoch_manager_.NeedGC()) {
+      epoch_manager_.PerformGC();
+    }
+  }
+
+  void DeleteSubtree(ARTNode *node) {
+    if (IsLeaf(node)) {
+      free(GetLeaf(node));
+      return;
+    }
+    std::vector<ARTNode::ChildEntry> children;
+    node->GetChildren(children);
+    for (auto &child : children) {
+      DeleteSubtree(child.second);
+    }
+    ARTNode::Delete(node);
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Prefixes
+  //===--------------------------------------------------------------------===//
+
+  /*
+   * CheckPrefixOptimistic() - Skips the prefix of the node, checking the
+   *                           bytes it keeps
+   *
+   * A longer prefix is checked by the caller against the key of the leaf.
+   */
+  static inline bool CheckPrefixOptimistic(const ARTNode *node,
+                                           const unsigned char *key,
+                                           uint32_t &level,
+                                           bool &need_restart) {
+    uint32_t prefix_length = node->GetPrefixLength();
+    if (level + prefix_length >= key_length) {
+      need_restart = true;
+      return false;
+    }
+    uint32_t stored_length = ARTNode::GetStoredLength(prefix_length);
+    for (uint32_t i = 0; i < stored_length; i++) {
+      if (node->GetPrefix()[i] != key[level + i]) {
+        return false;
+      }
+    }
+    level += prefix_length;
+    return true;
+  }
+
+  /*
+   * CheckPrefixPessimistic() - Compares the whole prefix with the key
+   *
+   * On a mismatch the level is that of the first differing byte, which is
+   * returned with the bytes of the prefix that follow it.
+   */
+  static bool CheckPrefixPessimistic(const ARTNode *node,
+                                     const unsigned char *key,
+                                     uint32_t &level,
+                                     unsigned char &non_matching_key,
+                                     unsigned char *remaining_prefix,
+                                     bool &need_restart) {
+    uint32_t prefix_length = node->GetPrefixLength();
+    uint32_t start_level = level;
+    if (level + prefix_length >= key_length) {
+      need_restart = true;
+      return false;
+    }
+
+    const unsigned char *any_key = nullptr;
+    if (prefix_length > ARTNode::max_stored_prefix_length) {
+      any_key = LoadAnyKey(node, need_restart);
+      if (need_restart) {
+        return false;
+      }
+    }
+
+    for (uint32_t i = 0; i < prefix_length; i++, level++) {
+      unsigned char byte = i < ARTNode::max_stored_prefix_length
+                               ? node->GetPrefix()[i]
+                               : any_key[level];
+      if (byte != key[level]) {
+        non_matching_key = byte;
+        uint32_t remaining_length = prefix_length - (level - start_level + 1);
+        if (any_key != nullptr) {
+          PL_MEMCPY(remaining_prefix, any_key + level + 1,
+                    ARTNode::GetStoredLength(remaining_length));
+        } else {
+          PL_MEMCPY(remaining_prefix, node->GetPrefix() + i + 1,
+                    remaining_length);
+        }
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Operations
+  //===--------------------------------------------------------------------===//
+
+  bool InsertValue(const KeyType &key, const ValueType &value,
+                   std::function<bool(const void *)> *predicate,
+                   bool *predicate_satisfied) {
+    bool ret;
+    {
+      EpochGuard guard(this);
+      bool need_restart;
+      do {
+        need_restart = false;
+        ret = TryInsert(guard, key, value, predicate, predicate_satisfied,
+                        need_restart);
+      } while (need_restart);
+    }
+    CollectGarbage();
+    return ret;
+  }
+
+  bool TryInsert(const EpochGuard &guard, const KeyType &key,
+                 const ValueType &value,
+                 std::function<bool(const void *)> *predicate,
+                 bool *predicate_satisfied, bool &need_restart) {
+    const unsigned char *k = key.GetRawData();
+    ARTNode *node = nullptr;
+    ARTNode *next_node = root_;
+    ARTNode *parent_node = nullptr;
+    unsigned char parent_key = 0;
+    unsigned char node_key = 0;
+    uint64_t parent_version = 0;
+    uint32_t level = 0;
+
+    while (true) {
+      parent_node = node;
+      parent_key = node_key;
+      node = next_node;
+      uint64_t version = node->ReadLockOrRestart(need_restart);
+      if (need_restart) return false;
+
+      uint32_t next_level = level;
+      unsigned char non_matching_key = 0;
+      unsigned char remaining_prefix[ARTNode::max_stored_prefix_length];
+      bool prefix_matches =
+          CheckPrefixPessimistic(node, k, next_level, non_matching_key,
+                                 remaining_prefix, need_restart);
+      if (need_restart) return false;
+
+      if (prefix_matches == false) {
+        // Split the prefix with a new parent for the node and the key
+        parent_node->UpgradeToWriteLockOrRestart(parent_version, need_restart);
+        if (need_restart) return false;
+        node->UpgradeToWriteLockOrRestart(version, need_restart);
+        if (need_restart) {
+          parent_node->WriteUnlock();
+          return false;
+        }
+
+        ARTNode *new_node =
+            NewNode(new ARTNode4(&k[level], next_level - level));
+        new_node->Insert(k[next_level], TagLeaf(NewLeaf(key, value)));
+        new_node->Insert(non_matching_key, node);
+        parent_node->Change(parent_key, new_node);
+        parent_node->WriteUnlock();
+
+        node->SetPrefix(remaining_prefix,
+                        node->GetPrefixLength() - (next_level - level + 1));
+        node->WriteUnlock();
+        return true;
+      }
+
+      level = next_level;
+      node_key = k[level];
+      next_node = node->GetChild(node_key);
+      node->CheckOrRestart(version, need_restart);
+      if (need_restart) return false;
+
+      if (next_node == nullptr) {
+        Leaf *leaf = NewLeaf(key, value);
+        InsertAndUnlock(guard, node, version, parent_node, parent_version,
+                        parent_key, node_key, TagLeaf(leaf), need_restart);
+        if (need_restart) {
+          FreeLeaf(this, leaf);
+          return false;
+        }
+        return true;
+      }
+
+      if (parent_node != nullptr) {
+        parent_node->ReadUnlockOrRestart(parent_version, need_restart);
+        if (need_restart) return false;
+      }
+
+      if (IsLeaf(next_node)) {
+        Leaf *leaf = GetLeaf(next_node);
+        node->UpgradeToWriteLockOrRestart(version, need_restart);
+        if (need_restart) return false;
+
+        if (KeyEquals(leaf->key, key)) {
+          // Another value of the key
+          for (uint32_t i = 0; i < leaf->value_count; i++) {
+            if (predicate != nullptr && (*predicate)(leaf->values[i])) {
+              *predicate_satisfied = true;
+              node->WriteUnlock();
+              return false;
+            }
+          }
+          for (uint32_t i = 0; i < leaf->value_count; i++) {
+            if (value_equals_(leaf->values[i], value)) {
+              node->WriteUnlock();
+              return false;
+            }
+          }
+          Leaf *new_leaf = NewLeaf(key, leaf->values, leaf->value_count,
+                                   leaf->value_count, &value);
+          node->Change(node_key, TagLeaf(new_leaf));
+          node->WriteUnlock();
+          guard.Retire(next_node);
+          return true;
+        }
+
+        // Split the leaf with a node for the bytes the keys share
+        const unsigned char *leaf_k = leaf->key.GetRawData();
+        level++;
+        uint32_t prefix_length = 0;
+        while (leaf_k[level + prefix_length] == k[level + prefix_length]) {
+          prefix_length++;
+        }
+        ARTNode *new_node = NewNode(new ARTNode4(&k[level], prefix_length));
+        new_node->Insert(k[level + prefix_length],
+                         TagLeaf(NewLeaf(key, value)));
+        new_node->Insert(leaf_k[level + prefix_length], next_node);
+        node->Change(node_key, new_node);
+        node->WriteUnlock();
+        return true;
+      }
+
+      level++;
+      parent_version = version;
+    }
+  }
+
+  void InsertAndUnlock(const EpochGuard &guard, ARTNode *node,
+                       uint64_t version, ARTNode *parent_node,
+                       uint64_t parent_version, unsigned char parent_key,
+                       unsigned char key, ARTNode *child,
+                       bool &need_restart) {
+    if (node->IsFull()) {
+      // Replace the node with a larger one
+      parent_node->UpgradeToWriteLockOrRestart(parent_version, need_restart);
+      if (need_restart) return;
+      node->UpgradeToWriteLockOrRestart(version, need_restart);
+      if (need_restart) {
+        parent_node->WriteUnlock();
+        return;
+      }
+
+      ARTNode *larger_node = NewNode(node->Grow());
+      larger_node->Insert(key, child);
+      parent_node->Change(parent_key, larger_node);
+      parent_node->WriteUnlock();
+
+      node->WriteUnlockObsolete();
+      guard.Retire(node);
+      return;
+    }
+
+    node->UpgradeToWriteLockOrRestart(version, need_restart);
+    if (need_restart) return;
+    if (parent_node != nullptr) {
+      parent_node->ReadUnlockOrRestart(parent_version, need_restart);
+      if (need_restart) {
+        node->WriteUnlock();
+        return;
+      }
+    }
+    node->Insert(key, child);
+    node->WriteUnlock();
+  }
+
+  bool TryDelete(const EpochGuard &guard, const KeyType &key,
+                 const ValueType &value, bool &need_restart) {
+    const unsigned char *k = key.GetRawData();
+    ARTNode *node = nullptr;
+    ARTNode *next_node = root_;
+    ARTNode *parent_node = nullptr;
+    unsigned char parent_key = 0;
+    unsigned char node_key = 0;
+    uint64_t parent_version = 0;
+    uint32_t level = 0;
+
+    while (true) {
+      parent_node = node;
+      parent_key = node_key;
+      node = next_node;
+      uint64_t version = node->ReadLockOrRestart(need_restart);
+      if (need_restart) return false;
+
+      if (CheckPrefixOptimistic(node, k, level, need_restart) == false) {
+        node->ReadUnlockOrRestart(version, need_restart);
+        return false;
+      }
+
+      node_key = k[level];
+      next_node = node->GetChild(node_key);
+      node->CheckOrRestart(version, need_restart);
+      if (need_restart) return false;
+
+      if (next_node == nullptr) {
+        return false;
+      }
+
+      if (IsLeaf(next_node)) {
+        Leaf *leaf = GetLeaf(next_node);
+        if (KeyEquals(leaf->key, key) == false) {
+          return false;
+        }
+        uint32_t pos = 0;
+        while (pos < leaf->value_count &&
+               value_equals_(leaf->values[pos], value) == false) {
+          pos++;
+        }
+        if (pos == leaf->value_count) {
+          return false;
+        }
+
+        if (leaf->value_count > 1) {
+          // The key keeps its other values
+          node->UpgradeToWriteLockOrRestart(version, need_restart);
+          if (need_restart) return false;
+          Leaf *new_leaf =
+              NewLeaf(key, leaf->values, leaf->value_count, pos, nullptr);
+          node->Change(node_key, TagLeaf(new_leaf));
+          node->WriteUnlock();
+        } else if (node->GetType() == ARTNodeType::NODE4 &&
+                   node->GetCount() == 2 && parent_node != nullptr) {
+          // The other child takes the place of the node
+          parent_node->UpgradeToWriteLockOrRestart(parent_version,
+                                                   need_restart);
+          if (need_restart) return false;
+          node->UpgradeToWriteLockOrRestart(version, need_restart);
+          if (need_restart) {
+            parent_node->WriteUnlock();
+            return false;
+          }
+
+          auto second_child =
+              static_cast<ARTNode4 *>(node)->GetSecondChild(node_key);
+          if (IsLeaf(second_child.second) == false) {
+            second_child.second->WriteLockOrRestart(need_restart);
+            if (need_restart) {
+              node->WriteUnlock();
+              parent_node->WriteUnlock();
+              return false;
+            }
+          }
+          parent_node->Change(parent_key, second_child.second);
+          parent_node->WriteUnlock();
+          if (IsLeaf(second_child.second) == false) {
+            second_child.second->AddPrefixBefore(node, second_child.first);
+            second_child.second->WriteUnlock();
+          }
+          node->WriteUnlockObsolete();
+          guard.Retire(node);
+        } else {
+          RemoveAndUnlock(guard, node, version, node_key, parent_node,
+                          parent_version, parent_key, need_restart);
+          if (need_restart) return false;
+        }
+        guard.Retire(next_node);
+        return true;
+      }
+
+      level++;
+      parent_version = version;
+    }
+  }
+
+  void RemoveAndUnlock(const EpochGuard &guard, ARTNode *node,
+                       uint64_t version, unsigned char key,
+                       ARTNode *parent_node, uint64_t parent_version,
+                       unsigned char parent_key, bool &need_restart) {
+    if (node->IsUnderfull() && parent_node != nullptr) {
+      // Replace the node with a smaller one
+      parent_node->UpgradeToWriteLockOrRestart(parent_version, need_restart);
+      if (need_restart) return;
+      node->UpgradeToWriteLockOrRestart(version, need_restart);
+      if (need_restart) {
+        parent_node->WriteUnlock();
+        return;
+      }
+
+      ARTNode *smaller_node = NewNode(node->Shrink());
+      smaller_node->Remove(key);
+      parent_node->Change(parent_key, smaller_node);
+      parent_node->WriteUnlock();
+
+      node->WriteUnlockObsolete();
+      guard.Retire(node);
+      return;
+    }
+
+    node->UpgradeToWriteLockOrRestart(version, need_restart);
+    if (need_restart) return;
+    node->Remove(key);
+    node->WriteUnlock();
+  }
+
+  void TryLookup(const KeyType &key, std::vector<ValueType> &result,
+                 bool &need_restart) const {
+    const unsigned char *k = key.GetRawData();
+    ARTNode *node = root_;
+    uint64_t version = node->ReadLockOrRestart(need_restart);
+    if (need_restart) return;
+    uint32_t level = 0;
+
+    while (true) {
+      if (CheckPrefixOptimistic(node, k, level, need_restart) == false) {
+        node->ReadUnlockOrRestart(version, need_restart);
+        return;
+      }
+
+      ARTNode *child = node->GetChild(k[level]);
+      node->CheckOrRestart(version, need_restart);
+      if (need_restart || child == nullptr) return;
+
+      if (IsLeaf(child)) {
+        Leaf *leaf = GetLeaf(child);
+        if (KeyEquals(leaf->key, key)) {
+          result.insert(result.end(), leaf->values,
+                        leaf->values + leaf->value_count);
+        }
+        return;
+      }
+
+      level++;
+      uint64_t child_version = child->ReadLockOrRestart(need_restart);
+      if (need_restart) return;
+      node->ReadUnlockOrRestart(version, need_restart);
+      if (need_restart) return;
+      node = child;
+      version = child_version;
+    }
+  }
+
+  /*
+   * CollectRange() - Appends the values of the subtree that are between the
+   *                  bounds
+   *
+   * A bound is only passed down while the path still equals its prefix; the
+   * subtree is entirely inside the range on that side otherwise. The
+   * children of every node are copied to the shared stack before descending,
+   * so the node is validated once.
+   */
+  void CollectRange(const ARTNode *node, uint32_t level,
+                    const unsigned char *low, const unsigned char *high,
+                    bool forward, std::vector<ARTNode::ChildEntry> &stack,
+                    std::vector<ValueType> &result,
+                    bool &need_restart) const {
+    uint64_t version = node->ReadLockOrRestart(need_restart);
+    if (need_restart) return;
+
+    uint32_t prefix_length = node->GetPrefixLength();
+    if (level + prefix_length >= key_length) {
+      need_restart = true;
+      return;
+    }
+    if ((low != nullptr || high != nullptr) && prefix_length > 0) {
+      const unsigned char *any_key = nullptr;
+      if (prefix_length > ARTNode::max_stored_prefix_length) {
+        any_key = LoadAnyKey(node, need_restart);
+        if (need_restart) return;
+      }
+      for (uint32_t i = 0; i < prefix_length; i++) {
+        unsigned char byte = i < ARTNode::max_stored_prefix_length
+                                 ? node->GetPrefix()[i]
+                                 : any_key[level + i];
+        if (low != nullptr) {
+          if (byte < low[level + i]) {
+            node->ReadUnlockOrRestart(version, need_restart);
+            return;
+          } else if (byte > low[level + i]) {
+            low = nullptr;
+          }
+        }
+        if (high != nullptr) {
+          if (byte > high[level + i]) {
+            node->ReadUnlockOrRestart(version, need_restart);
+            return;
+          } else if (byte < high[level + i]) {
+            high = nullptr;
+          }
+        }
+      }
+    }
+    level += prefix_length;
+
+    size_t begin = stack.size();
+    node->GetChildren(stack);
+    size_t end = stack.size();
+    node->ReadUnlockOrRestart(version, need_restart);
+    if (need_restart) return;
+
+    for (size_t i = 0; i < end - begin; i++) {
+      auto entry = stack[forward ? begin + i : end - 1 - i];
+      if (low != nullptr && entry.first < low[level]) continue;
+      if (high != nullptr && entry.first > high[level]) continue;
+      const unsigned char *child_low =
+          low != nullptr && entry.first == low[level] ? low : nullptr;
+      const unsigned char *child_high =
+          high != nullptr && entry.first == high[level] ? high : nullptr;
+
+      if (IsLeaf(entry.second)) {
+        Leaf *leaf = GetLeaf(entry.second);
+        const unsigned char *leaf_k = leaf->key.GetRawData();
+        if (child_low != nullptr && memcmp(leaf_k, child_low, key_length) < 0)
+          continue;
+        if (child_high != nullptr &&
+            memcmp(leaf_k, child_high, key_length) > 0)
+          continue;
+        if (forward) {
+          result.insert(result.end(), leaf->values,
+                        leaf->values + leaf->value_count);
+        } else {
+          for (uint32_t j = leaf->value_count; j > 0; j--) {
+            result.push_back(leaf->values[j - 1]);
+          }
+        }
+      } else {
+        CollectRange(entry.second, level + 1, child_low, child_high, forward,
+                     stack, result, need_restart);
+        if (need_restart) return;
+      }
+    }
+    stack.resize(begin);
+  }
+
+  ARTNode *const root_;
+
+  ValueEqualityChecker value_equals_;
+
+  std::atomic<size_t> memory_footprint_;
+
+  ARTEpochManager epoch_manager_;
+};
+
+}  // End index namespace
+}  // End peloton namespace
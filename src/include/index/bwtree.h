@@ -7637,6 +7637,54 @@ before_switch:
     return;
   }
 
+  /*
+   * GetValueBatch() - Fill a value list with the values of many keys
+   *
+   * The keys must be sorted. A leaf page is loaded once for all the keys
+   * that fall into it, and the tree is only traversed again for a key that
+   * is beyond the loaded page. The values of each key are appended to the
+   * value list in key order, and the offset of the first value of each key
+   * is appended to the offset list
+   */
+  void GetValueBatch(const std::vector<KeyType> &search_key_list,
+                     std::vector<ValueType> &value_list,
+                     std::vector<size_t> &offset_list) {
+    bwt_printf("GetValueBatch()\n");
+
+    size_t offset_base = offset_list.size();
+
+    ForwardIterator it{};
+    for(size_t i = 0;i < search_key_list.size();i++) {
+      const KeyType &search_key = search_key_list[i];
+      offset_list.push_back(value_list.size());
+
+      // The iterator has already moved past the values of a repeated key
+      if((i > 0) && (KeyCmpEqual(search_key, search_key_list[i - 1]) == true)) {
+        size_t prev_offset = offset_list[offset_base + i - 1];
+        size_t prev_end = offset_list[offset_base + i];
+        for(size_t j = prev_offset;j < prev_end;j++) {
+          value_list.push_back(value_list[j]);
+        }
+
+        continue;
+      }
+
+      if(it.SeekInPage(search_key) == false) {
+        // Copy assignment releases the page held by the old iterator
+        ForwardIterator next_it{this, search_key};
+        it = next_it;
+      }
+
+      while((it.IsEnd() == false) &&
+            (KeyCmpEqual(it->first, search_key) == true)) {
+        value_list.push_back(it->second);
+        ++it;
+      }
+    }
+
+    return;
+  }
+
   /*
    * GetValue() - Return value in a ValueSet object
    *
@@ -8982,6 +9030,48 @@ try_join_again:
       return &*kv_p;
     }
 
+    /*
+     * SeekInPage() - Moves the iterator to the first item whose key is >= the
+     *                given key if the cached leaf page holds that item
+     *
+     * The key must not be smaller than the current key. This is how a batch
+     * of sorted lookups shares one leaf page. If the item is not on the
+     * cached page the iterator is not moved and false is returned, and the
+     * caller should locate the key from the root
+     */
+    bool SeekInPage(const KeyType &start_key) {
+      if(ic_p == nullptr) {
+        return false;
+      }
+
+      LeafNode *leaf_node_p = ic_p->GetLeafNode();
+      BwTree *tree_p = ic_p->GetTree();
+
+      // Keys at or above the high key belong to the next pages
+      if((leaf_node_p->GetNextNodeID() != INVALID_NODE_ID) &&
+         (tree_p->KeyCmpGreaterEqual(start_key,
+                                     leaf_node_p->GetHighKey()) == true)) {
+        return false;
+      }
+
+      KeyValuePair *new_kv_p = \
+        std::lower_bound(kv_p,
+                         leaf_node_p->End(),
+                         std::make_pair(start_key, ValueType{}),
+                         tree_p->key_value_pair_cmp_obj);
+
+      // Moving past the last item of the page means loading the next page,
+      // which is left to the caller
+      if((new_kv_p == leaf_node_p->End()) &&
+         (leaf_node_p->GetNextNodeID() != INVALID_NODE_ID)) {
+        return false;
+      }
+
+      kv_p = new_kv_p;
+
+      return true;
+    }
+
     /*
      * operator< - Compares two iterators by comparing their current key
      *
@@ -96,6 +96,10 @@ class BWTreeIndex : public Index {
   void ScanKey(const storage::Tuple *key,
                std::vector<ValueType> &result);
 
+  void ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                    std::vector<ValueType> &result,
+                    std::vector<size_t> &offsets);
+
   std::string GetTypeName() const;
 
   // TODO: Implement this
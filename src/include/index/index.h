@@ -102,6 +102,17 @@ class IndexMetadata : public Printable {
 
   bool HasUniqueKeys() const { return unique_keys; }
 
+  /*
+   * Whether the index keeps only a prefix of long keys. Such an index may
+   * return keys that do not match a scan, and does not keep the keys that
+   * share the prefix in order
+   */
+  bool HasTruncatedKeys() const { return truncated_keys_; }
+
+  void SetTruncatedKeys(bool truncated_keys) {
+    truncated_keys_ = truncated_keys;
+  }
+
   /*
    * GetKeyAttrs() - Returns the mapping relation between indexed columns
    *                 and base table columns
@@ -181,6 +192,9 @@ class IndexMetadata : public Printable {
   // Whether keys are unique (e.g. primary key)
   bool unique_keys;
 
+  // Whether long keys are cut to a prefix (see NormalizedKey)
+  bool truncated_keys_ = false;
+
   // utility of an index
   double utility_ratio = INVALID_RATIO;
 
@@ -283,6 +297,13 @@ class Index : public Printable {
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer *> &result) = 0;
 
+  // Looks up many keys at once. The result of keys[i] is stored in
+  // result[offsets[i]] to result[offsets[i + 1]], and offsets has one more
+  // entry than keys. Indexes that can share work between keys override this
+  virtual void ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                            std::vector<ItemPointer *> &result,
+                            std::vector<size_t> &offsets);
+
   ///////////////////////////////////////////////////////////////////
   // Garbage Collection
   ///////////////////////////////////////////////////////////////////
@@ -332,6 +353,8 @@ class Index : public Printable {
    */
   bool HasUniqueKeys() const { return metadata->HasUniqueKeys(); }
 
+  bool HasTruncatedKeys() const { return metadata->HasTruncatedKeys(); }
+
   oid_t GetColumnCount() const { return metadata->GetColumnCount(); }
 
   const std::string &GetName() const { return metadata->GetName(); }
@@ -40,6 +40,8 @@ class IndexFactory {
 
   static Index *GetBwTreeGenericKeyIndex(IndexMetadata *metadata);
 
+  static Index *GetBwTreeNormalizedKeyIndex(IndexMetadata *metadata);
+
   //===--------------------------------------------------------------------===//
   // PELOTON::SKIPLIST
   //===--------------------------------------------------------------------===//
@@ -47,6 +49,16 @@ class IndexFactory {
   static Index *GetSkipListIntsKeyIndex(IndexMetadata *metadata);
 
   static Index *GetSkipListGenericKeyIndex(IndexMetadata *metadata);
+
+  static Index *GetSkipListNormalizedKeyIndex(IndexMetadata *metadata);
+
+  //===--------------------------------------------------------------------===//
+  // PELOTON::ART
+  //===--------------------------------------------------------------------===//
+
+  static Index *GetARTIntsKeyIndex(IndexMetadata *metadata);
+
+  static Index *GetARTNormalizedKeyIndex(IndexMetadata *metadata);
 };
 
 }  // End index namespace
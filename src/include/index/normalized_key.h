@@ -0,0 +1,296 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// normalized_key.h
+//
+// Identification: src/include/index/normalized_key.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include <boost/functional/hash.hpp>
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "common/macros.h"
+#include "storage/tuple.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace index {
+
+// This is the largest NormalizedKey that we instantiate. Longer keys are
+// either cut to this size or kept in a TupleKey, see IndexFactory
+#define NORMALIZED_KEY_MAX_SIZE 256
+
+/*
+ * class NormalizedKeyUtil - Tells whether a key schema can be normalized
+ */
+class NormalizedKeyUtil {
+ public:
+  /*
+   * GetMaxKeySize() - Returns the largest encoding of a key of this schema,
+   *                   or 0 if one of its columns cannot be normalized
+   */
+  static size_t GetMaxKeySize(const catalog::Schema *key_schema) {
+    size_t key_size = 0;
+    for (const auto &column : key_schema->GetColumns()) {
+      switch (column.GetType()) {
+        case type::Type::BOOLEAN:
+        case type::Type::TINYINT:
+          key_size += sizeof(int8_t);
+          break;
+        case type::Type::SMALLINT:
+          key_size += sizeof(int16_t);
+          break;
+        case type::Type::INTEGER:
+          key_size += sizeof(int32_t);
+          break;
+        case type::Type::BIGINT:
+        case type::Type::DECIMAL:
+        case type::Type::TIMESTAMP:
+          key_size += sizeof(int64_t);
+          break;
+        case type::Type::VARCHAR:
+        case type::Type::VARBINARY:
+          // Marker, declared length and terminator
+          key_size += static_cast<size_t>(column.GetLength()) + 2;
+          break;
+        default:
+          return 0;
+      }
+    }
+    return key_size;
+  }
+};
+
+/*
+ * NormalizedKey - Index key encoded so that memcmp() gives its order
+ *
+ * GenericKey keeps the columns as they are in a tuple and compares them one
+ * by one through the type system. This key instead stores every column in a
+ * form whose bytes sort like the values do, so the comparator, the equality
+ * checker and the hasher of the index only ever see a flat byte array:
+ *
+ *   - integers and booleans are big-endian with the sign bit flipped;
+ *   - decimals are the big-endian bits of the double, with the sign bit
+ *     flipped if it is clear and every bit flipped if it is set;
+ *   - timestamps are big-endian;
+ *   - strings are a marker byte, their bytes up to the first NUL and a NUL.
+ *     This is the order of strncmp() in TypeUtil::CompareStrings(), which
+ *     also ignores what follows an embedded NUL.
+ *
+ * Nulls of fixed length types are the smallest value of the type, and are
+ * encoded like any other value, so they sort first. A null string has a
+ * marker of its own that sorts after every string, because the scan
+ * optimizer uses it as the largest VARCHAR (see Type::GetMaxValue()).
+ *
+ * Every column is self-delimiting, so the zero padding at the end never
+ * decides the order of two keys of the same schema.
+ *
+ * A key longer than KeySize is cut at KeySize bytes. The cut keeps the order
+ * but may make different keys equal, so IndexFactory only lets that happen
+ * to indexes without unique keys and marks them with
+ * IndexMetadata::HasTruncatedKeys(). Their scans then return a superset of
+ * the matches, which the index scan executor checks against the tuples.
+ * Strings are not held to their declared length, so every key with a string
+ * counts as one that may be cut.
+ */
+template <size_t KeySize>
+class NormalizedKey {
+ public:
+  static_assert(KeySize % sizeof(uint64_t) == 0,
+                "Please align the size of normalized key");
+
+  // This is the actual byte size of the key
+  static constexpr size_t key_size_byte = KeySize;
+
+  /*
+   * SetFromKey() - Encodes the key columns of a tuple
+   */
+  inline void SetFromKey(const storage::Tuple *tuple) {
+    PL_ASSERT(tuple != nullptr);
+
+    const catalog::Schema *key_schema = tuple->GetSchema();
+    size_t offset = 0;
+    for (oid_t column_id = 0; column_id < key_schema->GetColumnCount();
+         column_id++) {
+      offset = AppendValue(tuple->GetValue(column_id), offset);
+    }
+
+    PL_MEMSET(key_data + offset, 0, KeySize - offset);
+  }
+
+  inline const unsigned char *GetRawData() const { return key_data; }
+
+  /*
+   * Compare() - Returns negative, zero or positive like memcmp()
+   */
+  static inline int Compare(const NormalizedKey<KeySize> &lhs,
+                            const NormalizedKey<KeySize> &rhs) {
+    return memcmp(lhs.key_data, rhs.key_data, KeySize);
+  }
+
+  static inline bool LessThan(const NormalizedKey<KeySize> &lhs,
+                              const NormalizedKey<KeySize> &rhs) {
+    return Compare(lhs, rhs) < 0;
+  }
+
+  static inline bool Equals(const NormalizedKey<KeySize> &lhs,
+                            const NormalizedKey<KeySize> &rhs) {
+    return Compare(lhs, rhs) == 0;
+  }
+
+ private:
+  // Marker of a string
+  static const unsigned char string_marker = 0x01;
+
+  // Marker of a null string, which sorts after every string
+  static const unsigned char null_string_marker = 0x02;
+
+  /*
+   * Append() - Copies as many bytes as still fit and returns the new offset
+   */
+  inline size_t Append(const void *bytes, size_t length, size_t offset) {
+    length = std::min(length, KeySize - offset);
+    PL_MEMCPY(key_data + offset, bytes, length);
+    return offset + length;
+  }
+
+  inline size_t AppendByte(unsigned char byte, size_t offset) {
+    return Append(&byte, 1, offset);
+  }
+
+  inline size_t AppendValue(const type::Value &value, size_t offset) {
+    switch (value.GetTypeId()) {
+      case type::Type::BOOLEAN:
+      case type::Type::TINYINT:
+        return AppendByte(static_cast<uint8_t>(value.GetAs<int8_t>()) ^ 0x80,
+                          offset);
+      case type::Type::SMALLINT: {
+        uint16_t bits = htobe16(
+            static_cast<uint16_t>(value.GetAs<int16_t>()) ^ 0x8000);
+        return Append(&bits, sizeof(bits), offset);
+      }
+      case type::Type::INTEGER: {
+        uint32_t bits = htobe32(
+            static_cast<uint32_t>(value.GetAs<int32_t>()) ^ 0x80000000U);
+        return Append(&bits, sizeof(bits), offset);
+      }
+      case type::Type::BIGINT: {
+        uint64_t bits = htobe64(static_cast<uint64_t>(value.GetAs<int64_t>()) ^
+                                0x8000000000000000ULL);
+        return Append(&bits, sizeof(bits), offset);
+      }
+      case type::Type::DECIMAL: {
+        double decimal = value.GetAs<double>();
+        // -0.0 and 0.0 are the same key
+        if (decimal == 0) {
+          decimal = 0;
+        }
+        uint64_t bits;
+        PL_MEMCPY(&bits, &decimal, sizeof(bits));
+        if ((bits & 0x8000000000000000ULL) != 0) {
+          bits = ~bits;
+        } else {
+          bits |= 0x8000000000000000ULL;
+        }
+        bits = htobe64(bits);
+        return Append(&bits, sizeof(bits), offset);
+      }
+      case type::Type::TIMESTAMP: {
+        uint64_t bits = htobe64(value.GetAs<uint64_t>());
+        return Append(&bits, sizeof(bits), offset);
+      }
+      case type::Type::VARCHAR:
+      case type::Type::VARBINARY: {
+        if (value.IsNull()) {
+          return AppendByte(null_string_marker, offset);
+        }
+        offset = AppendByte(string_marker, offset);
+        const char *data = value.GetData();
+        offset = Append(data, strnlen(data, value.GetLength()), offset);
+        return AppendByte(0, offset);
+      }
+      default:
+        throw IndexException("Type " +
+                             TypeIdToString(value.GetTypeId()) +
+                             " cannot be normalized");
+    }
+  }
+
+  // This is the array we use for storing the encoded columns
+  unsigned char key_data[KeySize];
+};
+
+/*
+ * class NormalizedComparator - Compares two normalized keys
+ */
+template <size_t KeySize>
+class NormalizedComparator {
+ public:
+  NormalizedComparator() {}
+  NormalizedComparator(const NormalizedComparator &) {}
+
+  /*
+   * operator()() - Returns true if lhs < rhs
+   */
+  inline bool operator()(const NormalizedKey<KeySize> &lhs,
+                         const NormalizedKey<KeySize> &rhs) const {
+    return NormalizedKey<KeySize>::LessThan(lhs, rhs);
+  }
+};
+
+/*
+ * class NormalizedEqualityChecker - Compares whether two normalized keys are
+ *                                   equivalent
+ */
+template <size_t KeySize>
+class NormalizedEqualityChecker {
+ public:
+  NormalizedEqualityChecker() {}
+  NormalizedEqualityChecker(const NormalizedEqualityChecker &) {}
+
+  inline bool operator()(const NormalizedKey<KeySize> &lhs,
+                         const NormalizedKey<KeySize> &rhs) const {
+    return NormalizedKey<KeySize>::Equals(lhs, rhs);
+  }
+};
+
+/*
+ * class NormalizedHasher - Hash function for normalized key
+ */
+template <size_t KeySize>
+class NormalizedHasher {
+ public:
+  // Make sure there is no other field
+  static_assert(sizeof(NormalizedKey<KeySize>) == KeySize,
+                "Extra fields detected in class NormalizedKey");
+
+  NormalizedHasher() {}
+  NormalizedHasher(const NormalizedHasher &) {}
+
+  /*
+   * operator()() - Hashes the key 8 bytes at a time
+   */
+  inline size_t operator()(NormalizedKey<KeySize> const &p) const {
+    size_t seed = 0UL;
+    for (size_t i = 0; i < KeySize; i += sizeof(uint64_t)) {
+      uint64_t word;
+      PL_MEMCPY(&word, p.GetRawData() + i, sizeof(word));
+      boost::hash_combine(seed, word);
+    }
+
+    return seed;
+  }
+};
+
+}  // End index namespace
+}  // End peloton namespace
@@ -16,8 +16,13 @@
 
 namespace peloton {
 
+namespace expression {
+class AbstractExpression;
+}
+
 namespace optimizer {
 class ColumnManager;
+class Memo;
 }
 
 namespace optimizer {
@@ -25,12 +30,14 @@ namespace optimizer {
 // Generate child property requirements for physical operators
 class ChildPropertyGenerator : public OperatorVisitor {
  public:
-  ChildPropertyGenerator(ColumnManager &manager) : manager_(manager) {}
+  ChildPropertyGenerator(ColumnManager &manager, Memo &memo)
+      : manager_(manager), memo_(memo) {}
 
   std::vector<std::pair<PropertySet, std::vector<PropertySet>>> GetProperties(
       std::shared_ptr<GroupExpression> gexpr, PropertySet requirements);
 
   void Visit(const PhysicalScan *) override;
+  void Visit(const PhysicalIndexScan *) override;
   void Visit(const PhysicalProject *) override;
   void Visit(const PhysicalOrderBy *) override;
   void Visit(const PhysicalLimit *) override;
@@ -43,12 +50,24 @@ class ChildPropertyGenerator : public OperatorVisitor {
   void Visit(const PhysicalLeftHashJoin *) override;
   void Visit(const PhysicalRightHashJoin *) override;
   void Visit(const PhysicalOuterHashJoin *) override;
+  void Visit(const PhysicalInnerMergeJoin *) override;
   void Visit(const PhysicalInsert *) override;
   void Visit(const PhysicalDelete *) override;
   void Visit(const PhysicalUpdate *) override;
 
  private:
+  // Columns and predicates of a scan, and the required sort if the scan
+  // outputs the tuples in that order
+  void GenerateScanProperties(const bool &provides_sort);
+
+  // Split the required columns and predicates of a join between its children
+  void GenerateJoinProperties(
+      const std::vector<std::shared_ptr<expression::AbstractExpression>> &
+          join_predicates);
+
   ColumnManager &manager_;
+  Memo &memo_;
+  std::shared_ptr<GroupExpression> gexpr_;
   PropertySet requirements_;
   std::vector<std::pair<PropertySet, std::vector<PropertySet>>> output_;
 };
@@ -20,6 +20,10 @@ namespace optimizer {
 class ColumnManager;
 }
 
+namespace storage {
+class DataTable;
+}
+
 namespace optimizer {
 
 // Derive cost and stats for a physical operator
@@ -41,6 +45,7 @@ class CostAndStatsCalculator : public OperatorVisitor {
   inline double GetOutputCost() { return output_cost_; }
 
   void Visit(const PhysicalScan *) override;
+  void Visit(const PhysicalIndexScan *) override;
   void Visit(const PhysicalProject *) override;
   void Visit(const PhysicalOrderBy *) override;
   void Visit(const PhysicalLimit *) override;
@@ -53,11 +58,33 @@ class CostAndStatsCalculator : public OperatorVisitor {
   void Visit(const PhysicalLeftHashJoin *) override;
   void Visit(const PhysicalRightHashJoin *) override;
   void Visit(const PhysicalOuterHashJoin *) override;
+  void Visit(const PhysicalInnerMergeJoin *) override;
   void Visit(const PhysicalInsert *) override;
   void Visit(const PhysicalDelete *) override;
   void Visit(const PhysicalUpdate *) override;
 
  private:
+  // Returns 1 when the child has no stats
+  double GetChildCardinality(const size_t &child_offset);
+
+  // Total cost of the children
+  double GetChildCost();
+
+  // Distinct values of a column in its table stats, 0 if unknown
+  double GetDistinctCount(const expression::AbstractExpression *expr);
+
+  // Tuples read by a scan of the whole table, times the cost of reading one
+  void CalculateScanCostAndStats(storage::DataTable *table,
+                                 const double &cost_factor);
+
+  enum class JoinAlgorithm { NESTED_LOOP, HASH, MERGE };
+
+  void CalculateJoinCostAndStats(
+      const JoinAlgorithm &algorithm, const bool &keep_left,
+      const bool &keep_right,
+      const std::vector<std::shared_ptr<expression::AbstractExpression>> &
+          join_predicates = {});
+
   ColumnManager &manager_;
 
   // We cannot use reference here because otherwise we have to initialize them
@@ -17,6 +17,7 @@
 #include "optimizer/property.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace peloton {
@@ -49,6 +50,14 @@ class Group {
   inline void SetImplementationFlag() { has_implemented_ = true; }
   inline bool HasImplemented() { return has_implemented_; }
 
+  // Tables whose rows the expressions of the group produce
+  inline void SetTableOids(std::unordered_set<oid_t> table_oids) {
+    table_oids_ = std::move(table_oids);
+  }
+  inline const std::unordered_set<oid_t> &GetTableOids() const {
+    return table_oids_;
+  }
+
  private:
   GroupID id_;
   std::vector<Operator> items_;
@@ -62,6 +71,8 @@ class Group {
 
   // Whether physical operators have been implemented for this group
   bool has_implemented_;
+
+  std::unordered_set<oid_t> table_oids_;
 };
 
 } /* namespace optimizer */
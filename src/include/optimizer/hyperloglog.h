@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hyperloglog.h
+//
+// Identification: src/include/optimizer/hyperloglog.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace peloton {
+namespace optimizer {
+
+//===--------------------------------------------------------------------===//
+// HyperLogLog
+//===--------------------------------------------------------------------===//
+
+/**
+ * Sketch of the number of distinct values in a stream of hashes (Flajolet et
+ * al., with the small and large range corrections). With the default
+ * precision it takes 4KB and is off by about 1.6%.
+ */
+class HyperLogLog {
+ public:
+  explicit HyperLogLog(const uint8_t &precision = 12);
+
+  void Add(const uint64_t &hash);
+
+  // Fold in the values seen by another sketch of the same precision
+  void Merge(const HyperLogLog &other);
+
+  double Estimate() const;
+
+ private:
+  uint8_t precision_;
+
+  // Longest run of leading zeros (plus one) seen in each bucket
+  std::vector<uint8_t> registers_;
+};
+
+}  // namespace optimizer
+}  // namespace peloton
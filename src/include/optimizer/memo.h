@@ -59,6 +59,10 @@ class Memo {
  private:
   GroupID AddNewGroup();
 
+  // The tables of a new group are those of its first expression
+  std::unordered_set<oid_t> DeriveTableOids(
+      std::shared_ptr<GroupExpression> gexpr);
+
   std::unordered_set<GroupExpression*, GExprPtrHash, GExprPtrEq>
       group_expressions_;
   std::vector<Group> groups_;
@@ -43,6 +43,7 @@ enum class OpType {
   LogicalPhysicalDelimiter,
   // Physical ops
   Scan,
+  IndexScan,
   Project,
   OrderBy,
   PhysicalLimit,
@@ -56,6 +57,7 @@ enum class OpType {
   LeftHashJoin,
   RightHashJoin,
   OuterHashJoin,
+  InnerMergeJoin,
   Insert,
   Delete,
   Update
@@ -16,14 +16,27 @@
 
 namespace peloton {
 
+namespace catalog {
+class Schema;
+}
+
+namespace expression {
+class AbstractExpression;
+}
+
 namespace planner {
 class AbstractPlan;
 class HashJoinPlan;
 class NestedLoopJoinPlan;
+class ProjectInfo;
 class ProjectionPlan;
 class SeqScanPlan;
 }
 
+namespace storage {
+class DataTable;
+}
+
 namespace optimizer {
 class OperatorExpression;
 }
@@ -44,6 +57,8 @@ class OperatorToPlanTransformer : public OperatorVisitor {
 
   void Visit(const PhysicalScan *op) override;
 
+  void Visit(const PhysicalIndexScan *op) override;
+
   void Visit(const PhysicalProject *) override;
 
   void Visit(const PhysicalOrderBy *) override;
@@ -68,17 +83,39 @@ class OperatorToPlanTransformer : public OperatorVisitor {
 
   void Visit(const PhysicalOuterHashJoin *) override;
 
+  void Visit(const PhysicalInnerMergeJoin *) override;
+
   void Visit(const PhysicalInsert *) override;
 
   void Visit(const PhysicalDelete *) override;
 
   void Visit(const PhysicalUpdate *) override;
 
-
-
  private:
   void VisitOpExpression(std::shared_ptr<OperatorExpression> op);
 
+  // Find which child outputs a column and at which offset
+  bool FindChildColumn(const std::tuple<oid_t, oid_t, oid_t> &column,
+                       oid_t &child_idx, oid_t &offset) const;
+
+  // Columns a scan of the table outputs
+  void GenerateScanColumns(storage::DataTable *table,
+                           std::vector<oid_t> &column_ids);
+
+  // A copy of the predicate of a scan, or nullptr
+  expression::AbstractExpression *GenerateScanPredicate() const;
+
+  // Projection and schema of the output of a join
+  void GenerateJoinProjection(
+      std::unique_ptr<const planner::ProjectInfo> &proj_info,
+      std::shared_ptr<const catalog::Schema> &schema);
+
+  // AND the join predicates together, with their columns pointing into the
+  // output of the children
+  expression::AbstractExpression *GenerateJoinPredicate(
+      const std::vector<std::shared_ptr<expression::AbstractExpression>> &
+          join_predicates) const;
+
   std::unique_ptr<planner::AbstractPlan> output_plan_;
   std::vector<std::unique_ptr<planner::AbstractPlan>> children_plans_;
   PropertySet *requirements_;
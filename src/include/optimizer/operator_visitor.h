@@ -26,6 +26,7 @@ class OperatorVisitor {
   virtual ~OperatorVisitor(){};
 
   virtual void Visit(const PhysicalScan *) = 0;
+  virtual void Visit(const PhysicalIndexScan *) = 0;
   virtual void Visit(const PhysicalProject *) = 0;
   virtual void Visit(const PhysicalOrderBy *) = 0;
   virtual void Visit(const PhysicalLimit *) = 0;
@@ -38,6 +39,7 @@ class OperatorVisitor {
   virtual void Visit(const PhysicalLeftHashJoin *) = 0;
   virtual void Visit(const PhysicalRightHashJoin *) = 0;
   virtual void Visit(const PhysicalOuterHashJoin *) = 0;
+  virtual void Visit(const PhysicalInnerMergeJoin *) = 0;
   virtual void Visit(const PhysicalInsert *) = 0;
   virtual void Visit(const PhysicalDelete *) = 0;
   virtual void Visit(const PhysicalUpdate *) = 0;
@@ -18,6 +18,8 @@
 #include "optimizer/operator_node.h"
 #include "optimizer/util.h"
 
+#include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace peloton {
@@ -37,9 +39,14 @@ class PropertySort;
 //===--------------------------------------------------------------------===//
 class LeafOperator : OperatorNode<LeafOperator> {
  public:
-  static Operator make(GroupID group);
+  static Operator make(GroupID group,
+                       std::unordered_set<oid_t> table_oids = {});
 
   GroupID origin_group;
+
+  // Tables of the origin group, so that rules can tell which side of a join
+  // a predicate refers to
+  std::unordered_set<oid_t> table_oids;
 };
 
 //===--------------------------------------------------------------------===//
@@ -70,9 +77,13 @@ class LogicalFilter : public OperatorNode<LogicalFilter> {
 //===--------------------------------------------------------------------===//
 class LogicalInnerJoin : public OperatorNode<LogicalInnerJoin> {
  public:
-  static Operator make(expression::AbstractExpression *condition = nullptr);
+  static Operator make(
+      std::vector<std::shared_ptr<expression::AbstractExpression>>
+          join_predicates = {});
 
-  expression::AbstractExpression *condition;
+  // Conjuncts that refer to both sides of the join and to no table outside of
+  // it. Each one holds the bound column references of the query.
+  std::vector<std::shared_ptr<expression::AbstractExpression>> join_predicates;
 };
 
 //===--------------------------------------------------------------------===//
@@ -188,6 +199,24 @@ class PhysicalScan : public OperatorNode<PhysicalScan> {
   storage::DataTable *table_;
 };
 
+//===--------------------------------------------------------------------===//
+// IndexScan
+//===--------------------------------------------------------------------===//
+class PhysicalIndexScan : public OperatorNode<PhysicalIndexScan> {
+ public:
+  static Operator make(storage::DataTable *table, oid_t index_offset);
+
+  bool operator==(const BaseOperatorNode &r) override;
+
+  hash_t Hash() const override;
+
+  storage::DataTable *table_;
+
+  // Offset of the index among the indexes of the table. The scan reads the
+  // whole index, so its output is in key order.
+  oid_t index_offset_;
+};
+
 //===--------------------------------------------------------------------===//
 // PhysicalProject
 //===--------------------------------------------------------------------===//
@@ -232,7 +261,11 @@ class PhysicalFilter : public OperatorNode<PhysicalFilter> {
 //===--------------------------------------------------------------------===//
 class PhysicalInnerNLJoin : public OperatorNode<PhysicalInnerNLJoin> {
  public:
-  static Operator make();
+  static Operator make(
+      std::vector<std::shared_ptr<expression::AbstractExpression>>
+          join_predicates);
+
+  std::vector<std::shared_ptr<expression::AbstractExpression>> join_predicates;
 };
 
 //===--------------------------------------------------------------------===//
@@ -264,7 +297,11 @@ class PhysicalOuterNLJoin : public OperatorNode<PhysicalOuterNLJoin> {
 //===--------------------------------------------------------------------===//
 class PhysicalInnerHashJoin : public OperatorNode<PhysicalInnerHashJoin> {
  public:
-  static Operator make();
+  static Operator make(
+      std::vector<std::shared_ptr<expression::AbstractExpression>>
+          join_predicates);
+
+  std::vector<std::shared_ptr<expression::AbstractExpression>> join_predicates;
 };
 
 //===--------------------------------------------------------------------===//
@@ -291,6 +328,20 @@ class PhysicalOuterHashJoin : public OperatorNode<PhysicalOuterHashJoin> {
   static Operator make();
 };
 
+//===--------------------------------------------------------------------===//
+// InnerMergeJoin
+//===--------------------------------------------------------------------===//
+class PhysicalInnerMergeJoin : public OperatorNode<PhysicalInnerMergeJoin> {
+ public:
+  static Operator make(
+      std::vector<std::shared_ptr<expression::AbstractExpression>>
+          join_predicates);
+
+  // Equalities between a column of each side, which the children are sorted
+  // on
+  std::vector<std::shared_ptr<expression::AbstractExpression>> join_predicates;
+};
+
 //===--------------------------------------------------------------------===//
 // PhysicalInsert
 //===--------------------------------------------------------------------===//
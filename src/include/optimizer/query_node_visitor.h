@@ -25,6 +25,7 @@ class ExecuteStatement;
 class TransactionStatement;
 class UpdateStatement;
 class CopyStatement;
+class AnalyzeStatement;
 struct JoinDefinition;
 struct TableRef;
 
@@ -61,6 +62,7 @@ class QueryNodeVisitor {
   virtual void Visit(const parser::TransactionStatement *) = 0;
   virtual void Visit(const parser::UpdateStatement *) = 0;
   virtual void Visit(const parser::CopyStatement *) = 0;
+  virtual void Visit(const parser::AnalyzeStatement *) = 0;
 };
 
 } /* namespace optimizer */
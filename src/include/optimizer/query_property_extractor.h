@@ -52,8 +52,13 @@ class QueryPropertyExtractor : public SqlNodeVisitor {
   void Visit(const parser::TransactionStatement *) override;
   void Visit(const parser::UpdateStatement *) override;
   void Visit(const parser::CopyStatement *) override;
+  void Visit(const parser::AnalyzeStatement *) override;
 
  private:
+  // Properties of a select over several tables, whose columns are identified
+  // by their bound oids
+  void VisitJoinSelect(const parser::SelectStatement *select_stmt);
+
   ColumnManager &manager_;
 
   // Required properties by the visitor
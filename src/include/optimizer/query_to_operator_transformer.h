@@ -12,10 +12,19 @@
 
 #pragma once
 
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
 #include "common/sql_node_visitor.h"
+#include "type/types.h"
 
 namespace peloton {
 
+namespace expression {
+class AbstractExpression;
+}
+
 namespace parser {}
 
 namespace optimizer {
@@ -50,11 +59,30 @@ class QueryToOperatorTransformer : public SqlNodeVisitor {
   void Visit(const parser::TransactionStatement *op) override;
   void Visit(const parser::UpdateStatement *op) override;
   void Visit(const parser::CopyStatement *op) override;
+  void Visit(const parser::AnalyzeStatement *op) override;
 
  private:
+  // Keep the conjuncts of a predicate that refer to more than one table, to
+  // be evaluated by the lowest join over all of those tables
+  void CollectJoinPredicates(expression::AbstractExpression *predicate);
+
+  // Take the collected conjuncts that only refer to the given tables
+  std::vector<std::shared_ptr<expression::AbstractExpression>>
+  ExtractJoinPredicates(const std::unordered_set<oid_t> &table_oids);
+
+  // Join two operators on the collected conjuncts they cover
+  std::shared_ptr<OperatorExpression> MakeInnerJoin(
+      std::shared_ptr<OperatorExpression> left_expr,
+      const std::unordered_set<oid_t> &left_table_oids,
+      std::shared_ptr<OperatorExpression> right_expr);
+
   ColumnManager &manager_;
 
   std::shared_ptr<OperatorExpression> output_expr;
+  // Tables below output_expr
+  std::unordered_set<oid_t> output_table_oids_;
+  std::vector<std::shared_ptr<expression::AbstractExpression>>
+      join_predicates_;
   // For expr nodes
   type::Type::TypeId output_type;
   int output_size;
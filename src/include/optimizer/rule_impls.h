@@ -32,6 +32,21 @@ class InnerJoinCommutativity : public Rule {
       const override;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+/// InnerJoinAssociativity
+/// (A join B) join C => A join (B join C), with the predicates that only refer
+/// to B and C moved to the new join
+class InnerJoinAssociativity : public Rule {
+ public:
+  InnerJoinAssociativity();
+
+  bool Check(std::shared_ptr<OperatorExpression> plan) const override;
+
+  void Transform(std::shared_ptr<OperatorExpression> input,
+                 std::vector<std::shared_ptr<OperatorExpression>> &transformed)
+      const override;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 /// GetToScan
 class GetToScan : public Rule {
@@ -45,6 +60,21 @@ class GetToScan : public Rule {
       const override;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+/// GetToIndexScan
+/// A full scan of each ordered index of the table, for when its key order
+/// saves a sort
+class GetToIndexScan : public Rule {
+ public:
+  GetToIndexScan();
+
+  bool Check(std::shared_ptr<OperatorExpression> plan) const override;
+
+  void Transform(std::shared_ptr<OperatorExpression> input,
+                 std::vector<std::shared_ptr<OperatorExpression>> &transformed)
+      const override;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LogicalFilterToPhysical
 class LogicalFilterToPhysical : public Rule {
@@ -175,6 +205,19 @@ class InnerJoinToInnerHashJoin : public Rule {
       const override;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+/// InnerJoinToInnerMergeJoin
+class InnerJoinToInnerMergeJoin : public Rule {
+ public:
+  InnerJoinToInnerMergeJoin();
+
+  bool Check(std::shared_ptr<OperatorExpression> plan) const override;
+
+  void Transform(std::shared_ptr<OperatorExpression> input,
+                 std::vector<std::shared_ptr<OperatorExpression>> &transformed)
+      const override;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LeftJoinToLeftHashJoin
 class LeftJoinToLeftHashJoin : public Rule {
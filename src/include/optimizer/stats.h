@@ -22,10 +22,16 @@ namespace optimizer {
 //===--------------------------------------------------------------------===//
 class Stats {
  public:
-  Stats(TupleSample *sample) : sample_(sample){};
+  Stats(TupleSample *sample, double cardinality = 1)
+      : sample_(sample), cardinality_(cardinality){};
+
+  // Estimated number of tuples the expression outputs
+  double GetCardinality() const { return cardinality_; }
 
  private:
   TupleSample *sample_;
+
+  double cardinality_;
 };
 
 } /* namespace optimizer */
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// stats_collector.h
+//
+// Identification: src/include/optimizer/stats_collector.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "optimizer/table_stats.h"
+
+namespace peloton {
+
+namespace concurrency {
+class Transaction;
+}
+
+namespace storage {
+class DataTable;
+}
+
+namespace optimizer {
+
+//===--------------------------------------------------------------------===//
+// Stats Collector
+//===--------------------------------------------------------------------===//
+
+/**
+ * Builds the stats of a table for ANALYZE. Up to max_tile_group_count tile
+ * groups are picked at random and scanned; every visible value goes into a
+ * HyperLogLog sketch of its column, and a reservoir sample of the rows is
+ * kept for the most common values and the histograms.
+ *
+ * When the whole table is scanned the sketches give the number of distinct
+ * values directly. Otherwise it is extrapolated from the sample with the
+ * Duj1 estimator of Haas et al.
+ */
+class StatsCollector {
+ public:
+  StatsCollector(const size_t &max_tile_group_count = 256,
+                 const size_t &sample_size = 30000,
+                 const size_t &histogram_bucket_count = 100,
+                 const size_t &most_common_value_count = 10);
+
+  std::shared_ptr<TableStats> CollectTableStats(
+      storage::DataTable *table, concurrency::Transaction *txn,
+      const int64_t &modification_count = 0);
+
+  // Collect the stats of a table and hand them to the catalog
+  static void AnalyzeTable(storage::DataTable *table,
+                           concurrency::Transaction *txn);
+
+ private:
+  ColumnStats BuildColumnStats(const type::Type::TypeId &type_id,
+                               std::vector<type::Value> &sample,
+                               const double &row_count) const;
+
+  size_t max_tile_group_count_;
+
+  size_t sample_size_;
+
+  size_t histogram_bucket_count_;
+
+  size_t most_common_value_count_;
+
+  std::mt19937_64 random_generator_;
+};
+
+}  // namespace optimizer
+}  // namespace peloton
@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_stats.h
+//
+// Identification: src/include/optimizer/table_stats.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace expression {
+class AbstractExpression;
+}
+
+namespace optimizer {
+
+//===--------------------------------------------------------------------===//
+// Column Stats
+//===--------------------------------------------------------------------===//
+
+/**
+ * What ANALYZE learned about the values of one column: the fraction of nulls,
+ * the number of distinct values, the most common values with their
+ * frequencies, and an equi-depth histogram of the remaining values. The
+ * histogram is only kept for numeric columns.
+ */
+class ColumnStats {
+ public:
+  explicit ColumnStats(const type::Type::TypeId &type_id)
+      : type_id(type_id) {}
+
+  // Fraction of the rows for which "column <comparison_type> constant" holds
+  double EstimateSelectivity(const ExpressionType &comparison_type,
+                             const type::Value &constant) const;
+
+  type::Type::TypeId type_id;
+
+  double null_fraction = 0;
+
+  double distinct_count = 0;
+
+  // Sorted by descending frequency
+  std::vector<std::pair<type::Value, double>> most_common_values;
+
+  // Bounds of buckets that each hold the same number of the values that are
+  // not among the most common ones
+  std::vector<double> histogram_bounds;
+
+ private:
+  double EstimateEqualSelectivity(const type::Value &constant) const;
+
+  // Fraction of the rows that are less than (or equal to) the constant
+  double EstimateLessThanSelectivity(const type::Value &constant,
+                                     const bool &or_equal) const;
+};
+
+//===--------------------------------------------------------------------===//
+// Table Stats
+//===--------------------------------------------------------------------===//
+
+class TableStats {
+ public:
+  TableStats(const double &row_count, std::vector<ColumnStats> column_stats,
+             const int64_t &modification_count)
+      : row_count_(row_count),
+        column_stats_(std::move(column_stats)),
+        modification_count_(modification_count) {}
+
+  double GetRowCount() const { return row_count_; }
+
+  // Returns nullptr for columns that were not analyzed
+  const ColumnStats *GetColumnStats(const oid_t &column_id) const {
+    if (column_id >= column_stats_.size()) {
+      return nullptr;
+    }
+    return &column_stats_[column_id];
+  }
+
+  // Inserts, updates and deletes seen by the table metric when analyzed
+  int64_t GetModificationCount() const { return modification_count_; }
+
+  // Fraction of the rows of the table for which the predicate holds
+  double EstimateSelectivity(
+      const expression::AbstractExpression *predicate) const;
+
+ private:
+  double row_count_;
+
+  std::vector<ColumnStats> column_stats_;
+
+  int64_t modification_count_;
+};
+
+}  // namespace optimizer
+}  // namespace peloton
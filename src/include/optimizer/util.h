@@ -14,9 +14,19 @@
 
 #include <cstdlib>
 #include <algorithm>
+#include <memory>
 #include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "type/types.h"
 
 namespace peloton {
+
+namespace expression {
+class AbstractExpression;
+}
+
 namespace optimizer {
 
 using hash_t = std::size_t;
@@ -55,6 +65,31 @@ inline void to_lower_string(std::string &str) {
   std::transform(str.begin(), str.end(), str.begin(), ::tolower);
 }
 
+// Break a predicate into the expressions joined by its top level ANDs
+void SplitPredicates(expression::AbstractExpression *expr,
+                     std::vector<expression::AbstractExpression *> &predicates);
+
+// AND copies of the predicates together, returns nullptr if there are none
+expression::AbstractExpression *CombinePredicates(
+    const std::vector<std::shared_ptr<expression::AbstractExpression>> &
+        predicates);
+expression::AbstractExpression *CombinePredicates(
+    const std::vector<expression::AbstractExpression *> &predicates);
+
+// Oids of the tables whose columns the expression refers to, taken from the
+// bound column references
+void GetPredicateTables(const expression::AbstractExpression *expr,
+                        std::unordered_set<oid_t> &table_oids);
+
+// Whether every table of the subset is in the set
+bool IsSubset(const std::unordered_set<oid_t> &set,
+              const std::unordered_set<oid_t> &subset);
+
+// Fill in the value type and the table column offset of every bound column
+// reference, for expressions over more than one table where the columns
+// cannot be looked up by name in a single schema
+void TransformBoundExpression(expression::AbstractExpression *expr);
+
 } /* namespace util */
 } /* namespace optimizer */
 } /* namespace peloton */
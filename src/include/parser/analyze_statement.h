@@ -0,0 +1,41 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_statement.h
+//
+// Identification: src/include/parser/analyze_statement.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "parser/sql_statement.h"
+#include "parser/table_ref.h"
+#include "common/sql_node_visitor.h"
+
+namespace peloton {
+namespace parser {
+
+/**
+ * @struct AnalyzeStatement
+ * @brief Represents "ANALYZE [table]". Without a table every table of the
+ * default database is analyzed.
+ */
+struct AnalyzeStatement : SQLStatement {
+  AnalyzeStatement()
+      : SQLStatement(StatementType::ANALYZE), analyze_table(nullptr){};
+
+  virtual ~AnalyzeStatement() { delete analyze_table; }
+
+  virtual void Accept(SqlNodeVisitor* v) const override {
+    v->Visit(this);
+  }
+
+  TableRef* analyze_table;
+};
+
+}  // End parser namespace
+}  // End peloton namespace
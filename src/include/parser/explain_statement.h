@@ -0,0 +1,45 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// explain_statement.h
+//
+// Identification: src/include/parser/explain_statement.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "parser/sql_statement.h"
+#include "common/sql_node_visitor.h"
+
+namespace peloton {
+namespace parser {
+
+/**
+ * @struct ExplainStatement
+ * @brief Represents "EXPLAIN [ANALYZE] <statement>". With ANALYZE the
+ * statement is run, and its plan is returned with the runtime statistics of
+ * every executor.
+ */
+struct ExplainStatement : SQLStatement {
+  ExplainStatement()
+      : SQLStatement(StatementType::EXPLAIN),
+        real_sql_stmt(nullptr),
+        analyze(false){};
+
+  virtual ~ExplainStatement() { delete real_sql_stmt; }
+
+  // The visitors only ever see the explained statement
+  virtual void Accept(SqlNodeVisitor* v) const override {
+    real_sql_stmt->Accept(v);
+  }
+
+  SQLStatement* real_sql_stmt;
+  bool analyze;
+};
+
+}  // End parser namespace
+}  // End peloton namespace
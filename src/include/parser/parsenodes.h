@@ -593,6 +593,32 @@ typedef struct CopyStmt
   List	   *options;		/* List of DefElem nodes */
 } CopyStmt;
 
+typedef enum VacuumOption
+{
+  VACOPT_VACUUM = 1 << 0,		/* do VACUUM */
+  VACOPT_ANALYZE = 1 << 1,	/* do ANALYZE */
+  VACOPT_VERBOSE = 1 << 2,	/* print progress info */
+  VACOPT_FREEZE = 1 << 3,		/* FREEZE option */
+  VACOPT_FULL = 1 << 4,		/* FULL (non-concurrent) vacuum */
+  VACOPT_NOWAIT = 1 << 5,		/* don't wait to get lock (autovacuum only) */
+  VACOPT_SKIPTOAST = 1 << 6	/* don't process the TOAST table, if any */
+} VacuumOption;
+
+typedef struct VacuumStmt
+{
+  NodeTag		type;
+  int			options;		/* OR of VacuumOption flags */
+  RangeVar   *relation;		/* single table to process, or NULL */
+  List	   *va_cols;		/* list of column names, or NIL for all */
+} VacuumStmt;
+
+typedef struct ExplainStmt
+{
+  NodeTag		type;
+  Node	   *query;			/* the query to explain */
+  List	   *options;		/* list of DefElem nodes */
+} ExplainStmt;
+
 typedef struct CreatedbStmt
 {
   NodeTag		type;
@@ -172,6 +172,12 @@ class PostgresParser {
 
   // transform helper for execute statement
   static parser::CopyStatement* CopyTransform(CopyStmt* root);
+
+  // transform helper for analyze statement
+  static parser::AnalyzeStatement* AnalyzeTransform(VacuumStmt* root);
+
+  // transform helper for explain statement
+  static parser::ExplainStatement* ExplainTransform(ExplainStmt* root);
 };
 
 }  // End parser namespace
@@ -14,11 +14,13 @@
 
 // This is just for convenience
 
+#include "analyze_statement.h"
 #include "copy_statement.h"
 #include "create_statement.h"
 #include "delete_statement.h"
 #include "drop_statement.h"
 #include "execute_statement.h"
+#include "explain_statement.h"
 #include "insert_statement.h"
 #include "prepare_statement.h"
 #include "select_statement.h"
@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_plan.h
+//
+// Identification: src/include/planner/analyze_plan.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "planner/abstract_plan.h"
+
+namespace peloton {
+namespace storage {
+class DataTable;
+}
+namespace parser {
+struct AnalyzeStatement;
+}
+
+namespace planner {
+class AnalyzePlan : public AbstractPlan {
+ public:
+  AnalyzePlan() = delete;
+  AnalyzePlan(const AnalyzePlan &) = delete;
+  AnalyzePlan &operator=(const AnalyzePlan &) = delete;
+  AnalyzePlan(AnalyzePlan &&) = delete;
+  AnalyzePlan &operator=(AnalyzePlan &&) = delete;
+
+  // A null table analyzes every table of the database
+  explicit AnalyzePlan(storage::DataTable *table,
+                       std::string database_name = DEFAULT_DB_NAME)
+      : target_table_(table), database_name_(database_name) {}
+
+  explicit AnalyzePlan(parser::AnalyzeStatement *parse_tree);
+
+  inline PlanNodeType GetPlanNodeType() const { return PlanNodeType::ANALYZE; }
+
+  const std::string GetInfo() const { return "AnalyzePlan"; }
+
+  std::unique_ptr<AbstractPlan> Copy() const {
+    return std::unique_ptr<AbstractPlan>(
+        new AnalyzePlan(target_table_, database_name_));
+  }
+
+  storage::DataTable *GetTable() const { return target_table_; }
+
+  std::string GetDatabaseName() const { return database_name_; }
+
+ private:
+  // Target Table
+  storage::DataTable *target_table_ = nullptr;
+
+  std::string database_name_;
+};
+}
+}
@@ -154,6 +154,8 @@ class IndexScanPlan : public AbstractScan {
 
   inline bool GetDescend() const { return descend_; }
 
+  inline bool GetKeepKeyOrder() const { return keep_key_order_; }
+
   const std::string GetInfo() const { return "IndexScan"; }
 
   void SetLimit(bool limit) { limit_ = limit; }
@@ -164,6 +166,10 @@ class IndexScanPlan : public AbstractScan {
 
   void SetDescend(bool descend) { descend_ = descend; }
 
+  void SetKeepKeyOrder(bool keep_key_order) {
+    keep_key_order_ = keep_key_order;
+  }
+
   void SetParameterValues(std::vector<type::Value> *values);
 
   std::unique_ptr<AbstractPlan> Copy() const {
@@ -174,8 +180,12 @@ class IndexScanPlan : public AbstractScan {
 
     IndexScanDesc desc(index_, key_column_ids_, expr_types_, values_,
                        new_runtime_keys);
+    // The constructor makes its own copy of the predicate
+    std::unique_ptr<expression::AbstractExpression> predicate(
+        GetPredicate() == nullptr ? nullptr : GetPredicate()->Copy());
     IndexScanPlan *new_plan = new IndexScanPlan(
-        GetTable(), GetPredicate()->Copy(), GetColumnIds(), desc, false);
+        GetTable(), predicate.get(), GetColumnIds(), desc, false);
+    new_plan->SetKeepKeyOrder(keep_key_order_);
     return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
@@ -232,6 +242,10 @@ class IndexScanPlan : public AbstractScan {
 
   // whether order by is descending
   bool descend_ = false;
+
+  // whether the output must follow the order of the index keys, e.g. for a
+  // merge join. The tuples are then not grouped by tile group.
+  bool keep_key_order_ = false;
 };
 
 }  // namespace planner
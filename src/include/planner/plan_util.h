@@ -15,9 +15,13 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "planner/abstract_plan.h"
+#include "planner/abstract_scan_plan.h"
+#include "planner/insert_plan.h"
 #include "planner/populate_index_plan.h"
+#include "storage/data_table.h"
 #include "util/string_util.h"
 
 namespace peloton {
@@ -58,6 +62,54 @@ class PlanUtil {
     }
   }
 
+ public:
+  /**
+   * @brief Describe a single plan node for EXPLAIN.
+   * @param The plan node
+   * @return The node type, and the table of a scan
+   */
+  static std::string GetNodeInfo(const planner::AbstractPlan *plan) {
+    std::string info = plan->GetInfo();
+    switch (plan->GetPlanNodeType()) {
+      case PlanNodeType::SEQSCAN:
+      case PlanNodeType::INDEXSCAN: {
+        auto scan_node = reinterpret_cast<const planner::AbstractScan *>(plan);
+        if (scan_node->GetTable() != nullptr) {
+          info += " on " + scan_node->GetTable()->GetName();
+        }
+        break;
+      }
+      default:
+        break;
+    }
+    return info;
+  }
+
+  /**
+   * @brief Get the plan tree as EXPLAIN returns it.
+   * @param The plan tree
+   * @return One line per plan node, the children indented under their parent
+   */
+  static std::vector<std::string> GetExplainInfo(
+      const planner::AbstractPlan *plan) {
+    std::vector<std::string> lines;
+    if (plan != nullptr) {
+      GetExplainInfo(plan, lines, "");
+    }
+    return lines;
+  }
+
+ private:
+  static void GetExplainInfo(const planner::AbstractPlan *plan,
+                             std::vector<std::string> &lines,
+                             const std::string &prefix) {
+    lines.push_back(prefix + GetNodeInfo(plan));
+    for (auto &child : plan->GetChildren()) {
+      GetExplainInfo(child.get(), lines,
+                     (prefix.empty() ? "  ->  " : "      " + prefix));
+    }
+  }
+
  public:
   /**
    * @brief Get the tables referenced in the plan
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "expression/abstract_expression.h"
+#include "expression/compiled_expression.h"
 #include "storage/tuple.h"
 
 namespace peloton {
@@ -57,9 +58,16 @@ class ProjectInfo {
 
   bool isNonTrivial() const { return target_list_.size() > 0; };
 
+  // The expressions of the target list compiled into bytecode, in order
+  std::vector<std::unique_ptr<expression::CompiledExpression>>
+  CompileTargetList(executor::ExecutorContext *econtext) const;
+
   bool Evaluate(storage::Tuple *dest, const AbstractTuple *tuple1,
                 const AbstractTuple *tuple2,
-                executor::ExecutorContext *econtext) const;
+                executor::ExecutorContext *econtext,
+                const std::vector<std::unique_ptr<
+                    expression::CompiledExpression>> *compiled_targets =
+                    nullptr) const;
 
   bool Evaluate(AbstractTuple *dest, const AbstractTuple *tuple1,
                 const AbstractTuple *tuple2,
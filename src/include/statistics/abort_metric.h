@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// abort_metric.h
+//
+// Identification: src/include/statistics/abort_metric.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "common/item_pointer.h"
+#include "common/platform.h"
+#include "type/types.h"
+#include "statistics/abstract_metric.h"
+#include "statistics/counter_metric.h"
+
+namespace peloton {
+namespace stats {
+
+// A tuple that transactions keep aborting on
+struct HotTuple {
+  oid_t table_id_ = INVALID_OID;
+  // tile group and offset of the tuple
+  ItemPointer location_;
+  // aborts counted on the tuple, an overestimate by at most error_
+  uint64_t count_ = 0;
+  uint64_t error_ = 0;
+};
+
+/**
+ * Metric for the causes of aborted transactions and the tuples they
+ * conflicted on.
+ *
+ * Aborts are counted per cause. The hottest tuples are kept in a fixed
+ * number of slots with the space-saving algorithm: a tuple that is not
+ * tracked yet replaces the one with the fewest aborts and inherits its
+ * count. Any tuple that caused more than 1 / HOT_TUPLE_COUNT of the aborts
+ * is guaranteed to be among them.
+ *
+ * The counters are cumulative like the other counters. The hot tuples are
+ * moved to the aggregator when it aggregates, so its metric holds the
+ * hottest tuples of the last interval.
+ */
+class AbortMetric : public AbstractMetric {
+ public:
+  AbortMetric(MetricType type);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  // Records an abort of the given cause. The table and location are those
+  // of the conflicting tuple, if there was one.
+  void RecordAbort(AbortCauseType cause, oid_t table_id,
+                   const ItemPointer &location);
+
+  inline CounterMetric &GetAbortCount(AbortCauseType cause) {
+    return abort_counts_[static_cast<size_t>(cause)];
+  }
+
+  // Returns the tracked tuples, with the most aborts first
+  std::vector<HotTuple> GetHotTuples() const;
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  void Reset();
+
+  // Adds up the counters, and moves the hot tuples of the source here
+  void Aggregate(AbstractMetric &source);
+
+  const std::string GetInfo() const;
+
+  // Number of tuples tracked
+  static const size_t HOT_TUPLE_COUNT = 16;
+
+ private:
+  // Counts the aborts on a tuple. The caller holds the lock.
+  void CountHotTuple(oid_t table_id, const ItemPointer &location,
+                     uint64_t count, uint64_t error);
+
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  static const size_t CAUSE_COUNT =
+      static_cast<size_t>(AbortCauseType::VALIDATION) + 1;
+
+  // Number of aborts per cause, the unclassified ones under INVALID
+  std::vector<CounterMetric> abort_counts_;
+
+  // The tracked tuples, the first hot_tuple_count_ slots are in use
+  HotTuple hot_tuples_[HOT_TUPLE_COUNT];
+  size_t hot_tuple_count_ = 0;
+
+  // The owner records while the aggregator moves the tuples away
+  mutable Spinlock hot_tuple_lock_;
+};
+
+}  // namespace stats
+}  // namespace peloton
@@ -12,15 +12,18 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <thread>
 #include <sstream>
 #include <unordered_map>
 
 #include "common/platform.h"
+#include "statistics/abort_metric.h"
 #include "statistics/table_metric.h"
 #include "statistics/index_metric.h"
 #include "statistics/latency_metric.h"
+#include "statistics/phase_metric.h"
 #include "statistics/database_metric.h"
 #include "statistics/query_metric.h"
 #include "container/cuckoo_map.h"
@@ -49,7 +52,7 @@ class BackendStatsContext {
  public:
   static BackendStatsContext* GetInstance();
 
-  BackendStatsContext(size_t max_latency_history, bool regiser_to_aggregator);
+  BackendStatsContext(bool regiser_to_aggregator);
   ~BackendStatsContext();
 
   //===--------------------------------------------------------------------===//
@@ -80,6 +83,20 @@ class BackendStatsContext {
   // Returns the latency metric
   LatencyMetric& GetTxnLatencyMetric();
 
+  // Returns the latency metric of the completed queries
+  LatencyMetric& GetQueryLatencyMetric();
+
+  // Returns the metric of the abort causes and hot tuples
+  AbortMetric& GetAbortMetric();
+
+  // Number of statement types with phase latencies
+  static const size_t STATEMENT_TYPE_COUNT =
+      static_cast<size_t>(StatementType::EXPLAIN) + 1;
+
+  // Returns the phase latencies of the given statement type, or nullptr if
+  // no statement of the type has completed yet
+  PhaseMetric* GetPhaseMetric(StatementType type);
+
   // Increment the read stat for given tile group
   void IncrementTableReads(oid_t tile_group_id);
 
@@ -111,6 +128,27 @@ class BackendStatsContext {
   // Increment the abortion stat for given database
   void IncrementTxnAborted(oid_t database_id);
 
+  // Record why a txn aborted, and the tuple it conflicted on
+  void RecordAbortCause(AbortCauseType cause, oid_t table_id,
+                        const ItemPointer& location);
+
+  // Start timing a phase of the current statement
+  inline void StartPhase(QueryPhaseType phase) {
+    phase_timers_[static_cast<size_t>(phase) - 1].Start();
+  }
+
+  // Stop timing a phase, and add its time to the current statement
+  inline void EndPhase(QueryPhaseType phase) {
+    phase_timers_[static_cast<size_t>(phase) - 1].Stop();
+  }
+
+  // Set the type of the current statement
+  inline void SetStatementType(StatementType type) { statement_type_ = type; }
+
+  // Record the phase times of the current statement under its type, and
+  // start the next statement
+  void CompleteStatementPhases();
+
   // Initialize the query stat
   void InitQueryMetric(const std::shared_ptr<Statement> statement,
                        const std::shared_ptr<QueryMetric::QueryParams> params);
@@ -174,6 +212,19 @@ class BackendStatsContext {
   // Latencies recorded by this worker
   LatencyMetric txn_latencies_;
 
+  LatencyMetric query_latencies_;
+
+  // Aborts recorded by this worker
+  AbortMetric aborts_;
+
+  // Phase latencies per statement type. A type gets its metric when its
+  // first statement completes, while the aggregator may be reading.
+  std::atomic<PhaseMetric*> phase_metrics_[STATEMENT_TYPE_COUNT];
+
+  // Type of the current statement, and the time it spent in each phase
+  StatementType statement_type_ = StatementType::INVALID;
+  Timer<std::ratio<1, 1000>> phase_timers_[PhaseMetric::PHASE_COUNT];
+
   // Whether this context is registered to the global aggregator
   bool is_registered_to_aggregator_;
 
@@ -187,6 +238,10 @@ class BackendStatsContext {
   // Mark the on going query as completed and move it to completed query queue
   void CompleteQueryMetric();
 
+  // Returns the phase latencies of the given statement type, creating them if
+  // needed
+  PhaseMetric* GetOrCreatePhaseMetric(StatementType type);
+
   // Get the mapping table of backend stat context for each thread
   static CuckooMap<std::thread::id, std::shared_ptr<BackendStatsContext>> &
     GetBackendContextMap(void);
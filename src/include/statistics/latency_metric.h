@@ -12,47 +12,53 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include "common/timer.h"
 #include "common/macros.h"
 #include "type/types.h"
 #include "common/exception.h"
-#include "container/circular_buffer.h"
 #include "statistics/abstract_metric.h"
-#include <mutex>
 
 namespace peloton {
 namespace stats {
 
 // Container for different latency measurements
 struct LatencyMeasurements {
+  uint64_t count_ = 0;
   double average_ = 0.0;
   double min_ = 0.0;
   double max_ = 0.0;
   double median_ = 0.0;
   double perc_25th_ = 0.0;
   double perc_75th_ = 0.0;
+  double perc_95th_ = 0.0;
   double perc_99th_ = 0.0;
+  double perc_999th_ = 0.0;
 };
 
 /**
- * Metric for storing raw latency values and computing
+ * Metric for counting latencies in a log-bucketed histogram and computing
  * latency measurements.
+ *
+ * Each power of two microseconds is split into SUB_BUCKET_COUNT buckets, so
+ * a latency is counted within about 3% of its value, in fixed memory and
+ * however many latencies come in. Only the thread that owns the metric
+ * records into it, which makes a recording two plain stores. The aggregator
+ * reads the counters concurrently and merges them by adding them up.
  */
 class LatencyMetric : public AbstractMetric {
  public:
-  LatencyMetric(MetricType type, size_t max_history);
+  LatencyMetric(MetricType type);
 
   //===--------------------------------------------------------------------===//
   // HELPER METHODS
   //===--------------------------------------------------------------------===//
 
-  inline void Reset() {
-    latencies_.Clear();
-    timer_ms_.Reset();
-  }
+  void Reset();
 
   // Starts the timer for the next latency measurement
   inline void StartTimer() {
@@ -63,57 +69,90 @@ class LatencyMetric : public AbstractMetric {
   // Stops the latency timer and records the total time elapsed
   inline void RecordLatency() {
     timer_ms_.Stop();
-    double latency_value = timer_ms_.GetDuration();
-    // Record this latency only if we can do so without blocking.
-    // Occasionally losing single latency measurements is fine.
-    {
-      std::unique_lock<std::mutex> lock(latency_mutex_, std::defer_lock);
-      if (lock.try_lock()) {
-        latencies_.PushBack(latency_value);
-      }
-    }
+    RecordLatency(timer_ms_.GetDuration());
   }
 
-  // Returns the first latency value recorded
-  inline double GetFirstLatencyValue() {
-    PL_ASSERT(latencies_.begin() != latencies_.end());
-    return *(latencies_.begin());
+  // Records a latency given in milliseconds
+  inline void RecordLatency(const double &latency_ms) {
+    uint64_t latency_us =
+        latency_ms > 0 ? static_cast<uint64_t>(latency_ms * 1000) : 0;
+    auto &count = counts_[GetBucket(latency_us)];
+    count.store(count.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+    sum_us_.store(sum_us_.load(std::memory_order_relaxed) + latency_us,
+                  std::memory_order_relaxed);
   }
 
-  // Computes the latency measurements using the latencies
-  // collected so far.
+  // Computes the latency measurements from the latencies recorded since the
+  // last call. Only the aggregator calls this, once per interval.
   void ComputeLatencies();
 
   // Combines the source latency metric with this latency metric
   void Aggregate(AbstractMetric &source);
 
+  // Returns the result of the last call to ComputeLatencies()
+  const LatencyMeasurements &GetLatencyMeasurements() const {
+    return latency_measurements_;
+  }
+
+  // Counts all latencies recorded so far up to each of the given bounds, in
+  // ms and ascending, into bound_counts. Returns the number of latencies,
+  // and their sum in ms in sum_ms.
+  uint64_t GetCumulativeCounts(const std::vector<double> &bounds_ms,
+                               std::vector<uint64_t> &bound_counts,
+                               double &sum_ms) const;
+
   // Returns a string representation of this latency metric
   const std::string GetInfo() const;
 
-  // Returns a copy of the latencies collected
-  CircularBuffer<double> Copy();
-
  private:
+  // Buckets per power of two
+  static const size_t SUB_BUCKET_BITS = 5;
+  static const size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+
+  // Latencies from 2^36 us (about 19 hours) up share the last bucket
+  static const size_t MAX_LATENCY_BITS = 36;
+  static const size_t BUCKET_COUNT =
+      (MAX_LATENCY_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+  static inline size_t GetBucket(const uint64_t &latency_us) {
+    if (latency_us < SUB_BUCKET_COUNT) {
+      return latency_us;
+    }
+    size_t shift = 63 - __builtin_clzll(latency_us) - SUB_BUCKET_BITS;
+    size_t bucket = (shift + 1) * SUB_BUCKET_COUNT + (latency_us >> shift) -
+                    SUB_BUCKET_COUNT;
+    return bucket < BUCKET_COUNT ? bucket : BUCKET_COUNT - 1;
+  }
+
+  // Smallest latency (in us) counted by a bucket
+  static inline uint64_t GetBucketLatency(const size_t &bucket) {
+    if (bucket < SUB_BUCKET_COUNT) {
+      return bucket;
+    }
+    size_t shift = bucket / SUB_BUCKET_COUNT - 1;
+    return static_cast<uint64_t>(bucket % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT)
+           << shift;
+  }
+
   //===--------------------------------------------------------------------===//
   // MEMBERS
   //===--------------------------------------------------------------------===//
 
-  // Circular buffer with capacity N that stores the <= N
-  // most recent latencies collected
-  CircularBuffer<double> latencies_;
+  // Number of latencies in each bucket, and their sum
+  std::atomic<uint64_t> counts_[BUCKET_COUNT];
+  std::atomic<uint64_t> sum_us_;
+
+  // Counters as of the last call to ComputeLatencies(). Reset() leaves them
+  // alone, as the aggregator resets and refills its metrics every interval.
+  std::vector<uint64_t> last_counts_;
+  uint64_t last_sum_us_ = 0;
 
   // Timer for timing individual latencies
   Timer<std::ratio<1, 1000>> timer_ms_;
 
   // Stores result of last call to ComputeLatencies()
   LatencyMeasurements latency_measurements_;
-
-  // The maximum number of latencies that can be stored
-  // (the capacity size N of the circular buffer)
-  size_t max_history_;
-
-  // Protects accesses to the circular buffer
-  std::mutex latency_mutex_;
 };
 
 }  // namespace stats
@@ -0,0 +1,83 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// phase_metric.h
+//
+// Identification: src/include/statistics/phase_metric.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "common/macros.h"
+#include "type/types.h"
+#include "statistics/abstract_metric.h"
+#include "statistics/latency_metric.h"
+
+namespace peloton {
+namespace stats {
+
+/**
+ * Metric for the latencies of the phases that the statements of one type go
+ * through, from decoding the query off the network to encoding its results.
+ * Each phase has its own latency histogram.
+ */
+class PhaseMetric : public AbstractMetric {
+ public:
+  PhaseMetric(MetricType type, StatementType statement_type);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  inline StatementType GetStatementType() const { return statement_type_; }
+
+  inline LatencyMetric &GetPhaseLatency(QueryPhaseType phase) {
+    PL_ASSERT(phase != QueryPhaseType::INVALID);
+    return *phase_latencies_[static_cast<size_t>(phase) - 1];
+  }
+
+  // Records the time a statement spent in a phase, in milliseconds
+  inline void RecordLatency(QueryPhaseType phase, double latency_ms) {
+    GetPhaseLatency(phase).RecordLatency(latency_ms);
+  }
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  // Computes the latency measurements of every phase
+  void ComputeLatencies();
+
+  void Reset();
+
+  void Aggregate(AbstractMetric &source);
+
+  const std::string GetInfo() const;
+
+  // Number of phases, the INVALID phase is not timed
+  static const size_t PHASE_COUNT =
+      static_cast<size_t>(QueryPhaseType::ENCODE);
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  // The type of the statements
+  StatementType statement_type_;
+
+  // Latencies of each phase, starting with DECODE
+  std::vector<std::unique_ptr<LatencyMetric>> phase_latencies_;
+};
+
+}  // namespace stats
+}  // namespace peloton
@@ -15,10 +15,10 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include "common/timer.h"
 #include "type/types.h"
 #include "statistics/abstract_metric.h"
 #include "statistics/access_metric.h"
-#include "statistics/latency_metric.h"
 #include "statistics/processor_metric.h"
 
 namespace peloton {
@@ -72,7 +72,8 @@ class QueryMetric : public AbstractMetric {
 
   inline AccessMetric &GetQueryAccess() { return query_access_; }
 
-  inline LatencyMetric &GetQueryLatency() { return latency_metric_; }
+  // Latency of the query in milliseconds
+  inline double GetQueryLatency() const { return latency_timer_.GetDuration(); }
 
   inline ProcessorMetric &GetProcessorMetric() { return processor_metric_; }
 
@@ -90,6 +91,9 @@ class QueryMetric : public AbstractMetric {
 
   inline void Reset() { query_access_.Reset(); }
 
+  // Stops the latency timer started with the query
+  inline void RecordLatency() { latency_timer_.Stop(); }
+
   void Aggregate(AbstractMetric &source);
 
   inline const std::string GetInfo() const {
@@ -118,8 +122,8 @@ class QueryMetric : public AbstractMetric {
   // The number of tuple accesses
   AccessMetric query_access_{ACCESS_METRIC};
 
-  // Latency metric
-  LatencyMetric latency_metric_{LATENCY_METRIC, 2};
+  // Latency timer
+  Timer<std::ratio<1, 1000>> latency_timer_;
 
   // Processor metric
   ProcessorMetric processor_metric_{PROCESSOR_METRIC};
@@ -34,8 +34,10 @@
 
 #define STATS_AGGREGATION_INTERVAL_MS 1000
 #define STATS_LOG_INTERVALS 10
-#define LATENCY_MAX_HISTORY_THREAD 100
-#define LATENCY_MAX_HISTORY_AGGREGATOR 10000
+// A table is analyzed again once this many rows plus this fraction of its
+// rows have been modified since it was last analyzed
+#define STATS_AUTO_ANALYZE_BASE_THRESHOLD 50
+#define STATS_AUTO_ANALYZE_SCALE_FACTOR 0.1
 
 class BackendStatsContext;
 
@@ -78,6 +80,10 @@ class StatsAggregator {
   // Get the current aggregated stats of all threads (including history)
   inline BackendStatsContext &GetAggregatedStats() { return aggregated_stats_; }
 
+  // Get the aggregated stats of the last interval in the Prometheus text
+  // format
+  std::string GetExportedMetrics();
+
   //===--------------------------------------------------------------------===//
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
@@ -146,6 +152,13 @@ class StatsAggregator {
   // Abstract Pool to hold query strings
   std::unique_ptr<type::AbstractPool> pool_;
 
+  // The aggregated stats in the Prometheus text format, rendered once per
+  // interval for the metrics endpoint to serve
+  std::string exported_metrics_;
+
+  // Protect the exported metrics from the thread serving them
+  std::mutex exported_metrics_mutex_{};
+
   //===--------------------------------------------------------------------===//
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
@@ -153,6 +166,9 @@ class StatsAggregator {
   // Write all metrics to metric tables
   void UpdateMetrics();
 
+  // Render the aggregated stats in the Prometheus text format
+  void ExportMetrics();
+
   // Update the table metrics with a given database
   void UpdateTableMetrics(storage::Database *database, int64_t time_stamp,
                           concurrency::Transaction *txn);
@@ -165,6 +181,12 @@ class StatsAggregator {
   // Write all query metrics to a metric table
   void UpdateQueryMetrics(int64_t time_stamp, concurrency::Transaction *txn);
 
+  // Write the phase latencies of each statement type to a metric table
+  void UpdatePhaseMetrics(int64_t time_stamp, concurrency::Transaction *txn);
+
+  // Analyze the tables whose column stats have gone stale
+  void UpdateTableStats();
+
   // Aggregate stats periodically
   void RunAggregator();
 };
@@ -21,6 +21,7 @@
 
 #include "common/item_pointer.h"
 #include "common/printable.h"
+#include "storage/tile_group_allocator.h"
 #include "type/types.h"
 
 //===--------------------------------------------------------------------===//
@@ -125,6 +126,9 @@ class AbstractTable : public Printable {
 
   virtual size_t GetTupleCount() const = 0;
 
+  // NUMA node that new tile groups of this table should be placed on
+  virtual int GetPreferredNumaNode() const { return NUMA_NODE_ANY; }
+
  protected:
   //===--------------------------------------------------------------------===//
   // INTERNAL METHODS
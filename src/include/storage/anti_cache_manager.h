@@ -0,0 +1,200 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// anti_cache_manager.h
+//
+// Identification: src/include/storage/anti_cache_manager.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "type/types.h"
+
+namespace peloton {
+namespace storage {
+
+class AbstractTable;
+class DataTable;
+class TileGroup;
+
+typedef std::map<oid_t, std::pair<oid_t, oid_t>> column_map_type;
+
+//===--------------------------------------------------------------------===//
+// Anti-Cache Manager
+//===--------------------------------------------------------------------===//
+
+/**
+ * Moves cold tile groups out of memory and into a file on secondary storage.
+ *
+ * Every lookup through catalog::Manager stamps the tile group with the
+ * current tick of the anti-cache clock, which advances once per eviction
+ * pass. Full tile groups that have not been looked up for a few passes and
+ * that no transaction currently owns a tuple of are serialized to the file,
+ * and their entry in catalog::Manager is replaced by a tombstone kept here.
+ * Transactions hold on to raw tile group headers after a lookup, so a tile
+ * group is only evicted once every transaction that was running when it was
+ * last looked up has finished.
+ * The next lookup of an evicted tile group (by a scan, an index lookup, a
+ * version chain traversal or the GC) transparently reads it back in.
+ *
+ * Only the tile group is evicted: indexes and indirection arrays stay in
+ * memory, so evicted tuples are still found through their indexes.
+ */
+class AntiCacheManager {
+ public:
+  AntiCacheManager(const AntiCacheManager &) = delete;
+  AntiCacheManager &operator=(const AntiCacheManager &) = delete;
+  AntiCacheManager(AntiCacheManager &&) = delete;
+  AntiCacheManager &operator=(AntiCacheManager &&) = delete;
+
+  AntiCacheManager();
+
+  ~AntiCacheManager();
+
+  // Singleton
+  static AntiCacheManager &GetInstance();
+
+  // Start evicting
+  void Start();
+
+  // Stop evicting
+  void Stop();
+
+  // Tables are registered by the database they belong to
+  void AddTable(storage::DataTable *table);
+
+  void DropTable(const oid_t &table_oid);
+
+  // Clear list
+  void ClearTables();
+
+  // Set the file evicted tile groups are written to
+  void SetFile(const std::string &file_name);
+
+  // Evict the cold tile groups of a table. Returns the number of tile groups
+  // that were evicted.
+  size_t EvictColdTileGroups(storage::DataTable *table);
+
+  // Returns false if the tile group is not resident, not full, in use or
+  // owned by a transaction
+  bool EvictTileGroup(const oid_t &tile_group_id);
+
+  // Read an evicted tile group back in. Returns nullptr if the tile group was
+  // never evicted (or has been dropped).
+  std::shared_ptr<storage::TileGroup> FetchTileGroup(const oid_t &tile_group_id);
+
+  // Forget about an evicted tile group that is being dropped
+  void DiscardTileGroup(const oid_t &tile_group_id);
+
+  // Current tick of the access clock
+  inline uint64_t GetClock() const {
+    return clock_.load(std::memory_order_relaxed);
+  }
+
+  // Advance the access clock
+  void Tick();
+
+  // Number of tile groups that currently live in the file
+  inline size_t GetEvictedTileGroupCount() const {
+    return evicted_tile_group_count_.load();
+  }
+
+  // Number of passes a tile group must stay untouched to be evicted
+  void SetColdPasses(const uint64_t &cold_passes) { cold_passes_ = cold_passes; }
+
+ private:
+  // Everything needed to rebuild an empty tile group with the same layout
+  struct EvictedTileGroup {
+    oid_t database_id;
+    oid_t table_id;
+    AbstractTable *table;
+    std::vector<catalog::Schema> schemas;
+    column_map_type column_map;
+    int tuple_count;
+
+    // Location of the image in the file
+    off_t offset;
+    size_t length;
+  };
+
+  void Evict();
+
+  // Whether the tile group is cold and nobody is writing to it
+  bool IsEvictable(storage::TileGroup *tile_group);
+
+  // Release the ticks that no running transaction has seen
+  void UpdateReleasedClock();
+
+  bool OpenFile();
+
+  bool WriteImage(const char *data, const size_t &length, off_t &offset);
+
+  bool ReadImage(char *data, const size_t &length, const off_t &offset);
+
+  // Tables whose tile groups may be evicted
+  std::vector<storage::DataTable *> tables_;
+
+  // Protects the table list
+  std::mutex table_mutex_;
+
+  // Tombstones of the evicted tile groups
+  std::unordered_map<oid_t, EvictedTileGroup> evicted_tile_groups_;
+
+  // Incremented before a tile group disappears from catalog::Manager and
+  // decremented after it is back, so that lookups know when to wait for us
+  std::atomic<size_t> evicted_tile_group_count_;
+
+  // Serializes evictions and fetches, and protects the file
+  std::mutex anti_cache_mutex_;
+
+  std::string file_name_;
+
+  int file_descriptor_;
+
+  // Images are appended, the space is reclaimed when the file empties out
+  off_t file_end_;
+
+  std::atomic<uint64_t> clock_;
+
+  // The begin commit id of a transaction started right after each tick. A
+  // tick is released once every transaction before that one has finished.
+  std::deque<std::pair<uint64_t, cid_t>> tick_cids_;
+
+  // Tile groups last looked up before this tick are no longer in use
+  uint64_t released_clock_;
+
+  // Stop signal
+  std::atomic<bool> eviction_stop_;
+
+  // Eviction thread
+  std::thread eviction_thread_;
+
+  //===--------------------------------------------------------------------===//
+  // Anti-Cache Parameters
+  //===--------------------------------------------------------------------===//
+
+  uint64_t cold_passes_ = 10;
+
+  // Sleeping period between passes (in ms)
+  oid_t sleep_duration_ = 1000;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
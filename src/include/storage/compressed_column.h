@@ -0,0 +1,137 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_column.h
+//
+// Identification: src/include/storage/compressed_column.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace storage {
+
+class Tile;
+
+//===--------------------------------------------------------------------===//
+// Compressed Column
+//===--------------------------------------------------------------------===//
+
+// How the keys of a compressed column are laid out
+enum class ColumnEncodingType {
+  // raw fields, for inlined types wider than 64 bits
+  PLAIN = 0,
+  // fixed-width keys packed into 64-bit words
+  BIT_PACKED = 1,
+  // (key, end) pairs
+  RUN_LENGTH = 2
+};
+
+/**
+ * Read-only, compressed copy of one column of a frozen tile.
+ *
+ * Every field is mapped to an unsigned key:
+ *  - fixed-length fields are stored relative to the smallest field of the
+ *    column (frame of reference);
+ *  - varlen fields are replaced with their code in a dictionary of the
+ *    distinct values of the column.
+ *
+ * The keys are then either bit-packed with just as many bits as the largest
+ * key needs, or run-length encoded, whichever is smaller.
+ *
+ * Predicates of the form "column <cmp> constant" can be evaluated without
+ * decoding the column: once per run, once per dictionary entry, or directly
+ * on the keys of an integer column.
+ */
+class CompressedColumn {
+  CompressedColumn(const CompressedColumn &) = delete;
+  CompressedColumn &operator=(const CompressedColumn &) = delete;
+
+ public:
+  // Compress the given column of a tile
+  CompressedColumn(Tile *tile, const oid_t column_id);
+
+  type::Value GetValue(const oid_t tuple_offset) const;
+
+  // Clear the selection of every tuple for which "value <cmp> constant" does
+  // not hold
+  void Filter(const ExpressionType &comparison_type,
+              const type::Value &constant, std::vector<bool> &selection) const;
+
+  ColumnEncodingType GetEncodingType() const { return encoding_type_; }
+
+  bool IsDictionaryEncoded() const { return dictionary_encoded_; }
+
+  size_t GetDictionarySize() const { return dictionary_entries_.size(); }
+
+  // Approximate memory footprint (in bytes)
+  size_t GetSize() const;
+
+ private:
+  void EncodeFixedLength(Tile *tile, const oid_t column_id);
+
+  void EncodeVarlen(Tile *tile, const oid_t column_id);
+
+  void EncodeKeys(const std::vector<uint64_t> &keys);
+
+  uint64_t GetKey(const oid_t tuple_offset) const;
+
+  type::Value DecodeKey(const uint64_t &key) const;
+
+  // Evaluates the predicate on the keys of an integer column
+  void FilterKeys(const ExpressionType &comparison_type,
+                  const type::Value &constant,
+                  std::vector<bool> &selection) const;
+
+  type::Type::TypeId column_type_;
+
+  // length of the inlined field
+  size_t field_length_;
+
+  oid_t tuple_count_;
+
+  ColumnEncodingType encoding_type_;
+
+  bool dictionary_encoded_;
+
+  // Frame of reference: the smallest and largest field of the column
+  int64_t base_;
+
+  int64_t max_;
+
+  // Key of the null field, if the column has any
+  bool has_null_;
+
+  uint64_t null_key_;
+
+  // Bit-packed keys
+  size_t bit_width_;
+
+  std::vector<uint64_t> packed_keys_;
+
+  // Run-length encoded keys, each run ends right before its end offset
+  std::vector<uint64_t> run_keys_;
+
+  std::vector<oid_t> run_ends_;
+
+  // Plain fields
+  std::vector<char> plain_data_;
+
+  // Dictionary entries, laid out like in the varlen pool ([length][data]).
+  // A null entry (if any) comes first.
+  std::vector<char> dictionary_data_;
+
+  std::vector<const char *> dictionary_entries_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -130,7 +130,8 @@ class DataTable : public AbstractTable {
 
   void AddTileGroup(const std::shared_ptr<TileGroup> &tile_group);
 
-  // Offset is a 0-based number local to the table
+  // Offset is a 0-based number local to the table. Returns nullptr if the
+  // tile group at that offset has been dropped.
   std::shared_ptr<storage::TileGroup> GetTileGroup(
       const std::size_t &tile_group_offset) const;
 
@@ -138,8 +139,16 @@ class DataTable : public AbstractTable {
   std::shared_ptr<storage::TileGroup> GetTileGroupById(
       const oid_t &tile_group_id) const;
 
+  // ID of the tile group at the given offset, without touching the tile group
+  // itself. Returns INVALID_OID if it has been dropped.
+  oid_t GetTileGroupId(const std::size_t &tile_group_offset) const;
+
+  // Number of tile group offsets, including dropped tile groups
   size_t GetTileGroupCount() const;
 
+  // Drop a tile group that no longer holds any tuple (used by compaction)
+  bool DropTileGroup(const oid_t &tile_group_id);
+
   // Get a tile group with given layout
   TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning);
 
@@ -203,6 +212,25 @@ class DataTable : public AbstractTable {
 
   void ResetDirty();
 
+  //===--------------------------------------------------------------------===//
+  // NUMA PLACEMENT
+  //===--------------------------------------------------------------------===//
+
+  // NUMA node most of the inserts into this table come from
+  int GetPreferredNumaNode() const;
+
+  //===--------------------------------------------------------------------===//
+  // PARTITIONING
+  //===--------------------------------------------------------------------===//
+
+  // Column whose value decides the partition a tuple belongs to under
+  // partitioned execution, or INVALID_OID if the table is not partitioned
+  void SetPartitionColumn(const oid_t &column_id) {
+    partition_column_ = column_id;
+  }
+
+  oid_t GetPartitionColumn() const { return partition_column_; }
+
   //===--------------------------------------------------------------------===//
   // LAYOUT TUNER
   //===--------------------------------------------------------------------===//
@@ -271,6 +299,9 @@ class DataTable : public AbstractTable {
   // Claim a tuple slot in a tile group
   ItemPointer GetEmptyTupleSlot(const storage::Tuple *tuple);
 
+  // Sample the NUMA node of the inserting thread
+  void RecordInsertNumaNode();
+
   // add a tile group to the table
   oid_t AddDefaultTileGroup();
   // add a tile group to the table. replace the active_tile_group_id-th active
@@ -349,6 +380,12 @@ class DataTable : public AbstractTable {
   // dirty flag. for detecting whether the tile group has been used.
   bool dirty_ = false;
 
+  // sampled # of inserts coming from each NUMA node
+  std::atomic<size_t> numa_insert_counts_[MAX_NUMA_NODES] = {};
+
+  // partitioning column
+  oid_t partition_column_ = INVALID_OID;
+
   //===--------------------------------------------------------------------===//
   // TUNING MEMBERS
   //===--------------------------------------------------------------------===//
@@ -11,6 +11,9 @@
 //===----------------------------------------------------------------------===//
 
 #include <array>
+#include <new>
+
+#include "storage/storage_manager.h"
 
 namespace peloton {
 namespace storage {
@@ -21,10 +24,17 @@ const size_t INVALID_INDIRECTION_OFFSET = std::numeric_limits<size_t>::max();
 class IndirectionArray {
  public:
   IndirectionArray(oid_t oid) : oid_(oid) {
-    indirections_.reset(new indirection_array_t());
+    // the array lives next to the tile groups of the inserting thread
+    auto &storage_manager = StorageManager::GetInstance();
+    void *location = storage_manager.Allocate(
+        BackendType::MM, sizeof(indirection_array_t), NUMA_NODE_ANY);
+    indirections_ = new (location) indirection_array_t();
   }
 
-  ~IndirectionArray() {}
+  ~IndirectionArray() {
+    auto &storage_manager = StorageManager::GetInstance();
+    storage_manager.Release(BackendType::MM, indirections_);
+  }
 
   size_t AllocateIndirection() {
     if (indirection_counter_ >= INDIRECTION_ARRAY_MAX_SIZE) {
@@ -50,7 +60,7 @@ class IndirectionArray {
   typedef std::array<ItemPointer, INDIRECTION_ARRAY_MAX_SIZE>
       indirection_array_t;
 
-  std::unique_ptr<indirection_array_t> indirections_;
+  indirection_array_t *indirections_;
 
   std::atomic<size_t> indirection_counter_ = ATOMIC_VAR_INIT(0);
 
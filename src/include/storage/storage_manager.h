@@ -15,6 +15,7 @@
 #include <mutex>
 
 #include "common/platform.h"
+#include "storage/tile_group_allocator.h"
 #include "type/types.h"
 
 namespace peloton {
@@ -46,6 +47,10 @@ class StorageManager {
 
   void *Allocate(BackendType type, size_t size);
 
+  // Allocate memory that belongs to a tile group. In-memory tile groups are
+  // carved from huge page regions on the given NUMA node if enabled.
+  void *Allocate(BackendType type, size_t size, int numa_node);
+
   void Release(BackendType type, void *address);
 
   void Sync(BackendType type, void *address, size_t length);
@@ -12,12 +12,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include "catalog/manager.h"
 #include "catalog/schema.h"
 #include "common/item_pointer.h"
 #include "common/printable.h"
+#include "storage/tile_group_allocator.h"
 #include "type/abstract_pool.h"
 #include "type/serializeio.h"
 #include "type/serializer.h"
@@ -34,6 +38,7 @@ namespace storage {
 // Tile
 //===--------------------------------------------------------------------===//
 
+class CompressedColumn;
 class Tuple;
 class TileGroup;
 class TileGroupHeader;
@@ -59,7 +64,7 @@ class Tile : public Printable {
   // Tile creator
   Tile(BackendType backend_type, TileGroupHeader *tile_header,
        const catalog::Schema &tuple_schema, TileGroup *tile_group,
-       int tuple_count);
+       int tuple_count, int numa_node = NUMA_NODE_ANY);
 
   virtual ~Tile();
 
@@ -117,6 +122,28 @@ class Tile : public Printable {
   // Copy current tile in given backend and return new tile
   Tile *CopyTile(BackendType backend_type);
 
+  //===--------------------------------------------------------------------===//
+  // Compression
+  //===--------------------------------------------------------------------===//
+
+  // Replace the tile with a read-only, compressed copy. The uncompressed data
+  // stays around for readers that started earlier until it is released.
+  void Compress();
+
+  // Free the uncompressed data of a compressed tile
+  void ReleaseUncompressedData();
+
+  inline bool IsCompressed() const {
+    return compressed.load(std::memory_order_acquire);
+  }
+
+  const CompressedColumn *GetCompressedColumn(const oid_t column_id) const {
+    return compressed_columns[column_id].get();
+  }
+
+  // Memory used by the compressed columns
+  size_t GetCompressedSize() const;
+
   //===--------------------------------------------------------------------===//
   // Size Stats
   //===--------------------------------------------------------------------===//
@@ -223,6 +250,11 @@ class Tile : public Printable {
 
   oid_t column_header_size;
 
+  // compressed copy of the columns, only valid once the tile is compressed
+  std::vector<std::unique_ptr<CompressedColumn>> compressed_columns;
+
+  std::atomic<bool> compressed;
+
   /**
    * NOTE : Tiles don't keep track of number of occupied slots.
    * This is maintained by shared Tile Header.
@@ -282,9 +314,9 @@ class TileFactory {
                        oid_t table_id, oid_t tile_group_id, oid_t tile_id,
                        TileGroupHeader *tile_header,
                        const catalog::Schema &schema, TileGroup *tile_group,
-                       int tuple_count) {
-    Tile *tile =
-        new Tile(backend_type, tile_header, schema, tile_group, tuple_count);
+                       int tuple_count, int numa_node = NUMA_NODE_ANY) {
+    Tile *tile = new Tile(backend_type, tile_header, schema, tile_group,
+                          tuple_count, numa_node);
 
     TileFactory::InitCommon(tile, database_id, table_id, tile_group_id, tile_id,
                             schema);
@@ -21,12 +21,16 @@
 #include "common/item_pointer.h"
 #include "common/printable.h"
 #include "planner/project_info.h"
+#include "storage/tile_group_allocator.h"
 #include "type/abstract_pool.h"
 #include "type/types.h"
 #include "type/value.h"
 
 namespace peloton {
 
+class SerializeInput;
+class SerializeOutput;
+
 namespace catalog {
 class Manager;
 class Schema;
@@ -52,6 +56,7 @@ class TileGroupHeader;
 class AbstractTable;
 class TileGroupIterator;
 class RollbackSegment;
+class ZoneMap;
 
 typedef std::map<oid_t, std::pair<oid_t, oid_t>> column_map_type;
 
@@ -76,7 +81,8 @@ class TileGroup : public Printable {
   // Tile group constructor
   TileGroup(BackendType backend_type, TileGroupHeader *tile_group_header,
             AbstractTable *table, const std::vector<catalog::Schema> &schemas,
-            const column_map_type &column_map, int tuple_count);
+            const column_map_type &column_map, int tuple_count,
+            int numa_node = NUMA_NODE_ANY);
 
   ~TileGroup();
 
@@ -185,6 +191,58 @@ class TileGroup : public Printable {
   // Sync the contents
   void Sync();
 
+  //===--------------------------------------------------------------------===//
+  // Anti-caching
+  //===--------------------------------------------------------------------===//
+
+  // Write the header and the contents of all tiles, including the uninlined
+  // values of the tuples that are still around
+  void SerializeTo(SerializeOutput &output) const;
+
+  // Restore the image written by SerializeTo() into an empty tile group with
+  // the same layout
+  void DeserializeFrom(SerializeInput &input);
+
+  // Anti-cache clock tick at which the tile group was last looked up
+  inline uint64_t GetLastAccess() const {
+    return last_access_clock.load(std::memory_order_relaxed);
+  }
+
+  // Only write when the tick changed, so that hot tile groups do not bounce
+  // the cache line between readers
+  inline void RecordAccess(const uint64_t &clock) {
+    if (last_access_clock.load(std::memory_order_relaxed) != clock) {
+      last_access_clock.store(clock, std::memory_order_relaxed);
+    }
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Zone Map
+  //===--------------------------------------------------------------------===//
+
+  // Summary of the values written to each column, kept up to date by
+  // CopyTuple() and SetValue()
+  ZoneMap *GetZoneMap() const { return zone_map.get(); }
+
+  // Recompute the zone map from the tuples in the tile group, for contents
+  // that were written behind its back. Only valid before the tile group is
+  // visible to other threads.
+  void RebuildZoneMap();
+
+  //===--------------------------------------------------------------------===//
+  // Compression
+  //===--------------------------------------------------------------------===//
+
+  // Compress all tiles and mark the tile group as frozen. Only valid for tile
+  // groups whose slots will never be written again.
+  void Freeze();
+
+  // Free the uncompressed tiles once nobody can be reading them anymore
+  void ReleaseUncompressedData();
+
+  // Memory used by the compressed tiles
+  size_t GetCompressedSize() const;
+
  protected:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -221,6 +279,15 @@ class TileGroup : public Printable {
   // column to tile mapping :
   // <column offset> to <tile offset, tile column offset>
   column_map_type column_map;
+
+  // anti-cache clock tick of the last lookup
+  std::atomic<uint64_t> last_access_clock;
+
+  // per-column value ranges used to skip the tile group in scans
+  std::unique_ptr<ZoneMap> zone_map;
+
+ private:
+  void ResetZoneMap();
 };
 
 }  // End storage namespace
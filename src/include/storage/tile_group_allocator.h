@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_allocator.h
+//
+// Identification: src/include/storage/tile_group_allocator.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include "common/platform.h"
+
+namespace peloton {
+namespace storage {
+
+// No preference for the NUMA node of an allocation
+const int NUMA_NODE_ANY = -1;
+
+// Upper bound on the number of NUMA nodes we keep track of
+const int MAX_NUMA_NODES = 8;
+
+//===--------------------------------------------------------------------===//
+// Tile Group Allocator
+//===--------------------------------------------------------------------===//
+
+/**
+ * Carves tile data, tile group headers and indirection arrays out of
+ * 2MB-aligned regions that are backed by transparent huge pages and bound
+ * to a NUMA node. Allocations are bump-allocated from the active region of
+ * their node, and a region is unmapped as a whole once every allocation in
+ * it has been released.
+ */
+class TileGroupAllocator {
+ public:
+  TileGroupAllocator(const TileGroupAllocator &) = delete;
+  TileGroupAllocator &operator=(const TileGroupAllocator &) = delete;
+
+  // global singleton
+  static TileGroupAllocator &GetInstance(void);
+
+  TileGroupAllocator();
+  ~TileGroupAllocator();
+
+  // Allocate memory on the given NUMA node (or the caller's node when
+  // NUMA_NODE_ANY is given). Returns nullptr if the region cannot be mapped.
+  void *Allocate(size_t size, int numa_node = NUMA_NODE_ANY);
+
+  // Returns false if the address was not handed out by this allocator.
+  // Addresses outside of every region ever mapped are turned away without
+  // taking the lock, so that freeing heap memory stays cheap.
+  bool Release(void *address);
+
+  // Number of regions that are currently mapped
+  size_t GetRegionCount();
+
+  // Number of bytes that are currently mapped
+  size_t GetMappedBytes();
+
+  // NUMA node of the CPU the calling thread is running on
+  static int GetCurrentNumaNode();
+
+  // Number of NUMA nodes on this machine
+  static int GetNumaNodeCount();
+
+  // Huge page size (and region alignment)
+  static const size_t kRegionSize = 2 * 1024 * 1024;
+
+ private:
+  struct Region {
+    char *start;
+    size_t size;
+    size_t offset;
+    size_t live_allocations;
+    int numa_node;
+  };
+
+  Region *MapRegion(size_t size, int numa_node);
+
+  void UnmapRegion(Region *region);
+
+  // Regions keyed by their start address
+  std::map<uintptr_t, Region *> regions_;
+
+  // Region that new allocations are carved from, per NUMA node
+  Region *active_regions_[MAX_NUMA_NODES];
+
+  size_t mapped_bytes_ = 0;
+
+  // Bounds of the address range covered by all regions mapped so far. They
+  // only ever grow and are read without the lock in Release().
+  std::atomic<uintptr_t> min_address_;
+  std::atomic<uintptr_t> max_address_;
+
+  // Protects all of the above. Allocations happen once per tile, so this is
+  // far from the hot path.
+  Spinlock allocator_lock_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
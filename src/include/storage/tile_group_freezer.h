@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer.h
+//
+// Identification: src/include/storage/tile_group_freezer.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "type/types.h"
+
+namespace peloton {
+namespace storage {
+
+class DataTable;
+class TileGroup;
+
+//===--------------------------------------------------------------------===//
+// Tile Group Freezer
+//===--------------------------------------------------------------------===//
+
+/**
+ * Append-mostly tables accumulate full tile groups whose tuples are never
+ * written again. The freezer looks for full tile groups in which every tuple
+ * is the latest version and visible to every transaction, and compresses
+ * their tiles column by column (see CompressedColumn). Frozen tile groups
+ * are read-only: updates and deletes still work, as they always create the
+ * new version elsewhere, but the slots they free up are never reused.
+ *
+ * Transactions that started before a tile group was frozen may still be
+ * reading its uncompressed tiles, so those are only released once every such
+ * transaction is gone.
+ */
+class TileGroupFreezer {
+ public:
+  TileGroupFreezer(const TileGroupFreezer &) = delete;
+  TileGroupFreezer &operator=(const TileGroupFreezer &) = delete;
+  TileGroupFreezer(TileGroupFreezer &&) = delete;
+  TileGroupFreezer &operator=(TileGroupFreezer &&) = delete;
+
+  TileGroupFreezer();
+
+  ~TileGroupFreezer();
+
+  // Singleton
+  static TileGroupFreezer &GetInstance();
+
+  // Start freezing
+  void Start();
+
+  // Stop freezing
+  void Stop();
+
+  // Tables are registered by the database they belong to
+  void AddTable(storage::DataTable *table);
+
+  void DropTable(const oid_t &table_oid);
+
+  // Clear list
+  void ClearTables();
+
+  // Freeze the eligible tile groups of a table. Returns the number of tile
+  // groups that were frozen.
+  size_t FreezeTable(storage::DataTable *table);
+
+  // Release the uncompressed tiles that nobody can be reading anymore.
+  // Returns the number of tile groups whose tiles were released.
+  size_t ReleaseUncompressedData();
+
+  // Number of tile groups frozen so far
+  size_t GetFrozenTileGroupCount() const { return frozen_tile_group_count_; }
+
+ private:
+  void Freeze();
+
+  // Whether the tile group is full and every tuple in it is a latest version
+  // that every transaction can see
+  bool IsFreezable(storage::TileGroup *tile_group,
+                   const cid_t &max_committed_cid);
+
+  // Tables whose tile groups may be frozen
+  std::vector<storage::DataTable *> tables_;
+
+  // Frozen tile groups that still hold on to their uncompressed tiles, with
+  // the commit id after which no transaction can be reading those anymore
+  std::vector<std::pair<oid_t, cid_t>> retired_tile_groups_;
+
+  // Protects the table list. Held for the duration of a pass so that a table
+  // cannot be dropped under our feet.
+  std::mutex freezer_mutex_;
+
+  // Stop signal
+  std::atomic<bool> freezing_stop_;
+
+  // Freezer thread
+  std::thread freezer_thread_;
+
+  std::atomic<size_t> frozen_tile_group_count_;
+
+  //===--------------------------------------------------------------------===//
+  // Freezer Parameters
+  //===--------------------------------------------------------------------===//
+
+  // Sleeping period between passes (in ms)
+  oid_t sleep_duration_ = 1000;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
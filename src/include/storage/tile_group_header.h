@@ -22,12 +22,18 @@
 #include "common/macros.h"
 #include "common/platform.h"
 #include "common/printable.h"
+#include "storage/tile_group_allocator.h"
 #include "type/types.h"
 
 namespace peloton {
+
+class SerializeInput;
+class SerializeOutput;
+
 namespace storage {
 
 class TileGroup;
+struct UndoRecord;
 
 //===--------------------------------------------------------------------===//
 // Tile Group Header
@@ -43,7 +49,7 @@ class TileGroup;
  *  -----------------------------------------------------------------------------
  *  | TxnID (8 bytes)  | BeginTimeStamp (8 bytes) | EndTimeStamp (8 bytes) |
  *  | NextItemPointer (8 bytes) | PrevItemPointer (8 bytes) |
- *  | Indirection (8 bytes) | ReservedField (16 bytes)
+ *  | Indirection (8 bytes) | UndoRecord (8 bytes) | ReservedField (16 bytes)
  *  -----------------------------------------------------------------------------
  *
  *  FIELD DESCRIPTIONS:
@@ -57,6 +63,8 @@ class TileGroup;
  * version chain.
  *  Indirection: the pointer pointing to the index entry that holds the address
  * of the version chain header.
+ *  UndoRecord: the newest undo record of a tuple that was updated in place,
+ * which leads back to its older versions (see UndoRecord).
  *  ReservedField: unused space for future usage.
  *
  */
@@ -67,7 +75,8 @@ class TileGroupHeader : public Printable {
   TileGroupHeader() = delete;
 
  public:
-  TileGroupHeader(const BackendType &backend_type, const int &tuple_count);
+  TileGroupHeader(const BackendType &backend_type, const int &tuple_count,
+                  const int &numa_node = NUMA_NODE_ANY);
 
   TileGroupHeader &operator=(const peloton::storage::TileGroupHeader &other) {
     // check for self-assignment
@@ -133,6 +142,18 @@ class TileGroupHeader : public Printable {
 
   oid_t GetActiveTupleCount() const;
 
+  // A tile group that is being compacted no longer hands out recycled slots,
+  // so that it drains and can eventually be dropped.
+  inline bool IsCompacting() const { return compacting.load(); }
+
+  inline void SetCompacting() { compacting.store(true); }
+
+  // The tiles of a frozen tile group are compressed and read-only, so its
+  // slots are never handed out again either.
+  inline bool IsFrozen() const { return frozen.load(); }
+
+  inline void SetFrozen() { frozen.store(true); }
+
   //===--------------------------------------------------------------------===//
   // MVCC utilities
   //===--------------------------------------------------------------------===//
@@ -170,6 +191,12 @@ class TileGroupHeader : public Printable {
     return *(ItemPointer **)(TUPLE_HEADER_LOCATION + indirection_offset);
   }
 
+  inline UndoRecord *GetUndoRecord(const oid_t &tuple_slot_id) const {
+    return __atomic_load_n(
+        (UndoRecord **)(TUPLE_HEADER_LOCATION + undo_record_offset),
+        __ATOMIC_ACQUIRE);
+  }
+
   // constraint: at most 16 bytes.
   inline char *GetReservedFieldRef(const oid_t &tuple_slot_id) const {
     return (char *)(TUPLE_HEADER_LOCATION + reserved_field_offset);
@@ -211,6 +238,22 @@ class TileGroupHeader : public Printable {
         indirection;
   }
 
+  // the undo record is published before the tuple slot gets overwritten
+  inline void SetUndoRecord(const oid_t &tuple_slot_id,
+                            UndoRecord *record) const {
+    __atomic_store_n(
+        (UndoRecord **)(TUPLE_HEADER_LOCATION + undo_record_offset), record,
+        __ATOMIC_RELEASE);
+  }
+
+  inline bool SetAtomicUndoRecord(const oid_t &tuple_slot_id,
+                                  UndoRecord *old_record,
+                                  UndoRecord *new_record) const {
+    UndoRecord **record_ptr =
+        (UndoRecord **)(TUPLE_HEADER_LOCATION + undo_record_offset);
+    return __sync_bool_compare_and_swap(record_ptr, old_record, new_record);
+  }
+
   inline txn_id_t SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                          const txn_id_t &old_txn_id,
                                          const txn_id_t &new_txn_id) const {
@@ -234,6 +277,11 @@ class TileGroupHeader : public Printable {
   // Sync the contents
   void Sync();
 
+  // Raw image of the header, used by the anti-cache to evict the tile group
+  void SerializeTo(SerializeOutput &output) const;
+
+  void DeserializeFrom(SerializeInput &input);
+
   //===--------------------------------------------------------------------===//
   // Utilities
   //===--------------------------------------------------------------------===//
@@ -247,7 +295,8 @@ class TileGroupHeader : public Printable {
   static const size_t reserved_size = 16;
   static const size_t header_entry_size = sizeof(txn_id_t) + 2 * sizeof(cid_t) +
                                           2 * sizeof(ItemPointer) +
-                                          sizeof(ItemPointer *) + reserved_size;
+                                          sizeof(ItemPointer *) +
+                                          sizeof(UndoRecord *) + reserved_size;
   static const size_t txn_id_offset = 0;
   static const size_t begin_cid_offset = txn_id_offset + sizeof(txn_id_t);
   static const size_t end_cid_offset = begin_cid_offset + sizeof(cid_t);
@@ -256,8 +305,10 @@ class TileGroupHeader : public Printable {
       next_pointer_offset + sizeof(ItemPointer);
   static const size_t indirection_offset =
       prev_pointer_offset + sizeof(ItemPointer);
+  static const size_t undo_record_offset =
+      indirection_offset + sizeof(ItemPointer *);
   static const size_t reserved_field_offset =
-      indirection_offset + sizeof(ItemPointer);
+      undo_record_offset + sizeof(UndoRecord *);
 
  private:
   //===--------------------------------------------------------------------===//
@@ -283,6 +334,12 @@ class TileGroupHeader : public Printable {
   // IT MAY OUT OF BOUNDARY! ALWAYS CHECK IF IT EXCEEDS num_tuple_slots
   std::atomic<oid_t> next_tuple_slot;
 
+  // set once the compactor starts moving tuples out of this tile group
+  std::atomic<bool> compacting;
+
+  // set once the freezer compressed the tiles of this tile group
+  std::atomic<bool> frozen;
+
   Spinlock tile_header_lock;
 };
 
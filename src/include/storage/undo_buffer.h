@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// undo_buffer.h
+//
+// Identification: src/include/storage/undo_buffer.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#include "common/item_pointer.h"
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace storage {
+
+class TileGroupHeader;
+
+//===--------------------------------------------------------------------===//
+// Undo Record
+//===--------------------------------------------------------------------===//
+
+/**
+ * Older version of a tuple that was updated in place (see
+ * FLAGS_delta_versions). It only keeps the values that the columns in
+ * column_ids had before the update. The records of a tuple are chained from
+ * the tuple header, newest first, and a reader rebuilds an older version by
+ * applying them to the values in the tuple slot one after the other.
+ *
+ * The version was visible from begin_cid until end_cid. The end commit id
+ * stays MAX_CID while the update is not committed, and an aborted update
+ * leaves an empty version behind (end_cid == begin_cid).
+ */
+struct UndoRecord {
+  txn_id_t txn_id = INVALID_TXN_ID;
+  cid_t begin_cid = MAX_CID;
+  std::atomic<cid_t> end_cid;
+
+  // commit id at which the record was taken off the tuple header, from when
+  // on only the readers that were already around may still reach it
+  std::atomic<cid_t> unlink_cid;
+
+  // next (older) record of the tuple
+  UndoRecord *next = nullptr;
+
+  // tuple slot the record belongs to
+  ItemPointer location;
+
+  std::vector<oid_t> column_ids;
+  std::vector<type::Value> values;
+
+  UndoRecord() : end_cid(MAX_CID), unlink_cid(MAX_CID) {}
+
+  // Overwrite the columns of the record in a full row of values
+  void Apply(std::vector<type::Value> &row) const;
+};
+
+//===--------------------------------------------------------------------===//
+// Undo Buffer
+//===--------------------------------------------------------------------===//
+
+/**
+ * Per-thread log of undo records. Only the owning thread appends to its
+ * buffer and reclaims from it; the records are handed out by address and
+ * never move. Records are reclaimed in the order they were made, once no
+ * snapshot needs the version they keep and every reader that may have
+ * picked them up from a tuple header is gone.
+ */
+class UndoBuffer {
+ public:
+  UndoBuffer(const UndoBuffer &) = delete;
+  UndoBuffer &operator=(const UndoBuffer &) = delete;
+
+  UndoBuffer() {}
+
+  // Buffer of the calling thread. Buffers outlive their threads, as tuple
+  // headers may still point into them, and are handed on to the next thread.
+  static UndoBuffer &GetInstance();
+
+  // Append a record for the tuple at the given location
+  UndoRecord *NewRecord(const txn_id_t &txn_id, const cid_t &begin_cid,
+                        const ItemPointer &location, UndoRecord *next);
+
+  // Mark a record that is no longer the head of its chain
+  static void Unlink(UndoRecord *record);
+
+  // Take the records off a tuple slot that is about to be reused
+  static void Unlink(TileGroupHeader *tile_group_header,
+                     const oid_t &tuple_id);
+
+  // Reclaim the records at the front of the buffer that nobody can reach
+  // anymore. Returns the number of reclaimed records.
+  size_t Reclaim();
+
+  size_t GetRecordCount() const { return records_.size(); }
+
+ private:
+  bool IsReclaimable(UndoRecord &record, const cid_t &max_committed_cid);
+
+  std::deque<UndoRecord> records_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
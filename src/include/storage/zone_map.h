@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.h
+//
+// Identification: src/include/storage/zone_map.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Zone Map
+//===--------------------------------------------------------------------===//
+
+/**
+ * Per-column summary of the values stored in a tile group: the smallest and
+ * largest value and the number of nulls written so far.
+ *
+ * The summary only ever widens. Values overwritten by later versions, or
+ * written by transactions that aborted, stay covered, so the ranges are a
+ * superset of what any transaction can see. That is all a scan needs to skip
+ * a tile group, and it lets writers update the summary with a couple of
+ * atomic operations instead of a latch.
+ *
+ * Ranges are only kept for the integer, timestamp and decimal columns. The
+ * other columns only count their nulls.
+ */
+class ZoneMap {
+ public:
+  ZoneMap(const ZoneMap &) = delete;
+  ZoneMap &operator=(const ZoneMap &) = delete;
+  ZoneMap(ZoneMap &&) = delete;
+  ZoneMap &operator=(ZoneMap &&) = delete;
+
+  // Column types in tile group column order
+  explicit ZoneMap(const std::vector<type::Type::TypeId> &column_types);
+
+  // Widen the summary of a column to cover the value
+  void Update(const oid_t &column_id, const type::Value &value);
+
+  // Whether some value of the column could satisfy "column <cmp> constant"
+  bool MayMatch(const oid_t &column_id, const ExpressionType &comparison_type,
+                const type::Value &constant) const;
+
+  // Whether the range of the column is maintained
+  bool HasRange(const oid_t &column_id) const;
+
+  // Smallest and largest values written, or null if there are none (or the
+  // column has no range)
+  type::Value GetMin(const oid_t &column_id) const;
+
+  type::Value GetMax(const oid_t &column_id) const;
+
+  size_t GetNullCount(const oid_t &column_id) const;
+
+ private:
+  struct ColumnZone {
+    type::Type::TypeId type_id = type::Type::INVALID;
+
+    // Integer and timestamp columns
+    std::atomic<int64_t> min_integer;
+    std::atomic<int64_t> max_integer;
+
+    // Decimal columns
+    std::atomic<double> min_decimal;
+    std::atomic<double> max_decimal;
+
+    std::atomic<size_t> null_count;
+  };
+
+  std::unique_ptr<ColumnZone[]> columns_;
+
+  oid_t column_count_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
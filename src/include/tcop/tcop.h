@@ -64,11 +64,11 @@ class TrafficCop {
       const size_t thread_id = 0);
 
   // ExecutePrepStmt - Helper to handle txn-specifics for the plan-tree of a
-  // statement
+  // statement. With explain_analyze the result is the profiled plan tree.
   bridge::peloton_status ExecuteStatementPlan(
       const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
       std::vector<StatementResult> &result, const std::vector<int> &result_format,
-      const size_t thread_id = 0);
+      const size_t thread_id = 0, const bool explain_analyze = false);
 
   // InitBindPrepStmt - Prepare and bind a query from a query string
   std::shared_ptr<Statement> PrepareStatement(const std::string &statement_name,
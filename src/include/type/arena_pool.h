@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// arena_pool.h
+//
+// Identification: src/include/type/arena_pool.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "common/macros.h"
+#include "type/abstract_pool.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace peloton {
+namespace type {
+
+// A bump-pointer arena for short-lived allocations (e.g. the varlen
+// temporaries produced while executing a single statement).
+//
+// Allocations are carved out of large blocks without any locking, and Free()
+// is a no-op: all memory is released at once when the arena is reset or
+// destroyed. The arena is therefore NOT thread-safe and must only be used by
+// the thread that owns it (one per query / executor context).
+class ArenaPool : public AbstractPool {
+ public:
+  ArenaPool(const ArenaPool &) = delete;
+  ArenaPool &operator=(const ArenaPool &) = delete;
+
+  ArenaPool(size_t block_size = kDefaultBlockSize)
+      : block_size_(block_size),
+        current_(nullptr),
+        remaining_(0),
+        allocated_bytes_(0) {}
+
+  // Destroy this pool, and all memory it owns.
+  ~ArenaPool() {
+    for (auto block : blocks_) {
+      delete[] block;
+    }
+    for (auto block : large_blocks_) {
+      delete[] block;
+    }
+  }
+
+  // Allocate a contiguous block of memory of the given size. If the allocation
+  // is successful a non-null pointer is returned. If the allocation fails, a
+  // null pointer will be returned.
+  void *Allocate(size_t size) {
+    size = Align(size);
+    allocated_bytes_ += size;
+
+    // Large requests get their own block so that they don't waste the tail
+    // of the current one
+    if (size > block_size_ / 4) {
+      auto location = new char[size];
+      large_blocks_.push_back(location);
+      return location;
+    }
+
+    if (unlikely_branch(size > remaining_)) {
+      NextBlock();
+    }
+
+    auto location = current_;
+    current_ += size;
+    remaining_ -= size;
+    return location;
+  }
+
+  // Memory is only reclaimed in bulk by Reset() or the destructor
+  void Free(UNUSED_ATTRIBUTE void *ptr) {}
+
+  // Release everything allocated so far. The first block is kept around so
+  // that a reused arena does not hit the allocator again.
+  void Reset() {
+    for (auto block : large_blocks_) {
+      delete[] block;
+    }
+    large_blocks_.clear();
+
+    if (blocks_.empty() == false) {
+      for (size_t block_itr = 1; block_itr < blocks_.size(); block_itr++) {
+        delete[] blocks_[block_itr];
+      }
+      blocks_.resize(1);
+      current_ = blocks_[0];
+      remaining_ = block_size_;
+    }
+
+    allocated_bytes_ = 0;
+  }
+
+  // Number of bytes handed out since the last reset
+  size_t GetAllocatedBytes() const { return allocated_bytes_; }
+
+  static const size_t kDefaultBlockSize = 64 * 1024;
+
+ private:
+  // Round up to the natural alignment of any scalar
+  static inline size_t Align(size_t size) {
+    const size_t alignment = sizeof(void *) * 2;
+    if (size == 0) return alignment;
+    return (size + alignment - 1) & ~(alignment - 1);
+  }
+
+  void NextBlock() {
+    current_ = new char[block_size_];
+    blocks_.push_back(current_);
+    remaining_ = block_size_;
+  }
+
+  // Size of each regular block
+  const size_t block_size_;
+
+  // Bump pointer into the current block
+  char *current_;
+
+  // Bytes left in the current block
+  size_t remaining_;
+
+  // Bytes handed out since the last reset
+  size_t allocated_bytes_;
+
+  // Regular blocks
+  std::vector<char *> blocks_;
+
+  // Oversized allocations
+  std::vector<char *> large_blocks_;
+};
+
+}  // namespace type
+}  // namespace peloton
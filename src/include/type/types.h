@@ -381,7 +381,10 @@ enum SqlStateErrorCode {
 
 enum class ConcurrencyType {
   INVALID = INVALID_TYPE_ID,
-  TIMESTAMP_ORDERING = 1  // timestamp ordering
+  TIMESTAMP_ORDERING = 1,  // timestamp ordering
+  OPTIMISTIC = 2,          // optimistic multi-version concurrency control
+  SSI = 3,                 // serializable snapshot isolation
+  PARTITIONED = 4          // partitioned single-threaded execution
 };
 
 //===--------------------------------------------------------------------===//
@@ -415,6 +418,32 @@ enum class IsolationLevelType {
   REPEATABLE_READ = 3  // repeatable read
 };
 
+//===--------------------------------------------------------------------===//
+// Conflict Avoidance Types
+//===--------------------------------------------------------------------===//
+
+enum class ConflictAvoidanceType {
+  INVALID = INVALID_TYPE_ID,
+  ABORT = 1,  // fail as soon as another transaction owns the tuple
+  WAIT = 2    // wait a bounded time for a younger owner to finish (wait-die)
+};
+
+//===--------------------------------------------------------------------===//
+// Abort Cause Types
+//===--------------------------------------------------------------------===//
+
+enum class AbortCauseType {
+  INVALID = INVALID_TYPE_ID,  // not classified, e.g. a user rollback
+  OWNERSHIP_CONFLICT = 1,     // the tuple is owned by another transaction
+  READ_TIMESTAMP = 2,         // a younger transaction already read the tuple
+  VISIBILITY = 3,             // the version to work on is no longer visible
+  CONSTRAINT = 4,             // a unique or primary key violation
+  VALIDATION = 5              // commit-time validation failed (OCC, SSI)
+};
+std::string AbortCauseTypeToString(AbortCauseType type);
+AbortCauseType StringToAbortCauseType(const std::string &str);
+std::ostream &operator<<(std::ostream &os, const AbortCauseType &type);
+
 //===--------------------------------------------------------------------===//
 // Garbage Collection Types
 //===--------------------------------------------------------------------===//
@@ -438,7 +467,8 @@ enum class IndexType {
   INVALID = INVALID_TYPE_ID,  // invalid index type
   BWTREE = 1,                 // bwtree
   HASH = 2,                   // hash
-  SKIPLIST = 3                // skiplist
+  SKIPLIST = 3,               // skiplist
+  ART = 4                     // adaptive radix tree
 };
 std::string IndexTypeToString(IndexType type);
 IndexType StringToIndexType(const std::string &str);
@@ -556,6 +586,7 @@ enum class PlanNodeType {
   // Utility
   RESULT = 70,
   COPY = 71,
+  ANALYZE = 72,
 
   // Test
   MOCK = 80
@@ -593,12 +624,33 @@ enum class StatementType {
   RENAME = 11,                // rename statement type
   ALTER = 12,                 // alter statement type
   TRANSACTION = 13,           // transaction statement type,
-  COPY = 14                   // copy type
+  COPY = 14,                  // copy type
+  ANALYZE = 15,               // analyze type
+  EXPLAIN = 16                // explain type
 };
 std::string StatementTypeToString(StatementType type);
 StatementType StringToStatementType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const StatementType &type);
 
+//===--------------------------------------------------------------------===//
+// Query Phase Types
+//===--------------------------------------------------------------------===//
+
+enum class QueryPhaseType {
+  INVALID = INVALID_TYPE_ID,  // invalid query phase
+  DECODE = 1,                 // reading the query or parameters off a packet
+  PARSE = 2,                  // building the parse tree
+  PLAN = 3,                   // building the plan tree
+  BUILD = 4,                  // building and initializing the executor tree
+  EXECUTE = 5,                // running the executor tree
+  COMMIT = 6,                 // committing the transaction
+  LOG_FLUSH = 7,              // waiting for the commit record to be flushed
+  ENCODE = 8                  // putting the results into packets
+};
+std::string QueryPhaseTypeToString(QueryPhaseType type);
+QueryPhaseType StringToQueryPhaseType(const std::string &str);
+std::ostream &operator<<(std::ostream &os, const QueryPhaseType &type);
+
 //===--------------------------------------------------------------------===//
 // Scan Direction Types
 //===--------------------------------------------------------------------===//
@@ -939,6 +991,10 @@ enum MetricType {
   QUERY_METRIC = 9,
   // Statistics for CPU
   PROCESSOR_METRIC = 10,
+  // Causes of aborts and the most contended tuples
+  ABORT_METRIC = 11,
+  // Latencies of the phases of a type of statements
+  PHASE_METRIC = 12,
 };
 
 static const int INVALID_FILE_DESCRIPTOR = -1;
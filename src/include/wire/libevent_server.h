@@ -15,6 +15,7 @@
 #include <event2/buffer.h>
 #include <event2/bufferevent.h>
 #include <event2/event.h>
+#include <event2/http.h>
 #include <event2/listener.h>
 
 #include <arpa/inet.h>
@@ -79,6 +80,9 @@ void WorkerHandleNewConn(evutil_socket_t local_fd, short ev_flags, void *arg);
 /* Used by a worker to execute the main event loop for a connection */
 void EventHandler(evutil_socket_t connfd, short ev_flags, void *arg);
 
+/* Used by the master thread to serve the statistics to an HTTP request */
+void MetricsRequestHandler(struct evhttp_request *req, void *arg);
+
 /* Helpers */
 
 /* Runs the state machine for the protocol. Invoked by event handler callback */
@@ -0,0 +1,221 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// art_index.cpp
+//
+// Identification: src/index/art_index.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "index/art_index.h"
+
+#include "common/logger.h"
+#include "index/index_key.h"
+#include "index/scan_optimizer.h"
+#include "statistics/stats_aggregator.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace index {
+
+template <typename KeyType, typename ValueType, typename ValueEqualityChecker>
+ART_INDEX_TYPE::ARTIndex(IndexMetadata *metadata)
+    :  // Base class
+      Index{metadata},
+      container{} {
+  return;
+}
+
+template <typename KeyType, typename ValueType, typename ValueEqualityChecker>
+ART_INDEX_TYPE::~ARTIndex() {}
+
+/*
+ * InsertEntry() - insert a key-value pair into the map
+ *
+ * If the key value pair already exists in the map, just return false
+ */
+template <typename KeyType, typename ValueType, typename ValueEqualityChecker>
+bool ART_INDEX_TYPE::InsertEntry(const storage::Tuple *key,
+                                 ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool ret = container.Insert(index_key, value);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * DeleteEntry() - Removes a key-value pair
+ *
+ * If the key-value pair does not exists yet in the map return false
+ */
+template <typename KeyType, typename ValueType, typename ValueEqualityChecker>
+bool ART_INDEX_TYPE::DeleteEntry(const storage::Tuple *key,
+                                 ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool ret = container.Delete(index_key, value);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        ret ? 1 : 0, metadata);
+  }
+  return ret;
+}
+
+/*
+ * CondInsertEntry() - Inserts a key-value pair unless the predicate is true
+ *                     for a value of the key
+ */
+template <typename KeyType, typename ValueType, typename ValueEqualityChecker>
+bool ART_INDEX_TYPE::CondInsertEntry(
+    const storage::Tuple *key, ItemPointer *value,
+    std::function<bool(const void *)> predicate) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool predicate_satisfied = false;
+  bool ret = container.ConditionalInsert(index_key, value, predicate,
+                                         &predicate_satisfied);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * Scan() - Scans a range inside the index using index scan optimizer
+ *
+ * Unlike BWTreeIndex the tree can also walk its nodes from the right, so a
+ * backward scan returns the values in descending key order.
+ */
+template <typename KeyType, typename ValueType, typename ValueEqualityChecker>
+void ART_INDEX_TYPE::Scan(
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p) {
+  if (scan_direction == ScanDirectionType::INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+  bool forward = scan_direction != ScanDirectionType::BACKWARD;
+
+  LOG_TRACE("Scan() Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
+            csp_p->IsFullIndexScan());
+
+  if (csp_p->IsPointQuery() == true) {
+    KeyType point_query_key;
+    point_query_key.SetFromKey(csp_p->GetPointQueryKey());
+
+    container.GetValue(point_query_key, result);
+  } else if (csp_p->IsFullIndexScan() == true) {
+    container.ScanRange(nullptr, nullptr, forward, result);
+  } else {
+    const storage::Tuple *low_key_p = csp_p->GetLowKey();
+    const storage::Tuple *high_key_p = csp_p->GetHighKey();
+
+    LOG_TRACE("Partial scan low key: %s\n high key: %s",
+              low_key_p->GetInfo().c_str(), high_key_p->GetInfo().c_str());
+
+    KeyType index_low_key;
+    KeyType index_high_key;
+    index_low_key.SetFromKey(low_key_p);
+    index_high_key.SetFromKey(high_key_p);
+
+    container.ScanRange(&index_low_key, &index_high_key, forward, result);
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return;
+}
+
+/*
+ * ScanLimit() - Scan the index with predicate and limit/offset
+ *
+ * The executor applies the limit on the tuples it fetches, so this is just
+ * a scan in the given direction
+ */
+template <typename KeyType, typename ValueType, typename ValueEqualityChecker>
+void ART_INDEX_TYPE::ScanLimit(const std::vector<type::Value> &value_list,
+                               const std::vector<oid_t> &tuple_column_id_list,
+                               const std::vector<ExpressionType> &expr_list,
+                               ScanDirectionType scan_direction,
+                               std::vector<ValueType> &result,
+                               const ConjunctionScanPredicate *csp_p,
+                               UNUSED_ATTRIBUTE uint64_t limit,
+                               UNUSED_ATTRIBUTE uint64_t offset) {
+  Scan(value_list, tuple_column_id_list, expr_list, scan_direction, result,
+       csp_p);
+}
+
+template <typename KeyType, typename ValueType, typename ValueEqualityChecker>
+void ART_INDEX_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
+  container.ScanRange(nullptr, nullptr, true, result);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+  return;
+}
+
+template <typename KeyType, typename ValueType, typename ValueEqualityChecker>
+void ART_INDEX_TYPE::ScanKey(const storage::Tuple *key,
+                             std::vector<ValueType> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  container.GetValue(index_key, result);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return;
+}
+
+template <typename KeyType, typename ValueType, typename ValueEqualityChecker>
+std::string ART_INDEX_TYPE::GetTypeName() const {
+  return "ART";
+}
+
+// IMPORTANT: Make sure you don't exceed CompactIntegerKey_MAX_SLOTS
+
+template class ARTIndex<CompactIntsKey<1>, ItemPointer *,
+                        ItemPointerComparator>;
+template class ARTIndex<CompactIntsKey<2>, ItemPointer *,
+                        ItemPointerComparator>;
+template class ARTIndex<CompactIntsKey<3>, ItemPointer *,
+                        ItemPointerComparator>;
+template class ARTIndex<CompactIntsKey<4>, ItemPointer *,
+                        ItemPointerComparator>;
+
+// Normalized key
+template class ARTIndex<NormalizedKey<8>, ItemPointer *,
+                        ItemPointerComparator>;
+template class ARTIndex<NormalizedKey<16>, ItemPointer *,
+                        ItemPointerComparator>;
+template class ARTIndex<NormalizedKey<64>, ItemPointer *,
+                        ItemPointerComparator>;
+template class ARTIndex<NormalizedKey<256>, ItemPointer *,
+                        ItemPointerComparator>;
+
+}  // End index namespace
+}  // End peloton namespace
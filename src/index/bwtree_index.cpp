@@ -11,6 +11,9 @@
 //===----------------------------------------------------------------------===//
 #include "index/bwtree_index.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "common/logger.h"
 #include "index/index_key.h"
 #include "index/scan_optimizer.h"
@@ -212,8 +215,10 @@ void BWTREE_INDEX_TYPE::ScanLimit(
   // But still since we could not access tuples in the table
   // the index just fetches the first qualified key without further checking
   // including checking for non-exact bounds!!!
+  // The first key in range may not match when the keys are truncated
   if (csp_p->IsPointQuery() == false && limit == 1 && offset == 0 &&
-      scan_direction == ScanDirectionType::FORWARD) {
+      scan_direction == ScanDirectionType::FORWARD &&
+      metadata->HasTruncatedKeys() == false) {
     const storage::Tuple *low_key_p = csp_p->GetLowKey();
     const storage::Tuple *high_key_p = csp_p->GetHighKey();
 
@@ -273,6 +278,64 @@ void BWTREE_INDEX_TYPE::ScanKey(const storage::Tuple *key,
   return;
 }
 
+/*
+ * ScanKeyBatch() - Looks up the keys in sorted order, so that the keys on
+ *                  the same leaf page share one traversal
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::ScanKeyBatch(
+    const std::vector<const storage::Tuple *> &keys,
+    std::vector<ValueType> &result, std::vector<size_t> &offsets) {
+  std::vector<KeyType> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i]);
+  }
+
+  std::vector<size_t> key_order(keys.size());
+  std::iota(key_order.begin(), key_order.end(), 0);
+  std::sort(key_order.begin(), key_order.end(),
+            [this, &index_keys](const size_t &left, const size_t &right) {
+              return container.KeyCmpLess(index_keys[left],
+                                          index_keys[right]);
+            });
+
+  std::vector<KeyType> sorted_keys;
+  sorted_keys.reserve(keys.size());
+  for (auto key_offset : key_order) {
+    sorted_keys.push_back(index_keys[key_offset]);
+  }
+
+  std::vector<ValueType> sorted_result;
+  std::vector<size_t> sorted_offsets;
+  container.GetValueBatch(sorted_keys, sorted_result, sorted_offsets);
+  sorted_offsets.push_back(sorted_result.size());
+
+  // Lay the values out in the order the keys were given
+  std::vector<size_t> sorted_position(keys.size());
+  for (size_t i = 0; i < key_order.size(); i++) {
+    sorted_position[key_order[i]] = i;
+  }
+
+  offsets.clear();
+  offsets.reserve(keys.size() + 1);
+  result.reserve(result.size() + sorted_result.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    offsets.push_back(result.size());
+    auto position = sorted_position[i];
+    result.insert(result.end(),
+                  sorted_result.begin() + sorted_offsets[position],
+                  sorted_result.begin() + sorted_offsets[position + 1]);
+  }
+  offsets.push_back(result.size());
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        sorted_result.size(), metadata);
+  }
+
+  return;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 std::string BWTREE_INDEX_TYPE::GetTypeName() const { return "BWTree"; }
 
@@ -317,6 +380,25 @@ template class BWTreeIndex<GenericKey<256>, ItemPointer *,
                            GenericEqualityChecker<256>, GenericHasher<256>,
                            ItemPointerComparator, ItemPointerHashFunc>;
 
+// Normalized key
+template class BWTreeIndex<NormalizedKey<8>, ItemPointer *,
+                           NormalizedComparator<8>,
+                           NormalizedEqualityChecker<8>, NormalizedHasher<8>,
+                           ItemPointerComparator, ItemPointerHashFunc>;
+template class BWTreeIndex<NormalizedKey<16>, ItemPointer *,
+                           NormalizedComparator<16>,
+                           NormalizedEqualityChecker<16>, NormalizedHasher<16>,
+                           ItemPointerComparator, ItemPointerHashFunc>;
+template class BWTreeIndex<NormalizedKey<64>, ItemPointer *,
+                           NormalizedComparator<64>,
+                           NormalizedEqualityChecker<64>, NormalizedHasher<64>,
+                           ItemPointerComparator, ItemPointerHashFunc>;
+template class BWTreeIndex<NormalizedKey<256>, ItemPointer *,
+                           NormalizedComparator<256>,
+                           NormalizedEqualityChecker<256>,
+                           NormalizedHasher<256>, ItemPointerComparator,
+                           ItemPointerHashFunc>;
+
 // Tuple key
 template class BWTreeIndex<TupleKey, ItemPointer *, TupleKeyComparator,
                            TupleKeyEqualityChecker, TupleKeyHasher,
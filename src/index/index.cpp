@@ -205,6 +205,25 @@ void Index::ScanTest(const std::vector<type::Value> &value_list,
   return;
 }
 
+/*
+ * ScanKeyBatch() - Looks up each key in turn and lays the results out one
+ *                  after another
+ */
+void Index::ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                         std::vector<ItemPointer *> &result,
+                         std::vector<size_t> &offsets) {
+  offsets.clear();
+  offsets.reserve(keys.size() + 1);
+
+  for (auto key : keys) {
+    offsets.push_back(result.size());
+    ScanKey(key, result);
+  }
+  offsets.push_back(result.size());
+
+  return;
+}
+
 /*
  * Compare() - Check whether a given index key satisfies a predicate
  *
@@ -10,10 +10,12 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 
 #include "common/logger.h"
 #include "common/macros.h"
+#include "index/art_index.h"
 #include "index/bwtree_index.h"
 #include "index/index_factory.h"
 #include "index/index_key.h"
@@ -51,6 +53,37 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
     ints_only = false;
   }
 
+  // Otherwise use a NormalizedKey if all the columns can be encoded. A key
+  // that may not fit is cut, unless the index has to tell keys apart, in
+  // which case it stays a GenericKey or TupleKey. The declared length of a
+  // string is not enforced, so any key with a string may not fit
+  bool normalized = false;
+  if (ints_only == false) {
+    bool has_strings = false;
+    for (auto column : metadata->key_schema->GetColumns()) {
+      auto col_type = column.GetType();
+      if (col_type == type::Type::VARCHAR ||
+          col_type == type::Type::VARBINARY) {
+        has_strings = true;
+        break;
+      }
+    }  // FOR
+
+    auto max_key_size =
+        NormalizedKeyUtil::GetMaxKeySize(metadata->key_schema);
+    if (max_key_size != 0 &&
+        (max_key_size > NORMALIZED_KEY_MAX_SIZE || has_strings == true)) {
+      if (metadata->HasUniqueKeys() == true) {
+        max_key_size = 0;
+      } else {
+        metadata->SetTruncatedKeys(true);
+        max_key_size =
+            std::min<size_t>(max_key_size, NORMALIZED_KEY_MAX_SIZE);
+      }
+    }
+    normalized = max_key_size != 0;
+  }
+
   auto index_type = metadata->GetIndexType();
   Index *index = nullptr;
   LOG_TRACE("Index type : %s", IndexTypeToString(index_type).c_str());
@@ -61,6 +94,8 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
   if (index_type == IndexType::BWTREE) {
     if (ints_only) {
       index = IndexFactory::GetBwTreeIntsKeyIndex(metadata);
+    } else if (normalized) {
+      index = IndexFactory::GetBwTreeNormalizedKeyIndex(metadata);
     } else {
       index = IndexFactory::GetBwTreeGenericKeyIndex(metadata);
     }
@@ -71,10 +106,27 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
   } else if (index_type == IndexType::SKIPLIST) {
     if (ints_only) {
       index = IndexFactory::GetSkipListIntsKeyIndex(metadata);
+    } else if (normalized) {
+      index = IndexFactory::GetSkipListNormalizedKeyIndex(metadata);
     } else {
       index = IndexFactory::GetSkipListGenericKeyIndex(metadata);
     }
 
+  // -----------------------
+  // ART
+  // -----------------------
+  } else if (index_type == IndexType::ART) {
+    if (ints_only) {
+      index = IndexFactory::GetARTIntsKeyIndex(metadata);
+    } else if (normalized) {
+      index = IndexFactory::GetARTNormalizedKeyIndex(metadata);
+    } else {
+      // The tree needs keys whose bytes sort like the values
+      LOG_DEBUG("Index '%s' cannot be an ART, using a BwTree instead",
+                metadata->GetName().c_str());
+      index = IndexFactory::GetBwTreeGenericKeyIndex(metadata);
+    }
+
   // -----------------------
   // ERROR
   // -----------------------
@@ -215,6 +267,64 @@ Index *IndexFactory::GetBwTreeGenericKeyIndex(IndexMetadata *metadata) {
   return (index);
 }
 
+Index *IndexFactory::GetBwTreeNormalizedKeyIndex(IndexMetadata *metadata) {
+  // Our new Index!
+  Index *index = nullptr;
+
+  // The size of the encoded key in bytes
+  const auto key_size = std::min<size_t>(
+      NormalizedKeyUtil::GetMaxKeySize(metadata->key_schema),
+      NORMALIZED_KEY_MAX_SIZE);
+
+// Debug Output
+#ifdef LOG_TRACE_ENABLED
+  std::string comparatorType;
+#endif
+
+  if (key_size <= 8) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<8>";
+#endif
+    index =
+        new BWTreeIndex<NormalizedKey<8>, ItemPointer *,
+                        NormalizedComparator<8>, NormalizedEqualityChecker<8>,
+                        NormalizedHasher<8>, ItemPointerComparator,
+                        ItemPointerHashFunc>(metadata);
+  } else if (key_size <= 16) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<16>";
+#endif
+    index =
+        new BWTreeIndex<NormalizedKey<16>, ItemPointer *,
+                        NormalizedComparator<16>, NormalizedEqualityChecker<16>,
+                        NormalizedHasher<16>, ItemPointerComparator,
+                        ItemPointerHashFunc>(metadata);
+  } else if (key_size <= 64) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<64>";
+#endif
+    index =
+        new BWTreeIndex<NormalizedKey<64>, ItemPointer *,
+                        NormalizedComparator<64>, NormalizedEqualityChecker<64>,
+                        NormalizedHasher<64>, ItemPointerComparator,
+                        ItemPointerHashFunc>(metadata);
+  } else {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<256>";
+#endif
+    index = new BWTreeIndex<NormalizedKey<256>, ItemPointer *,
+                            NormalizedComparator<256>,
+                            NormalizedEqualityChecker<256>,
+                            NormalizedHasher<256>, ItemPointerComparator,
+                            ItemPointerHashFunc>(metadata);
+  }
+
+#ifdef LOG_TRACE_ENABLED
+  LOG_TRACE("%s", IndexFactory::GetInfo(metadata, comparatorType).c_str());
+#endif
+  return (index);
+}
+
 Index *IndexFactory::GetSkipListIntsKeyIndex(IndexMetadata *metadata) {
   // Our new Index!
   Index *index = nullptr;
@@ -341,6 +451,152 @@ Index *IndexFactory::GetSkipListGenericKeyIndex(IndexMetadata *metadata) {
   return (index);
 }
 
+Index *IndexFactory::GetSkipListNormalizedKeyIndex(IndexMetadata *metadata) {
+  // Our new Index!
+  Index *index = nullptr;
+
+  // The size of the encoded key in bytes
+  const auto key_size = std::min<size_t>(
+      NormalizedKeyUtil::GetMaxKeySize(metadata->key_schema),
+      NORMALIZED_KEY_MAX_SIZE);
+
+// Debug Output
+#ifdef LOG_TRACE_ENABLED
+  std::string comparatorType;
+#endif
+
+  if (key_size <= 8) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<8>";
+#endif
+    index = new SkipListIndex<NormalizedKey<8>, ItemPointer *,
+                              NormalizedComparator<8>,
+                              NormalizedEqualityChecker<8>,
+                              ItemPointerComparator>(metadata);
+  } else if (key_size <= 16) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<16>";
+#endif
+    index = new SkipListIndex<NormalizedKey<16>, ItemPointer *,
+                              NormalizedComparator<16>,
+                              NormalizedEqualityChecker<16>,
+                              ItemPointerComparator>(metadata);
+  } else if (key_size <= 64) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<64>";
+#endif
+    index = new SkipListIndex<NormalizedKey<64>, ItemPointer *,
+                              NormalizedComparator<64>,
+                              NormalizedEqualityChecker<64>,
+                              ItemPointerComparator>(metadata);
+  } else {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<256>";
+#endif
+    index = new SkipListIndex<NormalizedKey<256>, ItemPointer *,
+                              NormalizedComparator<256>,
+                              NormalizedEqualityChecker<256>,
+                              ItemPointerComparator>(metadata);
+  }
+
+#ifdef LOG_TRACE_ENABLED
+  LOG_TRACE("%s", IndexFactory::GetInfo(metadata, comparatorType).c_str());
+#endif
+  return (index);
+}
+
+Index *IndexFactory::GetARTIntsKeyIndex(IndexMetadata *metadata) {
+  // Our new Index!
+  Index *index = nullptr;
+
+  // The size of the key in bytes
+  const auto key_size = metadata->key_schema->GetLength();
+
+// Debug Output
+#ifdef LOG_TRACE_ENABLED
+  std::string comparatorType;
+#endif
+
+  if (key_size <= sizeof(uint64_t)) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<1>";
+#endif
+    index = new ARTIndex<CompactIntsKey<1>, ItemPointer *,
+                         ItemPointerComparator>(metadata);
+  } else if (key_size <= sizeof(uint64_t) * 2) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<2>";
+#endif
+    index = new ARTIndex<CompactIntsKey<2>, ItemPointer *,
+                         ItemPointerComparator>(metadata);
+  } else if (key_size <= sizeof(uint64_t) * 3) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<3>";
+#endif
+    index = new ARTIndex<CompactIntsKey<3>, ItemPointer *,
+                         ItemPointerComparator>(metadata);
+  } else if (key_size <= sizeof(uint64_t) * 4) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<4>";
+#endif
+    index = new ARTIndex<CompactIntsKey<4>, ItemPointer *,
+                         ItemPointerComparator>(metadata);
+  } else {
+    throw IndexException("Unsupported IntsKey scheme");
+  }
+
+#ifdef LOG_TRACE_ENABLED
+  LOG_TRACE("%s", IndexFactory::GetInfo(metadata, comparatorType).c_str());
+#endif
+  return (index);
+}
+
+Index *IndexFactory::GetARTNormalizedKeyIndex(IndexMetadata *metadata) {
+  // Our new Index!
+  Index *index = nullptr;
+
+  // The size of the encoded key in bytes
+  const auto key_size = std::min<size_t>(
+      NormalizedKeyUtil::GetMaxKeySize(metadata->key_schema),
+      NORMALIZED_KEY_MAX_SIZE);
+
+// Debug Output
+#ifdef LOG_TRACE_ENABLED
+  std::string comparatorType;
+#endif
+
+  if (key_size <= 8) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<8>";
+#endif
+    index = new ARTIndex<NormalizedKey<8>, ItemPointer *,
+                         ItemPointerComparator>(metadata);
+  } else if (key_size <= 16) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<16>";
+#endif
+    index = new ARTIndex<NormalizedKey<16>, ItemPointer *,
+                         ItemPointerComparator>(metadata);
+  } else if (key_size <= 64) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<64>";
+#endif
+    index = new ARTIndex<NormalizedKey<64>, ItemPointer *,
+                         ItemPointerComparator>(metadata);
+  } else {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<256>";
+#endif
+    index = new ARTIndex<NormalizedKey<256>, ItemPointer *,
+                         ItemPointerComparator>(metadata);
+  }
+
+#ifdef LOG_TRACE_ENABLED
+  LOG_TRACE("%s", IndexFactory::GetInfo(metadata, comparatorType).c_str());
+#endif
+  return (index);
+}
+
 std::string IndexFactory::GetInfo(IndexMetadata *metadata,
                                   std::string comparatorType) {
   std::ostringstream os;
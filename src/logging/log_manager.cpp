@@ -18,10 +18,12 @@
 #include "common/logger.h"
 #include "common/macros.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
 #include "executor/executor_context.h"
 #include "logging/log_manager.h"
 #include "logging/logging_util.h"
 #include "logging/records/transaction_record.h"
+#include "statistics/backend_stats_context.h"
 #include "storage/data_table.h"
 #include "storage/database.h"
 #include "storage/tile_group.h"
@@ -276,7 +278,15 @@ void LogManager::LogCommitTransaction(cid_t commit_id) {
     TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_COMMIT, commit_id);
     logger->Log(&record);
     if (syncronization_commit) {
+      if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+        stats::BackendStatsContext::GetInstance()->StartPhase(
+            QueryPhaseType::LOG_FLUSH);
+      }
       WaitForFlush(commit_id);
+      if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+        stats::BackendStatsContext::GetInstance()->EndPhase(
+            QueryPhaseType::LOG_FLUSH);
+      }
     }
     // logger->GetVarlenPool()->Purge();
   }
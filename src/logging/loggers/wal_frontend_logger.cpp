@@ -426,6 +426,12 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
     // Retrieve a tile group
     auto tile_group = target_table->GetTileGroup(current_tile_group_offset);
 
+    // Skip tile groups dropped by compaction
+    if (tile_group == nullptr) {
+      current_tile_group_offset++;
+      continue;
+    }
+
     // Retrieve a logical tile
     std::unique_ptr<executor::LogicalTile> logical_tile(
         scanner.Scan(tile_group, column_ids, start_cid));
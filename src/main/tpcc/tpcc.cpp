@@ -21,6 +21,7 @@
 
 #include "gc/gc_manager_factory.h"
 #include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
 
 namespace peloton {
 namespace benchmark {
@@ -39,6 +40,15 @@ void RunBenchmark() {
   
   concurrency::EpochManagerFactory::Configure(state.epoch);
 
+  concurrency::TransactionManagerFactory::Configure(
+      state.protocol, IsolationLevelType::FULL,
+      state.wait_on_conflict ? ConflictAvoidanceType::WAIT
+                             : ConflictAvoidanceType::ABORT);
+
+  // every warehouse is a partition
+  concurrency::PartitionedTransactionManager::GetInstance().SetPartitionCount(
+      state.warehouse_count);
+
   std::unique_ptr<std::thread> epoch_thread;
   std::vector<std::unique_ptr<std::thread>> gc_threads;
 
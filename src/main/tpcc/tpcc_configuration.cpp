@@ -26,7 +26,7 @@ void Usage(FILE *out) {
   fprintf(out,
           "Command line options : tpcc <options> \n"
           "   -h --help              :  print help message \n"
-          "   -i --index             :  index type: bwtree (default) \n"
+          "   -i --index             :  index type: bwtree (default) or art \n"
           "   -k --scale_factor      :  scale factor \n"
           "   -d --duration          :  execution duration \n"
           "   -p --profile_duration  :  profile duration \n"
@@ -38,6 +38,8 @@ void Usage(FILE *out) {
           "   -n --gc_backend_count  :  # of gc backends \n"
           "   -l --loader_count      :  # of loaders \n"
           "   -y --epoch             :  epoch type: centralized or decentralized \n"
+          "   -r --protocol          :  concurrency control: to (default), occ, ssi or partitioned \n"
+          "   -t --wait_on_conflict  :  wait for the owner of a tuple instead of aborting \n"
   );
 }
 
@@ -54,11 +56,13 @@ static struct option opts[] = {
     { "gc_backend_count", optional_argument, NULL, 'n' },
     { "loader_count", optional_argument, NULL, 'n' },
     { "epoch", optional_argument, NULL, 'y' },
+    { "protocol", optional_argument, NULL, 'r' },
+    { "wait_on_conflict", no_argument, NULL, 't' },
     { NULL, 0, NULL, 0 }
 };
 
 void ValidateIndex(const configuration &state) {
-  if (state.index != IndexType::BWTREE) {
+  if (state.index != IndexType::BWTREE && state.index != IndexType::ART) {
     LOG_ERROR("Invalid index");
     exit(EXIT_FAILURE);
   }
@@ -123,6 +127,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.index = IndexType::BWTREE;
   state.epoch = EpochType::DECENTRALIZED_EPOCH;
+  state.protocol = ConcurrencyType::TIMESTAMP_ORDERING;
+  state.wait_on_conflict = false;
   state.scale_factor = 1;
   state.duration = 10;
   state.profile_duration = 1;
@@ -138,7 +144,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "heagi:k:d:p:b:w:n:l:y:", opts, &idx);
+    int c = getopt_long(argc, argv, "heagti:k:d:p:b:w:n:l:y:r:", opts, &idx);
 
     if (c == -1) break;
 
@@ -147,6 +153,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         char *index = optarg;
         if (strcmp(index, "bwtree") == 0) {
           state.index = IndexType::BWTREE;
+        } else if (strcmp(index, "art") == 0) {
+          state.index = IndexType::ART;
         } else {
           LOG_ERROR("Unknown index: %s", index);
           exit(EXIT_FAILURE);
@@ -163,6 +171,22 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         }
         break;
       }
+      case 'r': {
+        char *protocol = optarg;
+        if (strcmp(protocol, "to") == 0) {
+          state.protocol = ConcurrencyType::TIMESTAMP_ORDERING;
+        } else if (strcmp(protocol, "occ") == 0) {
+          state.protocol = ConcurrencyType::OPTIMISTIC;
+        } else if (strcmp(protocol, "ssi") == 0) {
+          state.protocol = ConcurrencyType::SSI;
+        } else if (strcmp(protocol, "partitioned") == 0) {
+          state.protocol = ConcurrencyType::PARTITIONED;
+        } else {
+          LOG_ERROR("Unknown protocol: %s", protocol);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
       case 'l':
         state.loader_count = atoi(optarg);
         break;
@@ -184,6 +208,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'e':
         state.exp_backoff = true;
         break;
+      case 't':
+        state.wait_on_conflict = true;
+        break;
       case 'a':
         state.affinity = true;
         break;
@@ -223,6 +250,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
 
   LOG_TRACE("%s : %d", "Run client affinity", state.affinity);
   LOG_TRACE("%s : %d", "Run exponential backoff", state.exp_backoff);
+  LOG_TRACE("%s : %d", "Run wait on conflict", state.wait_on_conflict);
   LOG_TRACE("%s : %d", "Run garbage collection", state.gc_mode);
 }
 
@@ -116,8 +116,9 @@ bool RunDelivery(const size_t &thread_id){
   /////////////////////////////////////////////////////////
 
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  
-  auto txn = txn_manager.BeginTransaction(thread_id);
+
+  auto txn = txn_manager.BeginSinglePartitionTransaction(
+      type::ValueFactory::GetIntegerValue(warehouse_id), thread_id);
 
   std::unique_ptr<executor::ExecutorContext> context(
     new executor::ExecutorContext(txn));
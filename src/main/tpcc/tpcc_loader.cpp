@@ -987,6 +987,16 @@ void CreateTPCCDatabase() {
   CreateOrdersTable();
   CreateNewOrderTable();
   CreateOrderLineTable();
+
+  // The warehouse column partitions the tables. Items are only read, and the
+  // history is only inserted into.
+  warehouse_table->SetPartitionColumn(0);
+  district_table->SetPartitionColumn(1);
+  customer_table->SetPartitionColumn(2);
+  stock_table->SetPartitionColumn(1);
+  orders_table->SetPartitionColumn(3);
+  new_order_table->SetPartitionColumn(2);
+  order_line_table->SetPartitionColumn(2);
 }
 
 /////////////////////////////////////////////////////////
@@ -132,7 +132,12 @@ bool RunNewOrder(const size_t &thread_id){
 
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
 
-  auto txn = txn_manager.BeginTransaction(thread_id);
+  // an order supplied by other warehouses spans several partitions
+  auto txn = o_all_local == true
+                 ? txn_manager.BeginSinglePartitionTransaction(
+                       type::ValueFactory::GetIntegerValue(warehouse_id),
+                       thread_id)
+                 : txn_manager.BeginTransaction(thread_id);
 
   std::unique_ptr<executor::ExecutorContext> context(
       new executor::ExecutorContext(txn));
@@ -93,15 +93,17 @@ bool RunOrderStatus(const size_t &thread_id){
     }
    */
 
+  // Generate w_id, d_id, c_id, c_last
+  //int w_id = GetRandomInteger(0, state.warehouse_count - 1);
+  int w_id = GenerateWarehouseId(thread_id);
+
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  auto txn = txn_manager.BeginTransaction(thread_id);
+  auto txn = txn_manager.BeginSinglePartitionTransaction(
+      type::ValueFactory::GetIntegerValue(w_id), thread_id);
 
   std::unique_ptr<executor::ExecutorContext> context(
     new executor::ExecutorContext(txn));
 
-  // Generate w_id, d_id, c_id, c_last
-  //int w_id = GetRandomInteger(0, state.warehouse_count - 1);
-  int w_id = GenerateWarehouseId(thread_id);
   int d_id = GetRandomInteger(0, state.districts_per_warehouse - 1);
 
   int c_id = -1;
@@ -144,8 +144,13 @@ bool RunPayment(const size_t &thread_id){
   /////////////////////////////////////////////////////////
 
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  
-  auto txn = txn_manager.BeginTransaction(thread_id);
+
+  // paying through another warehouse spans two partitions
+  auto txn = customer_warehouse_id == warehouse_id
+                 ? txn_manager.BeginSinglePartitionTransaction(
+                       type::ValueFactory::GetIntegerValue(warehouse_id),
+                       thread_id)
+                 : txn_manager.BeginTransaction(thread_id);
 
   std::unique_ptr<executor::ExecutorContext> context(
     new executor::ExecutorContext(txn));
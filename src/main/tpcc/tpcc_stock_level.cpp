@@ -90,14 +90,16 @@ bool RunStockLevel(const size_t &thread_id) {
      "getStockCount": "SELECT COUNT(DISTINCT(OL_I_ID)) FROM ORDER_LINE, STOCK  WHERE OL_W_ID = ? AND OL_D_ID = ? AND OL_O_ID < ? AND OL_O_ID >= ? AND S_W_ID = ? AND S_I_ID = OL_I_ID AND S_QUANTITY < ?
      }
    */
+  // Prepare random data
+  int w_id = GenerateWarehouseId(thread_id);
+
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  auto txn = txn_manager.BeginTransaction(thread_id);
+  auto txn = txn_manager.BeginSinglePartitionTransaction(
+      type::ValueFactory::GetIntegerValue(w_id), thread_id);
 
   std::unique_ptr<executor::ExecutorContext> context(
     new executor::ExecutorContext(txn));
 
-  // Prepare random data
-  int w_id = GenerateWarehouseId(thread_id);
   int d_id = GetRandomInteger(0, state.districts_per_warehouse - 1);
   int threshold = GetRandomInteger(stock_min_threshold, stock_max_threshold);
 
@@ -21,6 +21,7 @@
 
 #include "gc/gc_manager_factory.h"
 #include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
 
 namespace peloton {
 namespace benchmark {
@@ -38,6 +39,11 @@ void RunBenchmark() {
   }
 
   concurrency::EpochManagerFactory::Configure(state.epoch);
+
+  concurrency::TransactionManagerFactory::Configure(
+      state.protocol, IsolationLevelType::FULL,
+      state.wait_on_conflict ? ConflictAvoidanceType::WAIT
+                             : ConflictAvoidanceType::ABORT);
   
   std::unique_ptr<std::thread> epoch_thread;
   std::vector<std::unique_ptr<std::thread>> gc_threads;
@@ -27,7 +27,7 @@ void Usage(FILE *out) {
   fprintf(out,
           "Command line options : ycsb <options> \n"
           "   -h --help              :  print help message \n"
-          "   -i --index             :  index type: bwtree (default) \n"
+          "   -i --index             :  index type: bwtree (default) or art \n"
           "   -k --scale_factor      :  # of K tuples \n"
           "   -d --duration          :  execution duration \n"
           "   -p --profile_duration  :  profile duration \n"
@@ -42,6 +42,8 @@ void Usage(FILE *out) {
           "   -n --gc_backend_count  :  # of gc backends \n"
           "   -l --loader_count      :  # of loaders \n"
           "   -y --epoch             :  epoch type: centralized or decentralized \n"
+          "   -r --protocol          :  concurrency control: to (default), occ or ssi \n"
+          "   -t --wait_on_conflict  :  wait for the owner of a tuple instead of aborting \n"
   );
 }
 
@@ -61,11 +63,13 @@ static struct option opts[] = {
     { "gc_backend_count", optional_argument, NULL, 'n' },
     { "loader_count", optional_argument, NULL, 'n' },
     { "epoch", optional_argument, NULL, 'y' },
+    { "protocol", optional_argument, NULL, 'r' },
+    { "wait_on_conflict", no_argument, NULL, 't' },
     { NULL, 0, NULL, 0 }
 };
 
 void ValidateIndex(const configuration &state) {
-  if (state.index != IndexType::BWTREE && state.index != IndexType::BWTREE) {
+  if (state.index != IndexType::BWTREE && state.index != IndexType::ART) {
     LOG_ERROR("Invalid index");
     exit(EXIT_FAILURE);
   }
@@ -156,6 +160,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.index = IndexType::BWTREE;
   state.epoch = EpochType::DECENTRALIZED_EPOCH;
+  state.protocol = ConcurrencyType::TIMESTAMP_ORDERING;
+  state.wait_on_conflict = false;
   state.scale_factor = 1;
   state.duration = 10;
   state.profile_duration = 1;
@@ -173,7 +179,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:l:y:", opts, &idx);
+    int c = getopt_long(argc, argv, "hemgti:k:d:p:b:c:o:u:z:n:l:y:r:", opts, &idx);
 
     if (c == -1) break;
 
@@ -182,6 +188,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         char *index = optarg;
         if (strcmp(index, "bwtree") == 0) {
           state.index = IndexType::BWTREE;
+        } else if (strcmp(index, "art") == 0) {
+          state.index = IndexType::ART;
         } else {
           LOG_ERROR("Unknown index: %s", index);
           exit(EXIT_FAILURE);
@@ -198,6 +206,20 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         }
         break;
       }
+      case 'r': {
+        char *protocol = optarg;
+        if (strcmp(protocol, "to") == 0) {
+          state.protocol = ConcurrencyType::TIMESTAMP_ORDERING;
+        } else if (strcmp(protocol, "occ") == 0) {
+          state.protocol = ConcurrencyType::OPTIMISTIC;
+        } else if (strcmp(protocol, "ssi") == 0) {
+          state.protocol = ConcurrencyType::SSI;
+        } else {
+          LOG_ERROR("Unknown protocol: %s", protocol);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
       case 'l':
         state.loader_count = atoi(optarg);
         break;
@@ -228,6 +250,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'e':
         state.exp_backoff = true;
         break;
+      case 't':
+        state.wait_on_conflict = true;
+        break;
       case 'm':
         state.string_mode = true;
         break;
@@ -264,6 +289,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateGCBackendCount(state);
 
   LOG_TRACE("%s : %d", "Run exponential backoff", state.exp_backoff);
+  LOG_TRACE("%s : %d", "Run wait on conflict", state.wait_on_conflict);
   LOG_TRACE("%s : %d", "Run string mode", state.string_mode);
   LOG_TRACE("%s : %d", "Run garbage collection", state.gc_mode);
   
@@ -17,6 +17,7 @@
 #include "networking/peloton_endpoint.h"
 #include "networking/rpc_server.h"
 #include "planner/seq_scan_plan.h"
+#include "storage/anti_cache_manager.h"
 #include "storage/tile.h"
 #include "storage/tuple.h"
 #include "type/serializeio.h"
@@ -276,14 +277,33 @@ void PelotonService::Heartbeat(::google::protobuf::RpcController* controller,
 
 void PelotonService::UnevictData(
     ::google::protobuf::RpcController* controller,
-    UNUSED_ATTRIBUTE const UnevictDataRequest* request,
-    UNUSED_ATTRIBUTE UnevictDataResponse* response,
+    const UnevictDataRequest* request, UnevictDataResponse* response,
     ::google::protobuf::Closure* done) {
   if (controller->Failed()) {
     std::string error = controller->ErrorText();
     LOG_TRACE("PelotonService with controller failed:%s ", error.c_str());
   }
 
+  if (request != NULL) {
+    LOG_TRACE("Received unevict request, table: %d, block count: %d",
+              request->table_id(), request->block_ids_size());
+
+    // Fault the blocks the transaction is about to touch back in, so that it
+    // does not stall on them once it is restarted
+    auto& anti_cache_manager = storage::AntiCacheManager::GetInstance();
+    for (auto block_id : request->block_ids()) {
+      anti_cache_manager.FetchTileGroup(block_id);
+    }
+
+    response->set_sender_site(request->sender_site());
+    response->set_transaction_id(request->has_new_transaction_id()
+                                     ? request->new_transaction_id()
+                                     : request->transaction_id());
+    response->set_partition_id(request->partition_id());
+    Status status = OK;
+    response->set_status(status);
+  }
+
   // if callback exist, run it
   if (done) {
     done->Run();
@@ -84,7 +84,8 @@ bool GroupBindingIterator::HasNext() {
 std::shared_ptr<OperatorExpression> GroupBindingIterator::Next() {
   if (pattern_->Type() == OpType::Leaf) {
     current_item_index_ = num_group_items_;
-    return std::make_shared<OperatorExpression>(LeafOperator::make(group_id_));
+    return std::make_shared<OperatorExpression>(
+        LeafOperator::make(group_id_, target_group_->GetTableOids()));
   }
   return current_iterator_->Next();
 }
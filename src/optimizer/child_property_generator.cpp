@@ -11,8 +11,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "optimizer/child_property_generator.h"
+#include "index/index.h"
 #include "optimizer/column_manager.h"
+#include "optimizer/memo.h"
 #include "optimizer/properties.h"
+#include "optimizer/util.h"
+#include "storage/data_table.h"
 
 namespace peloton {
 namespace optimizer {
@@ -20,6 +24,7 @@ namespace optimizer {
 std::vector<std::pair<PropertySet, std::vector<PropertySet>>>
 ChildPropertyGenerator::GetProperties(std::shared_ptr<GroupExpression> gexpr,
                                       PropertySet requirements) {
+  gexpr_ = gexpr;
   requirements_ = requirements;
   output_.clear();
 
@@ -41,8 +46,39 @@ void ChildPropertyGenerator::Visit(const PhysicalLimit *) {
 }
 
 void ChildPropertyGenerator::Visit(const PhysicalScan *) {
+  GenerateScanProperties(false);
+}
+
+void ChildPropertyGenerator::Visit(const PhysicalIndexScan *op) {
+  // The index gives back the tuples in key order, which is an ascending sort
+  // on any prefix of the key columns. Truncated keys are only partly ordered
+  bool provides_sort = false;
+  auto sort_prop = requirements_.GetPropertyOfType(PropertyType::SORT)
+                       ->As<PropertySort>();
+  auto index = op->table_->GetIndex(op->index_offset_);
+  if (sort_prop != nullptr && index != nullptr &&
+      index->HasTruncatedKeys() == false) {
+    auto &key_attrs = index->GetMetadata()->GetKeyAttrs();
+    provides_sort = sort_prop->GetSortColumnSize() <= key_attrs.size();
+    for (size_t i = 0; provides_sort && i < sort_prop->GetSortColumnSize();
+         ++i) {
+      auto bound_oid = sort_prop->GetSortColumn(i)->GetBoundOid();
+      provides_sort = sort_prop->GetSortAscending(i) &&
+                      std::get<1>(bound_oid) == op->table_->GetOid() &&
+                      std::get<2>(bound_oid) == key_attrs[i];
+    }
+  }
+  GenerateScanProperties(provides_sort);
+}
+
+void ChildPropertyGenerator::GenerateScanProperties(const bool &provides_sort) {
   PropertySet provided_property;
 
+  if (provides_sort) {
+    provided_property.AddProperty(
+        requirements_.GetPropertyOfType(PropertyType::SORT));
+  }
+
   auto columns_prop = requirements_.GetPropertyOfType(PropertyType::COLUMNS);
   auto predicate_prop =
       requirements_.GetPropertyOfType(PropertyType::PREDICATE);
@@ -93,12 +129,48 @@ void ChildPropertyGenerator::Visit(const PhysicalScan *) {
 void ChildPropertyGenerator::Visit(const PhysicalProject *){};
 void ChildPropertyGenerator::Visit(const PhysicalOrderBy *) {}
 void ChildPropertyGenerator::Visit(const PhysicalFilter *){};
-void ChildPropertyGenerator::Visit(const PhysicalInnerNLJoin *){};
+void ChildPropertyGenerator::Visit(const PhysicalInnerNLJoin *op) {
+  GenerateJoinProperties(op->join_predicates);
+}
 void ChildPropertyGenerator::Visit(const PhysicalLeftNLJoin *){};
 void ChildPropertyGenerator::Visit(const PhysicalRightNLJoin *){};
 void ChildPropertyGenerator::Visit(const PhysicalOuterNLJoin *){};
-void ChildPropertyGenerator::Visit(const PhysicalInnerHashJoin *){};
+void ChildPropertyGenerator::Visit(const PhysicalInnerHashJoin *op) {
+  GenerateJoinProperties(op->join_predicates);
+}
 void ChildPropertyGenerator::Visit(const PhysicalLeftHashJoin *){};
+void ChildPropertyGenerator::Visit(const PhysicalInnerMergeJoin *op) {
+  GenerateJoinProperties(op->join_predicates);
+
+  // Each child has to be sorted on its columns of the equalities, in the
+  // order of the predicates
+  auto child_group_ids = gexpr_->GetChildGroupIDs();
+  std::vector<std::vector<expression::TupleValueExpression *>> sort_columns(
+      child_group_ids.size());
+  for (auto &predicate : op->join_predicates) {
+    for (size_t i = 0; i < predicate->GetChildrenSize(); ++i) {
+      auto column = const_cast<expression::TupleValueExpression *>(
+          static_cast<const expression::TupleValueExpression *>(
+              predicate->GetChild(i)));
+      auto table_oid = std::get<1>(column->GetBoundOid());
+      for (size_t child = 0; child < child_group_ids.size(); ++child) {
+        if (memo_.GetGroupByID(child_group_ids[child])
+                ->GetTableOids()
+                .count(table_oid) > 0) {
+          sort_columns[child].push_back(column);
+        }
+      }
+    }
+  }
+
+  for (auto &output : output_) {
+    for (size_t child = 0; child < child_group_ids.size(); ++child) {
+      std::vector<bool> sort_ascending(sort_columns[child].size(), true);
+      output.second[child].AddProperty(std::make_shared<PropertySort>(
+          sort_columns[child], sort_ascending));
+    }
+  }
+}
 void ChildPropertyGenerator::Visit(const PhysicalRightHashJoin *){};
 void ChildPropertyGenerator::Visit(const PhysicalOuterHashJoin *){};
 void ChildPropertyGenerator::Visit(const PhysicalInsert *){};
@@ -111,5 +183,116 @@ void ChildPropertyGenerator::Visit(const PhysicalDelete *) {
       std::make_pair(requirements_, std::move(child_input_properties)));
 };
 
+void ChildPropertyGenerator::GenerateJoinProperties(
+    const std::vector<std::shared_ptr<expression::AbstractExpression>> &
+        join_predicates) {
+  PropertySet provided_property;
+  std::vector<PropertySet> child_input_properties(2);
+
+  auto child_group_ids = gexpr_->GetChildGroupIDs();
+  PL_ASSERT(child_group_ids.size() == 2);
+  std::vector<const std::unordered_set<oid_t> *> child_table_oids;
+  for (auto child_group_id : child_group_ids) {
+    child_table_oids.push_back(
+        &memo_.GetGroupByID(child_group_id)->GetTableOids());
+  }
+
+  // The join evaluates the predicates spanning both children, and each child
+  // the conjuncts that only refer to its own tables
+  auto predicate_prop =
+      requirements_.GetPropertyOfType(PropertyType::PREDICATE);
+  if (predicate_prop != nullptr) {
+    provided_property.AddProperty(predicate_prop);
+
+    std::vector<expression::AbstractExpression *> predicates;
+    util::SplitPredicates(
+        predicate_prop->As<PropertyPredicate>()->GetPredicate(), predicates);
+    for (size_t i = 0; i < child_group_ids.size(); ++i) {
+      std::vector<expression::AbstractExpression *> child_predicates;
+      for (auto predicate : predicates) {
+        std::unordered_set<oid_t> predicate_tables;
+        util::GetPredicateTables(predicate, predicate_tables);
+        if (util::IsSubset(*child_table_oids[i], predicate_tables)) {
+          child_predicates.push_back(predicate);
+        }
+      }
+      if (!child_predicates.empty()) {
+        child_input_properties[i].AddProperty(
+            std::make_shared<PropertyPredicate>(
+                util::CombinePredicates(child_predicates)));
+      }
+    }
+  }
+
+  auto columns_prop = requirements_.GetPropertyOfType(PropertyType::COLUMNS);
+  if (columns_prop == nullptr ||
+      columns_prop->As<PropertyColumns>()->IsStarExpressionInColumn()) {
+    if (columns_prop != nullptr) provided_property.AddProperty(columns_prop);
+    for (auto &child_property : child_input_properties) {
+      child_property.AddProperty(std::make_shared<PropertyColumns>(true));
+    }
+    output_.push_back(std::make_pair(std::move(provided_property),
+                                     std::move(child_input_properties)));
+    return;
+  }
+
+  // Output the required columns and the sort columns, so that a sort can be
+  // enforced on top of the join
+  auto columns_prop_ptr = columns_prop->As<PropertyColumns>();
+  std::vector<expression::TupleValueExpression *> column_exprs;
+  auto add_column = [](std::vector<expression::TupleValueExpression *> &columns,
+                       expression::TupleValueExpression *column) {
+    for (auto &col : columns) {
+      if (col->GetBoundOid() == column->GetBoundOid()) return;
+    }
+    columns.push_back(column);
+  };
+  for (size_t i = 0; i < columns_prop_ptr->GetSize(); ++i) {
+    add_column(column_exprs, columns_prop_ptr->GetColumn(i));
+  }
+  auto sort_prop = requirements_.GetPropertyOfType(PropertyType::SORT);
+  if (sort_prop != nullptr) {
+    auto sort_prop_ptr = sort_prop->As<PropertySort>();
+    for (size_t i = 0; i < sort_prop_ptr->GetSortColumnSize(); ++i) {
+      add_column(column_exprs, sort_prop_ptr->GetSortColumn(i));
+    }
+  }
+  provided_property.AddProperty(
+      std::make_shared<PropertyColumns>(column_exprs));
+
+  // Each child also outputs the columns the join predicates need
+  std::vector<expression::TupleValueExpression *> needed_columns =
+      column_exprs;
+  std::vector<const expression::AbstractExpression *> exprs;
+  for (auto &predicate : join_predicates) exprs.push_back(predicate.get());
+  while (!exprs.empty()) {
+    auto expr = exprs.back();
+    exprs.pop_back();
+    if (expr->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+      add_column(needed_columns,
+                 const_cast<expression::TupleValueExpression *>(
+                     static_cast<const expression::TupleValueExpression *>(
+                         expr)));
+    }
+    for (size_t i = 0; i < expr->GetChildrenSize(); ++i) {
+      exprs.push_back(expr->GetChild(i));
+    }
+  }
+
+  for (size_t i = 0; i < child_group_ids.size(); ++i) {
+    std::vector<expression::TupleValueExpression *> child_columns;
+    for (auto column : needed_columns) {
+      if (child_table_oids[i]->count(std::get<1>(column->GetBoundOid())) > 0) {
+        child_columns.push_back(column);
+      }
+    }
+    child_input_properties[i].AddProperty(
+        std::make_shared<PropertyColumns>(child_columns));
+  }
+
+  output_.push_back(std::make_pair(std::move(provided_property),
+                                   std::move(child_input_properties)));
+}
+
 } /* namespace optimizer */
 } /* namespace peloton */
@@ -11,12 +11,31 @@
 //===----------------------------------------------------------------------===//
 
 #include "optimizer/cost_and_stats_calculator.h"
+
+#include <cmath>
+
+#include "catalog/catalog.h"
+#include "expression/tuple_value_expression.h"
 #include "optimizer/column_manager.h"
+#include "optimizer/properties.h"
 #include "optimizer/stats.h"
+#include "optimizer/table_stats.h"
 
 namespace peloton {
 namespace optimizer {
 
+// Rows assumed for tables that have not been analyzed
+static const double default_row_count = 1000;
+
+// Selectivity assumed for join predicates other than equalities
+static const double default_join_selectivity = 1.0 / 3.0;
+
+// Inserting a tuple into a hash table costs more than probing it
+static const double hash_build_factor = 2;
+
+// Reading a tuple through an index costs more than reading it in place
+static const double index_scan_factor = 1.2;
+
 void CostAndStatsCalculator::CalculateCostAndStats(
     std::shared_ptr<GroupExpression> gexpr,
     const PropertySet *output_properties,
@@ -32,45 +51,200 @@ void CostAndStatsCalculator::CalculateCostAndStats(
   gexpr->Op().Accept(this);
 }
 
-void CostAndStatsCalculator::Visit(const PhysicalScan *) {
-  // TODO: Replace with more accurate cost
-  output_stats_.reset(new Stats(nullptr));
-  output_cost_ = 1;
+// Costs are in tuples touched and include the cost of the children, so that
+// the cost of an expression is the cost of the whole plan below it.
+
+void CostAndStatsCalculator::Visit(const PhysicalScan *op) {
+  CalculateScanCostAndStats(op->table_, 1);
 };
+void CostAndStatsCalculator::Visit(const PhysicalIndexScan *op) {
+  // The whole index is read, so this only pays off when its order is needed
+  CalculateScanCostAndStats(op->table_, index_scan_factor);
+}
 void CostAndStatsCalculator::Visit(const PhysicalProject *) {
-  // TODO: Replace with more accurate cost
-  output_stats_.reset(new Stats(nullptr));
-  output_cost_ = 0;
+  auto cardinality = GetChildCardinality(0);
+  output_stats_.reset(new Stats(nullptr, cardinality));
+  output_cost_ = GetChildCost() + cardinality;
 }
 void CostAndStatsCalculator::Visit(const PhysicalOrderBy *) {
-  // TODO: Replace with more accurate cost
-  output_cost_ = 0;
+  auto cardinality = GetChildCardinality(0);
+  output_stats_.reset(new Stats(nullptr, cardinality));
+  output_cost_ = GetChildCost() + cardinality * std::log2(cardinality + 2);
 }
-void CostAndStatsCalculator::Visit(const PhysicalLimit *) {
-  // TODO: Replace with more accurate cost
-  output_cost_ = 0;
+void CostAndStatsCalculator::Visit(const PhysicalLimit *op) {
+  auto cardinality = GetChildCardinality(0);
+  if (op->limit >= 0) {
+    cardinality = std::min(cardinality, static_cast<double>(op->limit));
+  }
+  output_stats_.reset(new Stats(nullptr, cardinality));
+  output_cost_ = GetChildCost();
 }
-void CostAndStatsCalculator::Visit(const PhysicalFilter *){};
-void CostAndStatsCalculator::Visit(const PhysicalInnerNLJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalLeftNLJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalRightNLJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalOuterNLJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalInnerHashJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalLeftHashJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalRightHashJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalOuterHashJoin *){};
+void CostAndStatsCalculator::Visit(const PhysicalFilter *) {
+  auto cardinality = GetChildCardinality(0);
+  output_stats_.reset(new Stats(nullptr, cardinality));
+  output_cost_ = GetChildCost() + cardinality;
+};
+void CostAndStatsCalculator::Visit(const PhysicalInnerNLJoin *op) {
+  CalculateJoinCostAndStats(JoinAlgorithm::NESTED_LOOP, false, false,
+                            op->join_predicates);
+};
+void CostAndStatsCalculator::Visit(const PhysicalLeftNLJoin *) {
+  CalculateJoinCostAndStats(JoinAlgorithm::NESTED_LOOP, true, false);
+};
+void CostAndStatsCalculator::Visit(const PhysicalRightNLJoin *) {
+  CalculateJoinCostAndStats(JoinAlgorithm::NESTED_LOOP, false, true);
+};
+void CostAndStatsCalculator::Visit(const PhysicalOuterNLJoin *) {
+  CalculateJoinCostAndStats(JoinAlgorithm::NESTED_LOOP, true, true);
+};
+void CostAndStatsCalculator::Visit(const PhysicalInnerHashJoin *op) {
+  CalculateJoinCostAndStats(JoinAlgorithm::HASH, false, false,
+                            op->join_predicates);
+};
+void CostAndStatsCalculator::Visit(const PhysicalInnerMergeJoin *op) {
+  CalculateJoinCostAndStats(JoinAlgorithm::MERGE, false, false,
+                            op->join_predicates);
+};
+void CostAndStatsCalculator::Visit(const PhysicalLeftHashJoin *) {
+  CalculateJoinCostAndStats(JoinAlgorithm::HASH, true, false);
+};
+void CostAndStatsCalculator::Visit(const PhysicalRightHashJoin *) {
+  CalculateJoinCostAndStats(JoinAlgorithm::HASH, false, true);
+};
+void CostAndStatsCalculator::Visit(const PhysicalOuterHashJoin *) {
+  CalculateJoinCostAndStats(JoinAlgorithm::HASH, true, true);
+};
 void CostAndStatsCalculator::Visit(const PhysicalInsert *){
-  // TODO: Replace with more accurate cost
-  output_cost_ = 0;
+  output_stats_.reset(new Stats(nullptr));
+  output_cost_ = GetChildCost();
 };
 void CostAndStatsCalculator::Visit(const PhysicalDelete *){
-  // TODO: Replace with more accurate cost
-  output_cost_ = 0;
+  output_stats_.reset(new Stats(nullptr, GetChildCardinality(0)));
+  output_cost_ = GetChildCost() + GetChildCardinality(0);
 };
 void CostAndStatsCalculator::Visit(const PhysicalUpdate *){
-  // TODO: Replace with more accurate cost
-  output_cost_ = 0;
+  output_stats_.reset(new Stats(nullptr, GetChildCardinality(0)));
+  output_cost_ = GetChildCost() + GetChildCardinality(0);
 };
 
+double CostAndStatsCalculator::GetChildCardinality(const size_t &child_offset) {
+  if (child_offset >= child_stats_.size() ||
+      child_stats_[child_offset] == nullptr) {
+    return 1;
+  }
+  return child_stats_[child_offset]->GetCardinality();
+}
+
+double CostAndStatsCalculator::GetChildCost() {
+  double cost = 0;
+  for (auto child_cost : child_costs_) {
+    cost += child_cost;
+  }
+  return cost;
+}
+
+double CostAndStatsCalculator::GetDistinctCount(
+    const expression::AbstractExpression *expr) {
+  if (expr->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+    return 0;
+  }
+  auto tuple_value_expr =
+      static_cast<const expression::TupleValueExpression *>(expr);
+  if (tuple_value_expr->GetIsBound() == false) {
+    return 0;
+  }
+
+  auto bound_oid = tuple_value_expr->GetBoundOid();
+  auto table_stats = catalog::Catalog::GetInstance()->GetTableStats(
+      std::get<0>(bound_oid), std::get<1>(bound_oid));
+  if (table_stats == nullptr) {
+    return 0;
+  }
+  auto column_stats = table_stats->GetColumnStats(std::get<2>(bound_oid));
+  if (column_stats == nullptr) {
+    return 0;
+  }
+  return column_stats->distinct_count;
+}
+
+void CostAndStatsCalculator::CalculateScanCostAndStats(
+    storage::DataTable *table, const double &cost_factor) {
+  auto predicate_prop =
+      output_properties_->GetPropertyOfType(PropertyType::PREDICATE)
+          ->As<PropertyPredicate>();
+  expression::AbstractExpression *predicate = nullptr;
+  if (predicate_prop != nullptr) {
+    predicate = predicate_prop->GetPredicate();
+  }
+
+  // Fall back to the default selectivities for tables never analyzed
+  auto table_stats = catalog::Catalog::GetInstance()->GetTableStats(
+      table->GetDatabaseOid(), table->GetOid());
+  if (table_stats == nullptr) {
+    table_stats = std::make_shared<TableStats>(
+        default_row_count, std::vector<ColumnStats>(), 0);
+  }
+
+  auto row_count = table_stats->GetRowCount();
+  auto selectivity = table_stats->EstimateSelectivity(predicate);
+  output_stats_.reset(new Stats(nullptr, row_count * selectivity));
+  output_cost_ = row_count * cost_factor;
+}
+
+void CostAndStatsCalculator::CalculateJoinCostAndStats(
+    const JoinAlgorithm &algorithm, const bool &keep_left,
+    const bool &keep_right,
+    const std::vector<std::shared_ptr<expression::AbstractExpression>> &
+        join_predicates) {
+  auto left_cardinality = GetChildCardinality(0);
+  auto right_cardinality = GetChildCardinality(1);
+
+  // An equality matches a tuple with the tuples sharing its value on the side
+  // with more distinct values. Without stats, assume it is a key of the
+  // larger side.
+  double selectivity = 1;
+  for (auto &join_predicate : join_predicates) {
+    if (join_predicate->GetExpressionType() != ExpressionType::COMPARE_EQUAL) {
+      selectivity *= default_join_selectivity;
+      continue;
+    }
+    auto distinct_count =
+        std::max(GetDistinctCount(join_predicate->GetChild(0)),
+                 GetDistinctCount(join_predicate->GetChild(1)));
+    if (distinct_count <= 0) {
+      distinct_count = std::max(left_cardinality, right_cardinality);
+    }
+    selectivity /= std::max(distinct_count, 1.0);
+  }
+
+  auto cardinality = left_cardinality * right_cardinality * selectivity;
+  if (keep_left) {
+    cardinality = std::max(cardinality, left_cardinality);
+  }
+  if (keep_right) {
+    cardinality = std::max(cardinality, right_cardinality);
+  }
+  output_stats_.reset(new Stats(nullptr, cardinality));
+
+  // A hash join builds a table over the right side and probes it once with
+  // every left tuple, a merge join reads both sorted sides once, and a nested
+  // loop join rescans the right side for every left tuple
+  switch (algorithm) {
+    case JoinAlgorithm::HASH:
+      output_cost_ = GetChildCost() + left_cardinality +
+                     hash_build_factor * right_cardinality;
+      break;
+    case JoinAlgorithm::MERGE:
+      output_cost_ = GetChildCost() + left_cardinality + right_cardinality;
+      break;
+    case JoinAlgorithm::NESTED_LOOP: {
+      double left_cost = child_costs_.size() > 0 ? child_costs_[0] : 0;
+      double right_cost = child_costs_.size() > 1 ? child_costs_[1] : 0;
+      output_cost_ = left_cost + left_cardinality * right_cost;
+      break;
+    }
+  }
+}
+
 } /* namespace optimizer */
 } /* namespace peloton */
@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hyperloglog.cpp
+//
+// Identification: src/optimizer/hyperloglog.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/hyperloglog.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace optimizer {
+
+// Hashes of small integers are not necessarily well distributed
+static uint64_t Mix(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+HyperLogLog::HyperLogLog(const uint8_t &precision)
+    : precision_(precision), registers_(1ULL << precision, 0) {
+  PL_ASSERT(precision >= 4 && precision <= 16);
+}
+
+void HyperLogLog::Add(const uint64_t &hash) {
+  auto mixed_hash = Mix(hash);
+
+  // The first bits pick the bucket, the rest are the stream of coin flips
+  auto bucket = mixed_hash >> (64 - precision_);
+  auto remainder = (mixed_hash << precision_) | (1ULL << (precision_ - 1));
+  uint8_t rank = __builtin_clzll(remainder) + 1;
+
+  registers_[bucket] = std::max(registers_[bucket], rank);
+}
+
+void HyperLogLog::Merge(const HyperLogLog &other) {
+  PL_ASSERT(precision_ == other.precision_);
+  for (size_t bucket = 0; bucket < registers_.size(); bucket++) {
+    registers_[bucket] = std::max(registers_[bucket], other.registers_[bucket]);
+  }
+}
+
+double HyperLogLog::Estimate() const {
+  double bucket_count = registers_.size();
+  double alpha = 0.7213 / (1.0 + 1.079 / bucket_count);
+
+  double sum = 0;
+  size_t empty_bucket_count = 0;
+  for (auto rank : registers_) {
+    sum += std::ldexp(1.0, -rank);
+    if (rank == 0) {
+      empty_bucket_count++;
+    }
+  }
+
+  double estimate = alpha * bucket_count * bucket_count / sum;
+
+  // Small range: linear counting is more accurate
+  if (estimate <= 2.5 * bucket_count && empty_bucket_count > 0) {
+    return bucket_count * std::log(bucket_count / empty_bucket_count);
+  }
+
+  // Large range: hash collisions start to matter
+  const double two_to_64 = std::ldexp(1.0, 64);
+  if (estimate > two_to_64 / 30.0) {
+    return -two_to_64 * std::log(1.0 - estimate / two_to_64);
+  }
+
+  return estimate;
+}
+
+}  // namespace optimizer
+}  // namespace peloton
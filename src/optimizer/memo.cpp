@@ -13,6 +13,7 @@
 #include "optimizer/memo.h"
 
 #include "optimizer/operators.h"
+#include "storage/data_table.h"
 
 #include <cassert>
 
@@ -56,6 +57,7 @@ bool Memo::InsertExpression(std::shared_ptr<GroupExpression> gexpr,
     GroupID group_id;
     if (target_group == UNDEFINED_GROUP) {
       group_id = AddNewGroup();
+      GetGroupByID(group_id)->SetTableOids(DeriveTableOids(gexpr));
     } else {
       group_id = target_group;
     }
@@ -70,6 +72,24 @@ const std::vector<Group> &Memo::Groups() const { return groups_; }
 
 Group *Memo::GetGroupByID(GroupID id) { return &(groups_[id]); }
 
+std::unordered_set<oid_t> Memo::DeriveTableOids(
+    std::shared_ptr<GroupExpression> gexpr) {
+  std::unordered_set<oid_t> table_oids;
+  if (gexpr->Op().type() == OpType::Get) {
+    auto table = gexpr->Op().As<LogicalGet>()->table;
+    if (table != nullptr) {
+      table_oids.insert(table->GetOid());
+    }
+    return table_oids;
+  }
+
+  for (auto child_group_id : gexpr->GetChildGroupIDs()) {
+    auto &child_table_oids = GetGroupByID(child_group_id)->GetTableOids();
+    table_oids.insert(child_table_oids.begin(), child_table_oids.end());
+  }
+  return table_oids;
+}
+
 GroupID Memo::AddNewGroup() {
   GroupID new_group_id = groups_.size();
   groups_.emplace_back(new_group_id);
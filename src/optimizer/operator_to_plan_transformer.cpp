@@ -11,12 +11,18 @@
 //===----------------------------------------------------------------------===//
 
 #include "planner/update_plan.h"
+#include "catalog/catalog.h"
 #include "expression/expression_util.h"
+#include "storage/data_table.h"
 
 #include "optimizer/operator_expression.h"
 #include "optimizer/operator_to_plan_transformer.h"
 #include "optimizer/properties.h"
+#include "optimizer/util.h"
 #include "planner/hash_join_plan.h"
+#include "planner/hash_plan.h"
+#include "planner/index_scan_plan.h"
+#include "planner/merge_join_plan.h"
 #include "planner/nested_loop_join_plan.h"
 #include "planner/projection_plan.h"
 #include "planner/seq_scan_plan.h"
@@ -48,48 +54,28 @@ OperatorToPlanTransformer::ConvertOpExpression(
 
 void OperatorToPlanTransformer::Visit(const PhysicalScan *op) {
   std::vector<oid_t> column_ids;
+  GenerateScanColumns(op->table_, column_ids);
 
-  // Scan predicates
-  auto predicate_prop =
-      requirements_->GetPropertyOfType(PropertyType::PREDICATE)
-          ->As<PropertyPredicate>();
-
-  expression::AbstractExpression *predicate = nullptr;
-  if (predicate_prop != nullptr) {
-    predicate = predicate_prop->GetPredicate()->Copy();
-  }
-
-  // Scan columns
-  auto column_prop = requirements_->GetPropertyOfType(PropertyType::COLUMNS)
-                         ->As<PropertyColumns>();
-
-  PL_ASSERT(column_prop != nullptr);
-
-  // Add col_ids for SELECT *
-  if (column_prop->IsStarExpressionInColumn()) {
-    size_t col_num = op->table_->GetSchema()->GetColumnCount();
-    auto db_id = op->table_->GetDatabaseOid();
-    oid_t table_id = op->table_->GetOid();
-    for (oid_t i = 0; i < col_num; ++i) {
-      column_ids.push_back(i);
-      if (output_columns_ != nullptr)
-        output_columns_->emplace_back(std::make_tuple(db_id, table_id, i));
-    }
-  } else {
-    for (size_t column_idx = 0; column_idx < column_prop->GetSize();
-         column_idx++) {
-      auto col = column_prop->GetColumn(column_idx);
-      oid_t id = std::get<2>(col->GetBoundOid());
-      column_ids.push_back(id);
-
-      // record output column mapping
-      if (output_columns_ != nullptr)
-        output_columns_->emplace_back(col->GetBoundOid());
-    }
-  }
+  output_plan_.reset(new planner::SeqScanPlan(
+      op->table_, GenerateScanPredicate(), column_ids));
+}
 
-  output_plan_.reset(
-      new planner::SeqScanPlan(op->table_, predicate, column_ids));
+void OperatorToPlanTransformer::Visit(const PhysicalIndexScan *op) {
+  std::vector<oid_t> column_ids;
+  GenerateScanColumns(op->table_, column_ids);
+
+  // The plan makes its own copy of the predicate
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      GenerateScanPredicate());
+
+  // Without key conditions the executor reads the whole index
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      op->table_->GetIndex(op->index_offset_), {}, {}, {}, {});
+  std::unique_ptr<planner::IndexScanPlan> index_scan_plan(
+      new planner::IndexScanPlan(op->table_, predicate.get(), column_ids,
+                                 index_scan_desc));
+  index_scan_plan->SetKeepKeyOrder(true);
+  output_plan_ = std::move(index_scan_plan);
 }
 
 void OperatorToPlanTransformer::Visit(const PhysicalProject *) {
@@ -221,7 +207,23 @@ void OperatorToPlanTransformer::Visit(const PhysicalOrderBy *op) {
 }
 void OperatorToPlanTransformer::Visit(const PhysicalFilter *) {}
 
-void OperatorToPlanTransformer::Visit(const PhysicalInnerNLJoin *) {}
+void OperatorToPlanTransformer::Visit(const PhysicalInnerNLJoin *op) {
+  PL_ASSERT(children_plans_.size() == 2);
+
+  std::unique_ptr<const planner::ProjectInfo> proj_info;
+  std::shared_ptr<const catalog::Schema> schema;
+  GenerateJoinProjection(proj_info, schema);
+
+  std::unique_ptr<const expression::AbstractExpression> predicate(
+      GenerateJoinPredicate(op->join_predicates));
+
+  std::unique_ptr<planner::AbstractPlan> join_plan(
+      new planner::NestedLoopJoinPlan(JoinType::INNER, std::move(predicate),
+                                      std::move(proj_info), schema));
+  join_plan->AddChild(std::move(children_plans_[0]));
+  join_plan->AddChild(std::move(children_plans_[1]));
+  output_plan_ = std::move(join_plan);
+}
 
 void OperatorToPlanTransformer::Visit(const PhysicalLeftNLJoin *) {}
 
@@ -229,10 +231,91 @@ void OperatorToPlanTransformer::Visit(const PhysicalRightNLJoin *) {}
 
 void OperatorToPlanTransformer::Visit(const PhysicalOuterNLJoin *) {}
 
-void OperatorToPlanTransformer::Visit(const PhysicalInnerHashJoin *) {}
+void OperatorToPlanTransformer::Visit(const PhysicalInnerHashJoin *op) {
+  PL_ASSERT(children_plans_.size() == 2);
+
+  std::unique_ptr<const planner::ProjectInfo> proj_info;
+  std::shared_ptr<const catalog::Schema> schema;
+  GenerateJoinProjection(proj_info, schema);
+
+  // Every join predicate is an equality between a column of each side, which
+  // the hash table matches
+  std::vector<oid_t> outer_hash_ids;
+  std::vector<std::unique_ptr<const expression::AbstractExpression>>
+      hash_keys;
+  for (auto &join_predicate : op->join_predicates) {
+    PL_ASSERT(join_predicate->GetExpressionType() ==
+              ExpressionType::COMPARE_EQUAL);
+    for (size_t i = 0; i < join_predicate->GetChildrenSize(); ++i) {
+      auto column = static_cast<const expression::TupleValueExpression *>(
+          join_predicate->GetChild(i));
+      oid_t child_idx, offset;
+      if (FindChildColumn(column->GetBoundOid(), child_idx, offset) == false) {
+        throw Exception("Join column not found in the output of the children");
+      }
+      if (child_idx == 0) {
+        outer_hash_ids.push_back(offset);
+      } else {
+        hash_keys.emplace_back(expression::ExpressionUtil::TupleValueFactory(
+            column->GetValueType(), 0, offset));
+      }
+    }
+  }
+  PL_ASSERT(outer_hash_ids.size() == hash_keys.size());
+
+  std::unique_ptr<const expression::AbstractExpression> predicate(
+      GenerateJoinPredicate(op->join_predicates));
+
+  std::unique_ptr<planner::AbstractPlan> hash_plan(
+      new planner::HashPlan(hash_keys));
+  hash_plan->AddChild(std::move(children_plans_[1]));
+
+  std::unique_ptr<planner::AbstractPlan> join_plan(new planner::HashJoinPlan(
+      JoinType::INNER, std::move(predicate), std::move(proj_info), schema,
+      outer_hash_ids));
+  join_plan->AddChild(std::move(children_plans_[0]));
+  join_plan->AddChild(std::move(hash_plan));
+  output_plan_ = std::move(join_plan);
+}
 
 void OperatorToPlanTransformer::Visit(const PhysicalLeftHashJoin *) {}
 
+void OperatorToPlanTransformer::Visit(const PhysicalInnerMergeJoin *op) {
+  PL_ASSERT(children_plans_.size() == 2);
+
+  std::unique_ptr<const planner::ProjectInfo> proj_info;
+  std::shared_ptr<const catalog::Schema> schema;
+  GenerateJoinProjection(proj_info, schema);
+
+  // Every join predicate is an equality between a column of each side, and
+  // the children are sorted on those columns in the order of the predicates
+  std::vector<planner::MergeJoinPlan::JoinClause> join_clauses;
+  for (auto &join_predicate : op->join_predicates) {
+    PL_ASSERT(join_predicate->GetExpressionType() ==
+              ExpressionType::COMPARE_EQUAL);
+    const expression::AbstractExpression *keys[2] = {nullptr, nullptr};
+    for (size_t i = 0; i < join_predicate->GetChildrenSize(); ++i) {
+      auto column = static_cast<const expression::TupleValueExpression *>(
+          join_predicate->GetChild(i));
+      oid_t child_idx, offset;
+      if (FindChildColumn(column->GetBoundOid(), child_idx, offset) == false) {
+        throw Exception("Join column not found in the output of the children");
+      }
+      keys[child_idx] = expression::ExpressionUtil::TupleValueFactory(
+          column->GetValueType(), child_idx, offset);
+    }
+    PL_ASSERT(keys[0] != nullptr && keys[1] != nullptr);
+    join_clauses.emplace_back(keys[0], keys[1], false);
+  }
+
+  // The join clauses cover all the predicates
+  std::unique_ptr<planner::AbstractPlan> join_plan(new planner::MergeJoinPlan(
+      JoinType::INNER, nullptr, std::move(proj_info), schema, join_clauses));
+  join_plan->AddChild(std::move(children_plans_[0]));
+  join_plan->AddChild(std::move(children_plans_[1]));
+  output_plan_ = std::move(join_plan);
+}
+
 void OperatorToPlanTransformer::Visit(const PhysicalRightHashJoin *) {}
 
 void OperatorToPlanTransformer::Visit(const PhysicalOuterHashJoin *) {}
@@ -267,5 +350,132 @@ void OperatorToPlanTransformer::VisitOpExpression(
   op->Op().Accept(this);
 }
 
+bool OperatorToPlanTransformer::FindChildColumn(
+    const std::tuple<oid_t, oid_t, oid_t> &column, oid_t &child_idx,
+    oid_t &offset) const {
+  for (child_idx = 0; child_idx < children_output_columns_.size();
+       ++child_idx) {
+    auto &child_output_columns = children_output_columns_[child_idx];
+    for (offset = 0; offset < child_output_columns.size(); ++offset) {
+      if (child_output_columns[offset] == column) return true;
+    }
+  }
+  return false;
+}
+
+void OperatorToPlanTransformer::GenerateScanColumns(
+    storage::DataTable *table, std::vector<oid_t> &column_ids) {
+  auto column_prop = requirements_->GetPropertyOfType(PropertyType::COLUMNS)
+                         ->As<PropertyColumns>();
+
+  PL_ASSERT(column_prop != nullptr);
+
+  // Add col_ids for SELECT *
+  if (column_prop->IsStarExpressionInColumn()) {
+    size_t col_num = table->GetSchema()->GetColumnCount();
+    auto db_id = table->GetDatabaseOid();
+    oid_t table_id = table->GetOid();
+    for (oid_t i = 0; i < col_num; ++i) {
+      column_ids.push_back(i);
+      if (output_columns_ != nullptr)
+        output_columns_->emplace_back(std::make_tuple(db_id, table_id, i));
+    }
+  } else {
+    for (size_t column_idx = 0; column_idx < column_prop->GetSize();
+         column_idx++) {
+      auto col = column_prop->GetColumn(column_idx);
+      oid_t id = std::get<2>(col->GetBoundOid());
+      column_ids.push_back(id);
+
+      // record output column mapping
+      if (output_columns_ != nullptr)
+        output_columns_->emplace_back(col->GetBoundOid());
+    }
+  }
+}
+
+expression::AbstractExpression *
+OperatorToPlanTransformer::GenerateScanPredicate() const {
+  auto predicate_prop =
+      requirements_->GetPropertyOfType(PropertyType::PREDICATE)
+          ->As<PropertyPredicate>();
+
+  if (predicate_prop == nullptr) {
+    return nullptr;
+  }
+  return predicate_prop->GetPredicate()->Copy();
+}
+
+void OperatorToPlanTransformer::GenerateJoinProjection(
+    std::unique_ptr<const planner::ProjectInfo> &proj_info,
+    std::shared_ptr<const catalog::Schema> &schema) {
+  std::vector<std::tuple<oid_t, oid_t, oid_t>> join_output_columns;
+  auto column_prop = requirements_->GetPropertyOfType(PropertyType::COLUMNS)
+                         ->As<PropertyColumns>();
+  if (column_prop == nullptr || column_prop->IsStarExpressionInColumn()) {
+    for (auto &child_output_columns : children_output_columns_) {
+      join_output_columns.insert(join_output_columns.end(),
+                                 child_output_columns.begin(),
+                                 child_output_columns.end());
+    }
+  } else {
+    for (size_t column_idx = 0; column_idx < column_prop->GetSize();
+         column_idx++) {
+      join_output_columns.push_back(
+          column_prop->GetColumn(column_idx)->GetBoundOid());
+    }
+  }
+
+  DirectMapList dml;
+  std::vector<catalog::Column> columns;
+  auto catalog = catalog::Catalog::GetInstance();
+  for (oid_t output_idx = 0; output_idx < join_output_columns.size();
+       ++output_idx) {
+    auto &column = join_output_columns[output_idx];
+    oid_t child_idx, offset;
+    if (FindChildColumn(column, child_idx, offset) == false) {
+      throw Exception("Join column not found in the output of the children");
+    }
+    dml.push_back(DirectMap(output_idx, std::make_pair(child_idx, offset)));
+
+    auto table =
+        catalog->GetTableWithOid(std::get<0>(column), std::get<1>(column));
+    columns.push_back(table->GetSchema()->GetColumn(std::get<2>(column)));
+
+    // record output column mapping
+    if (output_columns_ != nullptr) output_columns_->push_back(column);
+  }
+
+  proj_info.reset(new planner::ProjectInfo(TargetList(), std::move(dml)));
+  schema.reset(new catalog::Schema(columns));
+}
+
+expression::AbstractExpression *
+OperatorToPlanTransformer::GenerateJoinPredicate(
+    const std::vector<std::shared_ptr<expression::AbstractExpression>> &
+        join_predicates) const {
+  auto predicate = util::CombinePredicates(join_predicates);
+
+  std::vector<expression::AbstractExpression *> exprs;
+  if (predicate != nullptr) exprs.push_back(predicate);
+  while (!exprs.empty()) {
+    auto expr = exprs.back();
+    exprs.pop_back();
+    if (expr->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+      auto column = static_cast<expression::TupleValueExpression *>(expr);
+      oid_t child_idx, offset;
+      if (FindChildColumn(column->GetBoundOid(), child_idx, offset) == false) {
+        throw Exception("Join column not found in the output of the children");
+      }
+      column->SetTupleValueExpressionParams(column->GetValueType(), offset,
+                                            child_idx);
+    }
+    for (size_t i = 0; i < expr->GetChildrenSize(); ++i) {
+      exprs.push_back(expr->GetModifiableChild(i));
+    }
+  }
+  return predicate;
+}
+
 } /* namespace optimizer */
 } /* namespace peloton */
@@ -19,9 +19,11 @@ namespace optimizer {
 //===--------------------------------------------------------------------===//
 // Leaf
 //===--------------------------------------------------------------------===//
-Operator LeafOperator::make(GroupID group) {
+Operator LeafOperator::make(GroupID group,
+                            std::unordered_set<oid_t> table_oids) {
   LeafOperator *op = new LeafOperator;
   op->origin_group = group;
+  op->table_oids = std::move(table_oids);
   return Operator(op);
 }
 
@@ -63,9 +65,11 @@ Operator LogicalFilter::make() {
 //===--------------------------------------------------------------------===//
 // InnerJoin
 //===--------------------------------------------------------------------===//
-Operator LogicalInnerJoin::make(expression::AbstractExpression *condition) {
+Operator LogicalInnerJoin::make(
+    std::vector<std::shared_ptr<expression::AbstractExpression>>
+        join_predicates) {
   LogicalInnerJoin *join = new LogicalInnerJoin;
-  join->condition = condition;
+  join->join_predicates = std::move(join_predicates);
   return Operator(join);
 }
 
@@ -182,6 +186,33 @@ hash_t PhysicalScan::Hash() const {
   return hash;
 }
 
+//===--------------------------------------------------------------------===//
+// IndexScan
+//===--------------------------------------------------------------------===//
+Operator PhysicalIndexScan::make(storage::DataTable *table,
+                                 oid_t index_offset) {
+  PhysicalIndexScan *scan = new PhysicalIndexScan;
+  scan->table_ = table;
+  scan->index_offset_ = index_offset;
+  return Operator(scan);
+}
+
+bool PhysicalIndexScan::operator==(const BaseOperatorNode &node) {
+  if (node.type() != OpType::IndexScan) return false;
+  const PhysicalIndexScan &r = *static_cast<const PhysicalIndexScan *>(&node);
+  if (table_->GetOid() != r.table_->GetOid()) return false;
+  if (index_offset_ != r.index_offset_) return false;
+  return true;
+}
+
+hash_t PhysicalIndexScan::Hash() const {
+  hash_t hash = BaseOperatorNode::Hash();
+  oid_t table_oid = table_->GetOid();
+  hash = util::CombineHashes(hash, util::Hash<oid_t>(&table_oid));
+  hash = util::CombineHashes(hash, util::Hash<oid_t>(&index_offset_));
+  return hash;
+}
+
 //===--------------------------------------------------------------------===//
 // Project
 //===--------------------------------------------------------------------===//
@@ -223,8 +254,11 @@ Operator PhysicalFilter::make() {
 //===--------------------------------------------------------------------===//
 // InnerNLJoin
 //===--------------------------------------------------------------------===//
-Operator PhysicalInnerNLJoin::make() {
+Operator PhysicalInnerNLJoin::make(
+    std::vector<std::shared_ptr<expression::AbstractExpression>>
+        join_predicates) {
   PhysicalInnerNLJoin *join = new PhysicalInnerNLJoin;
+  join->join_predicates = std::move(join_predicates);
   return Operator(join);
 }
 
@@ -255,8 +289,11 @@ Operator PhysicalOuterNLJoin::make() {
 //===--------------------------------------------------------------------===//
 // InnerHashJoin
 //===--------------------------------------------------------------------===//
-Operator PhysicalInnerHashJoin::make() {
+Operator PhysicalInnerHashJoin::make(
+    std::vector<std::shared_ptr<expression::AbstractExpression>>
+        join_predicates) {
   PhysicalInnerHashJoin *join = new PhysicalInnerHashJoin;
+  join->join_predicates = std::move(join_predicates);
   return Operator(join);
 }
 
@@ -284,6 +321,17 @@ Operator PhysicalOuterHashJoin::make() {
   return Operator(join);
 }
 
+//===--------------------------------------------------------------------===//
+// InnerMergeJoin
+//===--------------------------------------------------------------------===//
+Operator PhysicalInnerMergeJoin::make(
+    std::vector<std::shared_ptr<expression::AbstractExpression>>
+        join_predicates) {
+  PhysicalInnerMergeJoin *join = new PhysicalInnerMergeJoin;
+  join->join_predicates = std::move(join_predicates);
+  return Operator(join);
+}
+
 //===--------------------------------------------------------------------===//
 // PhysicalInsert
 //===--------------------------------------------------------------------===//
@@ -394,6 +442,8 @@ std::string OperatorNode<LogicalDelete>::name_ = "LogicalDelete";
 template <>
 std::string OperatorNode<PhysicalScan>::name_ = "PhysicalScan";
 template <>
+std::string OperatorNode<PhysicalIndexScan>::name_ = "PhysicalIndexScan";
+template <>
 std::string OperatorNode<PhysicalProject>::name_ = "PhysicalProject";
 template <>
 std::string OperatorNode<PhysicalOrderBy>::name_ = "PhysicalOrderBy";
@@ -421,6 +471,9 @@ template <>
 std::string OperatorNode<PhysicalOuterHashJoin>::name_ =
     "PhysicalOuterHashJoin";
 template <>
+std::string OperatorNode<PhysicalInnerMergeJoin>::name_ =
+    "PhysicalInnerMergeJoin";
+template <>
 std::string OperatorNode<PhysicalInsert>::name_ = "PhysicalInsert";
 template <>
 std::string OperatorNode<PhysicalDelete>::name_ = "PhysicalDelete";
@@ -457,6 +510,8 @@ OpType OperatorNode<LogicalDelete>::type_ = OpType::LogicalDelete;
 template <>
 OpType OperatorNode<PhysicalScan>::type_ = OpType::Scan;
 template <>
+OpType OperatorNode<PhysicalIndexScan>::type_ = OpType::IndexScan;
+template <>
 OpType OperatorNode<PhysicalProject>::type_ = OpType::Project;
 template <>
 OpType OperatorNode<PhysicalOrderBy>::type_ = OpType::OrderBy;
@@ -481,6 +536,8 @@ OpType OperatorNode<PhysicalRightHashJoin>::type_ = OpType::RightHashJoin;
 template <>
 OpType OperatorNode<PhysicalOuterHashJoin>::type_ = OpType::OuterHashJoin;
 template <>
+OpType OperatorNode<PhysicalInnerMergeJoin>::type_ = OpType::InnerMergeJoin;
+template <>
 OpType OperatorNode<PhysicalInsert>::type_ = OpType::Insert;
 template <>
 OpType OperatorNode<PhysicalDelete>::type_ = OpType::Delete;
@@ -25,6 +25,7 @@
 #include "optimizer/query_to_operator_transformer.h"
 #include "optimizer/rule_impls.h"
 
+#include "parser/analyze_statement.h"
 #include "parser/sql_statement.h"
 
 #include "planner/order_by_plan.h"
@@ -32,6 +33,7 @@
 #include "planner/seq_scan_plan.h"
 #include "planner/create_plan.h"
 #include "planner/drop_plan.h"
+#include "planner/analyze_plan.h"
 #include "binder/bind_node_visitor.h"
 
 namespace peloton {
@@ -42,17 +44,20 @@ namespace optimizer {
 //===--------------------------------------------------------------------===//
 Optimizer::Optimizer() {
   logical_transformation_rules_.emplace_back(new InnerJoinCommutativity());
+  logical_transformation_rules_.emplace_back(new InnerJoinAssociativity());
   physical_implementation_rules_.emplace_back(new LogicalLimitToPhysical());
   physical_implementation_rules_.emplace_back(new LogicalDeleteToPhysical());
   physical_implementation_rules_.emplace_back(new LogicalUpdateToPhysical());
   physical_implementation_rules_.emplace_back(new LogicalInsertToPhysical());
   physical_implementation_rules_.emplace_back(new GetToScan());
+  physical_implementation_rules_.emplace_back(new GetToIndexScan());
   physical_implementation_rules_.emplace_back(new LogicalFilterToPhysical());
   physical_implementation_rules_.emplace_back(new InnerJoinToInnerNLJoin());
   physical_implementation_rules_.emplace_back(new LeftJoinToLeftNLJoin());
   physical_implementation_rules_.emplace_back(new RightJoinToRightNLJoin());
   physical_implementation_rules_.emplace_back(new OuterJoinToOuterNLJoin());
-  // rules.emplace_back(new InnerJoinToInnerHashJoin());
+  physical_implementation_rules_.emplace_back(new InnerJoinToInnerHashJoin());
+  physical_implementation_rules_.emplace_back(new InnerJoinToInnerMergeJoin());
 }
 
 std::shared_ptr<planner::AbstractPlan> Optimizer::BuildPelotonPlanTree(
@@ -96,11 +101,11 @@ std::shared_ptr<planner::AbstractPlan> Optimizer::BuildPelotonPlanTree(
 
   auto best_plan = ChooseBestPlan(root_id, properties);
 
-  if (best_plan == nullptr) return nullptr;
-
   // Reset memo after finishing the optimization
   Reset();
 
+  if (best_plan == nullptr) return nullptr;
+
   LOG_DEBUG("Exit new optimizer...");
 
   //  return std::shared_ptr<planner::AbstractPlan>(best_plan.release());
@@ -133,6 +138,14 @@ std::unique_ptr<planner::AbstractPlan> Optimizer::HandleDDLStatement(
       ddl_plan = std::move(create_plan);
     }
       break;
+
+    case StatementType::ANALYZE: {
+      LOG_TRACE("Adding Analyze plan...");
+      std::unique_ptr<planner::AbstractPlan> analyze_plan(
+          new planner::AnalyzePlan((parser::AnalyzeStatement *) tree));
+      ddl_plan = std::move(analyze_plan);
+    }
+      break;
     default:is_ddl_stmt = false;
   }
 
@@ -176,6 +189,8 @@ std::unique_ptr<planner::AbstractPlan> Optimizer::ChooseBestPlan(
   Group *group = memo_.GetGroupByID(id);
   std::shared_ptr<GroupExpression> gexpr =
       group->GetBestExpression(requirements);
+  // No expression of the group can provide the properties
+  if (gexpr == nullptr) return nullptr;
 
   LOG_TRACE("Choosing best plan for group %d with op %s", gexpr->GetGroupID(),
             gexpr->Op().name().c_str());
@@ -249,6 +264,7 @@ void Optimizer::OptimizeExpression(std::shared_ptr<GroupExpression> gexpr,
 
     std::vector<std::shared_ptr<Stats>> best_child_stats;
     std::vector<double> best_child_costs;
+    bool children_satisfied = true;
     for (size_t i = 0; i < child_group_ids.size(); ++i) {
       GroupID child_group_id = child_group_ids[i];
       const PropertySet &input_properties = input_properties_list[i];
@@ -259,13 +275,16 @@ void Optimizer::OptimizeExpression(std::shared_ptr<GroupExpression> gexpr,
       std::shared_ptr<GroupExpression> best_expression =
           memo_.GetGroupByID(child_group_id)
               ->GetBestExpression(input_properties);
-      // TODO(abpoms): we should allow for failure in the case where no
-      // expression
-      // can provide the required properties
-      PL_ASSERT(best_expression != nullptr);
+      // No expression of the child can provide the required properties, e.g.
+      // a join whose inner side cannot be rescanned
+      if (best_expression == nullptr) {
+        children_satisfied = false;
+        break;
+      }
       best_child_stats.push_back(best_expression->GetStats(input_properties));
       best_child_costs.push_back(best_expression->GetCost(input_properties));
     }
+    if (children_satisfied == false) continue;
 
     // Perform costing
     DeriveCostAndStats(gexpr, output_properties, input_properties_list,
@@ -337,7 +356,7 @@ std::shared_ptr<GroupExpression> Optimizer::EnforceProperty(
 std::vector<std::pair<PropertySet, std::vector<PropertySet>>>
 Optimizer::DeriveChildProperties(std::shared_ptr<GroupExpression> gexpr,
                                  PropertySet requirements) {
-  ChildPropertyGenerator converter(column_manager_);
+  ChildPropertyGenerator converter(column_manager_, memo_);
   return std::move(converter.GetProperties(gexpr, requirements));
 }
 
@@ -79,11 +79,15 @@ bool PropertySort::operator>=(const Property &r) const {
   if (r.Type() != PropertyType::SORT) return false;
   const PropertySort &r_sort = *reinterpret_cast<const PropertySort *>(&r);
 
-  // All the sorting orders in r must be satisfied
+  // All the sorting orders in r must be satisfied, and a sort on more
+  // columns satisfies a sort on a prefix of them
   size_t num_sort_columns = r_sort.sort_columns_.size();
   PL_ASSERT(num_sort_columns == r_sort.sort_ascending_.size());
+  if (num_sort_columns > sort_columns_.size()) return false;
   for (size_t i = 0; i < num_sort_columns; ++i) {
-    if (sort_columns_[i] != r_sort.sort_columns_[i]) return false;
+    if (sort_columns_[i]->GetBoundOid() !=
+        r_sort.sort_columns_[i]->GetBoundOid())
+      return false;
     if (sort_ascending_[i] != r_sort.sort_ascending_[i]) return false;
   }
 
@@ -34,7 +34,8 @@ void PropertyEnforcer::Visit(const PropertyProjection *) {
       std::make_shared<OperatorExpression>(PhysicalProject::make());
 
   project_expr->PushChild(
-      std::make_shared<OperatorExpression>(input_gexpr_->Op()));
+      std::make_shared<OperatorExpression>(
+      LeafOperator::make(input_gexpr_->GetGroupID())));
 
   output_expr_ = project_expr;
 }
@@ -52,7 +53,8 @@ void PropertyEnforcer::Visit(const PropertySort *property) {
       PhysicalOrderBy::make(sort_columns, sort_ascending));
 
   order_by_expr->PushChild(
-      std::make_shared<OperatorExpression>(input_gexpr_->Op()));
+      std::make_shared<OperatorExpression>(
+      LeafOperator::make(input_gexpr_->GetGroupID())));
 
   output_expr_ = order_by_expr;
 }
@@ -14,8 +14,10 @@
 #include "optimizer/query_property_extractor.h"
 
 #include "catalog/catalog.h"
+#include "common/macros.h"
 #include "expression/expression_util.h"
 #include "optimizer/properties.h"
+#include "optimizer/util.h"
 #include "parser/select_statement.h"
 #include "parser/sql_statement.h"
 #include "storage/data_table.h"
@@ -28,7 +30,35 @@ PropertySet QueryPropertyExtractor::GetProperties(parser::SQLStatement *stmt) {
   return property_set_;
 }
 
+// Collect the conditions of the inner joins in the FROM clause
+static void GetInnerJoinConditions(
+    const parser::TableRef *table_ref,
+    std::vector<expression::AbstractExpression *> &conditions) {
+  if (table_ref == nullptr) return;
+  if (table_ref->list != nullptr) {
+    for (auto table : *table_ref->list) {
+      GetInnerJoinConditions(table, conditions);
+    }
+  }
+  if (table_ref->join != nullptr) {
+    GetInnerJoinConditions(table_ref->join->left, conditions);
+    GetInnerJoinConditions(table_ref->join->right, conditions);
+    if (table_ref->join->type == JoinType::INNER &&
+        table_ref->join->condition != nullptr) {
+      conditions.push_back(table_ref->join->condition);
+    }
+  }
+}
+
 void QueryPropertyExtractor::Visit(const parser::SelectStatement *select_stmt) {
+  auto from_table = select_stmt->from_table;
+  if (from_table != nullptr &&
+      (from_table->join != nullptr ||
+       (from_table->list != nullptr && from_table->list->size() > 1))) {
+    VisitJoinSelect(select_stmt);
+    return;
+  }
+
   // Get table pointer, id, and schema.
   storage::DataTable *target_table =
       catalog::Catalog::GetInstance()->GetTableWithName(
@@ -85,6 +115,45 @@ void QueryPropertyExtractor::Visit(const parser::SelectStatement *select_stmt) {
     select_stmt->order->Accept(this);
   }
 };
+void QueryPropertyExtractor::VisitJoinSelect(
+    const parser::SelectStatement *select_stmt) {
+  // The WHERE clause and the inner join conditions are one predicate, which
+  // the optimizer splits between the joins and the scans
+  std::vector<expression::AbstractExpression *> predicates;
+  if (select_stmt->where_clause != nullptr) {
+    predicates.push_back(select_stmt->where_clause);
+  }
+  GetInnerJoinConditions(select_stmt->from_table, predicates);
+  if (!predicates.empty()) {
+    auto predicate = util::CombinePredicates(predicates);
+    util::TransformBoundExpression(predicate);
+    property_set_.AddProperty(
+        std::shared_ptr<PropertyPredicate>(new PropertyPredicate(predicate)));
+  }
+
+  // SimpleOptimizer only sends joins that select plain columns down here
+  // (see IsOptimizableJoin)
+  auto &select_list = *select_stmt->getSelectList();
+  if (select_list[0]->GetExpressionType() == ExpressionType::STAR) {
+    property_set_.AddProperty(
+        std::shared_ptr<PropertyColumns>(new PropertyColumns(true)));
+  } else {
+    std::vector<expression::TupleValueExpression *> column_exprs;
+    for (auto col : select_list) {
+      PL_ASSERT(col->GetExpressionType() == ExpressionType::VALUE_TUPLE);
+      util::TransformBoundExpression(col);
+      column_exprs.emplace_back(
+          reinterpret_cast<expression::TupleValueExpression *>(col));
+    }
+    property_set_.AddProperty(
+        std::shared_ptr<PropertyColumns>(new PropertyColumns(column_exprs)));
+  }
+
+  if (select_stmt->order != nullptr) {
+    select_stmt->order->Accept(this);
+  }
+}
+
 void QueryPropertyExtractor::Visit(const parser::TableRef *) {}
 void QueryPropertyExtractor::Visit(const parser::JoinDefinition *) {}
 void QueryPropertyExtractor::Visit(const parser::GroupByDescription *) {}
@@ -133,6 +202,8 @@ void QueryPropertyExtractor::Visit(
     UNUSED_ATTRIBUTE const parser::UpdateStatement *op) {}
 void QueryPropertyExtractor::Visit(
     UNUSED_ATTRIBUTE const parser::CopyStatement *op) {}
+void QueryPropertyExtractor::Visit(
+    UNUSED_ATTRIBUTE const parser::AnalyzeStatement *op) {}
 
 } /* namespace optimizer */
 } /* namespace peloton */
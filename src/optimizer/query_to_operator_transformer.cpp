@@ -18,6 +18,7 @@
 #include "optimizer/operators.h"
 #include "optimizer/query_node_visitor.h"
 #include "optimizer/query_to_operator_transformer.h"
+#include "optimizer/util.h"
 
 #include "planner/order_by_plan.h"
 #include "planner/projection_plan.h"
@@ -43,7 +44,14 @@ QueryToOperatorTransformer::ConvertToOpExpression(parser::SQLStatement *op) {
 
 void QueryToOperatorTransformer::Visit(const parser::SelectStatement *op) {
   auto upper_expr = output_expr;
-  if (op->from_table != nullptr) op->from_table->Accept(this);
+  if (op->from_table != nullptr) {
+    // The conjuncts of a nested select only apply to its own joins
+    auto upper_join_predicates = std::move(join_predicates_);
+    join_predicates_.clear();
+    CollectJoinPredicates(op->where_clause);
+    op->from_table->Accept(this);
+    join_predicates_ = std::move(upper_join_predicates);
+  }
   if (op->group_by != nullptr) {
     auto aggregate = std::make_shared<OperatorExpression>(
         LogicalAggregate::make(op->group_by->columns, op->group_by->having));
@@ -70,6 +78,7 @@ void QueryToOperatorTransformer::Visit(const parser::JoinDefinition *node) {
   // Get left operator
   node->left->Accept(this);
   auto left_expr = output_expr;
+  auto left_table_oids = output_table_oids_;
 
   // Get right operator
   node->right->Accept(this);
@@ -79,9 +88,9 @@ void QueryToOperatorTransformer::Visit(const parser::JoinDefinition *node) {
   std::shared_ptr<OperatorExpression> join_expr;
   switch (node->type) {
     case JoinType::INNER: {
-      join_expr = std::make_shared<OperatorExpression>(
-          LogicalInnerJoin::make(node->condition));
-      break;
+      CollectJoinPredicates(node->condition);
+      output_expr = MakeInnerJoin(left_expr, left_table_oids, right_expr);
+      return;
     }
     case JoinType::OUTER: {
       join_expr = std::make_shared<OperatorExpression>(
@@ -111,6 +120,7 @@ void QueryToOperatorTransformer::Visit(const parser::JoinDefinition *node) {
   join_expr->PushChild(right_expr);
 
   output_expr = join_expr;
+  output_table_oids_.insert(left_table_oids.begin(), left_table_oids.end());
 }
 void QueryToOperatorTransformer::Visit(const parser::TableRef *node) {
   // Nested select. Not supported in the current executors
@@ -121,21 +131,16 @@ void QueryToOperatorTransformer::Visit(const parser::TableRef *node) {
   // Multiple tables
   else if (node->list != nullptr && node->list->size() > 1) {
     std::shared_ptr<OperatorExpression> join_expr = nullptr;
-    std::shared_ptr<OperatorExpression> next_join_expr = nullptr;
+    std::unordered_set<oid_t> join_table_oids;
 
-    // Construct join sequences with Cartesian products
+    // Construct a left deep join tree, which the optimizer reorders
     for (parser::TableRef *table : *(node->list)) {
-      if (join_expr == nullptr) {
-        join_expr =
-            std::make_shared<OperatorExpression>(LogicalInnerJoin::make());
-      } else {
-        next_join_expr =
-            std::make_shared<OperatorExpression>(LogicalInnerJoin::make());
-        next_join_expr->PushChild(join_expr);
-        join_expr = next_join_expr;
-      }
       table->Accept(this);
-      join_expr->PushChild(output_expr);
+      if (join_expr != nullptr) {
+        output_expr = MakeInnerJoin(join_expr, join_table_oids, output_expr);
+      }
+      join_expr = output_expr;
+      join_table_oids = output_table_oids_;
     }
     output_expr = join_expr;
   }
@@ -150,7 +155,55 @@ void QueryToOperatorTransformer::Visit(const parser::TableRef *node) {
     auto get_expr = std::make_shared<OperatorExpression>(
         LogicalGet::make(target_table, node->GetTableAlias()));
     output_expr = get_expr;
+    output_table_oids_ = {target_table->GetOid()};
+  }
+}
+
+void QueryToOperatorTransformer::CollectJoinPredicates(
+    expression::AbstractExpression *predicate) {
+  std::vector<expression::AbstractExpression *> predicates;
+  util::SplitPredicates(predicate, predicates);
+  for (auto expr : predicates) {
+    std::unordered_set<oid_t> table_oids;
+    util::GetPredicateTables(expr, table_oids);
+    if (table_oids.size() < 2) continue;
+
+    std::shared_ptr<expression::AbstractExpression> join_predicate(
+        expr->Copy());
+    util::TransformBoundExpression(join_predicate.get());
+    join_predicates_.push_back(join_predicate);
+  }
+}
+
+std::vector<std::shared_ptr<expression::AbstractExpression>>
+QueryToOperatorTransformer::ExtractJoinPredicates(
+    const std::unordered_set<oid_t> &table_oids) {
+  std::vector<std::shared_ptr<expression::AbstractExpression>> predicates;
+  auto itr = join_predicates_.begin();
+  while (itr != join_predicates_.end()) {
+    std::unordered_set<oid_t> predicate_tables;
+    util::GetPredicateTables(itr->get(), predicate_tables);
+    if (util::IsSubset(table_oids, predicate_tables)) {
+      predicates.push_back(*itr);
+      itr = join_predicates_.erase(itr);
+    } else {
+      ++itr;
+    }
   }
+  return predicates;
+}
+
+std::shared_ptr<OperatorExpression> QueryToOperatorTransformer::MakeInnerJoin(
+    std::shared_ptr<OperatorExpression> left_expr,
+    const std::unordered_set<oid_t> &left_table_oids,
+    std::shared_ptr<OperatorExpression> right_expr) {
+  // output_table_oids_ holds the tables of the right operator
+  output_table_oids_.insert(left_table_oids.begin(), left_table_oids.end());
+  auto join_expr = std::make_shared<OperatorExpression>(
+      LogicalInnerJoin::make(ExtractJoinPredicates(output_table_oids_)));
+  join_expr->PushChild(left_expr);
+  join_expr->PushChild(right_expr);
+  return join_expr;
 }
 
 // Not support ORDER BY in sub-queries
@@ -253,6 +306,8 @@ void QueryToOperatorTransformer::Visit(
 }
 void QueryToOperatorTransformer::Visit(
     UNUSED_ATTRIBUTE const parser::CopyStatement *op) {}
+void QueryToOperatorTransformer::Visit(
+    UNUSED_ATTRIBUTE const parser::AnalyzeStatement *op) {}
 
 } /* namespace optimizer */
 } /* namespace peloton */
@@ -12,12 +12,71 @@
 
 #include "optimizer/rule_impls.h"
 #include "optimizer/operators.h"
+#include "optimizer/util.h"
+
+#include "expression/abstract_expression.h"
+#include "index/index.h"
+#include "storage/data_table.h"
 
 #include <memory>
 
 namespace peloton {
 namespace optimizer {
 
+// Tables of the group a leaf of a rule binding stands for
+static const std::unordered_set<oid_t> &GetChildTableOids(
+    const std::shared_ptr<OperatorExpression> &child) {
+  static const std::unordered_set<oid_t> no_table_oids;
+  auto leaf = child->Op().As<LeafOperator>();
+  if (leaf == nullptr) {
+    return no_table_oids;
+  }
+  return leaf->table_oids;
+}
+
+// Whether the predicate is "left column = right column", which a hash join
+// can evaluate by probing and a merge join by walking both sides in order
+static bool IsEquiJoinPredicate(const expression::AbstractExpression *predicate,
+                                const std::unordered_set<oid_t> &left_tables,
+                                const std::unordered_set<oid_t> &right_tables) {
+  if (predicate->GetExpressionType() != ExpressionType::COMPARE_EQUAL ||
+      predicate->GetChild(0)->GetExpressionType() !=
+          ExpressionType::VALUE_TUPLE ||
+      predicate->GetChild(1)->GetExpressionType() !=
+          ExpressionType::VALUE_TUPLE) {
+    return false;
+  }
+
+  std::unordered_set<oid_t> first_tables;
+  std::unordered_set<oid_t> second_tables;
+  util::GetPredicateTables(predicate->GetChild(0), first_tables);
+  util::GetPredicateTables(predicate->GetChild(1), second_tables);
+  if (first_tables.size() != 1 || second_tables.size() != 1) {
+    return false;
+  }
+  return (util::IsSubset(left_tables, first_tables) &&
+          util::IsSubset(right_tables, second_tables)) ||
+         (util::IsSubset(right_tables, first_tables) &&
+          util::IsSubset(left_tables, second_tables));
+}
+
+// Whether every predicate of an inner join binding is an equi-join predicate
+static bool IsEquiJoin(const std::shared_ptr<OperatorExpression> &plan) {
+  auto &join_predicates = plan->Op().As<LogicalInnerJoin>()->join_predicates;
+  if (join_predicates.empty()) {
+    return false;
+  }
+
+  auto &left_tables = GetChildTableOids(plan->Children().at(0));
+  auto &right_tables = GetChildTableOids(plan->Children().at(1));
+  for (auto &predicate : join_predicates) {
+    if (!IsEquiJoinPredicate(predicate.get(), left_tables, right_tables)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// InnerJoinCommutativity
 InnerJoinCommutativity::InnerJoinCommutativity() {
@@ -25,11 +84,9 @@ InnerJoinCommutativity::InnerJoinCommutativity() {
 
   std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
   std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Leaf));
-  std::shared_ptr<Pattern> predicate(std::make_shared<Pattern>(OpType::Leaf));
   match_pattern = std::make_shared<Pattern>(OpType::InnerJoin);
   match_pattern->AddChild(left_child);
   match_pattern->AddChild(right_child);
-  match_pattern->AddChild(predicate);
 }
 
 bool InnerJoinCommutativity::Check(
@@ -41,8 +98,9 @@ bool InnerJoinCommutativity::Check(
 void InnerJoinCommutativity::Transform(
     std::shared_ptr<OperatorExpression> input,
     std::vector<std::shared_ptr<OperatorExpression>> &transformed) const {
-  auto result_plan =
-      std::make_shared<OperatorExpression>(LogicalInnerJoin::make());
+  const LogicalInnerJoin *join = input->Op().As<LogicalInnerJoin>();
+  auto result_plan = std::make_shared<OperatorExpression>(
+      LogicalInnerJoin::make(join->join_predicates));
   std::vector<std::shared_ptr<OperatorExpression>> children = input->Children();
   PL_ASSERT(children.size() == 2);
   result_plan->PushChild(children[1]);
@@ -51,6 +109,77 @@ void InnerJoinCommutativity::Transform(
   transformed.push_back(result_plan);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// InnerJoinAssociativity
+InnerJoinAssociativity::InnerJoinAssociativity() {
+  logical = true;
+
+  // (A join B) join C
+  std::shared_ptr<Pattern> left_child(
+      std::make_shared<Pattern>(OpType::InnerJoin));
+  left_child->AddChild(std::make_shared<Pattern>(OpType::Leaf));
+  left_child->AddChild(std::make_shared<Pattern>(OpType::Leaf));
+  std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Leaf));
+  match_pattern = std::make_shared<Pattern>(OpType::InnerJoin);
+  match_pattern->AddChild(left_child);
+  match_pattern->AddChild(right_child);
+}
+
+bool InnerJoinAssociativity::Check(
+    std::shared_ptr<OperatorExpression> expr) const {
+  (void)expr;
+  return true;
+}
+
+void InnerJoinAssociativity::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed) const {
+  std::vector<std::shared_ptr<OperatorExpression>> children = input->Children();
+  PL_ASSERT(children.size() == 2);
+  std::vector<std::shared_ptr<OperatorExpression>> left_children =
+      children[0]->Children();
+  PL_ASSERT(left_children.size() == 2);
+  auto &a = left_children[0];
+  auto &b = left_children[1];
+  auto &c = children[1];
+
+  // Move the predicates that only refer to B and C down to the new join
+  std::unordered_set<oid_t> lower_tables = GetChildTableOids(b);
+  auto &c_tables = GetChildTableOids(c);
+  lower_tables.insert(c_tables.begin(), c_tables.end());
+
+  std::vector<std::shared_ptr<expression::AbstractExpression>> predicates =
+      input->Op().As<LogicalInnerJoin>()->join_predicates;
+  auto &left_predicates =
+      children[0]->Op().As<LogicalInnerJoin>()->join_predicates;
+  predicates.insert(predicates.end(), left_predicates.begin(),
+                    left_predicates.end());
+
+  std::vector<std::shared_ptr<expression::AbstractExpression>> upper_predicates;
+  std::vector<std::shared_ptr<expression::AbstractExpression>> lower_predicates;
+  for (auto &predicate : predicates) {
+    std::unordered_set<oid_t> predicate_tables;
+    util::GetPredicateTables(predicate.get(), predicate_tables);
+    if (util::IsSubset(lower_tables, predicate_tables)) {
+      lower_predicates.push_back(predicate);
+    } else {
+      upper_predicates.push_back(predicate);
+    }
+  }
+
+  // A join (B join C)
+  auto lower_join = std::make_shared<OperatorExpression>(
+      LogicalInnerJoin::make(std::move(lower_predicates)));
+  lower_join->PushChild(b);
+  lower_join->PushChild(c);
+  auto result_plan = std::make_shared<OperatorExpression>(
+      LogicalInnerJoin::make(std::move(upper_predicates)));
+  result_plan->PushChild(a);
+  result_plan->PushChild(lower_join);
+
+  transformed.push_back(result_plan);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// GetToScan
 GetToScan::GetToScan() {
@@ -79,6 +208,41 @@ void GetToScan::Transform(
   transformed.push_back(result_plan);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// GetToIndexScan
+GetToIndexScan::GetToIndexScan() {
+  physical = true;
+
+  match_pattern = std::make_shared<Pattern>(OpType::Get);
+}
+
+bool GetToIndexScan::Check(std::shared_ptr<OperatorExpression> plan) const {
+  auto table = plan->Op().As<LogicalGet>()->table;
+  return table != nullptr && table->GetIndexCount() > 0;
+}
+
+void GetToIndexScan::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed) const {
+  const LogicalGet *get = input->Op().As<LogicalGet>();
+
+  UNUSED_ATTRIBUTE std::vector<std::shared_ptr<OperatorExpression>> children =
+      input->Children();
+  PL_ASSERT(children.size() == 0);
+
+  // Only the bwtree and the radix tree keep their keys in order
+  for (oid_t index_offset = 0; index_offset < get->table->GetIndexCount();
+       ++index_offset) {
+    auto index = get->table->GetIndex(index_offset);
+    if (index == nullptr || (index->GetIndexMethodType() != IndexType::BWTREE &&
+                             index->GetIndexMethodType() != IndexType::ART)) {
+      continue;
+    }
+    transformed.push_back(std::make_shared<OperatorExpression>(
+        PhysicalIndexScan::make(get->table, index_offset)));
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// SelectToFilter
 LogicalFilterToPhysical::LogicalFilterToPhysical() {
@@ -218,41 +382,41 @@ void LogicalInsertToPhysical::Transform(
 InnerJoinToInnerNLJoin::InnerJoinToInnerNLJoin() {
   physical = true;
 
-  // Make three node types for pattern matching
+  // Make two node types for pattern matching
   std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
   std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Leaf));
-  std::shared_ptr<Pattern> predicate(std::make_shared<Pattern>(OpType::Leaf));
 
   // Initialize a pattern for optimizer to match
   match_pattern = std::make_shared<Pattern>(OpType::InnerJoin);
 
-  // Add node - we match join relation R and S as well as the predicate exp
+  // Add node - we match join relation R and S, the predicates are kept in the
+  // join operator
   match_pattern->AddChild(left_child);
   match_pattern->AddChild(right_child);
-  match_pattern->AddChild(predicate);
 
   return;
 }
 
 bool InnerJoinToInnerNLJoin::Check(
     std::shared_ptr<OperatorExpression> plan) const {
-  (void)plan;
-  return true;
+  // The executor rescans the inner side for every outer tuple, which only a
+  // table scan can do
+  return GetChildTableOids(plan->Children().at(1)).size() == 1;
 }
 
 void InnerJoinToInnerNLJoin::Transform(
     std::shared_ptr<OperatorExpression> input,
     std::vector<std::shared_ptr<OperatorExpression>> &transformed) const {
-  // first build an expression representing hash join
-  auto result_plan =
-      std::make_shared<OperatorExpression>(PhysicalInnerNLJoin::make());
+  // first build an expression representing nested loop join
+  const LogicalInnerJoin *join = input->Op().As<LogicalInnerJoin>();
+  auto result_plan = std::make_shared<OperatorExpression>(
+      PhysicalInnerNLJoin::make(join->join_predicates));
   std::vector<std::shared_ptr<OperatorExpression>> children = input->Children();
-  PL_ASSERT(children.size() == 3);
+  PL_ASSERT(children.size() == 2);
 
   // Then push all children into the child list of the new operator
   result_plan->PushChild(children[0]);
   result_plan->PushChild(children[1]);
-  result_plan->PushChild(children[2]);
 
   transformed.push_back(result_plan);
 
@@ -387,48 +551,82 @@ void OuterJoinToOuterNLJoin::Transform(
 InnerJoinToInnerHashJoin::InnerJoinToInnerHashJoin() {
   physical = true;
 
-  // Make three node types for pattern matching
+  // Make two node types for pattern matching
   std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
   std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Leaf));
-  std::shared_ptr<Pattern> predicate(std::make_shared<Pattern>(OpType::Leaf));
 
   // Initialize a pattern for optimizer to match
   match_pattern = std::make_shared<Pattern>(OpType::InnerJoin);
 
-  // Add node - we match join relation R and S as well as the predicate exp
+  // Add node - we match join relation R and S, the predicates are kept in the
+  // join operator
   match_pattern->AddChild(left_child);
   match_pattern->AddChild(right_child);
-  match_pattern->AddChild(predicate);
 
   return;
 }
 
 bool InnerJoinToInnerHashJoin::Check(
     std::shared_ptr<OperatorExpression> plan) const {
-  (void)plan;
-  // TODO(abpoms): Figure out how to determine if the join condition is hashable
-  return false;
+  // The hash join executor only matches keys, so every predicate has to be an
+  // equality between a column of each side
+  return IsEquiJoin(plan);
 }
 
 void InnerJoinToInnerHashJoin::Transform(
     std::shared_ptr<OperatorExpression> input,
     std::vector<std::shared_ptr<OperatorExpression>> &transformed) const {
   // first build an expression representing hash join
-  auto result_plan =
-      std::make_shared<OperatorExpression>(PhysicalInnerHashJoin::make());
+  const LogicalInnerJoin *join = input->Op().As<LogicalInnerJoin>();
+  auto result_plan = std::make_shared<OperatorExpression>(
+      PhysicalInnerHashJoin::make(join->join_predicates));
   std::vector<std::shared_ptr<OperatorExpression>> children = input->Children();
-  PL_ASSERT(children.size() == 3);
+  PL_ASSERT(children.size() == 2);
 
   // Then push all children into the child list of the new operator
   result_plan->PushChild(children[0]);
   result_plan->PushChild(children[1]);
-  result_plan->PushChild(children[2]);
 
   transformed.push_back(result_plan);
 
   return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// InnerJoinToInnerMergeJoin
+InnerJoinToInnerMergeJoin::InnerJoinToInnerMergeJoin() {
+  physical = true;
+
+  std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
+  std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Leaf));
+
+  match_pattern = std::make_shared<Pattern>(OpType::InnerJoin);
+  match_pattern->AddChild(left_child);
+  match_pattern->AddChild(right_child);
+}
+
+bool InnerJoinToInnerMergeJoin::Check(
+    std::shared_ptr<OperatorExpression> plan) const {
+  // The children are sorted on the join keys, so every predicate has to be an
+  // equality between a column of each side
+  return IsEquiJoin(plan);
+}
+
+void InnerJoinToInnerMergeJoin::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed) const {
+  const LogicalInnerJoin *join = input->Op().As<LogicalInnerJoin>();
+  auto result_plan = std::make_shared<OperatorExpression>(
+      PhysicalInnerMergeJoin::make(join->join_predicates));
+  std::vector<std::shared_ptr<OperatorExpression>> children = input->Children();
+  PL_ASSERT(children.size() == 2);
+
+  result_plan->PushChild(children[0]);
+  result_plan->PushChild(children[1]);
+
+  transformed.push_back(result_plan);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LeftJoinToLeftHashJoin
 LeftJoinToLeftHashJoin::LeftJoinToLeftHashJoin() {
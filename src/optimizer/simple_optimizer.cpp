@@ -11,8 +11,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "optimizer/simple_optimizer.h"
+#include "optimizer/optimizer.h"
+#include "optimizer/rule.h"
 
 #include "parser/abstract_parse.h"
+#include "parser/analyze_statement.h"
 
 #include "catalog/catalog.h"
 #include "catalog/schema.h"
@@ -24,6 +27,7 @@
 #include "planner/abstract_plan.h"
 #include "planner/abstract_scan_plan.h"
 #include "planner/aggregate_plan.h"
+#include "planner/analyze_plan.h"
 #include "planner/copy_plan.h"
 #include "planner/create_plan.h"
 #include "planner/delete_plan.h"
@@ -53,6 +57,44 @@ class AbstractPlan;
 }
 namespace optimizer {
 
+// Count the tables in the FROM clause, returns 0 if they are not all joined
+// with inner joins
+static size_t CountInnerJoinedTables(const parser::TableRef* table_ref) {
+  if (table_ref == nullptr || table_ref->select != nullptr) return 0;
+  if (table_ref->join != nullptr) {
+    if (table_ref->join->type != JoinType::INNER) return 0;
+    auto left_count = CountInnerJoinedTables(table_ref->join->left);
+    auto right_count = CountInnerJoinedTables(table_ref->join->right);
+    if (left_count == 0 || right_count == 0) return 0;
+    return left_count + right_count;
+  }
+  if (table_ref->list != nullptr) {
+    size_t table_count = 0;
+    for (auto table : *table_ref->list) {
+      auto count = CountInnerJoinedTables(table);
+      if (count == 0) return 0;
+      table_count += count;
+    }
+    return table_count;
+  }
+  return 1;
+}
+
+// Whether the select is a join the cost-based optimizer can plan
+static bool IsOptimizableJoin(const parser::SelectStatement* select_stmt) {
+  if (select_stmt->group_by != nullptr ||
+      CountInnerJoinedTables(select_stmt->from_table) < 2) {
+    return false;
+  }
+  for (auto expr : *select_stmt->getSelectList()) {
+    if (expr->GetExpressionType() != ExpressionType::VALUE_TUPLE &&
+        expr->GetExpressionType() != ExpressionType::STAR) {
+      return false;
+    }
+  }
+  return true;
+}
+
 SimpleOptimizer::SimpleOptimizer(){};
 
 SimpleOptimizer::~SimpleOptimizer(){};
@@ -119,6 +161,13 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
       auto group_by = select_stmt->group_by;
       expression::AbstractExpression* having = nullptr;
 
+      // Joins go to the cost-based optimizer, which picks the join order and
+      // the join algorithms
+      if (IsOptimizableJoin(select_stmt)) {
+        Optimizer optimizer;
+        return optimizer.BuildPelotonPlanTree(parse_tree);
+      }
+
       // The HACK to make the join in tpcc work. This is written by Joy Arulraj
       if (select_stmt->from_table->list != NULL) {
         LOG_TRACE("have join condition? %d",
@@ -514,6 +563,13 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
       child_plan = std::move(child_InsertPlan);
     } break;
 
+    case StatementType::ANALYZE: {
+      LOG_TRACE("Adding Analyze plan...");
+      std::unique_ptr<planner::AbstractPlan> child_AnalyzePlan(
+          new planner::AnalyzePlan((parser::AnalyzeStatement*)parse_tree2));
+      child_plan = std::move(child_AnalyzePlan);
+    } break;
+
     case StatementType::COPY: {
       LOG_TRACE("Adding Copy plan...");
       parser::CopyStatement* copy_parse_tree =
@@ -1378,6 +1434,12 @@ bool SimpleOptimizer::UnderlyingSameOrder(planner::AbstractPlan* select_plan,
     return false;
   }
 
+  // Truncated keys do not keep the tuples that share a prefix in order
+  if (index_scan_plan->GetIndex()->HasTruncatedKeys()) {
+    LOG_TRACE("index scan keys are truncated");
+    return false;
+  }
+
   // Check whether index scan output has the same ordering with order_by
   if (index_scan_plan->GetDescend() != order_by_descending) {
     LOG_TRACE("index scan output does not have the same ordering");
@@ -0,0 +1,294 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// stats_collector.cpp
+//
+// Identification: src/optimizer/stats_collector.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/stats_collector.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "catalog/catalog.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
+#include "optimizer/hyperloglog.h"
+#include "statistics/stats_aggregator.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace optimizer {
+
+static bool HasHistogram(const type::Type::TypeId &type_id) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+    case type::Type::DECIMAL:
+    case type::Type::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static double GetNumericField(const type::Value &value) {
+  switch (value.GetTypeId()) {
+    case type::Type::TINYINT:
+      return value.GetAs<int8_t>();
+    case type::Type::SMALLINT:
+      return value.GetAs<int16_t>();
+    case type::Type::INTEGER:
+      return value.GetAs<int32_t>();
+    case type::Type::BIGINT:
+      return value.GetAs<int64_t>();
+    case type::Type::DECIMAL:
+      return value.GetAs<double>();
+    case type::Type::TIMESTAMP:
+      return value.GetAs<uint64_t>();
+    default:
+      throw Exception("Invalid type for a histogram.");
+  }
+}
+
+StatsCollector::StatsCollector(const size_t &max_tile_group_count,
+                               const size_t &sample_size,
+                               const size_t &histogram_bucket_count,
+                               const size_t &most_common_value_count)
+    : max_tile_group_count_(max_tile_group_count),
+      sample_size_(sample_size),
+      histogram_bucket_count_(histogram_bucket_count),
+      most_common_value_count_(most_common_value_count),
+      random_generator_(std::random_device()()) {}
+
+std::shared_ptr<TableStats> StatsCollector::CollectTableStats(
+    storage::DataTable *table, concurrency::Transaction *txn,
+    const int64_t &modification_count) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto schema = table->GetSchema();
+  auto column_count = schema->GetColumnCount();
+
+  // Pick the tile groups to scan
+  std::vector<oid_t> tile_group_offsets(table->GetTileGroupCount());
+  std::iota(tile_group_offsets.begin(), tile_group_offsets.end(), 0);
+  if (tile_group_offsets.size() > max_tile_group_count_) {
+    std::shuffle(tile_group_offsets.begin(), tile_group_offsets.end(),
+                 random_generator_);
+    tile_group_offsets.resize(max_tile_group_count_);
+    std::sort(tile_group_offsets.begin(), tile_group_offsets.end());
+  }
+  bool full_scan = tile_group_offsets.size() == table->GetTileGroupCount();
+
+  std::vector<HyperLogLog> sketches(column_count);
+  std::vector<std::vector<type::Value>> sample_rows;
+  size_t scanned_row_count = 0;
+
+  for (auto tile_group_offset : tile_group_offsets) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    // skip tile groups dropped by compaction
+    if (tile_group == nullptr) {
+      continue;
+    }
+
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (transaction_manager.IsVisible(txn, tile_group_header, tuple_id) !=
+          VisibilityType::OK) {
+        continue;
+      }
+      scanned_row_count++;
+
+      std::vector<type::Value> row;
+      row.reserve(column_count);
+      for (oid_t column_id = 0; column_id < column_count; column_id++) {
+        auto value = tile_group->GetValue(tuple_id, column_id);
+        if (value.IsNull() == false) {
+          sketches[column_id].Add(value.Hash());
+        }
+        row.push_back(value);
+      }
+
+      // Reservoir sampling keeps each row with the same probability
+      if (sample_rows.size() < sample_size_) {
+        sample_rows.push_back(std::move(row));
+      } else {
+        std::uniform_int_distribution<size_t> distribution(
+            0, scanned_row_count - 1);
+        auto slot = distribution(random_generator_);
+        if (slot < sample_size_) {
+          sample_rows[slot] = std::move(row);
+        }
+      }
+    }
+  }
+
+  // Extrapolate to the tile groups that were not scanned. Looking at them
+  // would fault evicted ones back in, so assume they are as full.
+  double row_count = scanned_row_count;
+  if (full_scan == false) {
+    row_count = scanned_row_count *
+                static_cast<double>(table->GetTileGroupCount()) /
+                tile_group_offsets.size();
+  }
+
+  std::vector<ColumnStats> column_stats;
+  column_stats.reserve(column_count);
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    std::vector<type::Value> sample;
+    sample.reserve(sample_rows.size());
+    for (auto &row : sample_rows) {
+      sample.push_back(row[column_id]);
+    }
+
+    auto stats = BuildColumnStats(schema->GetType(column_id), sample,
+                                  row_count);
+
+    // The sketch counted every value of the scanned tile groups, which is
+    // exact up to its error when that is the whole table
+    double sketch_distinct_count = sketches[column_id].Estimate();
+    double total_count = row_count * (1 - stats.null_fraction);
+    if (full_scan == true) {
+      stats.distinct_count = sketch_distinct_count;
+    } else {
+      stats.distinct_count =
+          std::max(stats.distinct_count, sketch_distinct_count);
+    }
+    stats.distinct_count = std::min(stats.distinct_count, total_count);
+    column_stats.push_back(std::move(stats));
+  }
+
+  return std::make_shared<TableStats>(row_count, std::move(column_stats),
+                                      modification_count);
+}
+
+ColumnStats StatsCollector::BuildColumnStats(
+    const type::Type::TypeId &type_id, std::vector<type::Value> &sample,
+    const double &row_count) const {
+  ColumnStats column_stats(type_id);
+  if (sample.empty() == true) {
+    return column_stats;
+  }
+  double sample_size = sample.size();
+
+  // Nulls go to the end, the other values in order
+  auto null_begin = std::partition(
+      sample.begin(), sample.end(),
+      [](const type::Value &value) { return value.IsNull() == false; });
+  std::sort(sample.begin(), null_begin,
+            [](const type::Value &left, const type::Value &right) {
+              return left.CompareLessThan(right) == type::CMP_TRUE;
+            });
+  column_stats.null_fraction = (sample.end() - null_begin) / sample_size;
+
+  // Runs of equal values
+  std::vector<std::pair<size_t, size_t>> runs;
+  size_t singleton_count = 0;
+  for (auto itr = sample.begin(); itr != null_begin;) {
+    auto run_end = itr + 1;
+    while (run_end != null_begin &&
+           run_end->CompareEquals(*itr) == type::CMP_TRUE) {
+      run_end++;
+    }
+    runs.emplace_back(itr - sample.begin(), run_end - itr);
+    if (run_end - itr == 1) {
+      singleton_count++;
+    }
+    itr = run_end;
+  }
+  double non_null_count = null_begin - sample.begin();
+  double sample_distinct_count = runs.size();
+  if (runs.empty() == true) {
+    return column_stats;
+  }
+
+  // Duj1: the values seen once in the sample stand for the unseen ones
+  double total_count = row_count * (1 - column_stats.null_fraction);
+  column_stats.distinct_count = sample_distinct_count;
+  if (total_count > non_null_count) {
+    column_stats.distinct_count =
+        non_null_count * sample_distinct_count /
+        (non_null_count - singleton_count +
+         singleton_count * non_null_count / total_count);
+  }
+
+  // A value is common if it is noticeably more frequent than average
+  std::vector<size_t> run_order(runs.size());
+  std::iota(run_order.begin(), run_order.end(), 0);
+  std::stable_sort(run_order.begin(), run_order.end(),
+                   [&runs](const size_t &left, const size_t &right) {
+                     return runs[left].second > runs[right].second;
+                   });
+  double average_run_length = non_null_count / sample_distinct_count;
+  std::vector<bool> is_common(runs.size(), false);
+  for (auto run_offset : run_order) {
+    auto &run = runs[run_offset];
+    if (column_stats.most_common_values.size() >= most_common_value_count_ ||
+        run.second < 2 || run.second < 1.25 * average_run_length) {
+      break;
+    }
+    column_stats.most_common_values.emplace_back(sample[run.first],
+                                                 run.second / sample_size);
+    is_common[run_offset] = true;
+  }
+
+  // Equi-depth histogram over the values that are not common
+  if (HasHistogram(type_id) == false) {
+    return column_stats;
+  }
+  std::vector<double> fields;
+  for (size_t run_offset = 0; run_offset < runs.size(); run_offset++) {
+    if (is_common[run_offset] == true) {
+      continue;
+    }
+    auto &run = runs[run_offset];
+    auto field = GetNumericField(sample[run.first]);
+    fields.insert(fields.end(), run.second, field);
+  }
+  if (fields.empty() == true) {
+    return column_stats;
+  }
+
+  size_t bucket_count =
+      std::min(histogram_bucket_count_, std::max<size_t>(fields.size() - 1, 1));
+  for (size_t bound = 0; bound <= bucket_count; bound++) {
+    auto position = bound * (fields.size() - 1) / bucket_count;
+    column_stats.histogram_bounds.push_back(fields[position]);
+  }
+
+  return column_stats;
+}
+
+void StatsCollector::AnalyzeTable(storage::DataTable *table,
+                                  concurrency::Transaction *txn) {
+  // Remember how many modifications the stats have seen, so that the stats
+  // aggregator can tell when they are stale
+  int64_t modification_count = 0;
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    auto table_metric =
+        stats::StatsAggregator::GetInstance()
+            .GetAggregatedStats()
+            .GetTableMetric(table->GetDatabaseOid(), table->GetOid());
+    auto table_access = table_metric->GetTableAccess();
+    modification_count = table_access.GetInserts() +
+                         table_access.GetUpdates() + table_access.GetDeletes();
+  }
+
+  StatsCollector stats_collector;
+  catalog::Catalog::GetInstance()->SetTableStats(
+      table->GetDatabaseOid(), table->GetOid(),
+      stats_collector.CollectTableStats(table, txn, modification_count));
+}
+
+}  // namespace optimizer
+}  // namespace peloton
@@ -0,0 +1,254 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_stats.cpp
+//
+// Identification: src/optimizer/table_stats.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/table_stats.h"
+
+#include <algorithm>
+
+#include "expression/abstract_expression.h"
+#include "expression/tuple_value_expression.h"
+
+namespace peloton {
+namespace optimizer {
+
+// What we assume when the stats cannot tell
+static const double default_equal_selectivity = 0.005;
+static const double default_range_selectivity = 1.0 / 3.0;
+
+static bool GetNumericField(const type::Value &value, double &field) {
+  switch (value.GetTypeId()) {
+    case type::Type::TINYINT:
+      field = value.GetAs<int8_t>();
+      return true;
+    case type::Type::SMALLINT:
+      field = value.GetAs<int16_t>();
+      return true;
+    case type::Type::INTEGER:
+      field = value.GetAs<int32_t>();
+      return true;
+    case type::Type::BIGINT:
+      field = value.GetAs<int64_t>();
+      return true;
+    case type::Type::DECIMAL:
+      field = value.GetAs<double>();
+      return true;
+    case type::Type::TIMESTAMP:
+      field = value.GetAs<uint64_t>();
+      return true;
+    default:
+      return false;
+  }
+}
+
+static double Clamp(const double &selectivity) {
+  return std::min(1.0, std::max(0.0, selectivity));
+}
+
+//===--------------------------------------------------------------------===//
+// Column Stats
+//===--------------------------------------------------------------------===//
+
+double ColumnStats::EstimateSelectivity(const ExpressionType &comparison_type,
+                                        const type::Value &constant) const {
+  // Comparisons with null never hold
+  if (constant.IsNull() == true) {
+    return 0;
+  }
+
+  double non_null_fraction = 1 - null_fraction;
+  switch (comparison_type) {
+    case ExpressionType::COMPARE_EQUAL:
+      return Clamp(EstimateEqualSelectivity(constant));
+    case ExpressionType::COMPARE_NOTEQUAL:
+      return Clamp(non_null_fraction - EstimateEqualSelectivity(constant));
+    case ExpressionType::COMPARE_LESSTHAN:
+      return Clamp(EstimateLessThanSelectivity(constant, false));
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return Clamp(EstimateLessThanSelectivity(constant, true));
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return Clamp(non_null_fraction -
+                   EstimateLessThanSelectivity(constant, true));
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return Clamp(non_null_fraction -
+                   EstimateLessThanSelectivity(constant, false));
+    default:
+      return default_range_selectivity;
+  }
+}
+
+double ColumnStats::EstimateEqualSelectivity(
+    const type::Value &constant) const {
+  double common_fraction = 0;
+  for (auto &common_value : most_common_values) {
+    if (common_value.first.CheckComparable(constant) == false) {
+      return default_equal_selectivity;
+    }
+    if (common_value.first.CompareEquals(constant) == type::CMP_TRUE) {
+      return common_value.second;
+    }
+    common_fraction += common_value.second;
+  }
+
+  // The remaining values are assumed to be equally frequent
+  double other_fraction = 1 - null_fraction - common_fraction;
+  double other_distinct_count = distinct_count - most_common_values.size();
+  if (distinct_count == 0) {
+    return default_equal_selectivity;
+  }
+  return other_fraction / std::max(other_distinct_count, 1.0);
+}
+
+double ColumnStats::EstimateLessThanSelectivity(const type::Value &constant,
+                                                const bool &or_equal) const {
+  double field;
+  if (GetNumericField(constant, field) == false) {
+    return default_range_selectivity;
+  }
+
+  double common_fraction = 0;
+  double common_match_fraction = 0;
+  for (auto &common_value : most_common_values) {
+    double common_field;
+    if (GetNumericField(common_value.first, common_field) == false) {
+      return default_range_selectivity;
+    }
+    common_fraction += common_value.second;
+    if (common_field < field || (or_equal && common_field == field)) {
+      common_match_fraction += common_value.second;
+    }
+  }
+
+  double other_fraction = 1 - null_fraction - common_fraction;
+  if (histogram_bounds.size() < 2) {
+    return common_match_fraction + other_fraction * default_range_selectivity;
+  }
+
+  // Interpolate within the bucket the constant falls into
+  double histogram_fraction;
+  if (field < histogram_bounds.front()) {
+    histogram_fraction = 0;
+  } else if (field >= histogram_bounds.back()) {
+    histogram_fraction = 1;
+  } else {
+    auto upper = std::upper_bound(histogram_bounds.begin(),
+                                  histogram_bounds.end(), field);
+    size_t bucket = upper - histogram_bounds.begin() - 1;
+    double bucket_min = histogram_bounds[bucket];
+    double bucket_max = histogram_bounds[bucket + 1];
+    double bucket_fraction = 0.5;
+    if (bucket_max > bucket_min) {
+      bucket_fraction = (field - bucket_min) / (bucket_max - bucket_min);
+    }
+    histogram_fraction =
+        (bucket + bucket_fraction) / (histogram_bounds.size() - 1);
+  }
+
+  return common_match_fraction + other_fraction * histogram_fraction;
+}
+
+//===--------------------------------------------------------------------===//
+// Table Stats
+//===--------------------------------------------------------------------===//
+
+double TableStats::EstimateSelectivity(
+    const expression::AbstractExpression *predicate) const {
+  if (predicate == nullptr) {
+    return 1;
+  }
+
+  auto expression_type = predicate->GetExpressionType();
+  switch (expression_type) {
+    case ExpressionType::CONJUNCTION_AND:
+      // Assume the conjuncts are independent
+      return EstimateSelectivity(predicate->GetChild(0)) *
+             EstimateSelectivity(predicate->GetChild(1));
+    case ExpressionType::CONJUNCTION_OR: {
+      auto left = EstimateSelectivity(predicate->GetChild(0));
+      auto right = EstimateSelectivity(predicate->GetChild(1));
+      return left + right - left * right;
+    }
+    case ExpressionType::OPERATOR_NOT:
+      return 1 - EstimateSelectivity(predicate->GetChild(0));
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      break;
+    default:
+      return default_range_selectivity;
+  }
+
+  auto default_selectivity = expression_type == ExpressionType::COMPARE_EQUAL
+                                 ? default_equal_selectivity
+                                 : default_range_selectivity;
+
+  // Put the column on the left
+  auto comparison_type = expression_type;
+  auto column_expr = predicate->GetChild(0);
+  auto value_expr = predicate->GetChild(1);
+  if (column_expr->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+    std::swap(column_expr, value_expr);
+    switch (comparison_type) {
+      case ExpressionType::COMPARE_LESSTHAN:
+        comparison_type = ExpressionType::COMPARE_GREATERTHAN;
+        break;
+      case ExpressionType::COMPARE_GREATERTHAN:
+        comparison_type = ExpressionType::COMPARE_LESSTHAN;
+        break;
+      case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+        comparison_type = ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+        break;
+      case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        comparison_type = ExpressionType::COMPARE_LESSTHANOREQUALTO;
+        break;
+      default:
+        break;
+    }
+  }
+  if (column_expr->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+    return default_selectivity;
+  }
+
+  auto tuple_value_expr =
+      static_cast<const expression::TupleValueExpression *>(column_expr);
+  oid_t column_id;
+  if (tuple_value_expr->GetIsBound() == true) {
+    column_id = std::get<2>(tuple_value_expr->GetBoundOid());
+  } else if (tuple_value_expr->GetColumnId() >= 0) {
+    column_id = tuple_value_expr->GetColumnId();
+  } else {
+    return default_selectivity;
+  }
+
+  auto column_stats = GetColumnStats(column_id);
+  if (column_stats == nullptr) {
+    return default_selectivity;
+  }
+
+  if (value_expr->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
+    auto constant = value_expr->Evaluate(nullptr, nullptr, nullptr);
+    return column_stats->EstimateSelectivity(comparison_type, constant);
+  }
+
+  // Parameters are not known when the plan is built, so fall back to the
+  // average frequency of a value
+  if (comparison_type == ExpressionType::COMPARE_EQUAL &&
+      column_stats->distinct_count > 0) {
+    return (1 - column_stats->null_fraction) / column_stats->distinct_count;
+  }
+  return default_selectivity;
+}
+
+}  // namespace optimizer
+}  // namespace peloton
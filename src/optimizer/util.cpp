@@ -12,8 +12,104 @@
 
 #include "optimizer/util.h"
 
+#include "catalog/catalog.h"
+#include "expression/conjunction_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "storage/data_table.h"
+
 namespace peloton {
 namespace optimizer {
-namespace util {} /* namespace util */
+namespace util {
+
+void SplitPredicates(
+    expression::AbstractExpression *expr,
+    std::vector<expression::AbstractExpression *> &predicates) {
+  if (expr == nullptr) {
+    return;
+  }
+  if (expr->GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+    for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+      SplitPredicates(expr->GetModifiableChild(i), predicates);
+    }
+    return;
+  }
+  predicates.push_back(expr);
+}
+
+expression::AbstractExpression *CombinePredicates(
+    const std::vector<std::shared_ptr<expression::AbstractExpression>> &
+        predicates) {
+  std::vector<expression::AbstractExpression *> raw_predicates;
+  for (auto &predicate : predicates) {
+    raw_predicates.push_back(predicate.get());
+  }
+  return CombinePredicates(raw_predicates);
+}
+
+expression::AbstractExpression *CombinePredicates(
+    const std::vector<expression::AbstractExpression *> &predicates) {
+  expression::AbstractExpression *conjunction = nullptr;
+  for (auto &predicate : predicates) {
+    if (conjunction == nullptr) {
+      conjunction = predicate->Copy();
+    } else {
+      conjunction = new expression::ConjunctionExpression(
+          ExpressionType::CONJUNCTION_AND, conjunction, predicate->Copy());
+    }
+  }
+  return conjunction;
+}
+
+void GetPredicateTables(const expression::AbstractExpression *expr,
+                        std::unordered_set<oid_t> &table_oids) {
+  if (expr == nullptr) {
+    return;
+  }
+  if (expr->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    auto tuple_value_expr =
+        static_cast<const expression::TupleValueExpression *>(expr);
+    if (tuple_value_expr->GetIsBound()) {
+      table_oids.insert(std::get<1>(tuple_value_expr->GetBoundOid()));
+    }
+  }
+  for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+    GetPredicateTables(expr->GetChild(i), table_oids);
+  }
+}
+
+bool IsSubset(const std::unordered_set<oid_t> &set,
+              const std::unordered_set<oid_t> &subset) {
+  for (auto table_oid : subset) {
+    if (set.count(table_oid) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TransformBoundExpression(expression::AbstractExpression *expr) {
+  if (expr == nullptr) {
+    return;
+  }
+  for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+    TransformBoundExpression(expr->GetModifiableChild(i));
+  }
+  if (expr->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    auto tuple_value_expr =
+        static_cast<expression::TupleValueExpression *>(expr);
+    if (tuple_value_expr->GetIsBound() == false) {
+      return;
+    }
+    auto bound_oid = tuple_value_expr->GetBoundOid();
+    auto table = catalog::Catalog::GetInstance()->GetTableWithOid(
+        std::get<0>(bound_oid), std::get<1>(bound_oid));
+    auto column_id = std::get<2>(bound_oid);
+    tuple_value_expr->SetTupleValueExpressionParams(
+        table->GetSchema()->GetType(column_id), column_id, 0);
+  }
+  expr->DeduceExpressionType();
+}
+
+} /* namespace util */
 } /* namespace optimizer */
 } /* namespace peloton */
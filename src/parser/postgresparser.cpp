@@ -877,6 +877,41 @@ parser::CopyStatement* PostgresParser::CopyTransform(CopyStmt* root) {
   return res;
 }
 
+// This function takes in a Postgres VacuumStmt parsenode and transfers it
+// into a Peloton AnalyzeStatement. Only ANALYZE is supported.
+parser::AnalyzeStatement* PostgresParser::AnalyzeTransform(VacuumStmt* root) {
+  if ((root->options & VACOPT_VACUUM) != 0 ||
+      (root->options & VACOPT_ANALYZE) == 0) {
+    throw NotImplementedException("VACUUM is not supported");
+  }
+  auto res = new AnalyzeStatement();
+  if (root->relation != nullptr) {
+    res->analyze_table = RangeVarTransform(root->relation);
+  }
+  return res;
+}
+
+// This function takes in a Postgres ExplainStmt parsenode and transfers it
+// into a Peloton ExplainStatement. Only the ANALYZE option is supported.
+parser::ExplainStatement* PostgresParser::ExplainTransform(ExplainStmt* root) {
+  bool analyze = false;
+  if (root->options != nullptr) {
+    for (auto cell = root->options->head; cell != NULL; cell = cell->next) {
+      auto def_elem = reinterpret_cast<DefElem*>(cell->data.ptr_value);
+      if (strcmp(def_elem->defname, "analyze") != 0) {
+        throw NotImplementedException("EXPLAIN option " +
+                                      std::string(def_elem->defname) +
+                                      " is not supported");
+      }
+      analyze = true;
+    }
+  }
+  auto res = new ExplainStatement();
+  res->analyze = analyze;
+  res->real_sql_stmt = NodeTransform(root->query);
+  return res;
+}
+
 std::vector<char*>* PostgresParser::ColumnNameTransform(List* root) {
   if (root == nullptr) return nullptr;
 
@@ -1075,6 +1110,12 @@ parser::SQLStatement* PostgresParser::NodeTransform(Node* stmt) {
     case T_CopyStmt:
       result = CopyTransform((CopyStmt*)stmt);
       break;
+    case T_VacuumStmt:
+      result = AnalyzeTransform((VacuumStmt*)stmt);
+      break;
+    case T_ExplainStmt:
+      result = ExplainTransform((ExplainStmt*)stmt);
+      break;
     case T_CreatedbStmt:
       result = CreateDbTransform((CreatedbStmt*)stmt);
       break;
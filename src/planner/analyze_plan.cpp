@@ -0,0 +1,34 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_plan.cpp
+//
+// Identification: src/planner/analyze_plan.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "planner/analyze_plan.h"
+
+#include "catalog/catalog.h"
+#include "parser/analyze_statement.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace planner {
+
+AnalyzePlan::AnalyzePlan(parser::AnalyzeStatement *parse_tree) {
+  if (parse_tree->analyze_table == nullptr) {
+    database_name_ = DEFAULT_DB_NAME;
+    return;
+  }
+
+  database_name_ = parse_tree->analyze_table->GetDatabaseName();
+  target_table_ = catalog::Catalog::GetInstance()->GetTableWithName(
+      database_name_, parse_tree->analyze_table->GetTableName());
+}
+
+}  // namespace planner
+}  // namespace peloton
@@ -45,18 +45,28 @@ ProjectInfo::~ProjectInfo() {
  * @param tuple1  Source tuple 1.
  * @param tuple2  Source tuple 2.
  * @param econtext  ExecutorContext for expression evaluation.
+ * @param compiled_targets  The target list from CompileTargetList(), if any.
  */
-bool ProjectInfo::Evaluate(storage::Tuple *dest, const AbstractTuple *tuple1,
-                           const AbstractTuple *tuple2,
-                           executor::ExecutorContext *econtext) const {
+bool ProjectInfo::Evaluate(
+    storage::Tuple *dest, const AbstractTuple *tuple1,
+    const AbstractTuple *tuple2, executor::ExecutorContext *econtext,
+    const std::vector<std::unique_ptr<expression::CompiledExpression>> *
+        compiled_targets) const {
   // Get varlen pool
   type::AbstractPool *pool = nullptr;
   if (econtext != nullptr) pool = econtext->GetPool();
 
   // (A) Execute target list
-  for (auto target : target_list_) {
-    auto col_id = target.first;
-    auto expr = target.second;
+  for (size_t target_idx = 0; target_idx < target_list_.size();
+       target_idx++) {
+    auto col_id = target_list_[target_idx].first;
+    if (compiled_targets != nullptr) {
+      auto value = (*compiled_targets)[target_idx]->Evaluate(tuple1, tuple2,
+                                                             econtext);
+      dest->SetValue(col_id, value, pool);
+      continue;
+    }
+    auto expr = target_list_[target_idx].second;
     auto value = expr->Evaluate(tuple1, tuple2, econtext);
 
     dest->SetValue(col_id, value, pool);
@@ -111,6 +121,15 @@ bool ProjectInfo::Evaluate(AbstractTuple *dest, const AbstractTuple *tuple1,
   return true;
 }
 
+std::vector<std::unique_ptr<expression::CompiledExpression>>
+ProjectInfo::CompileTargetList(executor::ExecutorContext *econtext) const {
+  std::vector<std::unique_ptr<expression::CompiledExpression>> compiled_targets;
+  for (auto &target : target_list_) {
+    compiled_targets.push_back(
+        expression::CompiledExpression::Compile(target.second, econtext));
+  }
+  return compiled_targets;
+}
 
 std::string ProjectInfo::Debug() const {
   std::ostringstream buffer;
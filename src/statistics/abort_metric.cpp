@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// abort_metric.cpp
+//
+// Identification: src/statistics/abort_metric.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "statistics/abort_metric.h"
+
+#include <algorithm>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace stats {
+
+AbortMetric::AbortMetric(MetricType type)
+    : AbstractMetric(type),
+      abort_counts_(CAUSE_COUNT, CounterMetric(COUNTER_METRIC)) {}
+
+void AbortMetric::RecordAbort(AbortCauseType cause, oid_t table_id,
+                              const ItemPointer &location) {
+  GetAbortCount(cause).Increment();
+
+  // an abort without a tuple, e.g. a user rollback, has no hot spot
+  if (location.IsNull() == true) {
+    return;
+  }
+  hot_tuple_lock_.Lock();
+  CountHotTuple(table_id, location, 1, 0);
+  hot_tuple_lock_.Unlock();
+}
+
+void AbortMetric::CountHotTuple(oid_t table_id, const ItemPointer &location,
+                                uint64_t count, uint64_t error) {
+  size_t min_slot = 0;
+  for (size_t slot = 0; slot < hot_tuple_count_; slot++) {
+    auto &hot_tuple = hot_tuples_[slot];
+    if (hot_tuple.location_.block == location.block &&
+        hot_tuple.location_.offset == location.offset) {
+      hot_tuple.count_ += count;
+      hot_tuple.error_ += error;
+      return;
+    }
+    if (hot_tuple.count_ < hot_tuples_[min_slot].count_) {
+      min_slot = slot;
+    }
+  }
+
+  if (hot_tuple_count_ < HOT_TUPLE_COUNT) {
+    hot_tuples_[hot_tuple_count_++] = {table_id, location, count, error};
+    return;
+  }
+
+  // the new tuple may have had as many aborts as the evicted one
+  auto &hot_tuple = hot_tuples_[min_slot];
+  auto evicted_count = hot_tuple.count_;
+  hot_tuple = {table_id, location, evicted_count + count,
+               evicted_count + error};
+}
+
+std::vector<HotTuple> AbortMetric::GetHotTuples() const {
+  hot_tuple_lock_.Lock();
+  std::vector<HotTuple> hot_tuples(hot_tuples_, hot_tuples_ + hot_tuple_count_);
+  hot_tuple_lock_.Unlock();
+
+  std::sort(hot_tuples.begin(), hot_tuples.end(),
+            [](const HotTuple &lhs, const HotTuple &rhs) {
+              return lhs.count_ > rhs.count_;
+            });
+  return hot_tuples;
+}
+
+void AbortMetric::Reset() {
+  for (auto &abort_count : abort_counts_) {
+    abort_count.Reset();
+  }
+  hot_tuple_lock_.Lock();
+  hot_tuple_count_ = 0;
+  hot_tuple_lock_.Unlock();
+}
+
+void AbortMetric::Aggregate(AbstractMetric &source) {
+  PL_ASSERT(source.GetType() == ABORT_METRIC);
+
+  AbortMetric &abort_metric = static_cast<AbortMetric &>(source);
+  for (size_t cause = 0; cause < CAUSE_COUNT; cause++) {
+    abort_counts_[cause].Aggregate(abort_metric.abort_counts_[cause]);
+  }
+
+  // take the tuples out of the source, so that its next aborts start a new
+  // interval.
+  HotTuple hot_tuples[HOT_TUPLE_COUNT];
+  abort_metric.hot_tuple_lock_.Lock();
+  size_t hot_tuple_count = abort_metric.hot_tuple_count_;
+  std::copy(abort_metric.hot_tuples_,
+            abort_metric.hot_tuples_ + hot_tuple_count, hot_tuples);
+  abort_metric.hot_tuple_count_ = 0;
+  abort_metric.hot_tuple_lock_.Unlock();
+
+  hot_tuple_lock_.Lock();
+  for (size_t slot = 0; slot < hot_tuple_count; slot++) {
+    auto &hot_tuple = hot_tuples[slot];
+    CountHotTuple(hot_tuple.table_id_, hot_tuple.location_, hot_tuple.count_,
+                  hot_tuple.error_);
+  }
+  hot_tuple_lock_.Unlock();
+}
+
+const std::string AbortMetric::GetInfo() const {
+  std::stringstream ss;
+  ss << "# transactions aborted by cause:";
+  for (size_t cause = 0; cause < CAUSE_COUNT; cause++) {
+    ss << " " << AbortCauseTypeToString(static_cast<AbortCauseType>(cause))
+       << "=" << abort_counts_[cause].GetInfo();
+  }
+  ss << std::endl;
+
+  auto hot_tuples = GetHotTuples();
+  if (hot_tuples.empty() == false) {
+    ss << "# hottest tuples (table, tile group, offset: aborts):" << std::endl;
+    for (auto &hot_tuple : hot_tuples) {
+      ss << "  (" << hot_tuple.table_id_ << ", " << hot_tuple.location_.block
+         << ", " << hot_tuple.location_.offset << "): " << hot_tuple.count_;
+      if (hot_tuple.error_ != 0) {
+        ss << " (over by at most " << hot_tuple.error_ << ")";
+      }
+      ss << std::endl;
+    }
+  }
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace peloton
@@ -39,15 +39,20 @@ BackendStatsContext* BackendStatsContext::GetInstance() {
   std::shared_ptr<BackendStatsContext> result(nullptr);
   auto &stats_context_map = GetBackendContextMap();
   if (stats_context_map.Find(this_id, result) == false) {
-    result.reset(new BackendStatsContext(LATENCY_MAX_HISTORY_THREAD, true));
+    result.reset(new BackendStatsContext(true));
     stats_context_map.Insert(this_id, result);
   }
   return result.get();
 }
 
-BackendStatsContext::BackendStatsContext(size_t max_latency_history,
-                                         bool regiser_to_aggregator)
-    : txn_latencies_(LATENCY_METRIC, max_latency_history) {
+BackendStatsContext::BackendStatsContext(bool regiser_to_aggregator)
+    : txn_latencies_(LATENCY_METRIC),
+      query_latencies_(LATENCY_METRIC),
+      aborts_(ABORT_METRIC) {
+  for (auto& phase_metric : phase_metrics_) {
+    phase_metric.store(nullptr);
+  }
+
   std::thread::id this_id = std::this_thread::get_id();
   thread_id_ = this_id;
 
@@ -58,7 +63,11 @@ BackendStatsContext::BackendStatsContext(size_t max_latency_history,
     StatsAggregator::GetInstance().RegisterContext(thread_id_, this);
 }
 
-BackendStatsContext::~BackendStatsContext() {}
+BackendStatsContext::~BackendStatsContext() {
+  for (auto& phase_metric : phase_metrics_) {
+    delete phase_metric.load();
+  }
+}
 
 //===--------------------------------------------------------------------===//
 // ACCESSORS
@@ -107,6 +116,28 @@ LatencyMetric& BackendStatsContext::GetTxnLatencyMetric() {
   return txn_latencies_;
 }
 
+LatencyMetric& BackendStatsContext::GetQueryLatencyMetric() {
+  return query_latencies_;
+}
+
+AbortMetric& BackendStatsContext::GetAbortMetric() { return aborts_; }
+
+PhaseMetric* BackendStatsContext::GetPhaseMetric(StatementType type) {
+  return phase_metrics_[static_cast<size_t>(type)].load(
+      std::memory_order_acquire);
+}
+
+PhaseMetric* BackendStatsContext::GetOrCreatePhaseMetric(StatementType type) {
+  auto phase_metric = GetPhaseMetric(type);
+  if (phase_metric == nullptr) {
+    // only the owner of the context creates its metrics
+    phase_metric = new PhaseMetric(PHASE_METRIC, type);
+    phase_metrics_[static_cast<size_t>(type)].store(phase_metric,
+                                                    std::memory_order_release);
+  }
+  return phase_metric;
+}
+
 void BackendStatsContext::IncrementTableReads(oid_t tile_group_id) {
   oid_t table_id =
       catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
@@ -217,6 +248,30 @@ void BackendStatsContext::IncrementTxnAborted(oid_t database_id) {
   CompleteQueryMetric();
 }
 
+void BackendStatsContext::RecordAbortCause(AbortCauseType cause,
+                                           oid_t table_id,
+                                           const ItemPointer& location) {
+  aborts_.RecordAbort(cause, table_id, location);
+}
+
+void BackendStatsContext::CompleteStatementPhases() {
+  // a statement that failed before it was parsed has no type
+  PhaseMetric* phase_metric = nullptr;
+  if (statement_type_ != StatementType::INVALID) {
+    phase_metric = GetOrCreatePhaseMetric(statement_type_);
+  }
+
+  for (size_t phase = 0; phase < PhaseMetric::PHASE_COUNT; phase++) {
+    auto& phase_timer = phase_timers_[phase];
+    if (phase_metric != nullptr && phase_timer.GetDuration() > 0) {
+      phase_metric->RecordLatency(static_cast<QueryPhaseType>(phase + 1),
+                                  phase_timer.GetDuration());
+    }
+    phase_timer.Reset();
+  }
+  statement_type_ = StatementType::INVALID;
+}
+
 void BackendStatsContext::InitQueryMetric(
     const std::shared_ptr<Statement> statement,
     const std::shared_ptr<QueryMetric::QueryParams> params) {
@@ -232,7 +287,16 @@ void BackendStatsContext::InitQueryMetric(
 void BackendStatsContext::Aggregate(BackendStatsContext& source) {
   // Aggregate all global metrics
   txn_latencies_.Aggregate(source.txn_latencies_);
-  txn_latencies_.ComputeLatencies();
+  query_latencies_.Aggregate(source.query_latencies_);
+  aborts_.Aggregate(source.aborts_);
+  for (size_t type = 0; type < STATEMENT_TYPE_COUNT; type++) {
+    auto phase_metric =
+        source.GetPhaseMetric(static_cast<StatementType>(type));
+    if (phase_metric != nullptr) {
+      GetOrCreatePhaseMetric(static_cast<StatementType>(type))
+          ->Aggregate(*phase_metric);
+    }
+  }
 
   // Aggregate all per-database metrics
   for (auto& database_item : source.database_metrics_) {
@@ -267,6 +331,13 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
 
 void BackendStatsContext::Reset() {
   txn_latencies_.Reset();
+  query_latencies_.Reset();
+  aborts_.Reset();
+  for (auto& phase_metric : phase_metrics_) {
+    if (phase_metric.load() != nullptr) {
+      phase_metric.load()->Reset();
+    }
+  }
 
   for (auto& database_item : database_metrics_) {
     database_item.second->Reset();
@@ -321,7 +392,14 @@ void BackendStatsContext::Reset() {
 std::string BackendStatsContext::ToString() const {
   std::stringstream ss;
 
-  ss << txn_latencies_.GetInfo() << std::endl;
+  ss << "TXN " << txn_latencies_.GetInfo() << std::endl;
+  ss << "QUERY " << query_latencies_.GetInfo() << std::endl;
+  ss << aborts_.GetInfo();
+  for (auto& phase_metric : phase_metrics_) {
+    if (phase_metric.load() != nullptr) {
+      ss << phase_metric.load()->GetInfo();
+    }
+  }
 
   for (auto& database_item : database_metrics_) {
     oid_t database_id = database_item.second->GetDatabaseId();
@@ -359,7 +437,8 @@ std::string BackendStatsContext::ToString() const {
 void BackendStatsContext::CompleteQueryMetric() {
   if (ongoing_query_metric_ != nullptr) {
     ongoing_query_metric_->GetProcessorMetric().RecordTime();
-    ongoing_query_metric_->GetQueryLatency().RecordLatency();
+    ongoing_query_metric_->RecordLatency();
+    query_latencies_.RecordLatency(ongoing_query_metric_->GetQueryLatency());
     completed_query_metrics_.Enqueue(ongoing_query_metric_);
     ongoing_query_metric_.reset();
     LOG_TRACE("Ongoing query completed");
@@ -10,103 +10,153 @@
 //
 //===----------------------------------------------------------------------===//
 
-#include <algorithm>
-
 #include "statistics/latency_metric.h"
 #include "common/macros.h"
 
 namespace peloton {
 namespace stats {
 
-LatencyMetric::LatencyMetric(MetricType type, size_t max_history)
-    : AbstractMetric(type) {
-  max_history_ = max_history;
-  latencies_.SetCapaciry(max_history_);
+LatencyMetric::LatencyMetric(MetricType type) : AbstractMetric(type) {
+  Reset();
 }
 
-void LatencyMetric::Aggregate(AbstractMetric& source) {
-  PL_ASSERT(source.GetType() == LATENCY_METRIC);
-
-  LatencyMetric& latency_metric = static_cast<LatencyMetric&>(source);
-  CircularBuffer<double> source_latencies = latency_metric.Copy();
-  {
-    // This method should only ever be called by the aggregator which
-    // is the only thread to access its own latencies_, but we lock
-    // here just to be safe. Either way the aggregator should never
-    // have to block here.
-    std::lock_guard<std::mutex> lock(latency_mutex_);
-    for (double latency_value : source_latencies) {
-      latencies_.PushBack(latency_value);
-    }
+void LatencyMetric::Reset() {
+  for (auto &count : counts_) {
+    count.store(0, std::memory_order_relaxed);
   }
+  sum_us_.store(0, std::memory_order_relaxed);
+  timer_ms_.Reset();
 }
 
-CircularBuffer<double> LatencyMetric::Copy() {
-  CircularBuffer<double> new_buffer;
-  {
-    // This method is only called by the aggregator to make
-    // a copy of a worker thread's latencies_.
-    std::lock_guard<std::mutex> lock(latency_mutex_);
-    new_buffer = latencies_;
+void LatencyMetric::Aggregate(AbstractMetric &source) {
+  PL_ASSERT(source.GetType() == LATENCY_METRIC);
+
+  // This method is only called by the aggregator, which is the only thread
+  // that records into its own metric. The source may be recording meanwhile,
+  // and its latencies that come in now are picked up in the next interval.
+  LatencyMetric &latency_metric = static_cast<LatencyMetric &>(source);
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    auto count = latency_metric.counts_[bucket].load(std::memory_order_relaxed);
+    if (count != 0) {
+      counts_[bucket].store(
+          counts_[bucket].load(std::memory_order_relaxed) + count,
+          std::memory_order_relaxed);
+    }
   }
-  return new_buffer;
+  sum_us_.store(sum_us_.load(std::memory_order_relaxed) +
+                    latency_metric.sum_us_.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
 }
 
 const std::string LatencyMetric::GetInfo() const {
   std::stringstream ss;
-  ss << "TXN LATENCY (ms): [ ";
+  ss << "LATENCY (ms): [ ";
   ss << "average=" << latency_measurements_.average_;
   ss << ", min=" << latency_measurements_.min_;
   ss << ", 25th-%-tile=" << latency_measurements_.perc_25th_;
   ss << ", median=" << latency_measurements_.median_;
   ss << ", 75th-%-tile=" << latency_measurements_.perc_75th_;
+  ss << ", 95th-%-tile=" << latency_measurements_.perc_95th_;
   ss << ", 99th-%-tile=" << latency_measurements_.perc_99th_;
+  ss << ", 99.9th-%-tile=" << latency_measurements_.perc_999th_;
   ss << ", max=" << latency_measurements_.max_;
   ss << " ]" << std::endl;
   return ss.str();
 }
 
+uint64_t LatencyMetric::GetCumulativeCounts(
+    const std::vector<double> &bounds_ms, std::vector<uint64_t> &bound_counts,
+    double &sum_ms) const {
+  bound_counts.assign(bounds_ms.size(), 0);
+
+  // A latency is counted as the smallest latency of its bucket, as in the
+  // latency measurements
+  uint64_t latency_count = 0;
+  size_t next_bound = 0;
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    auto count = counts_[bucket].load(std::memory_order_relaxed);
+    if (count == 0) {
+      continue;
+    }
+    double latency = static_cast<double>(GetBucketLatency(bucket)) / 1000;
+    while (next_bound < bounds_ms.size() && bounds_ms[next_bound] < latency) {
+      bound_counts[next_bound++] = latency_count;
+    }
+    latency_count += count;
+  }
+  while (next_bound < bounds_ms.size()) {
+    bound_counts[next_bound++] = latency_count;
+  }
+
+  sum_ms =
+      static_cast<double>(sum_us_.load(std::memory_order_relaxed)) / 1000;
+  return latency_count;
+}
+
 void LatencyMetric::ComputeLatencies() {
-  // LatencyMeasurements measurements;
-  if (latencies_.IsEmpty()) {
-    return;
+  if (last_counts_.empty()) {
+    last_counts_.assign(BUCKET_COUNT, 0);
   }
-  std::vector<double> sorted_latencies;
-  double latency_sum = 0.0;
-  {
-    // This method is called only by the aggregator when
-    // after it's aggregated all worker threads latencies
-    // into its own latencies_ buffer. Still we lock here
-    // just in case.
-    std::lock_guard<std::mutex> lock(latency_mutex_);
-    for (double latency : latencies_) {
-      sorted_latencies.push_back(latency);
-      latency_sum += latency;
-    }
+
+  // Take the latencies recorded in this interval. The counters only shrink
+  // if a context went away without being folded into the history.
+  std::vector<uint64_t> interval_counts(BUCKET_COUNT);
+  uint64_t latency_count = 0;
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    auto count = counts_[bucket].load(std::memory_order_relaxed);
+    interval_counts[bucket] =
+        count >= last_counts_[bucket] ? count - last_counts_[bucket] : count;
+    last_counts_[bucket] = count;
+    latency_count += interval_counts[bucket];
+  }
+  auto sum_us = sum_us_.load(std::memory_order_relaxed);
+  auto interval_sum_us =
+      sum_us >= last_sum_us_ ? sum_us - last_sum_us_ : sum_us;
+  last_sum_us_ = sum_us;
+
+  latency_measurements_ = LatencyMeasurements();
+  if (latency_count == 0) {
+    return;
   }
+  latency_measurements_.count_ = latency_count;
+  latency_measurements_.average_ =
+      static_cast<double>(interval_sum_us) / latency_count / 1000;
+
+  // Walk up the buckets once, filling in the percentiles in order
+  struct Percentile {
+    double fraction;
+    double *value;
+  };
+  Percentile percentiles[] = {
+      {0.25, &latency_measurements_.perc_25th_},
+      {0.5, &latency_measurements_.median_},
+      {0.75, &latency_measurements_.perc_75th_},
+      {0.95, &latency_measurements_.perc_95th_},
+      {0.99, &latency_measurements_.perc_99th_},
+      {0.999, &latency_measurements_.perc_999th_},
+      {1.0, &latency_measurements_.max_}};
+  size_t next_percentile = 0;
+  size_t percentile_count = sizeof(percentiles) / sizeof(percentiles[0]);
+  bool found_min = false;
 
-  std::sort(sorted_latencies.begin(), sorted_latencies.end());
-  size_t latencies_size = sorted_latencies.size();
-
-  // Calculate average
-  latency_measurements_.average_ = latency_sum / latencies_size;
-
-  // Min, max, median, and percentiles are values at indexes
-  latency_measurements_.min_ = sorted_latencies[0];
-  latency_measurements_.max_ = sorted_latencies[latencies_size - 1];
-  size_t mid = latencies_size / 2;
-  if (latencies_size % 2 == 0 || latencies_size == 1) {
-    latency_measurements_.median_ = sorted_latencies[mid];
-  } else {
-    latency_measurements_.median_ =
-        (sorted_latencies[mid - 1] + sorted_latencies[mid]) / 2;
+  uint64_t seen_count = 0;
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    if (interval_counts[bucket] == 0) {
+      continue;
+    }
+    double latency = static_cast<double>(GetBucketLatency(bucket)) / 1000;
+    if (found_min == false) {
+      latency_measurements_.min_ = latency;
+      found_min = true;
+    }
+    seen_count += interval_counts[bucket];
+    while (next_percentile < percentile_count &&
+           seen_count >=
+               percentiles[next_percentile].fraction * latency_count) {
+      *percentiles[next_percentile].value = latency;
+      next_percentile++;
+    }
   }
-  size_t index_25th = (size_t)(0.25 * latencies_size);
-  size_t index_75th = (size_t)(0.75 * latencies_size);
-  size_t index_99th = (size_t)(0.99 * latencies_size);
-  latency_measurements_.perc_25th_ = sorted_latencies[index_25th];
-  latency_measurements_.perc_75th_ = sorted_latencies[index_75th];
-  latency_measurements_.perc_99th_ = sorted_latencies[index_99th];
 }
 
 }  // namespace stats
@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// phase_metric.cpp
+//
+// Identification: src/statistics/phase_metric.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "statistics/phase_metric.h"
+
+namespace peloton {
+namespace stats {
+
+PhaseMetric::PhaseMetric(MetricType type, StatementType statement_type)
+    : AbstractMetric(type), statement_type_(statement_type) {
+  for (size_t phase = 0; phase < PHASE_COUNT; phase++) {
+    phase_latencies_.emplace_back(new LatencyMetric(LATENCY_METRIC));
+  }
+}
+
+void PhaseMetric::ComputeLatencies() {
+  for (auto &phase_latency : phase_latencies_) {
+    phase_latency->ComputeLatencies();
+  }
+}
+
+void PhaseMetric::Reset() {
+  for (auto &phase_latency : phase_latencies_) {
+    phase_latency->Reset();
+  }
+}
+
+void PhaseMetric::Aggregate(AbstractMetric &source) {
+  PL_ASSERT(source.GetType() == PHASE_METRIC);
+
+  PhaseMetric &phase_metric = static_cast<PhaseMetric &>(source);
+  PL_ASSERT(phase_metric.statement_type_ == statement_type_);
+  for (size_t phase = 0; phase < PHASE_COUNT; phase++) {
+    phase_latencies_[phase]->Aggregate(*phase_metric.phase_latencies_[phase]);
+  }
+}
+
+const std::string PhaseMetric::GetInfo() const {
+  std::stringstream ss;
+  for (size_t phase = 0; phase < PHASE_COUNT; phase++) {
+    auto &measurements = phase_latencies_[phase]->GetLatencyMeasurements();
+    if (measurements.count_ == 0) {
+      continue;
+    }
+    ss << StatementTypeToString(statement_type_) << " "
+       << QueryPhaseTypeToString(static_cast<QueryPhaseType>(phase + 1))
+       << " (" << measurements.count_ << ") "
+       << phase_latencies_[phase]->GetInfo() << std::endl;
+  }
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace peloton
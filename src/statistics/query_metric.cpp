@@ -26,7 +26,7 @@ QueryMetric::QueryMetric(MetricType type, const std::string& query_name,
       database_id_(database_id),
       query_name_(query_name),
       query_params_(query_params) {
-  latency_metric_.StartTimer();
+  latency_timer_.Start();
   processor_metric_.StartTimer();
   LOG_TRACE("Query metric initialized");
 }
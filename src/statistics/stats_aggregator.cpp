@@ -14,18 +14,49 @@
 #include <condition_variable>
 #include <fstream>
 #include <memory>
+#include <sstream>
 
 #include "catalog/catalog.h"
 #include "catalog/catalog_util.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "optimizer/stats_collector.h"
 #include "statistics/backend_stats_context.h"
 #include "statistics/stats_aggregator.h"
 
 namespace peloton {
 namespace stats {
 
+// Writes a latency metric as a Prometheus histogram in seconds. The labels
+// are given as name="value" pairs separated by commas, or empty.
+static void ExportLatencyHistogram(std::stringstream &ss,
+                                   const std::string &name,
+                                   const std::string &labels,
+                                   const LatencyMetric &latencies) {
+  // Bucket bounds from 100 us to 10 s
+  static const std::vector<double> bounds_ms = {
+      0.1, 0.25, 0.5, 1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000, 2500,
+      5000, 10000};
+  std::vector<uint64_t> bound_counts;
+  double sum_ms;
+  auto latency_count =
+      latencies.GetCumulativeCounts(bounds_ms, bound_counts, sum_ms);
+
+  auto le_prefix = labels.empty() ? "{le=\"" : "{" + labels + ",le=\"";
+  for (size_t bound = 0; bound < bounds_ms.size(); bound++) {
+    ss << name << "_bucket" << le_prefix << bounds_ms[bound] / 1000 << "\"} "
+       << bound_counts[bound] << "\n";
+  }
+  ss << name << "_bucket" << le_prefix << "+Inf\"} " << latency_count << "\n";
+
+  auto label_set = labels.empty() ? "" : "{" + labels + "}";
+  ss << name << "_sum" << label_set << " " << std::to_string(sum_ms / 1000)
+     << "\n";
+  ss << name << "_count" << label_set << " " << latency_count << "\n";
+}
+
 StatsAggregator::StatsAggregator(int64_t aggregation_interval_ms)
-    : stats_history_(0, false),
-      aggregated_stats_(LATENCY_MAX_HISTORY_AGGREGATOR, false),
+    : stats_history_(false),
+      aggregated_stats_(false),
       aggregation_interval_ms_(aggregation_interval_ms),
       thread_number_(0),
       total_prev_txn_committed_(0) {
@@ -83,6 +114,16 @@ void StatsAggregator::Aggregate(int64_t &interval_cnt, double &alpha,
     }
   }
   aggregated_stats_.Aggregate(stats_history_);
+  aggregated_stats_.GetTxnLatencyMetric().ComputeLatencies();
+  aggregated_stats_.GetQueryLatencyMetric().ComputeLatencies();
+  for (size_t type = 0; type < BackendStatsContext::STATEMENT_TYPE_COUNT;
+       type++) {
+    auto phase_metric =
+        aggregated_stats_.GetPhaseMetric(static_cast<StatementType>(type));
+    if (phase_metric != nullptr) {
+      phase_metric->ComputeLatencies();
+    }
+  }
   LOG_TRACE("%s\n", aggregated_stats_.ToString().c_str());
 
   int64_t current_txns_committed = 0;
@@ -106,9 +147,15 @@ void StatsAggregator::Aggregate(int64_t &interval_cnt, double &alpha,
   LOG_TRACE("Moving avg. throughput: %lf txn/s", weighted_avg_throughput);
   LOG_TRACE("Current throughput:     %lf txn/s", throughput_);
 
+  // Render the stats for the metrics endpoint before the catalog writes
+  ExportMetrics();
+
   // Write the stats to metric tables
   UpdateMetrics();
 
+  // Keep the optimizer's column stats up to date with the modifications
+  UpdateTableStats();
+
   if (interval_cnt % STATS_LOG_INTERVALS == 0) {
     try {
       ofs_ << "At interval: " << interval_cnt << std::endl;
@@ -136,7 +183,7 @@ void StatsAggregator::UpdateQueryMetrics(int64_t time_stamp, concurrency::Transa
     auto updates = table_access.GetUpdates();
     auto deletes = table_access.GetDeletes();
     auto inserts = table_access.GetInserts();
-    auto latency = query_metric->GetQueryLatency().GetFirstLatencyValue();
+    auto latency = query_metric->GetQueryLatency();
     auto cpu_system = query_metric->GetProcessorMetric().GetSystemDuration();
     auto cpu_user = query_metric->GetProcessorMetric().GetUserDuration();
 
@@ -165,6 +212,128 @@ void StatsAggregator::UpdateQueryMetrics(int64_t time_stamp, concurrency::Transa
   }
 }
 
+void StatsAggregator::UpdatePhaseMetrics(int64_t time_stamp,
+                                         concurrency::Transaction *txn) {
+  // Get the target phase metrics table
+  LOG_TRACE("Inserting Phase Metric Tuples");
+  auto phase_metrics_table = GetMetricTable(PHASE_METRIC_NAME);
+
+  for (size_t type = 0; type < BackendStatsContext::STATEMENT_TYPE_COUNT;
+       type++) {
+    auto statement_type = static_cast<StatementType>(type);
+    auto phase_metric = aggregated_stats_.GetPhaseMetric(statement_type);
+    if (phase_metric == nullptr) {
+      continue;
+    }
+
+    // One tuple per phase that statements of this type went through
+    for (size_t phase = 1; phase <= PhaseMetric::PHASE_COUNT; phase++) {
+      auto query_phase = static_cast<QueryPhaseType>(phase);
+      auto &measurements =
+          phase_metric->GetPhaseLatency(query_phase).GetLatencyMeasurements();
+      if (measurements.count_ == 0) {
+        continue;
+      }
+
+      auto phase_tuple = catalog::GetPhaseMetricsCatalogTuple(
+          phase_metrics_table->GetSchema(), statement_type, query_phase,
+          measurements, time_stamp, pool_.get());
+      catalog::InsertTuple(phase_metrics_table, std::move(phase_tuple), txn);
+      LOG_TRACE("Phase Metric Tuple inserted");
+    }
+  }
+}
+
+std::string StatsAggregator::GetExportedMetrics() {
+  std::lock_guard<std::mutex> lock(exported_metrics_mutex_);
+  return exported_metrics_;
+}
+
+void StatsAggregator::ExportMetrics() {
+  std::stringstream ss;
+
+  // Counters are totals since startup, as Prometheus expects
+  ss << "# HELP peloton_txn_committed_total Transactions committed.\n"
+     << "# TYPE peloton_txn_committed_total counter\n";
+  for (auto &database_item : aggregated_stats_.database_metrics_) {
+    ss << "peloton_txn_committed_total{database_oid=\"" << database_item.first
+       << "\"} " << database_item.second->GetTxnCommitted().GetCounter()
+       << "\n";
+  }
+  ss << "# HELP peloton_txn_aborted_total Transactions aborted.\n"
+     << "# TYPE peloton_txn_aborted_total counter\n";
+  for (auto &database_item : aggregated_stats_.database_metrics_) {
+    ss << "peloton_txn_aborted_total{database_oid=\"" << database_item.first
+       << "\"} " << database_item.second->GetTxnAborted().GetCounter()
+       << "\n";
+  }
+
+  ss << "# HELP peloton_txn_abort_causes_total Transactions aborted, by "
+        "cause.\n"
+     << "# TYPE peloton_txn_abort_causes_total counter\n";
+  auto &aborts = aggregated_stats_.GetAbortMetric();
+  for (size_t cause = 0;
+       cause <= static_cast<size_t>(AbortCauseType::VALIDATION); cause++) {
+    auto abort_cause = static_cast<AbortCauseType>(cause);
+    ss << "peloton_txn_abort_causes_total{cause=\""
+       << AbortCauseTypeToString(abort_cause) << "\"} "
+       << aborts.GetAbortCount(abort_cause).GetCounter() << "\n";
+  }
+
+  ss << "# HELP peloton_table_tuples_total Tuples accessed, by table and "
+        "operation.\n"
+     << "# TYPE peloton_table_tuples_total counter\n";
+  for (auto &table_item : aggregated_stats_.table_metrics_) {
+    auto &table_metric = table_item.second;
+    auto &table_access = table_metric->GetTableAccess();
+    std::string labels = "{database_oid=\"" +
+                         std::to_string(table_metric->GetDatabaseId()) +
+                         "\",table_oid=\"" +
+                         std::to_string(table_metric->GetTableId()) +
+                         "\",operation=\"";
+    ss << "peloton_table_tuples_total" << labels << "read\"} "
+       << table_access.GetReads() << "\n";
+    ss << "peloton_table_tuples_total" << labels << "update\"} "
+       << table_access.GetUpdates() << "\n";
+    ss << "peloton_table_tuples_total" << labels << "insert\"} "
+       << table_access.GetInserts() << "\n";
+    ss << "peloton_table_tuples_total" << labels << "delete\"} "
+       << table_access.GetDeletes() << "\n";
+  }
+
+  ss << "# HELP peloton_txn_latency_seconds Transaction latency.\n"
+     << "# TYPE peloton_txn_latency_seconds histogram\n";
+  ExportLatencyHistogram(ss, "peloton_txn_latency_seconds", "",
+                         aggregated_stats_.GetTxnLatencyMetric());
+  ss << "# HELP peloton_query_latency_seconds Query latency.\n"
+     << "# TYPE peloton_query_latency_seconds histogram\n";
+  ExportLatencyHistogram(ss, "peloton_query_latency_seconds", "",
+                         aggregated_stats_.GetQueryLatencyMetric());
+
+  ss << "# HELP peloton_statement_phase_latency_seconds Time statements spent "
+        "in each phase, by statement type.\n"
+     << "# TYPE peloton_statement_phase_latency_seconds histogram\n";
+  for (size_t type = 0; type < BackendStatsContext::STATEMENT_TYPE_COUNT;
+       type++) {
+    auto statement_type = static_cast<StatementType>(type);
+    auto phase_metric = aggregated_stats_.GetPhaseMetric(statement_type);
+    if (phase_metric == nullptr) {
+      continue;
+    }
+    for (size_t phase = 1; phase <= PhaseMetric::PHASE_COUNT; phase++) {
+      auto query_phase = static_cast<QueryPhaseType>(phase);
+      ExportLatencyHistogram(
+          ss, "peloton_statement_phase_latency_seconds",
+          "statement_type=\"" + StatementTypeToString(statement_type) +
+              "\",phase=\"" + QueryPhaseTypeToString(query_phase) + "\"",
+          phase_metric->GetPhaseLatency(query_phase));
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(exported_metrics_mutex_);
+  exported_metrics_ = ss.str();
+}
+
 void StatsAggregator::UpdateMetrics() {
   // All tuples are inserted in a single txn
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
@@ -201,9 +370,60 @@ void StatsAggregator::UpdateMetrics() {
   // Update all query metrics
   UpdateQueryMetrics(time_stamp, txn);
 
+  // Update the phase latencies of each statement type
+  UpdatePhaseMetrics(time_stamp, txn);
+
   txn_manager.CommitTransaction(txn);
 }
 
+void StatsAggregator::UpdateTableStats() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto catalog = catalog::Catalog::GetInstance();
+  optimizer::StatsCollector stats_collector;
+
+  auto database_count = catalog->GetDatabaseCount();
+  for (oid_t database_offset = 0; database_offset < database_count;
+       database_offset++) {
+    auto database = catalog->GetDatabaseWithOffset(database_offset);
+    auto database_oid = database->GetOid();
+    if (database->GetDBName() == CATALOG_DATABASE_NAME) {
+      continue;
+    }
+
+    auto table_count = database->GetTableCount();
+    for (oid_t table_offset = 0; table_offset < table_count; table_offset++) {
+      auto table = database->GetTable(table_offset);
+      auto table_oid = table->GetOid();
+      auto table_access =
+          aggregated_stats_.GetTableMetric(database_oid, table_oid)
+              ->GetTableAccess();
+      auto modification_count = table_access.GetInserts() +
+                                table_access.GetUpdates() +
+                                table_access.GetDeletes();
+
+      double analyzed_row_count = 0;
+      int64_t analyzed_modification_count = 0;
+      auto table_stats = catalog->GetTableStats(database_oid, table_oid);
+      if (table_stats != nullptr) {
+        analyzed_row_count = table_stats->GetRowCount();
+        analyzed_modification_count = table_stats->GetModificationCount();
+      }
+      if (modification_count - analyzed_modification_count <=
+          STATS_AUTO_ANALYZE_BASE_THRESHOLD +
+              STATS_AUTO_ANALYZE_SCALE_FACTOR * analyzed_row_count) {
+        continue;
+      }
+
+      LOG_TRACE("Analyzing table %u", table_oid);
+      auto txn = txn_manager.BeginTransaction();
+      catalog->SetTableStats(
+          database_oid, table_oid,
+          stats_collector.CollectTableStats(table, txn, modification_count));
+      txn_manager.CommitTransaction(txn);
+    }
+  }
+}
+
 void StatsAggregator::UpdateTableMetrics(storage::Database *database, int64_t time_stamp,
                                          concurrency::Transaction *txn) {
   // Get the target table metrics table
@@ -98,9 +98,10 @@ const std::string AbstractTable::GetInfo() const {
   oid_t tuple_count = 0;
   for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
        tile_group_itr++) {
-    if (tile_group_itr > 0) inner << std::endl;
-
     auto tile_group = this->GetTileGroup(tile_group_itr);
+    if (tile_group == nullptr) continue;
+
+    if (tile_group_itr > 0) inner << std::endl;
     auto tile_tuple_count = tile_group->GetNextTupleSlot();
 
     std::string tileData = tile_group->GetInfo();
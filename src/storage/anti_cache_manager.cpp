@@ -0,0 +1,383 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// anti_cache_manager.cpp
+//
+// Identification: src/storage/anti_cache_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/anti_cache_manager.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "catalog/manager.h"
+#include "common/exception.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_factory.h"
+#include "storage/tile_group_header.h"
+#include "type/serializeio.h"
+
+namespace peloton {
+namespace storage {
+
+AntiCacheManager &AntiCacheManager::GetInstance() {
+  static AntiCacheManager anti_cache_manager;
+  return anti_cache_manager;
+}
+
+AntiCacheManager::AntiCacheManager()
+    : evicted_tile_group_count_(0),
+      file_name_("peloton_anti_cache.data"),
+      file_descriptor_(-1),
+      file_end_(0),
+      clock_(0),
+      released_clock_(0),
+      eviction_stop_(true) {}
+
+AntiCacheManager::~AntiCacheManager() {
+  if (file_descriptor_ != -1) {
+    close(file_descriptor_);
+    unlink(file_name_.c_str());
+  }
+}
+
+void AntiCacheManager::Start() {
+  // Set signal
+  eviction_stop_ = false;
+
+  // Launch thread
+  eviction_thread_ = std::thread(&storage::AntiCacheManager::Evict, this);
+
+  LOG_INFO("Started anti-cache");
+}
+
+void AntiCacheManager::Stop() {
+  // Stop evicting
+  eviction_stop_ = true;
+
+  // Stop thread
+  eviction_thread_.join();
+
+  LOG_INFO("Stopped anti-cache");
+}
+
+void AntiCacheManager::AddTable(storage::DataTable *table) {
+  {
+    std::lock_guard<std::mutex> lock(table_mutex_);
+    LOG_TRACE("Anti-cache adding table : %p", table);
+
+    tables_.push_back(table);
+  }
+}
+
+void AntiCacheManager::DropTable(const oid_t &table_oid) {
+  {
+    std::lock_guard<std::mutex> lock(table_mutex_);
+    tables_.erase(std::remove_if(tables_.begin(), tables_.end(),
+                                 [&table_oid](storage::DataTable *table) {
+                                   return table->GetOid() == table_oid;
+                                 }),
+                  tables_.end());
+  }
+}
+
+void AntiCacheManager::ClearTables() {
+  {
+    std::lock_guard<std::mutex> lock(table_mutex_);
+    tables_.clear();
+  }
+}
+
+void AntiCacheManager::SetFile(const std::string &file_name) {
+  std::lock_guard<std::mutex> lock(anti_cache_mutex_);
+  PL_ASSERT(evicted_tile_groups_.empty());
+
+  if (file_descriptor_ != -1) {
+    close(file_descriptor_);
+    unlink(file_name_.c_str());
+    file_descriptor_ = -1;
+    file_end_ = 0;
+  }
+  file_name_ = file_name;
+}
+
+void AntiCacheManager::Tick() {
+  clock_.fetch_add(1, std::memory_order_relaxed);
+
+  // Every transaction that looked up a tile group before the clock moved
+  // began before this one
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  auto tick_cid = txn->GetBeginCommitId();
+  txn_manager.CommitTransaction(txn);
+
+  std::lock_guard<std::mutex> lock(anti_cache_mutex_);
+  tick_cids_.emplace_back(GetClock(), tick_cid);
+}
+
+void AntiCacheManager::Evict() {
+  // Continue till signal is not false
+  while (eviction_stop_ == false) {
+    {
+      std::lock_guard<std::mutex> lock(table_mutex_);
+      for (auto table : tables_) {
+        EvictColdTileGroups(table);
+      }
+    }
+
+    Tick();
+
+    // Sleep a bit
+    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_duration_));
+  }
+}
+
+size_t AntiCacheManager::EvictColdTileGroups(storage::DataTable *table) {
+  size_t evicted_count = 0;
+
+  auto tile_group_count = table->GetTileGroupCount();
+  for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    // Looking the tile group up through the table would count as an access
+    auto tile_group_id = table->GetTileGroupId(tile_group_offset);
+    if (tile_group_id == INVALID_OID) {
+      continue;
+    }
+
+    if (EvictTileGroup(tile_group_id) == true) {
+      evicted_count++;
+    }
+  }
+
+  if (evicted_count > 0) {
+    LOG_TRACE("Evicted %lu tile groups of table %u", evicted_count,
+              table->GetOid());
+  }
+  return evicted_count;
+}
+
+bool AntiCacheManager::IsEvictable(storage::TileGroup *tile_group) {
+  auto tile_group_header = tile_group->GetHeader();
+
+  // Leave the tile groups that are still being filled or drained alone, and
+  // the frozen ones which are already compressed
+  if (tile_group_header->IsCompacting() == true ||
+      tile_group_header->IsFrozen() == true ||
+      tile_group_header->GetCurrentNextTupleSlot() <
+          tile_group->GetAllocatedTupleCount()) {
+    return false;
+  }
+
+  // Transactions keep using the tile group header after they let go of the
+  // tile group, so all of those that looked the tile group up must be gone
+  auto last_access = tile_group->GetLastAccess();
+  if (GetClock() - last_access < cold_passes_ ||
+      last_access >= released_clock_) {
+    return false;
+  }
+
+  // A tuple that is owned by a transaction is about to change, and the undo
+  // records of a tuple must stay reachable from memory
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    if (tuple_txn_id != INITIAL_TXN_ID && tuple_txn_id != INVALID_TXN_ID) {
+      return false;
+    }
+    if (tile_group_header->GetUndoRecord(tuple_id) != nullptr) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool AntiCacheManager::EvictTileGroup(const oid_t &tile_group_id) {
+  std::lock_guard<std::mutex> lock(anti_cache_mutex_);
+  auto &manager = catalog::Manager::GetInstance();
+
+  UpdateReleasedClock();
+
+  auto tile_group = manager.GetResidentTileGroup(tile_group_id);
+  if (tile_group == nullptr || IsEvictable(tile_group.get()) == false) {
+    return false;
+  }
+  auto last_access = tile_group->GetLastAccess();
+
+  // Hide the tile group. From now on lookups end up in FetchTileGroup(),
+  // where they wait for us. Anybody still holding on to it, or who looked it
+  // up since we checked it, may be about to modify it, so back off then.
+  evicted_tile_group_count_++;
+  manager.AddTileGroup(tile_group_id, nullptr);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (tile_group.use_count() > 1 ||
+      tile_group->GetLastAccess() != last_access) {
+    manager.AddTileGroup(tile_group_id, tile_group);
+    evicted_tile_group_count_--;
+    return false;
+  }
+
+  CopySerializeOutput output;
+  tile_group->SerializeTo(output);
+
+  off_t offset;
+  if (WriteImage(output.Data(), output.Size(), offset) == false) {
+    manager.AddTileGroup(tile_group_id, tile_group);
+    evicted_tile_group_count_--;
+    return false;
+  }
+
+  EvictedTileGroup evicted_tile_group;
+  evicted_tile_group.database_id = tile_group->GetDatabaseId();
+  evicted_tile_group.table_id = tile_group->GetTableId();
+  evicted_tile_group.table = tile_group->GetAbstractTable();
+  evicted_tile_group.schemas = tile_group->GetTileSchemas();
+  evicted_tile_group.column_map = tile_group->GetColumnMap();
+  evicted_tile_group.tuple_count = tile_group->GetAllocatedTupleCount();
+  evicted_tile_group.offset = offset;
+  evicted_tile_group.length = output.Size();
+  evicted_tile_groups_.emplace(tile_group_id, std::move(evicted_tile_group));
+
+  LOG_TRACE("Evicted tile group %u (%lu bytes)", tile_group_id,
+            output.Size());
+
+  // Releasing the last reference frees the memory
+  return true;
+}
+
+std::shared_ptr<storage::TileGroup> AntiCacheManager::FetchTileGroup(
+    const oid_t &tile_group_id) {
+  std::lock_guard<std::mutex> lock(anti_cache_mutex_);
+  auto &manager = catalog::Manager::GetInstance();
+
+  // Somebody else may have faulted it in while we were waiting
+  auto tile_group = manager.GetResidentTileGroup(tile_group_id);
+  if (tile_group != nullptr) {
+    return tile_group;
+  }
+
+  auto entry = evicted_tile_groups_.find(tile_group_id);
+  if (entry == evicted_tile_groups_.end()) {
+    return nullptr;
+  }
+  auto &evicted_tile_group = entry->second;
+
+  std::unique_ptr<char[]> image(new char[evicted_tile_group.length]);
+  if (ReadImage(image.get(), evicted_tile_group.length,
+                evicted_tile_group.offset) == false) {
+    throw Exception("Could not read evicted tile group " +
+                    std::to_string(tile_group_id));
+  }
+
+  tile_group.reset(TileGroupFactory::GetTileGroup(
+      evicted_tile_group.database_id, evicted_tile_group.table_id,
+      tile_group_id, evicted_tile_group.table, evicted_tile_group.schemas,
+      evicted_tile_group.column_map, evicted_tile_group.tuple_count));
+
+  ReferenceSerializeInput input(image.get(), evicted_tile_group.length);
+  tile_group->DeserializeFrom(input);
+  tile_group->RecordAccess(GetClock());
+
+  manager.AddTileGroup(tile_group_id, tile_group);
+  evicted_tile_groups_.erase(entry);
+  evicted_tile_group_count_--;
+
+  LOG_TRACE("Fetched tile group %u", tile_group_id);
+
+  // Start over once nothing is left in the file
+  if (evicted_tile_groups_.empty() && file_end_ != 0) {
+    if (ftruncate(file_descriptor_, 0) == 0) {
+      file_end_ = 0;
+    }
+  }
+
+  return tile_group;
+}
+
+void AntiCacheManager::DiscardTileGroup(const oid_t &tile_group_id) {
+  std::lock_guard<std::mutex> lock(anti_cache_mutex_);
+
+  if (evicted_tile_groups_.erase(tile_group_id) > 0) {
+    evicted_tile_group_count_--;
+  }
+}
+
+void AntiCacheManager::UpdateReleasedClock() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto max_committed_cid = txn_manager.GetMaxCommittedCid();
+  if (max_committed_cid == MAX_CID) {
+    return;
+  }
+
+  while (tick_cids_.empty() == false &&
+         tick_cids_.front().second < max_committed_cid) {
+    released_clock_ = tick_cids_.front().first;
+    tick_cids_.pop_front();
+  }
+}
+
+bool AntiCacheManager::OpenFile() {
+  if (file_descriptor_ != -1) {
+    return true;
+  }
+
+  file_descriptor_ =
+      open(file_name_.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (file_descriptor_ == -1) {
+    LOG_ERROR("Could not open anti-cache file %s", file_name_.c_str());
+    return false;
+  }
+
+  file_end_ = 0;
+  return true;
+}
+
+bool AntiCacheManager::WriteImage(const char *data, const size_t &length,
+                                  off_t &offset) {
+  if (OpenFile() == false) {
+    return false;
+  }
+
+  size_t written = 0;
+  while (written < length) {
+    auto result = pwrite(file_descriptor_, data + written, length - written,
+                         file_end_ + written);
+    if (result <= 0) {
+      LOG_ERROR("Could not write to anti-cache file %s", file_name_.c_str());
+      return false;
+    }
+    written += result;
+  }
+
+  offset = file_end_;
+  file_end_ += length;
+  return true;
+}
+
+bool AntiCacheManager::ReadImage(char *data, const size_t &length,
+                                 const off_t &offset) {
+  size_t read_bytes = 0;
+  while (read_bytes < length) {
+    auto result = pread(file_descriptor_, data + read_bytes,
+                        length - read_bytes, offset + read_bytes);
+    if (result <= 0) {
+      LOG_ERROR("Could not read from anti-cache file %s", file_name_.c_str());
+      return false;
+    }
+    read_bytes += result;
+  }
+  return true;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,476 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_column.cpp
+//
+// Identification: src/storage/compressed_column.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/compressed_column.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "common/macros.h"
+#include "storage/tile.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace storage {
+
+// Fields are at most this long to be stored relative to a frame of reference
+static const size_t max_key_field_length = sizeof(int64_t);
+
+// Sign-extends a fixed-length field
+static int64_t ReadField(const char *field_location, const size_t &length) {
+  switch (length) {
+    case 1: {
+      int8_t field;
+      PL_MEMCPY(&field, field_location, sizeof(field));
+      return field;
+    }
+    case 2: {
+      int16_t field;
+      PL_MEMCPY(&field, field_location, sizeof(field));
+      return field;
+    }
+    case 4: {
+      int32_t field;
+      PL_MEMCPY(&field, field_location, sizeof(field));
+      return field;
+    }
+    case 8: {
+      int64_t field;
+      PL_MEMCPY(&field, field_location, sizeof(field));
+      return field;
+    }
+    default: {
+      int64_t field = 0;
+      PL_MEMCPY(&field, field_location, length);
+      return field;
+    }
+  }
+}
+
+static void WriteField(const int64_t &field, char *field_location,
+                       const size_t &length) {
+  switch (length) {
+    case 1: {
+      int8_t narrow_field = static_cast<int8_t>(field);
+      PL_MEMCPY(field_location, &narrow_field, sizeof(narrow_field));
+      break;
+    }
+    case 2: {
+      int16_t narrow_field = static_cast<int16_t>(field);
+      PL_MEMCPY(field_location, &narrow_field, sizeof(narrow_field));
+      break;
+    }
+    case 4: {
+      int32_t narrow_field = static_cast<int32_t>(field);
+      PL_MEMCPY(field_location, &narrow_field, sizeof(narrow_field));
+      break;
+    }
+    default:
+      PL_MEMCPY(field_location, &field, length);
+      break;
+  }
+}
+
+static bool IsIntegerType(const type::Type::TypeId &type_id) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool Compare(const type::Value &value,
+                    const ExpressionType &comparison_type,
+                    const type::Value &constant) {
+  switch (comparison_type) {
+    case ExpressionType::COMPARE_EQUAL:
+      return value.CompareEquals(constant) == type::CMP_TRUE;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      return value.CompareNotEquals(constant) == type::CMP_TRUE;
+    case ExpressionType::COMPARE_LESSTHAN:
+      return value.CompareLessThan(constant) == type::CMP_TRUE;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return value.CompareGreaterThan(constant) == type::CMP_TRUE;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return value.CompareLessThanEquals(constant) == type::CMP_TRUE;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return value.CompareGreaterThanEquals(constant) == type::CMP_TRUE;
+    default:
+      throw Exception("Invalid comparison expression type.");
+  }
+}
+
+CompressedColumn::CompressedColumn(Tile *tile, const oid_t column_id)
+    : column_type_(tile->GetSchema()->GetType(column_id)),
+      field_length_(tile->GetSchema()->GetLength(column_id)),
+      tuple_count_(tile->GetAllocatedTupleCount()),
+      encoding_type_(ColumnEncodingType::PLAIN),
+      dictionary_encoded_(false),
+      base_(0),
+      max_(0),
+      has_null_(false),
+      null_key_(0),
+      bit_width_(0) {
+  if (tile->GetSchema()->IsInlined(column_id) == false) {
+    EncodeVarlen(tile, column_id);
+  } else {
+    EncodeFixedLength(tile, column_id);
+  }
+}
+
+void CompressedColumn::EncodeFixedLength(Tile *tile, const oid_t column_id) {
+  auto column_offset = tile->GetSchema()->GetOffset(column_id);
+
+  if (field_length_ > max_key_field_length) {
+    encoding_type_ = ColumnEncodingType::PLAIN;
+    plain_data_.resize(tuple_count_ * field_length_);
+    for (oid_t tuple_id = 0; tuple_id < tuple_count_; tuple_id++) {
+      PL_MEMCPY(plain_data_.data() + tuple_id * field_length_,
+                tile->GetTupleLocation(tuple_id) + column_offset,
+                field_length_);
+    }
+    return;
+  }
+
+  std::vector<int64_t> fields(tuple_count_);
+  for (oid_t tuple_id = 0; tuple_id < tuple_count_; tuple_id++) {
+    fields[tuple_id] = ReadField(
+        tile->GetTupleLocation(tuple_id) + column_offset, field_length_);
+  }
+
+  base_ = *std::min_element(fields.begin(), fields.end());
+  max_ = *std::max_element(fields.begin(), fields.end());
+
+  std::vector<uint64_t> keys(tuple_count_);
+  for (oid_t tuple_id = 0; tuple_id < tuple_count_; tuple_id++) {
+    keys[tuple_id] = static_cast<uint64_t>(fields[tuple_id]) -
+                     static_cast<uint64_t>(base_);
+  }
+
+  // Nulls are stored as a reserved field
+  char null_field[max_key_field_length];
+  type::ValueFactory::GetNullValueByType(column_type_)
+      .SerializeTo(null_field, true, nullptr);
+  auto null_value = ReadField(null_field, field_length_);
+  if (null_value >= base_ && null_value <= max_) {
+    null_key_ =
+        static_cast<uint64_t>(null_value) - static_cast<uint64_t>(base_);
+    has_null_ = std::find(keys.begin(), keys.end(), null_key_) != keys.end();
+  }
+
+  EncodeKeys(keys);
+}
+
+void CompressedColumn::EncodeVarlen(Tile *tile, const oid_t column_id) {
+  auto column_offset = tile->GetSchema()->GetOffset(column_id);
+  dictionary_encoded_ = true;
+
+  // Collect the distinct values
+  std::vector<const char *> varlen_ptrs(tuple_count_);
+  std::map<std::string, uint64_t> dictionary;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count_; tuple_id++) {
+    auto field_location = tile->GetTupleLocation(tuple_id) + column_offset;
+    const char *varlen_ptr;
+    PL_MEMCPY(&varlen_ptr, field_location, sizeof(varlen_ptr));
+    varlen_ptrs[tuple_id] = varlen_ptr;
+
+    if (varlen_ptr == nullptr) {
+      has_null_ = true;
+      continue;
+    }
+    uint32_t length;
+    PL_MEMCPY(&length, varlen_ptr, sizeof(length));
+    dictionary.emplace(std::string(varlen_ptr + sizeof(length), length), 0);
+  }
+
+  // Lay the entries out in sorted order, after the null entry
+  uint64_t code = (has_null_ == true) ? 1 : 0;
+  size_t dictionary_data_size = 0;
+  for (auto &entry : dictionary) {
+    entry.second = code++;
+    dictionary_data_size += sizeof(uint32_t) + entry.first.size();
+  }
+
+  dictionary_data_.resize(dictionary_data_size);
+  if (has_null_ == true) {
+    dictionary_entries_.push_back(nullptr);
+  }
+  size_t dictionary_offset = 0;
+  for (auto &entry : dictionary) {
+    char *entry_location = dictionary_data_.data() + dictionary_offset;
+    uint32_t length = entry.first.size();
+    PL_MEMCPY(entry_location, &length, sizeof(length));
+    PL_MEMCPY(entry_location + sizeof(length), entry.first.data(), length);
+    dictionary_entries_.push_back(entry_location);
+    dictionary_offset += sizeof(length) + length;
+  }
+
+  std::vector<uint64_t> keys(tuple_count_);
+  for (oid_t tuple_id = 0; tuple_id < tuple_count_; tuple_id++) {
+    auto varlen_ptr = varlen_ptrs[tuple_id];
+    if (varlen_ptr == nullptr) {
+      keys[tuple_id] = 0;
+      continue;
+    }
+    uint32_t length;
+    PL_MEMCPY(&length, varlen_ptr, sizeof(length));
+    keys[tuple_id] =
+        dictionary[std::string(varlen_ptr + sizeof(length), length)];
+  }
+
+  EncodeKeys(keys);
+}
+
+void CompressedColumn::EncodeKeys(const std::vector<uint64_t> &keys) {
+  uint64_t max_key = 0;
+  size_t run_count = 0;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count_; tuple_id++) {
+    max_key = std::max(max_key, keys[tuple_id]);
+    if (tuple_id == 0 || keys[tuple_id] != keys[tuple_id - 1]) {
+      run_count++;
+    }
+  }
+
+  bit_width_ = 0;
+  while (bit_width_ < 64 && (max_key >> bit_width_) != 0) {
+    bit_width_++;
+  }
+
+  size_t word_count = (tuple_count_ * bit_width_ + 63) / 64;
+  size_t bit_packed_size = word_count * sizeof(uint64_t);
+  size_t run_length_size = run_count * (sizeof(uint64_t) + sizeof(oid_t));
+
+  if (run_length_size < bit_packed_size) {
+    encoding_type_ = ColumnEncodingType::RUN_LENGTH;
+    run_keys_.reserve(run_count);
+    run_ends_.reserve(run_count);
+    for (oid_t tuple_id = 0; tuple_id < tuple_count_; tuple_id++) {
+      if (tuple_id == 0 || keys[tuple_id] != keys[tuple_id - 1]) {
+        run_keys_.push_back(keys[tuple_id]);
+        run_ends_.push_back(tuple_id + 1);
+      } else {
+        run_ends_.back() = tuple_id + 1;
+      }
+    }
+    return;
+  }
+
+  encoding_type_ = ColumnEncodingType::BIT_PACKED;
+  packed_keys_.assign(word_count, 0);
+  if (bit_width_ == 0) {
+    return;
+  }
+  for (oid_t tuple_id = 0; tuple_id < tuple_count_; tuple_id++) {
+    size_t bit_offset = tuple_id * bit_width_;
+    size_t word_offset = bit_offset / 64;
+    size_t shift = bit_offset % 64;
+    packed_keys_[word_offset] |= keys[tuple_id] << shift;
+    if (shift + bit_width_ > 64) {
+      packed_keys_[word_offset + 1] |= keys[tuple_id] >> (64 - shift);
+    }
+  }
+}
+
+uint64_t CompressedColumn::GetKey(const oid_t tuple_offset) const {
+  if (encoding_type_ == ColumnEncodingType::RUN_LENGTH) {
+    auto run = std::upper_bound(run_ends_.begin(), run_ends_.end(),
+                                tuple_offset) -
+               run_ends_.begin();
+    return run_keys_[run];
+  }
+
+  if (bit_width_ == 0) {
+    return 0;
+  }
+
+  size_t bit_offset = tuple_offset * bit_width_;
+  size_t word_offset = bit_offset / 64;
+  size_t shift = bit_offset % 64;
+  uint64_t key = packed_keys_[word_offset] >> shift;
+  if (shift + bit_width_ > 64) {
+    key |= packed_keys_[word_offset + 1] << (64 - shift);
+  }
+  if (bit_width_ < 64) {
+    key &= (uint64_t(1) << bit_width_) - 1;
+  }
+  return key;
+}
+
+type::Value CompressedColumn::DecodeKey(const uint64_t &key) const {
+  if (dictionary_encoded_ == true) {
+    const char *varlen_ptr = dictionary_entries_[key];
+    return type::Value::DeserializeFrom(
+        reinterpret_cast<const char *>(&varlen_ptr), column_type_, false);
+  }
+
+  char field[max_key_field_length];
+  auto field_value =
+      static_cast<int64_t>(static_cast<uint64_t>(base_) + key);
+  WriteField(field_value, field, field_length_);
+  return type::Value::DeserializeFrom(field, column_type_, true);
+}
+
+type::Value CompressedColumn::GetValue(const oid_t tuple_offset) const {
+  PL_ASSERT(tuple_offset < tuple_count_);
+
+  if (encoding_type_ == ColumnEncodingType::PLAIN) {
+    return type::Value::DeserializeFrom(
+        plain_data_.data() + tuple_offset * field_length_, column_type_, true);
+  }
+
+  return DecodeKey(GetKey(tuple_offset));
+}
+
+void CompressedColumn::Filter(const ExpressionType &comparison_type,
+                              const type::Value &constant,
+                              std::vector<bool> &selection) const {
+  PL_ASSERT(selection.size() >= tuple_count_);
+
+  switch (encoding_type_) {
+    case ColumnEncodingType::RUN_LENGTH: {
+      // Evaluate once per run
+      oid_t run_begin = 0;
+      for (size_t run = 0; run < run_keys_.size(); run++) {
+        auto run_end = run_ends_[run];
+        if (Compare(DecodeKey(run_keys_[run]), comparison_type, constant) ==
+            false) {
+          std::fill(selection.begin() + run_begin, selection.begin() + run_end,
+                    false);
+        }
+        run_begin = run_end;
+      }
+      return;
+    }
+
+    case ColumnEncodingType::BIT_PACKED: {
+      if (dictionary_encoded_ == true) {
+        // Evaluate once per dictionary entry
+        std::vector<bool> qualifying_keys(dictionary_entries_.size());
+        for (uint64_t key = 0; key < dictionary_entries_.size(); key++) {
+          qualifying_keys[key] =
+              Compare(DecodeKey(key), comparison_type, constant);
+        }
+        for (oid_t tuple_id = 0; tuple_id < tuple_count_; tuple_id++) {
+          if (selection[tuple_id] == true &&
+              qualifying_keys[GetKey(tuple_id)] == false) {
+            selection[tuple_id] = false;
+          }
+        }
+        return;
+      }
+
+      if (IsIntegerType(column_type_) && IsIntegerType(constant.GetTypeId())) {
+        FilterKeys(comparison_type, constant, selection);
+        return;
+      }
+      break;
+    }
+
+    case ColumnEncodingType::PLAIN:
+      break;
+  }
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count_; tuple_id++) {
+    if (selection[tuple_id] == true &&
+        Compare(GetValue(tuple_id), comparison_type, constant) == false) {
+      selection[tuple_id] = false;
+    }
+  }
+}
+
+void CompressedColumn::FilterKeys(const ExpressionType &comparison_type,
+                                  const type::Value &constant,
+                                  std::vector<bool> &selection) const {
+  // Comparisons with null never hold
+  if (constant.IsNull() == true) {
+    std::fill(selection.begin(), selection.begin() + tuple_count_, false);
+    return;
+  }
+
+  // Turn the predicate into a range of fields, which is inverted for !=
+  const int64_t field_min = std::numeric_limits<int64_t>::min();
+  const int64_t field_max = std::numeric_limits<int64_t>::max();
+  int64_t value = type::ValueFactory::CastAsBigInt(constant).GetAs<int64_t>();
+  int64_t low = field_min, high = field_max;
+  bool inverted = false;
+  switch (comparison_type) {
+    case ExpressionType::COMPARE_EQUAL:
+      low = high = value;
+      break;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      low = high = value;
+      inverted = true;
+      break;
+    case ExpressionType::COMPARE_LESSTHAN:
+      if (value == field_min) {
+        std::fill(selection.begin(), selection.begin() + tuple_count_, false);
+        return;
+      }
+      high = value - 1;
+      break;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      high = value;
+      break;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      if (value == field_max) {
+        std::fill(selection.begin(), selection.begin() + tuple_count_, false);
+        return;
+      }
+      low = value + 1;
+      break;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      low = value;
+      break;
+    default:
+      throw Exception("Invalid comparison expression type.");
+  }
+
+  // Clip the range to the frame of reference and translate it into keys
+  low = std::max(low, base_);
+  high = std::min(high, max_);
+  bool empty_range = (low > high);
+  uint64_t low_key = static_cast<uint64_t>(low) - static_cast<uint64_t>(base_);
+  uint64_t high_key =
+      static_cast<uint64_t>(high) - static_cast<uint64_t>(base_);
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count_; tuple_id++) {
+    if (selection[tuple_id] == false) {
+      continue;
+    }
+    auto key = GetKey(tuple_id);
+    bool in_range =
+        (empty_range == false && key >= low_key && key <= high_key);
+    if (in_range == inverted || (has_null_ == true && key == null_key_)) {
+      selection[tuple_id] = false;
+    }
+  }
+}
+
+size_t CompressedColumn::GetSize() const {
+  return sizeof(CompressedColumn) + packed_keys_.size() * sizeof(uint64_t) +
+         run_keys_.size() * sizeof(uint64_t) +
+         run_ends_.size() * sizeof(oid_t) + plain_data_.size() +
+         dictionary_data_.size() +
+         dictionary_entries_.size() * sizeof(const char *);
+}
+
+}  // End storage namespace
+}  // End peloton namespace
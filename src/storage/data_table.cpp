@@ -23,6 +23,7 @@
 #include "common/platform.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
 #include "logging/log_manager.h"
@@ -183,6 +184,10 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   }
   //====================================================
 
+  if (FLAGS_tile_numa_binding == true) {
+    RecordInsertNumaNode();
+  }
+
   size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
   std::shared_ptr<storage::TileGroup> tile_group;
   oid_t tuple_slot = INVALID_OID;
@@ -587,6 +592,45 @@ bool DataTable::IsDirty() const { return dirty_; }
  */
 void DataTable::ResetDirty() { dirty_ = false; }
 
+//===--------------------------------------------------------------------===//
+// NUMA PLACEMENT
+//===--------------------------------------------------------------------===//
+
+// Only one out of this many inserts is sampled
+#define NUMA_SAMPLE_INTERVAL 64
+
+void DataTable::RecordInsertNumaNode() {
+  thread_local size_t insert_counter = 0;
+  if ((insert_counter++ % NUMA_SAMPLE_INTERVAL) != 0) {
+    return;
+  }
+
+  int numa_node = TileGroupAllocator::GetCurrentNumaNode();
+  if (numa_node >= 0 && numa_node < MAX_NUMA_NODES) {
+    numa_insert_counts_[numa_node].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+int DataTable::GetPreferredNumaNode() const {
+  if (FLAGS_tile_numa_binding == false) {
+    return NUMA_NODE_ANY;
+  }
+
+  int preferred_numa_node = NUMA_NODE_ANY;
+  size_t max_insert_count = 0;
+  for (int node_itr = 0; node_itr < MAX_NUMA_NODES; node_itr++) {
+    size_t insert_count =
+        numa_insert_counts_[node_itr].load(std::memory_order_relaxed);
+    if (insert_count > max_insert_count) {
+      max_insert_count = insert_count;
+      preferred_numa_node = node_itr;
+    }
+  }
+
+  // Without any samples, place it next to the current thread
+  return preferred_numa_node;
+}
+
 //===--------------------------------------------------------------------===//
 // TILE GROUP
 //===--------------------------------------------------------------------===//
@@ -718,18 +762,54 @@ std::shared_ptr<storage::TileGroup> DataTable::GetTileGroup(
     const std::size_t &tile_group_offset) const {
   PL_ASSERT(tile_group_offset < GetTileGroupCount());
 
-  auto tile_group_id =
-      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+  // Offsets are stable: a dropped tile group leaves a hole behind, for which
+  // we return nullptr
+  auto tile_group_id = tile_groups_.Find(tile_group_offset);
+  if (tile_group_id == invalid_tile_group_id) {
+    return nullptr;
+  }
 
   return GetTileGroupById(tile_group_id);
 }
 
+oid_t DataTable::GetTileGroupId(const std::size_t &tile_group_offset) const {
+  PL_ASSERT(tile_group_offset < GetTileGroupCount());
+
+  auto tile_group_id = tile_groups_.Find(tile_group_offset);
+  if (tile_group_id == invalid_tile_group_id) {
+    return INVALID_OID;
+  }
+  return tile_group_id;
+}
+
 std::shared_ptr<storage::TileGroup> DataTable::GetTileGroupById(
     const oid_t &tile_group_id) const {
   auto &manager = catalog::Manager::GetInstance();
   return manager.GetTileGroup(tile_group_id);
 }
 
+bool DataTable::DropTileGroup(const oid_t &tile_group_id) {
+  auto tile_groups_size = tile_groups_.GetSize();
+  std::size_t tile_groups_itr;
+
+  for (tile_groups_itr = 0; tile_groups_itr < tile_groups_size;
+       tile_groups_itr++) {
+    if (tile_groups_.Find(tile_groups_itr) == tile_group_id) {
+      // Leave a hole so that the offsets of other tile groups do not change
+      tile_groups_.Erase(tile_groups_itr, invalid_tile_group_id);
+
+      // drop tile group in catalog
+      auto &catalog_manager = catalog::Manager::GetInstance();
+      catalog_manager.DropTileGroup(tile_group_id);
+
+      LOG_TRACE("Dropped tile group : %u ", tile_group_id);
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void DataTable::DropTileGroups() {
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto tile_groups_size = tile_groups_.GetSize();
@@ -971,6 +1051,8 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
   auto header = orig_tile_group->GetHeader();
   auto new_header = new_tile_group->GetHeader();
   *new_header = *header;
+
+  new_tile_group->RebuildZoneMap();
 }
 
 storage::TileGroup *DataTable::TransformTileGroup(
@@ -981,12 +1063,18 @@ storage::TileGroup *DataTable::TransformTileGroup(
     return nullptr;
   }
 
-  auto tile_group_id =
-      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+  auto tile_group_id = tile_groups_.Find(tile_group_offset);
+  if (tile_group_id == invalid_tile_group_id) {
+    LOG_TRACE("Tile group at offset %u was dropped", tile_group_offset);
+    return nullptr;
+  }
 
   // Get orig tile group from catalog
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto tile_group = catalog_manager.GetTileGroup(tile_group_id);
+  if (tile_group == nullptr) {
+    return nullptr;
+  }
   auto diff = tile_group->GetSchemaDifference(default_partition_);
 
   // Check threshold for transformation
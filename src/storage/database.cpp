@@ -16,9 +16,12 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "index/index.h"
+#include "storage/anti_cache_manager.h"
 #include "storage/database.h"
 #include "storage/table_factory.h"
+#include "storage/tile_group_freezer.h"
 #include "gc/gc_manager_factory.h"
+#include "gc/tile_group_compactor.h"
 
 namespace peloton {
 namespace storage {
@@ -28,7 +31,15 @@ Database::Database(const oid_t &database_oid) : database_oid(database_oid) {}
 Database::~Database() {
   // Clean up all the tables
   LOG_TRACE("Deleting tables from database");
-  for (auto table : tables) delete table;
+  auto &tile_group_compactor = gc::TileGroupCompactor::GetInstance();
+  auto &anti_cache_manager = storage::AntiCacheManager::GetInstance();
+  auto &tile_group_freezer = storage::TileGroupFreezer::GetInstance();
+  for (auto table : tables) {
+    tile_group_compactor.DropTable(table->GetOid());
+    anti_cache_manager.DropTable(table->GetOid());
+    tile_group_freezer.DropTable(table->GetOid());
+    delete table;
+  }
 
   LOG_TRACE("Finish deleting tables from database");
 }
@@ -47,6 +58,15 @@ void Database::AddTable(storage::DataTable *table, bool is_catalog) {
       auto *gc_manager = &gc::GCManagerFactory::GetInstance();
       assert(gc_manager != nullptr);
       gc_manager->RegisterTable(table->GetOid());
+
+      // Register table to tile group compactor.
+      gc::TileGroupCompactor::GetInstance().AddTable(table);
+
+      // Register table to anti-cache.
+      storage::AntiCacheManager::GetInstance().AddTable(table);
+
+      // Register table to tile group freezer.
+      storage::TileGroupFreezer::GetInstance().AddTable(table);
     }
   }
 }
@@ -75,6 +95,15 @@ void Database::DropTableWithOid(const oid_t table_oid) {
     assert(gc_manager != nullptr);
     gc_manager->DeregisterTable(table_oid);
 
+    // Deregister table from tile group compactor.
+    gc::TileGroupCompactor::GetInstance().DropTable(table_oid);
+
+    // Deregister table from anti-cache.
+    storage::AntiCacheManager::GetInstance().DropTable(table_oid);
+
+    // Deregister table from tile group freezer.
+    storage::TileGroupFreezer::GetInstance().DropTable(table_oid);
+
     oid_t table_offset = 0;
     for (auto table : tables) {
       if (table->GetOid() == table_oid) {
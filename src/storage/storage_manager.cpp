@@ -27,6 +27,7 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/macros.h"
+#include "configuration/configuration.h"
 #include "type/types.h"
 #include "logging/logging_util.h"
 #include "storage/storage_manager.h"
@@ -492,9 +493,37 @@ void *StorageManager::Allocate(BackendType type, size_t size) {
   }
 }
 
+void *StorageManager::Allocate(BackendType type, size_t size,
+                               int numa_node) {
+  if (type != BackendType::MM || FLAGS_tile_huge_pages == false) {
+    return Allocate(type, size);
+  }
+
+  // Update allocation count
+  allocation_count++;
+
+  auto &tile_group_allocator = TileGroupAllocator::GetInstance();
+  void *address = tile_group_allocator.Allocate(size, numa_node);
+  if (address == nullptr) {
+    throw Exception("could not allocate tile group memory: size : " +
+                    std::to_string(size));
+  }
+
+  return address;
+}
+
 void StorageManager::Release(BackendType type, void *address) {
   switch (type) {
-    case BackendType::MM:
+    case BackendType::MM: {
+      // Check if it was carved from a huge page region. This does not look
+      // at the flag, which may have been turned off after the allocation.
+      // Heap memory is told apart without taking the allocator lock.
+      if (TileGroupAllocator::GetInstance().Release(address) == true) {
+        break;
+      }
+      ::operator delete(address);
+    } break;
+
     case BackendType::NVM: {
       ::operator delete(address);
     } break;
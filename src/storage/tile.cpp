@@ -20,6 +20,7 @@
 #include "type/types.h"
 #include "type/ephemeral_pool.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "storage/compressed_column.h"
 #include "storage/storage_manager.h"
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
@@ -31,7 +32,7 @@ namespace storage {
 
 Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
            const catalog::Schema &tuple_schema, TileGroup *tile_group,
-           int tuple_count)
+           int tuple_count, int numa_node)
     : database_id(INVALID_OID),
       table_id(INVALID_OID),
       tile_group_id(INVALID_OID),
@@ -47,15 +48,23 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
       uninlined_data_size(0),
       column_header(NULL),
       column_header_size(INVALID_OID),
+      compressed(false),
       tile_group_header(tile_header) {
   PL_ASSERT(tuple_count > 0);
 
   tile_size = tuple_count * tuple_length;
 
   // allocate tuple storage space for inlined data
+  // (only tiles that belong to a tile group go through the tile group
+  // allocator, temporary tiles are short-lived)
   auto &storage_manager = storage::StorageManager::GetInstance();
-  data = reinterpret_cast<char *>(
-      storage_manager.Allocate(backend_type, tile_size));
+  if (tile_header != nullptr) {
+    data = reinterpret_cast<char *>(
+        storage_manager.Allocate(backend_type, tile_size, numa_node));
+  } else {
+    data = reinterpret_cast<char *>(
+        storage_manager.Allocate(backend_type, tile_size));
+  }
   PL_ASSERT(data != NULL);
 
   // zero out the data
@@ -94,6 +103,7 @@ Tile::~Tile() {
  */
 void Tile::InsertTuple(const oid_t tuple_offset, Tuple *tuple) {
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
+  PL_ASSERT(IsCompressed() == false);
 
   // Find slot location
   char *location = tuple_offset * tuple_length + data;
@@ -110,6 +120,10 @@ type::Value Tile::GetValue(const oid_t tuple_offset, const oid_t column_id) {
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
   PL_ASSERT(column_id < schema.GetColumnCount());
 
+  if (IsCompressed() == true) {
+    return compressed_columns[column_id]->GetValue(tuple_offset);
+  }
+
   const type::Type::TypeId column_type = schema.GetType(column_id);
 
   const char *tuple_location = GetTupleLocation(tuple_offset);
@@ -132,6 +146,14 @@ type::Value Tile::GetValueFast(const oid_t tuple_offset,
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
   PL_ASSERT(column_offset < schema.GetLength());
 
+  if (IsCompressed() == true) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      if (schema.GetOffset(column_itr) == column_offset) {
+        return compressed_columns[column_itr]->GetValue(tuple_offset);
+      }
+    }
+  }
+
   const char *tuple_location = GetTupleLocation(tuple_offset);
   const char *field_location = tuple_location + column_offset;
 
@@ -147,6 +169,7 @@ void Tile::SetValue(const type::Value &value, const oid_t tuple_offset,
                     const oid_t column_id) {
   PL_ASSERT(tuple_offset < num_tuple_slots);
   PL_ASSERT(column_id < schema.GetColumnCount());
+  PL_ASSERT(IsCompressed() == false);
 
   char *tuple_location = GetTupleLocation(tuple_offset);
   char *field_location = tuple_location + schema.GetOffset(column_id);
@@ -169,6 +192,7 @@ void Tile::SetValueFast(const type::Value &value, const oid_t tuple_offset,
                         UNUSED_ATTRIBUTE const size_t column_length) {
   PL_ASSERT(tuple_offset < num_tuple_slots);
   PL_ASSERT(column_offset < schema.GetLength());
+  PL_ASSERT(IsCompressed() == false);
 
   char *tuple_location = GetTupleLocation(tuple_offset);
   char *field_location = tuple_location + column_offset;
@@ -178,7 +202,47 @@ void Tile::SetValueFast(const type::Value &value, const oid_t tuple_offset,
   value.SerializeTo(field_location, is_inlined, pool);
 }
 
+//===--------------------------------------------------------------------===//
+// Compression
+//===--------------------------------------------------------------------===//
+
+void Tile::Compress() {
+  PL_ASSERT(IsCompressed() == false);
+
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    compressed_columns.emplace_back(new CompressedColumn(this, column_itr));
+  }
+
+  // Readers that see the flag only ever look at the compressed columns
+  compressed.store(true, std::memory_order_release);
+}
+
+void Tile::ReleaseUncompressedData() {
+  PL_ASSERT(IsCompressed() == true);
+  if (data == NULL) {
+    return;
+  }
+
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  storage_manager.Release(backend_type, data);
+  data = NULL;
+
+  // The varlen values now live in the dictionaries
+  delete pool;
+  pool = new type::EphemeralPool();
+  uninlined_data_size = 0;
+}
+
+size_t Tile::GetCompressedSize() const {
+  size_t compressed_size = 0;
+  for (auto &compressed_column : compressed_columns) {
+    compressed_size += compressed_column->GetSize();
+  }
+  return compressed_size;
+}
+
 Tile *Tile::CopyTile(BackendType backend_type) {
+  PL_ASSERT(IsCompressed() == false);
   auto schema = GetSchema();
   bool tile_columns_inlined = schema->IsInlined();
   auto allocated_tuple_count = GetAllocatedTupleCount();
@@ -471,6 +535,11 @@ oid_t Tile::GetActiveTupleCount() const {
 }
 
 void Tile::Sync() {
+  // Compressed tiles are not backed by the storage manager anymore
+  if (data == NULL) {
+    return;
+  }
+
   // Sync the tile data
   auto &storage_manager = storage::StorageManager::GetInstance();
   storage_manager.Sync(backend_type, data, tile_size);
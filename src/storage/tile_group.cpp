@@ -13,16 +13,22 @@
 #include "storage/tile_group.h"
 
 #include <numeric>
+#include <thread>
 
 #include "catalog/manager.h"
 #include "common/container_tuple.h"
 #include "common/logger.h"
 #include "common/platform.h"
+#include "configuration/configuration.h"
 #include "type/types.h"
 #include "storage/abstract_table.h"
+#include "storage/anti_cache_manager.h"
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
+#include "storage/zone_map.h"
+#include "type/serializeio.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 namespace storage {
@@ -30,7 +36,8 @@ namespace storage {
 TileGroup::TileGroup(BackendType backend_type,
                      TileGroupHeader *tile_group_header, AbstractTable *table,
                      const std::vector<catalog::Schema> &schemas,
-                     const column_map_type &column_map, int tuple_count)
+                     const column_map_type &column_map, int tuple_count,
+                     int numa_node)
     : database_id(INVALID_OID),
       table_id(INVALID_OID),
       tile_group_id(INVALID_OID),
@@ -39,7 +46,8 @@ TileGroup::TileGroup(BackendType backend_type,
       tile_group_header(tile_group_header),
       table(table),
       num_tuple_slots(tuple_count),
-      column_map(column_map) {
+      column_map(column_map),
+      last_access_clock(AntiCacheManager::GetInstance().GetClock()) {
   tile_count = tile_schemas.size();
 
   for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
@@ -48,11 +56,14 @@ TileGroup::TileGroup(BackendType backend_type,
 
     std::shared_ptr<Tile> tile(storage::TileFactory::GetTile(
         backend_type, database_id, table_id, tile_group_id, tile_id,
-        tile_group_header, tile_schemas[tile_itr], this, tuple_count));
+        tile_group_header, tile_schemas[tile_itr], this, tuple_count,
+        numa_node));
 
     // Add a reference to the tile in the tile group
     tiles.push_back(tile);
   }
+
+  ResetZoneMap();
 }
 
 TileGroup::~TileGroup() {
@@ -118,6 +129,7 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
          tile_column_itr++) {
       type::Value val = (tuple->GetValue(column_itr));
       tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      zone_map->Update(column_itr, val);
       column_itr++;
     }
   }
@@ -201,6 +213,7 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
          tile_column_itr++) {
       type::Value val = (tuple->GetValue(column_itr));
       tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      zone_map->Update(column_itr, val);
       column_itr++;
     }
   }
@@ -301,6 +314,7 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
          tile_column_itr++) {
       type::Value val = (tuple->GetValue(column_itr));
       tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      zone_map->Update(column_itr, val);
       column_itr++;
     }
   }
@@ -339,6 +353,7 @@ void TileGroup::SetValue(type::Value &value, oid_t tuple_id,
   oid_t tile_column_id, tile_offset;
   LocateTileAndColumn(column_id, tile_offset, tile_column_id);
   GetTile(tile_offset)->SetValue(value, tuple_id, tile_column_id);
+  zone_map->Update(column_id, value);
 }
 
 
@@ -375,6 +390,144 @@ void TileGroup::Sync() {
   }
 }
 
+//===--------------------------------------------------------------------===//
+// Anti-caching
+//===--------------------------------------------------------------------===//
+
+//===--------------------------------------------------------------------===//
+// Zone Map
+//===--------------------------------------------------------------------===//
+
+void TileGroup::ResetZoneMap() {
+  std::vector<type::Type::TypeId> column_types;
+  for (auto &column_map_entry : column_map) {
+    auto &schema = tile_schemas[column_map_entry.second.first];
+    column_types.push_back(schema.GetType(column_map_entry.second.second));
+  }
+
+  zone_map.reset(new ZoneMap(column_types));
+}
+
+void TileGroup::RebuildZoneMap() {
+  ResetZoneMap();
+
+  auto column_count = column_map.size();
+  auto tuple_count = GetNextTupleSlot();
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    if (tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID) {
+      continue;
+    }
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      zone_map->Update(column_itr, GetValue(tuple_id, column_itr));
+    }
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Compression
+//===--------------------------------------------------------------------===//
+
+void TileGroup::Freeze() {
+  PL_ASSERT(tile_group_header->IsFrozen() == false);
+
+  // Stop handing out recycled slots first
+  tile_group_header->SetFrozen();
+
+  // Updates in place check the flag once they own the tuple, so the ones
+  // that missed it are over once their owners let go of the tuples
+  if (FLAGS_delta_versions == true) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    oid_t tuple_count = GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      while (true) {
+        auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+        if (tuple_txn_id == INITIAL_TXN_ID || tuple_txn_id == INVALID_TXN_ID) {
+          break;
+        }
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    GetTile(tile_itr)->Compress();
+  }
+}
+
+void TileGroup::ReleaseUncompressedData() {
+  PL_ASSERT(tile_group_header->IsFrozen() == true);
+
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    GetTile(tile_itr)->ReleaseUncompressedData();
+  }
+}
+
+size_t TileGroup::GetCompressedSize() const {
+  size_t compressed_size = 0;
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    compressed_size += GetTile(tile_itr)->GetCompressedSize();
+  }
+  return compressed_size;
+}
+
+void TileGroup::SerializeTo(SerializeOutput &output) const {
+  tile_group_header->SerializeTo(output);
+
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    auto tile = GetTile(tile_itr);
+    auto schema = tile->GetSchema();
+
+    // Fixed-length part of all tuple slots
+    output.WriteBytes(tile->GetTupleLocation(0), tile->GetInlinedSize());
+
+    // Uninlined values only live in the tile pool, so write them out as well.
+    // Reclaimed slots point to memory that is gone already.
+    for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+         column_itr++) {
+      if (schema->IsInlined(column_itr) == true) {
+        continue;
+      }
+      for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+        if (tile_group_header->GetTransactionId(tuple_itr) == INVALID_TXN_ID) {
+          continue;
+        }
+        tile->GetValue(tuple_itr, column_itr).SerializeTo(output);
+      }
+    }
+  }
+}
+
+void TileGroup::DeserializeFrom(SerializeInput &input) {
+  tile_group_header->DeserializeFrom(input);
+
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    auto tile = GetTile(tile_itr);
+    auto schema = tile->GetSchema();
+
+    input.ReadBytes(tile->GetTupleLocation(0), tile->GetInlinedSize());
+
+    // Re-allocate the uninlined values in the pool of the new tile
+    for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+         column_itr++) {
+      if (schema->IsInlined(column_itr) == true) {
+        continue;
+      }
+      auto column_type = schema->GetType(column_itr);
+      for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+        if (tile_group_header->GetTransactionId(tuple_itr) == INVALID_TXN_ID) {
+          auto null_value = type::ValueFactory::GetNullValueByType(column_type);
+          tile->SetValue(null_value, tuple_itr, column_itr);
+          continue;
+        }
+        auto value = type::Value::DeserializeFrom(input, column_type);
+        tile->SetValue(value, tuple_itr, column_itr);
+      }
+    }
+  }
+
+  RebuildZoneMap();
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
@@ -0,0 +1,255 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_allocator.cpp
+//
+// Identification: src/storage/tile_group_allocator.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+
+#include "common/logger.h"
+#include "common/macros.h"
+#include "storage/tile_group_allocator.h"
+
+// Memory policy that prefers the given node but falls back to others when
+// it runs out of memory (see mbind(2))
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+
+namespace peloton {
+namespace storage {
+
+const size_t TileGroupAllocator::kRegionSize;
+
+// global singleton
+TileGroupAllocator &TileGroupAllocator::GetInstance(void) {
+  static TileGroupAllocator tile_group_allocator;
+  return tile_group_allocator;
+}
+
+TileGroupAllocator::TileGroupAllocator()
+    : min_address_(UINTPTR_MAX), max_address_(0) {
+  for (int node_itr = 0; node_itr < MAX_NUMA_NODES; node_itr++) {
+    active_regions_[node_itr] = nullptr;
+  }
+}
+
+TileGroupAllocator::~TileGroupAllocator() {
+  for (auto entry : regions_) {
+    munmap(entry.second->start, entry.second->size);
+    delete entry.second;
+  }
+  regions_.clear();
+}
+
+void *TileGroupAllocator::Allocate(size_t size, int numa_node) {
+  // Keep every allocation cache line aligned
+  if (size == 0) size = 1;
+  size = (size + CACHELINE_SIZE - 1) & ~(CACHELINE_SIZE - 1);
+
+  if (numa_node == NUMA_NODE_ANY) {
+    numa_node = GetCurrentNumaNode();
+  }
+  if (numa_node < 0 || numa_node >= MAX_NUMA_NODES) {
+    numa_node = 0;
+  }
+
+  allocator_lock_.Lock();
+
+  // Large tiles get a dedicated region of their own
+  if (size > kRegionSize / 2) {
+    Region *region = MapRegion(size, numa_node);
+    if (region == nullptr) {
+      allocator_lock_.Unlock();
+      return nullptr;
+    }
+    region->offset = size;
+    region->live_allocations = 1;
+    allocator_lock_.Unlock();
+    return region->start;
+  }
+
+  Region *region = active_regions_[numa_node];
+  if (region == nullptr || region->offset + size > region->size) {
+    // Retire the active region. It is unmapped along with its last
+    // allocation, or right away if everything in it is already gone.
+    if (region != nullptr && region->live_allocations == 0) {
+      UnmapRegion(region);
+    }
+    active_regions_[numa_node] = nullptr;
+
+    region = MapRegion(kRegionSize, numa_node);
+    if (region == nullptr) {
+      allocator_lock_.Unlock();
+      return nullptr;
+    }
+    active_regions_[numa_node] = region;
+  }
+
+  char *location = region->start + region->offset;
+  region->offset += size;
+  region->live_allocations++;
+
+  allocator_lock_.Unlock();
+  return location;
+}
+
+bool TileGroupAllocator::Release(void *address) {
+  auto location = reinterpret_cast<uintptr_t>(address);
+
+  // Fast path for memory that cannot have come from any of our regions
+  if (location < min_address_.load(std::memory_order_acquire) ||
+      location >= max_address_.load(std::memory_order_acquire)) {
+    return false;
+  }
+
+  allocator_lock_.Lock();
+
+  // Find the region with the largest start address <= location
+  auto region_itr = regions_.upper_bound(location);
+  if (region_itr == regions_.begin()) {
+    allocator_lock_.Unlock();
+    return false;
+  }
+  region_itr--;
+
+  Region *region = region_itr->second;
+  if (location >= region_itr->first + region->size) {
+    allocator_lock_.Unlock();
+    return false;
+  }
+
+  PL_ASSERT(region->live_allocations > 0);
+  region->live_allocations--;
+
+  // Hand the whole region back once it is empty and no longer being filled
+  if (region->live_allocations == 0 &&
+      active_regions_[region->numa_node] != region) {
+    UnmapRegion(region);
+  }
+
+  allocator_lock_.Unlock();
+  return true;
+}
+
+size_t TileGroupAllocator::GetRegionCount() {
+  allocator_lock_.Lock();
+  size_t region_count = regions_.size();
+  allocator_lock_.Unlock();
+  return region_count;
+}
+
+size_t TileGroupAllocator::GetMappedBytes() {
+  allocator_lock_.Lock();
+  size_t mapped_bytes = mapped_bytes_;
+  allocator_lock_.Unlock();
+  return mapped_bytes;
+}
+
+TileGroupAllocator::Region *TileGroupAllocator::MapRegion(size_t size,
+                                                          int numa_node) {
+  size_t length = (size + kRegionSize - 1) & ~(kRegionSize - 1);
+
+  // Over-map so that the region can be aligned to the huge page size
+  size_t map_length = length + kRegionSize;
+  void *address = mmap(nullptr, map_length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (address == MAP_FAILED) {
+    LOG_ERROR("Could not map tile group region of %lu bytes", length);
+    return nullptr;
+  }
+
+  auto raw_start = reinterpret_cast<uintptr_t>(address);
+  auto aligned_start = (raw_start + kRegionSize - 1) & ~(kRegionSize - 1);
+  size_t head = aligned_start - raw_start;
+  size_t tail = map_length - head - length;
+  if (head > 0) {
+    munmap(address, head);
+  }
+  if (tail > 0) {
+    munmap(reinterpret_cast<char *>(aligned_start + length), tail);
+  }
+
+  char *start = reinterpret_cast<char *>(aligned_start);
+
+#ifdef MADV_HUGEPAGE
+  if (madvise(start, length, MADV_HUGEPAGE) != 0) {
+    LOG_TRACE("Transparent huge pages are not available");
+  }
+#endif
+
+  // Bind the region before it is touched so that the pages get faulted in on
+  // the right node
+  if (GetNumaNodeCount() > 1) {
+    unsigned long node_mask = 1UL << numa_node;
+    if (syscall(SYS_mbind, start, length, MPOL_PREFERRED, &node_mask,
+                sizeof(node_mask) * 8, 0) != 0) {
+      LOG_TRACE("Could not bind region to NUMA node %d", numa_node);
+    }
+  }
+
+  Region *region = new Region();
+  region->start = start;
+  region->size = length;
+  region->offset = 0;
+  region->live_allocations = 0;
+  region->numa_node = numa_node;
+
+  regions_[aligned_start] = region;
+  mapped_bytes_ += length;
+
+  if (aligned_start < min_address_.load(std::memory_order_relaxed)) {
+    min_address_.store(aligned_start, std::memory_order_release);
+  }
+  if (aligned_start + length > max_address_.load(std::memory_order_relaxed)) {
+    max_address_.store(aligned_start + length, std::memory_order_release);
+  }
+
+  return region;
+}
+
+void TileGroupAllocator::UnmapRegion(Region *region) {
+  regions_.erase(reinterpret_cast<uintptr_t>(region->start));
+  mapped_bytes_ -= region->size;
+
+  munmap(region->start, region->size);
+  delete region;
+}
+
+int TileGroupAllocator::GetCurrentNumaNode() {
+  unsigned int cpu = 0, node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+    return 0;
+  }
+  return static_cast<int>(node);
+}
+
+int TileGroupAllocator::GetNumaNodeCount() {
+  static int numa_node_count = []() {
+    int node_count = 0;
+    struct stat node_stat;
+    while (node_count < MAX_NUMA_NODES) {
+      std::string node_dir = "/sys/devices/system/node/node" +
+                             std::to_string(node_count);
+      if (stat(node_dir.c_str(), &node_stat) != 0) break;
+      node_count++;
+    }
+    return (node_count == 0) ? 1 : node_count;
+  }();
+  return numa_node_count;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -12,6 +12,7 @@
 
 #include "storage/tile_group_factory.h"
 #include "logging/logging_util.h"
+#include "storage/abstract_table.h"
 #include "storage/tile_group_header.h"
 
 //===--------------------------------------------------------------------===//
@@ -32,9 +33,17 @@ TileGroup *TileGroupFactory::GetTileGroup(
   BackendType backend_type =
       logging::LoggingUtil::GetBackendType(peloton_logging_mode);
 
-  TileGroupHeader *tile_header = new TileGroupHeader(backend_type, tuple_count);
-  TileGroup *tile_group = new TileGroup(backend_type, tile_header, table,
-                                        schemas, column_map, tuple_count);
+  // Place the tile group next to the threads that insert into the table
+  int numa_node = NUMA_NODE_ANY;
+  if (table != nullptr) {
+    numa_node = table->GetPreferredNumaNode();
+  }
+
+  TileGroupHeader *tile_header =
+      new TileGroupHeader(backend_type, tuple_count, numa_node);
+  TileGroup *tile_group =
+      new TileGroup(backend_type, tile_header, table, schemas, column_map,
+                    tuple_count, numa_node);
 
   tile_header->SetTileGroup(tile_group);
 
@@ -0,0 +1,197 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer.cpp
+//
+// Identification: src/storage/tile_group_freezer.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/tile_group_freezer.h"
+
+#include <algorithm>
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace storage {
+
+TileGroupFreezer &TileGroupFreezer::GetInstance() {
+  static TileGroupFreezer tile_group_freezer;
+  return tile_group_freezer;
+}
+
+TileGroupFreezer::TileGroupFreezer()
+    : freezing_stop_(true), frozen_tile_group_count_(0) {}
+
+TileGroupFreezer::~TileGroupFreezer() {}
+
+void TileGroupFreezer::Start() {
+  // Set signal
+  freezing_stop_ = false;
+
+  // Launch thread
+  freezer_thread_ = std::thread(&storage::TileGroupFreezer::Freeze, this);
+
+  LOG_INFO("Started tile group freezer");
+}
+
+void TileGroupFreezer::Stop() {
+  // Stop freezing
+  freezing_stop_ = true;
+
+  // Stop thread
+  freezer_thread_.join();
+
+  LOG_INFO("Stopped tile group freezer");
+}
+
+void TileGroupFreezer::AddTable(storage::DataTable *table) {
+  {
+    std::lock_guard<std::mutex> lock(freezer_mutex_);
+    LOG_TRACE("Tile group freezer adding table : %p", table);
+
+    tables_.push_back(table);
+  }
+}
+
+void TileGroupFreezer::DropTable(const oid_t &table_oid) {
+  {
+    std::lock_guard<std::mutex> lock(freezer_mutex_);
+    tables_.erase(std::remove_if(tables_.begin(), tables_.end(),
+                                 [&table_oid](storage::DataTable *table) {
+                                   return table->GetOid() == table_oid;
+                                 }),
+                  tables_.end());
+  }
+}
+
+void TileGroupFreezer::ClearTables() {
+  {
+    std::lock_guard<std::mutex> lock(freezer_mutex_);
+    tables_.clear();
+  }
+}
+
+void TileGroupFreezer::Freeze() {
+  // Continue till signal is not false
+  while (freezing_stop_ == false) {
+    {
+      std::lock_guard<std::mutex> lock(freezer_mutex_);
+      for (auto table : tables_) {
+        FreezeTable(table);
+      }
+      ReleaseUncompressedData();
+    }
+
+    // Sleep a bit
+    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_duration_));
+  }
+}
+
+size_t TileGroupFreezer::FreezeTable(storage::DataTable *table) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto max_committed_cid = txn_manager.GetMaxCommittedCid();
+  if (max_committed_cid == MAX_CID) {
+    return 0;
+  }
+
+  std::vector<oid_t> frozen_tile_group_ids;
+  auto tile_group_count = table->GetTileGroupCount();
+  for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    if (tile_group == nullptr ||
+        IsFreezable(tile_group.get(), max_committed_cid) == false) {
+      continue;
+    }
+
+    LOG_TRACE("Freezing tile group : %u", tile_group->GetTileGroupId());
+    tile_group->Freeze();
+    frozen_tile_group_ids.push_back(tile_group->GetTileGroupId());
+  }
+
+  if (frozen_tile_group_ids.empty() == true) {
+    return 0;
+  }
+
+  // Every transaction that may still read the uncompressed tiles began
+  // before this one
+  auto txn = txn_manager.BeginTransaction();
+  auto retire_cid = txn->GetBeginCommitId();
+  txn_manager.CommitTransaction(txn);
+
+  for (auto tile_group_id : frozen_tile_group_ids) {
+    retired_tile_groups_.emplace_back(tile_group_id, retire_cid);
+  }
+
+  frozen_tile_group_count_ += frozen_tile_group_ids.size();
+  return frozen_tile_group_ids.size();
+}
+
+size_t TileGroupFreezer::ReleaseUncompressedData() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+  auto max_committed_cid = txn_manager.GetMaxCommittedCid();
+  if (max_committed_cid == MAX_CID) {
+    return 0;
+  }
+
+  size_t released_count = 0;
+  auto retired_itr = retired_tile_groups_.begin();
+  while (retired_itr != retired_tile_groups_.end()) {
+    if (max_committed_cid <= retired_itr->second) {
+      retired_itr++;
+      continue;
+    }
+
+    // The tile group may have been dropped in the meantime
+    auto tile_group = manager.GetResidentTileGroup(retired_itr->first);
+    if (tile_group != nullptr) {
+      tile_group->ReleaseUncompressedData();
+      released_count++;
+    }
+    retired_itr = retired_tile_groups_.erase(retired_itr);
+  }
+
+  return released_count;
+}
+
+bool TileGroupFreezer::IsFreezable(storage::TileGroup *tile_group,
+                                   const cid_t &max_committed_cid) {
+  auto tile_group_header = tile_group->GetHeader();
+
+  if (tile_group_header->IsFrozen() == true ||
+      tile_group_header->IsCompacting() == true) {
+    return false;
+  }
+
+  // Leave the tile groups that are still being filled alone
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+  if (tile_group_header->GetCurrentNextTupleSlot() < tuple_count) {
+    return false;
+  }
+
+  // Without old versions there is no garbage whose slot the GC could hand
+  // out again, and nobody is in the middle of inserting a tuple
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    if (tile_group_header->GetTransactionId(tuple_id) != INITIAL_TXN_ID ||
+        tile_group_header->GetEndCommitId(tuple_id) != MAX_CID ||
+        tile_group_header->GetBeginCommitId(tuple_id) > max_committed_cid) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
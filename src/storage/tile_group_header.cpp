@@ -24,24 +24,27 @@
 #include "logging/log_manager.h"
 #include "storage/storage_manager.h"
 #include "storage/tile_group_header.h"
+#include "type/serializeio.h"
 
 namespace peloton {
 namespace storage {
 
 TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
-                                 const int &tuple_count)
+                                 const int &tuple_count, const int &numa_node)
     : backend_type(backend_type),
       tile_group(nullptr),
       data(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
+      compacting(false),
+      frozen(false),
       tile_header_lock() {
   header_size = num_tuple_slots * header_entry_size;
 
   // allocate storage space for header
   auto &storage_manager = storage::StorageManager::GetInstance();
   data = reinterpret_cast<char *>(
-      storage_manager.Allocate(backend_type, header_size));
+      storage_manager.Allocate(backend_type, header_size, numa_node));
   PL_ASSERT(data != nullptr);
 
   // zero out the data
@@ -165,6 +168,20 @@ void TileGroupHeader::Sync() {
   storage_manager.Sync(backend_type, data, header_size);
 }
 
+void TileGroupHeader::SerializeTo(SerializeOutput &output) const {
+  output.WriteInt(num_tuple_slots);
+  output.WriteInt(next_tuple_slot.load());
+  output.WriteBytes(data, header_size);
+}
+
+void TileGroupHeader::DeserializeFrom(SerializeInput &input) {
+  UNUSED_ATTRIBUTE oid_t tuple_slot_count = input.ReadInt();
+  PL_ASSERT(tuple_slot_count == num_tuple_slots);
+
+  next_tuple_slot = input.ReadInt();
+  input.ReadBytes(data, header_size);
+}
+
 void TileGroupHeader::PrintVisibility(txn_id_t txn_id, cid_t at_cid) {
   oid_t active_tuple_slots = GetCurrentNextTupleSlot();
   std::stringstream os;
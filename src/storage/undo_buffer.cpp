@@ -0,0 +1,165 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// undo_buffer.cpp
+//
+// Identification: src/storage/undo_buffer.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/undo_buffer.h"
+
+#include <memory>
+#include <mutex>
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "common/macros.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace storage {
+
+void UndoRecord::Apply(std::vector<type::Value> &row) const {
+  for (oid_t column_itr = 0; column_itr < column_ids.size(); column_itr++) {
+    row[column_ids[column_itr]] = values[column_itr];
+  }
+}
+
+namespace {
+
+// All buffers ever made, and the ones whose thread is gone
+struct UndoBufferPool {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<UndoBuffer>> buffers;
+  std::vector<UndoBuffer *> free_buffers;
+
+  static UndoBufferPool &GetInstance() {
+    static UndoBufferPool pool;
+    return pool;
+  }
+};
+
+// Gives the buffer of a thread back to the pool when the thread exits
+struct ThreadUndoBuffer {
+  UndoBuffer *buffer = nullptr;
+
+  ~ThreadUndoBuffer() {
+    if (buffer != nullptr) {
+      auto &pool = UndoBufferPool::GetInstance();
+      std::lock_guard<std::mutex> lock(pool.mutex);
+      pool.free_buffers.push_back(buffer);
+    }
+  }
+};
+
+thread_local ThreadUndoBuffer thread_undo_buffer;
+
+}  // namespace
+
+UndoBuffer &UndoBuffer::GetInstance() {
+  if (thread_undo_buffer.buffer == nullptr) {
+    auto &pool = UndoBufferPool::GetInstance();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (pool.free_buffers.empty() == false) {
+      thread_undo_buffer.buffer = pool.free_buffers.back();
+      pool.free_buffers.pop_back();
+    } else {
+      pool.buffers.emplace_back(new UndoBuffer());
+      thread_undo_buffer.buffer = pool.buffers.back().get();
+    }
+  }
+  return *thread_undo_buffer.buffer;
+}
+
+UndoRecord *UndoBuffer::NewRecord(const txn_id_t &txn_id,
+                                  const cid_t &begin_cid,
+                                  const ItemPointer &location,
+                                  UndoRecord *next) {
+  Reclaim();
+
+  records_.emplace_back();
+  auto &record = records_.back();
+  record.txn_id = txn_id;
+  record.begin_cid = begin_cid;
+  record.next = next;
+  record.location = location;
+  return &record;
+}
+
+void UndoBuffer::Unlink(UndoRecord *record) {
+  // readers that began before now may still hold on to the record
+  record->unlink_cid.store(
+      concurrency::EpochManagerFactory::GetInstance().GetCommitId());
+}
+
+void UndoBuffer::Unlink(TileGroupHeader *tile_group_header,
+                        const oid_t &tuple_id) {
+  auto record = tile_group_header->GetUndoRecord(tuple_id);
+  if (record == nullptr ||
+      tile_group_header->SetAtomicUndoRecord(tuple_id, record, nullptr) ==
+          false) {
+    // somebody else took it off in the meantime
+    return;
+  }
+  Unlink(record);
+}
+
+size_t UndoBuffer::Reclaim() {
+  auto max_committed_cid =
+      concurrency::EpochManagerFactory::GetInstance().GetMaxCommittedCid();
+  if (max_committed_cid == MAX_CID) {
+    return 0;
+  }
+
+  size_t reclaimed_count = 0;
+  while (records_.empty() == false &&
+         IsReclaimable(records_.front(), max_committed_cid) == true) {
+    records_.pop_front();
+    reclaimed_count++;
+  }
+
+  LOG_TRACE("Reclaimed %lu undo records", reclaimed_count);
+  return reclaimed_count;
+}
+
+bool UndoBuffer::IsReclaimable(UndoRecord &record,
+                               const cid_t &max_committed_cid) {
+  if (record.unlink_cid.load() != MAX_CID) {
+    // the version is older than every snapshot by the time the readers that
+    // were around when the record got unlinked are gone
+    return record.unlink_cid.load() <= max_committed_cid;
+  }
+
+  // a reader only follows the chain past the head record while it needs an
+  // older version, so the head has to be taken off first
+  auto end_cid = record.end_cid.load();
+  if (end_cid == MAX_CID || end_cid > max_committed_cid) {
+    return false;
+  }
+
+  // a tile group that is gone (or evicted, which it only is without undo
+  // records) cannot lead anybody to the record anymore
+  auto tile_group = catalog::Manager::GetInstance().GetResidentTileGroup(
+      record.location.block);
+  if (tile_group == nullptr) {
+    Unlink(&record);
+    return false;
+  }
+
+  // if the record is not the head anymore, whoever replaced it marks it
+  auto tile_group_header = tile_group->GetHeader();
+  if (tile_group_header->SetAtomicUndoRecord(record.location.offset, &record,
+                                             nullptr) == true) {
+    Unlink(&record);
+  }
+  return false;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,250 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.cpp
+//
+// Identification: src/storage/zone_map.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/zone_map.h"
+
+#include <limits>
+
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace storage {
+
+static bool IsIntegerType(const type::Type::TypeId &type_id) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool HasIntegerRange(const type::Type::TypeId &type_id) {
+  return IsIntegerType(type_id) || type_id == type::Type::TIMESTAMP;
+}
+
+static int64_t GetIntegerField(const type::Value &value) {
+  switch (value.GetTypeId()) {
+    case type::Type::TINYINT:
+      return value.GetAs<int8_t>();
+    case type::Type::SMALLINT:
+      return value.GetAs<int16_t>();
+    case type::Type::INTEGER:
+      return value.GetAs<int32_t>();
+    case type::Type::BIGINT:
+      return value.GetAs<int64_t>();
+    case type::Type::TIMESTAMP:
+      return static_cast<int64_t>(value.GetAs<uint64_t>());
+    default:
+      throw Exception("Invalid type for an integer zone.");
+  }
+}
+
+static type::Value GetIntegerValue(const type::Type::TypeId &type_id,
+                                   const int64_t &field) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+      return type::ValueFactory::GetTinyIntValue(static_cast<int8_t>(field));
+    case type::Type::SMALLINT:
+      return type::ValueFactory::GetSmallIntValue(static_cast<int16_t>(field));
+    case type::Type::INTEGER:
+      return type::ValueFactory::GetIntegerValue(static_cast<int32_t>(field));
+    case type::Type::BIGINT:
+      return type::ValueFactory::GetBigIntValue(field);
+    case type::Type::TIMESTAMP:
+      return type::ValueFactory::GetTimestampValue(field);
+    default:
+      throw Exception("Invalid type for an integer zone.");
+  }
+}
+
+template <typename T>
+static void WidenMin(std::atomic<T> &min, const T &value) {
+  T current = min.load();
+  while (value < current && min.compare_exchange_weak(current, value) == false)
+    ;
+}
+
+template <typename T>
+static void WidenMax(std::atomic<T> &max, const T &value) {
+  T current = max.load();
+  while (value > current && max.compare_exchange_weak(current, value) == false)
+    ;
+}
+
+template <typename T>
+static bool RangeMayMatch(const T &min, const T &max,
+                          const ExpressionType &comparison_type,
+                          const T &constant) {
+  switch (comparison_type) {
+    case ExpressionType::COMPARE_EQUAL:
+      return min <= constant && constant <= max;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      return min != constant || max != constant;
+    case ExpressionType::COMPARE_LESSTHAN:
+      return min < constant;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return min <= constant;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return max > constant;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return max >= constant;
+    default:
+      return true;
+  }
+}
+
+ZoneMap::ZoneMap(const std::vector<type::Type::TypeId> &column_types)
+    : columns_(new ColumnZone[column_types.size()]),
+      column_count_(column_types.size()) {
+  for (oid_t column_itr = 0; column_itr < column_count_; column_itr++) {
+    auto &zone = columns_[column_itr];
+    zone.type_id = column_types[column_itr];
+
+    // Empty ranges until the first value comes in
+    zone.min_integer = std::numeric_limits<int64_t>::max();
+    zone.max_integer = std::numeric_limits<int64_t>::min();
+    zone.min_decimal = std::numeric_limits<double>::infinity();
+    zone.max_decimal = -std::numeric_limits<double>::infinity();
+    zone.null_count = 0;
+  }
+}
+
+void ZoneMap::Update(const oid_t &column_id, const type::Value &value) {
+  PL_ASSERT(column_id < column_count_);
+  auto &zone = columns_[column_id];
+
+  if (value.IsNull() == true) {
+    zone.null_count++;
+    return;
+  }
+
+  if (HasIntegerRange(zone.type_id) == true) {
+    auto field = GetIntegerField(value);
+    WidenMin(zone.min_integer, field);
+    WidenMax(zone.max_integer, field);
+  } else if (zone.type_id == type::Type::DECIMAL) {
+    auto field = value.GetAs<double>();
+    WidenMin(zone.min_decimal, field);
+    WidenMax(zone.max_decimal, field);
+  }
+}
+
+bool ZoneMap::MayMatch(const oid_t &column_id,
+                       const ExpressionType &comparison_type,
+                       const type::Value &constant) const {
+  if (column_id >= column_count_ || HasRange(column_id) == false) {
+    return true;
+  }
+  auto &zone = columns_[column_id];
+
+  // Comparisons with null never hold
+  if (constant.IsNull() == true) {
+    return false;
+  }
+
+  auto constant_type = constant.GetTypeId();
+  if (HasIntegerRange(zone.type_id) == true) {
+    int64_t min = zone.min_integer, max = zone.max_integer;
+    // Only nulls so far
+    if (min > max) {
+      return false;
+    }
+
+    if (zone.type_id == type::Type::TIMESTAMP) {
+      if (constant_type != type::Type::TIMESTAMP) {
+        return true;
+      }
+      return RangeMayMatch(min, max, comparison_type,
+                           GetIntegerField(constant));
+    }
+
+    if (IsIntegerType(constant_type) == true) {
+      return RangeMayMatch(min, max, comparison_type,
+                           GetIntegerField(constant));
+    }
+    // Mixed comparisons are done on doubles, which preserves the order
+    if (constant_type == type::Type::DECIMAL) {
+      return RangeMayMatch(static_cast<double>(min), static_cast<double>(max),
+                           comparison_type, constant.GetAs<double>());
+    }
+    return true;
+  }
+
+  double min = zone.min_decimal, max = zone.max_decimal;
+  if (min > max) {
+    return false;
+  }
+  if (constant_type == type::Type::DECIMAL) {
+    return RangeMayMatch(min, max, comparison_type, constant.GetAs<double>());
+  }
+  if (IsIntegerType(constant_type) == true) {
+    return RangeMayMatch(min, max, comparison_type,
+                         static_cast<double>(GetIntegerField(constant)));
+  }
+  return true;
+}
+
+bool ZoneMap::HasRange(const oid_t &column_id) const {
+  PL_ASSERT(column_id < column_count_);
+  auto type_id = columns_[column_id].type_id;
+  return HasIntegerRange(type_id) || type_id == type::Type::DECIMAL;
+}
+
+type::Value ZoneMap::GetMin(const oid_t &column_id) const {
+  PL_ASSERT(column_id < column_count_);
+  auto &zone = columns_[column_id];
+
+  if (HasIntegerRange(zone.type_id) == true) {
+    int64_t min = zone.min_integer, max = zone.max_integer;
+    if (min <= max) {
+      return GetIntegerValue(zone.type_id, min);
+    }
+  } else if (zone.type_id == type::Type::DECIMAL) {
+    double min = zone.min_decimal, max = zone.max_decimal;
+    if (min <= max) {
+      return type::ValueFactory::GetDecimalValue(min);
+    }
+  }
+
+  return type::ValueFactory::GetNullValueByType(zone.type_id);
+}
+
+type::Value ZoneMap::GetMax(const oid_t &column_id) const {
+  PL_ASSERT(column_id < column_count_);
+  auto &zone = columns_[column_id];
+
+  if (HasIntegerRange(zone.type_id) == true) {
+    int64_t min = zone.min_integer, max = zone.max_integer;
+    if (min <= max) {
+      return GetIntegerValue(zone.type_id, max);
+    }
+  } else if (zone.type_id == type::Type::DECIMAL) {
+    double min = zone.min_decimal, max = zone.max_decimal;
+    if (min <= max) {
+      return type::ValueFactory::GetDecimalValue(max);
+    }
+  }
+
+  return type::ValueFactory::GetNullValueByType(zone.type_id);
+}
+
+size_t ZoneMap::GetNullCount(const oid_t &column_id) const {
+  PL_ASSERT(column_id < column_count_);
+  return columns_[column_id].null_count;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
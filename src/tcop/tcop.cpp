@@ -26,6 +26,7 @@
 #include "expression/expression_util.h"
 #include "optimizer/simple_optimizer.h"
 #include "common/exception.h"
+#include "parser/explain_statement.h"
 #include "parser/select_statement.h"
 
 #include "catalog/catalog.h"
@@ -112,7 +113,15 @@ ResultType TrafficCop::CommitQueryHelper() {
   if (curr_state.second != ResultType::ABORTED) {
     auto txn = curr_state.first;
     auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()->StartPhase(
+          QueryPhaseType::COMMIT);
+    }
     auto result = txn_manager.CommitTransaction(txn);
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()->EndPhase(
+          QueryPhaseType::COMMIT);
+    }
     return result;
   } else {
     // otherwise, the txn has already been aborted
@@ -178,8 +187,9 @@ ResultType TrafficCop::ExecuteStatement(
     int &rows_changed, UNUSED_ATTRIBUTE std::string &error_message,
     const size_t thread_id UNUSED_ATTRIBUTE) {
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
-    stats::BackendStatsContext::GetInstance()->InitQueryMetric(statement,
-                                                               param_stats);
+    auto stats_context = stats::BackendStatsContext::GetInstance();
+    stats_context->InitQueryMetric(statement, param_stats);
+    stats_context->SetStatementType(statement->GetStatementType());
   }
   LOG_TRACE("Execute Statement of name: %s",
             statement->GetStatementName().c_str());
@@ -195,10 +205,21 @@ ResultType TrafficCop::ExecuteStatement(
       return CommitQueryHelper();
     else if (statement->GetQueryType() == "ROLLBACK")
       return AbortQueryHelper();
-    else {
+    else if (statement->IsExplain() && !statement->IsExplainAnalyze()) {
+      // EXPLAIN only describes the plan, it does not need a txn
+      result.clear();
+      for (auto &line : planner::PlanUtil::GetExplainInfo(
+               statement->GetPlanTree().get())) {
+        auto res = StatementResult();
+        bridge::PlanExecutor::copyFromTo(line, res.second);
+        result.push_back(std::move(res));
+      }
+      rows_changed = result.size();
+      return ResultType::SUCCESS;
+    } else {
       auto status = ExecuteStatementPlan(statement->GetPlanTree().get(), params,
-                                         result, result_format,
-                                         thread_id);
+                                         result, result_format, thread_id,
+                                         statement->IsExplainAnalyze());
       LOG_TRACE("Statement executed. Result: %s",
                 ResultTypeToString(status.m_result).c_str());
       rows_changed = status.m_processed;
@@ -213,7 +234,7 @@ ResultType TrafficCop::ExecuteStatement(
 bridge::peloton_status TrafficCop::ExecuteStatementPlan(
     const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
     std::vector<StatementResult> &result, const std::vector<int> &result_format,
-    const size_t thread_id) {
+    const size_t thread_id, const bool explain_analyze) {
   concurrency::Transaction *txn;
   bool single_statement_txn = false, init_failure = false;
   bridge::peloton_status p_status;
@@ -234,8 +255,13 @@ bridge::peloton_status TrafficCop::ExecuteStatementPlan(
   // skip if already aborted
   if (curr_state.second != ResultType::ABORTED) {
     PL_ASSERT(txn);
-    p_status = bridge::PlanExecutor::ExecutePlan(plan, txn, params, result,
-                                                 result_format);
+    if (explain_analyze == false) {
+      p_status = bridge::PlanExecutor::ExecutePlan(plan, txn, params, result,
+                                                   result_format);
+    } else {
+      p_status =
+          bridge::PlanExecutor::ExplainAnalyzePlan(plan, txn, params, result);
+    }
 
     if (p_status.m_result == ResultType::FAILURE) {
       // only possible if init failed
@@ -255,7 +281,15 @@ bridge::peloton_status TrafficCop::ExecuteStatementPlan(
         case ResultType::SUCCESS:
           // Commit
           LOG_TRACE("Commit Transaction");
+          if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+            stats::BackendStatsContext::GetInstance()->StartPhase(
+                QueryPhaseType::COMMIT);
+          }
           p_status.m_result = txn_manager.CommitTransaction(txn);
+          if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+            stats::BackendStatsContext::GetInstance()->EndPhase(
+                QueryPhaseType::COMMIT);
+          }
           break;
 
         case ResultType::FAILURE:
@@ -282,12 +316,42 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
   std::shared_ptr<Statement> statement(
       new Statement(statement_name, query_string));
   try {
+    stats::BackendStatsContext *stats_context = nullptr;
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats_context = stats::BackendStatsContext::GetInstance();
+      stats_context->StartPhase(QueryPhaseType::PARSE);
+    }
     auto &peloton_parser = parser::PostgresParser::GetInstance();
     auto sql_stmt = peloton_parser.BuildParseTree(query_string);
     if (sql_stmt->is_valid == false) {
       throw ParserException("Error parsing SQL statement");
     }
+    if (sql_stmt->GetNumStatements() > 0) {
+      statement->SetStatementType(sql_stmt->GetStatement(0)->GetType());
+    }
+    if (stats_context != nullptr) {
+      stats_context->EndPhase(QueryPhaseType::PARSE);
+      stats_context->SetStatementType(statement->GetStatementType());
+    }
+
+    // EXPLAIN plans the statement it wraps, and only remembers how to
+    // return it
+    if (sql_stmt->GetNumStatements() > 0 &&
+        sql_stmt->GetStatement(0)->GetType() == StatementType::EXPLAIN) {
+      auto explain_stmt =
+          static_cast<parser::ExplainStatement *>(sql_stmt->GetStatement(0));
+      statement->SetExplain(explain_stmt->analyze);
+      sql_stmt->statements[0] = explain_stmt->real_sql_stmt;
+      explain_stmt->real_sql_stmt = nullptr;
+      delete explain_stmt;
+    }
+    if (stats_context != nullptr) {
+      stats_context->StartPhase(QueryPhaseType::PLAN);
+    }
     auto plan = optimizer_->BuildPelotonPlanTree(sql_stmt);
+    if (stats_context != nullptr) {
+      stats_context->EndPhase(QueryPhaseType::PLAN);
+    }
     statement->SetPlanTree(plan);
 
     // Get the tables that our plan references so that we know how to
@@ -304,6 +368,10 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
       }
       break;
     }
+    if (statement->IsExplain()) {
+      statement->SetTupleDescriptor(
+          {GetColumnFieldForValueType("QUERY PLAN", type::Type::VARCHAR)});
+    }
 
 #ifdef LOG_DEBUG_ENABLED
     if (statement->GetPlanTree().get() != nullptr) {
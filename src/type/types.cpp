@@ -345,6 +345,12 @@ std::string StatementTypeToString(StatementType type) {
     case StatementType::COPY: {
       return "COPY";
     }
+    case StatementType::ANALYZE: {
+      return "ANALYZE";
+    }
+    case StatementType::EXPLAIN: {
+      return "EXPLAIN";
+    }
     case StatementType::INSERT: {
       return "INSERT";
     }
@@ -400,6 +406,10 @@ StatementType StringToStatementType(const std::string& str) {
     return StatementType::TRANSACTION;
   } else if (upper_str == "COPY") {
     return StatementType::COPY;
+  } else if (upper_str == "ANALYZE") {
+    return StatementType::ANALYZE;
+  } else if (upper_str == "EXPLAIN") {
+    return StatementType::EXPLAIN;
   } else {
     throw ConversionException(StringUtil::Format(
         "No StatementType conversion from string '%s'", upper_str.c_str()));
@@ -411,6 +421,81 @@ std::ostream& operator<<(std::ostream& os, const StatementType& type) {
   return os;
 }
 
+//===--------------------------------------------------------------------===//
+// QueryPhaseType - String Utilities
+//===--------------------------------------------------------------------===//
+
+std::string QueryPhaseTypeToString(QueryPhaseType type) {
+  switch (type) {
+    case QueryPhaseType::INVALID: {
+      return "INVALID";
+    }
+    case QueryPhaseType::DECODE: {
+      return "DECODE";
+    }
+    case QueryPhaseType::PARSE: {
+      return "PARSE";
+    }
+    case QueryPhaseType::PLAN: {
+      return "PLAN";
+    }
+    case QueryPhaseType::BUILD: {
+      return "BUILD";
+    }
+    case QueryPhaseType::EXECUTE: {
+      return "EXECUTE";
+    }
+    case QueryPhaseType::COMMIT: {
+      return "COMMIT";
+    }
+    case QueryPhaseType::LOG_FLUSH: {
+      return "LOG_FLUSH";
+    }
+    case QueryPhaseType::ENCODE: {
+      return "ENCODE";
+    }
+    default: {
+      throw ConversionException(StringUtil::Format(
+          "No string conversion for QueryPhaseType value '%d'",
+          static_cast<int>(type)));
+    }
+  }
+  return "INVALID";
+}
+
+QueryPhaseType StringToQueryPhaseType(const std::string& str) {
+  std::string upper_str = StringUtil::Upper(str);
+  if (upper_str == "INVALID") {
+    return QueryPhaseType::INVALID;
+  } else if (upper_str == "DECODE") {
+    return QueryPhaseType::DECODE;
+  } else if (upper_str == "PARSE") {
+    return QueryPhaseType::PARSE;
+  } else if (upper_str == "PLAN") {
+    return QueryPhaseType::PLAN;
+  } else if (upper_str == "BUILD") {
+    return QueryPhaseType::BUILD;
+  } else if (upper_str == "EXECUTE") {
+    return QueryPhaseType::EXECUTE;
+  } else if (upper_str == "COMMIT") {
+    return QueryPhaseType::COMMIT;
+  } else if (upper_str == "LOG_FLUSH") {
+    return QueryPhaseType::LOG_FLUSH;
+  } else if (upper_str == "ENCODE") {
+    return QueryPhaseType::ENCODE;
+  } else {
+    throw ConversionException(
+        StringUtil::Format("No QueryPhaseType conversion from string '%s'",
+                           upper_str.c_str()));
+  }
+  return QueryPhaseType::INVALID;
+}
+
+std::ostream& operator<<(std::ostream& os, const QueryPhaseType& type) {
+  os << QueryPhaseTypeToString(type);
+  return os;
+}
+
 //===--------------------------------------------------------------------===//
 // Expression - String Utilities
 //===--------------------------------------------------------------------===//
@@ -806,6 +891,9 @@ std::string IndexTypeToString(IndexType type) {
     case IndexType::SKIPLIST: {
       return "SKIPLIST";
     }
+    case IndexType::ART: {
+      return "ART";
+    }
     default: {
       throw ConversionException(
           StringUtil::Format("No string conversion for IndexType value '%d'",
@@ -825,6 +913,8 @@ IndexType StringToIndexType(const std::string& str) {
     return IndexType::HASH;
   } else if (upper_str == "SKIPLIST") {
     return IndexType::SKIPLIST;
+  } else if (upper_str == "ART") {
+    return IndexType::ART;
   } else {
     throw ConversionException(StringUtil::Format(
         "No IndexType conversion from string '%s'", upper_str.c_str()));
@@ -1029,6 +1119,9 @@ std::string PlanNodeTypeToString(PlanNodeType type) {
     case PlanNodeType::COPY: {
       return ("COPY");
     }
+    case PlanNodeType::ANALYZE: {
+      return ("ANALYZE");
+    }
     case PlanNodeType::MOCK: {
       return ("MOCK");
     }
@@ -1104,6 +1197,8 @@ PlanNodeType StringToPlanNodeType(const std::string& str) {
     return PlanNodeType::RESULT;
   } else if (upper_str == "COPY") {
     return PlanNodeType::COPY;
+  } else if (upper_str == "ANALYZE") {
+    return PlanNodeType::ANALYZE;
   } else if (upper_str == "MOCK") {
     return PlanNodeType::MOCK;
   } else {
@@ -2306,6 +2401,66 @@ std::ostream& operator<<(std::ostream& os, const EntityType& type) {
   return os;
 }
 
+//===--------------------------------------------------------------------===//
+// AbortCauseType - String Utilities
+//===--------------------------------------------------------------------===//
+
+std::string AbortCauseTypeToString(AbortCauseType type) {
+  switch (type) {
+    case AbortCauseType::INVALID: {
+      return "INVALID";
+    }
+    case AbortCauseType::OWNERSHIP_CONFLICT: {
+      return "OWNERSHIP_CONFLICT";
+    }
+    case AbortCauseType::READ_TIMESTAMP: {
+      return "READ_TIMESTAMP";
+    }
+    case AbortCauseType::VISIBILITY: {
+      return "VISIBILITY";
+    }
+    case AbortCauseType::CONSTRAINT: {
+      return "CONSTRAINT";
+    }
+    case AbortCauseType::VALIDATION: {
+      return "VALIDATION";
+    }
+    default: {
+      throw ConversionException(StringUtil::Format(
+          "No string conversion for AbortCauseType value '%d'",
+          static_cast<int>(type)));
+    }
+  }
+  return "INVALID";
+}
+
+AbortCauseType StringToAbortCauseType(const std::string& str) {
+  std::string upper_str = StringUtil::Upper(str);
+  if (upper_str == "INVALID") {
+    return AbortCauseType::INVALID;
+  } else if (upper_str == "OWNERSHIP_CONFLICT") {
+    return AbortCauseType::OWNERSHIP_CONFLICT;
+  } else if (upper_str == "READ_TIMESTAMP") {
+    return AbortCauseType::READ_TIMESTAMP;
+  } else if (upper_str == "VISIBILITY") {
+    return AbortCauseType::VISIBILITY;
+  } else if (upper_str == "CONSTRAINT") {
+    return AbortCauseType::CONSTRAINT;
+  } else if (upper_str == "VALIDATION") {
+    return AbortCauseType::VALIDATION;
+  } else {
+    throw ConversionException(
+        StringUtil::Format("No AbortCauseType conversion from string '%s'",
+                           upper_str.c_str()));
+  }
+  return AbortCauseType::INVALID;
+}
+
+std::ostream& operator<<(std::ostream& os, const AbortCauseType& type) {
+  os << AbortCauseTypeToString(type);
+  return os;
+}
+
 //===--------------------------------------------------------------------===//
 // RWType - String Utilities
 //===--------------------------------------------------------------------===//
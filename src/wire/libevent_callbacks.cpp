@@ -15,6 +15,7 @@
 #include <unistd.h>
 #include "wire/libevent_server.h"
 #include "common/macros.h"
+#include "statistics/stats_aggregator.h"
 
 namespace peloton {
 namespace wire {
@@ -72,6 +73,28 @@ void EventHandler(UNUSED_ATTRIBUTE evutil_socket_t connfd, short ev_flags, void
   StateMachine(conn);
 }
 
+void MetricsRequestHandler(struct evhttp_request *req,
+                           UNUSED_ATTRIBUTE void *arg) {
+  if (evhttp_request_get_command(req) != EVHTTP_REQ_GET) {
+    evhttp_send_error(req, HTTP_BADMETHOD, nullptr);
+    return;
+  }
+
+  // The aggregator renders its stats once per interval, so a scrape neither
+  // waits for it nor runs a transaction
+  auto metrics = stats::StatsAggregator::GetInstance().GetExportedMetrics();
+  struct evbuffer *buf = evbuffer_new();
+  if (buf == nullptr) {
+    evhttp_send_error(req, HTTP_INTERNAL, nullptr);
+    return;
+  }
+  evbuffer_add(buf, metrics.data(), metrics.size());
+  evhttp_add_header(evhttp_request_get_output_headers(req), "Content-Type",
+                    "text/plain; version=0.0.4");
+  evhttp_send_reply(req, HTTP_OK, "OK", buf);
+  evbuffer_free(buf);
+}
+
 void StateMachine(LibeventSocket *conn) {
   bool done = false;
 
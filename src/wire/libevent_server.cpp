@@ -124,8 +124,29 @@ LibeventServer::LibeventServer() {
     LibeventServer::CreateNewConn(listen_fd, EV_READ | EV_PERSIST,
                                   master_thread.get(), CONN_LISTENING);
 
+    // Serve the statistics over HTTP on the same event base
+    struct evhttp *metrics_http = nullptr;
+    if (FLAGS_stats_port != 0 && FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      metrics_http = evhttp_new(base);
+      if (metrics_http == nullptr) {
+        throw ConnectionException("Couldn't create the statistics server");
+      }
+      evhttp_set_cb(metrics_http, "/metrics", MetricsRequestHandler, nullptr);
+      if (evhttp_bind_socket(metrics_http, "0.0.0.0", FLAGS_stats_port) < 0) {
+        throw ConnectionException("Failed to bind socket to statistics port: " +
+                                  std::to_string(FLAGS_stats_port));
+      }
+      LOG_INFO("Serving statistics on port %lu", FLAGS_stats_port);
+    } else if (FLAGS_stats_port != 0) {
+      LOG_WARN("Statistics are disabled, not serving them on port %lu",
+               FLAGS_stats_port);
+    }
+
     LOG_INFO("Listening on port %lu", port_);
     event_base_dispatch(base);
+    if (metrics_http != nullptr) {
+      evhttp_free(metrics_http);
+    }
     event_free(evstop);
     event_base_free(base);
   }
@@ -295,13 +295,27 @@ bool PacketManager::HardcodedExecuteFilter(std::string query_type) {
 
 // The Simple Query Protocol
 void PacketManager::ExecQueryMessage(InputPacket *pkt, const size_t thread_id) {
+  // the decoding of the message is counted to its first statement
+  stats::BackendStatsContext *stats_context = nullptr;
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats_context = stats::BackendStatsContext::GetInstance();
+    stats_context->StartPhase(QueryPhaseType::DECODE);
+  }
+
   std::string q_str;
   PacketGetString(pkt, pkt->len, q_str);
 
   std::vector<std::string> queries;
   boost::split(queries, q_str, boost::is_any_of(";"));
 
+  if (stats_context != nullptr) {
+    stats_context->EndPhase(QueryPhaseType::DECODE);
+  }
+
   if (queries.size() == 1) {
+    if (stats_context != nullptr) {
+      stats_context->CompleteStatementPhases();
+    }
     SendEmptyQueryResponse();
     SendReadyForQuery(txn_state_);
     return;
@@ -311,6 +325,9 @@ void PacketManager::ExecQueryMessage(InputPacket *pkt, const size_t thread_id) {
     // iterate till before the empty string after the last ';'
     if (query != queries.back()) {
       if (query.empty()) {
+        if (stats_context != nullptr) {
+          stats_context->CompleteStatementPhases();
+        }
         SendEmptyQueryResponse();
         SendReadyForQuery(NetworkTransactionStateType::IDLE);
         return;
@@ -328,11 +345,18 @@ void PacketManager::ExecQueryMessage(InputPacket *pkt, const size_t thread_id) {
 
       // check status
       if (status == ResultType::FAILURE) {
+        if (stats_context != nullptr) {
+          stats_context->CompleteStatementPhases();
+        }
         SendErrorResponse(
             {{NetworkMessageType::HUMAN_READABLE_ERROR, error_message}});
         break;
       }
 
+      if (stats_context != nullptr) {
+        stats_context->StartPhase(QueryPhaseType::ENCODE);
+      }
+
       // send the attribute names
       PutTupleDescriptor(tuple_descriptor);
 
@@ -341,6 +365,11 @@ void PacketManager::ExecQueryMessage(InputPacket *pkt, const size_t thread_id) {
 
       // TODO: should change to query_type
       CompleteCommand(query, rows_affected);
+
+      if (stats_context != nullptr) {
+        stats_context->EndPhase(QueryPhaseType::ENCODE);
+        stats_context->CompleteStatementPhases();
+      }
     } else if (queries.size() == 1) {
       // just a ';' sent
       SendEmptyQueryResponse();
@@ -391,6 +420,11 @@ void PacketManager::ExecParseMessage(InputPacket *pkt) {
 
   statement = traffic_cop_->PrepareStatement(statement_name, query_string,
                                              error_message);
+
+  // the statement is parsed and planned here, and bound and executed later
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->CompleteStatementPhases();
+  }
   if (statement.get() == nullptr) {
     skipped_stmt_ = true;
     SendErrorResponse(
@@ -534,9 +568,17 @@ void PacketManager::ExecBindMessage(InputPacket *pkt) {
 
   auto param_types = statement->GetParamTypes();
 
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->StartPhase(
+        QueryPhaseType::DECODE);
+  }
   auto val_buf_begin = pkt->Begin() + pkt->ptr;
   auto val_buf_len = ReadParamValue(pkt, num_params, param_types,
                                     bind_parameters, param_values, formats);
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->EndPhase(
+        QueryPhaseType::DECODE);
+  }
 
   int format_codes_number = PacketGetInt(pkt, 2);
   LOG_TRACE("format_codes_number: %d", format_codes_number);
@@ -818,12 +860,17 @@ void PacketManager::ExecExecuteMessage(InputPacket *pkt, const size_t thread_id)
       rows_affected, error_message,
       thread_id);
 
+  stats::BackendStatsContext *stats_context = nullptr;
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats_context = stats::BackendStatsContext::GetInstance();
+  }
+
   switch (status) {
     case ResultType::FAILURE:
       LOG_ERROR("Failed to execute: %s", error_message.c_str());
       SendErrorResponse(
           {{NetworkMessageType::HUMAN_READABLE_ERROR, error_message}});
-      return;
+      break;
     case ResultType::ABORTED:
       if (query_type != "ROLLBACK") {
         LOG_DEBUG("Failed to execute: Conflicting txn aborted");
@@ -832,14 +879,24 @@ void PacketManager::ExecExecuteMessage(InputPacket *pkt, const size_t thread_id)
                             SqlStateErrorCodeToString(
                                 SqlStateErrorCode::SERIALIZATION_ERROR)}});
       }
-      return;
+      break;
     default: {
+      if (stats_context != nullptr) {
+        stats_context->StartPhase(QueryPhaseType::ENCODE);
+      }
       auto tuple_descriptor = statement->GetTupleDescriptor();
       SendDataRows(results, tuple_descriptor.size(), rows_affected);
       CompleteCommand(query_type, rows_affected);
-      return;
+      if (stats_context != nullptr) {
+        stats_context->EndPhase(QueryPhaseType::ENCODE);
+      }
+      break;
     }
   }
+
+  if (stats_context != nullptr) {
+    stats_context->CompleteStatementPhases();
+  }
 }
 
 void PacketManager::ExecCloseMessage(InputPacket *pkt) {
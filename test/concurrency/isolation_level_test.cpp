@@ -24,7 +24,8 @@ namespace test {
 class IsolationLevelTests : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    ConcurrencyType::TIMESTAMP_ORDERING};
+    ConcurrencyType::TIMESTAMP_ORDERING, ConcurrencyType::OPTIMISTIC,
+    ConcurrencyType::SSI, ConcurrencyType::PARTITIONED};
 
 void DirtyWriteTest() {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
@@ -348,6 +349,31 @@ void ReadSkewTest() {
 // Look at the SSI paper (http://drkp.net/papers/ssi-vldb12.pdf).
 // This is an anomaly involving three transactions (one of them is a readonly
 // transaction).
+// Both transactions read the two tuples and update a different one. Either
+// update replaces a version the other transaction has read, so snapshot
+// isolation would commit both.
+void ReadWriteSkewTest() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TestingTransactionUtil::CreateTable());
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Read(1);
+    scheduler.Txn(1).Read(0);
+    scheduler.Txn(1).Read(1);
+    scheduler.Txn(0).Update(0, 1);
+    scheduler.Txn(1).Update(1, 1);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_FALSE(ResultType::SUCCESS == scheduler.schedules[0].txn_result &&
+                 ResultType::SUCCESS == scheduler.schedules[1].txn_result);
+  }
+}
+
 void SIAnomalyTest1() {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   std::unique_ptr<storage::DataTable> table(
@@ -389,6 +415,38 @@ void SIAnomalyTest1() {
   }
 }
 
+// Two transactions increment the same counter. Both read the old value
+// before either of them writes, so at most one of them can commit, and the
+// counter must count every committed increment.
+void LostUpdateTest() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TestingTransactionUtil::CreateTable());
+  {
+    TransactionScheduler scheduler(3, table.get(), &txn_manager);
+    scheduler.Txn(0).ReadStore(0, 1);
+    scheduler.Txn(1).ReadStore(0, 1);
+    scheduler.Txn(0).Update(0, TXN_STORED_VALUE);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Update(0, TXN_STORED_VALUE);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(2).Read(0);
+    scheduler.Txn(2).Commit();
+
+    scheduler.Run();
+    auto &schedules = scheduler.schedules;
+
+    EXPECT_FALSE(schedules[0].txn_result == ResultType::SUCCESS &&
+                 schedules[1].txn_result == ResultType::SUCCESS);
+
+    int committed = 0;
+    if (schedules[0].txn_result == ResultType::SUCCESS) committed++;
+    if (schedules[1].txn_result == ResultType::SUCCESS) committed++;
+    EXPECT_EQ(ResultType::SUCCESS, schedules[2].txn_result);
+    EXPECT_EQ(committed, schedules[2].results[0]);
+  }
+}
+
 TEST_F(IsolationLevelTests, SerializableTest) {
   for (auto test_type : TEST_TYPES) {
     concurrency::TransactionManagerFactory::Configure(
@@ -398,8 +456,10 @@ TEST_F(IsolationLevelTests, SerializableTest) {
     FuzzyReadTest();
     // WriteSkewTest();
     ReadSkewTest();
+    ReadWriteSkewTest();
     PhantomTest();
     SIAnomalyTest1();
+    LostUpdateTest();
   }
 }
 
@@ -26,7 +26,8 @@ namespace test {
 class MVCCTests : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    ConcurrencyType::TIMESTAMP_ORDERING};
+    ConcurrencyType::TIMESTAMP_ORDERING, ConcurrencyType::OPTIMISTIC,
+    ConcurrencyType::SSI, ConcurrencyType::PARTITIONED};
 
 TEST_F(MVCCTests, SingleThreadVersionChainTest) {
   LOG_INFO("SingleThreadVersionChainTest");
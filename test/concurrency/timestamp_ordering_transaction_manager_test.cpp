@@ -13,6 +13,8 @@
 
 #include "concurrency/testing_transaction_util.h"
 #include "common/harness.h"
+#include "configuration/configuration.h"
+#include "storage/tile_group.h"
 
 namespace peloton {
 
@@ -29,5 +31,131 @@ TEST_F(TimestampOrderingTransactionManagerTests, Test) {
   EXPECT_TRUE(true);
 }
 
+TEST_F(TimestampOrderingTransactionManagerTests, DeltaVersionsSnapshotTest) {
+  FLAGS_delta_versions = true;
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TestingTransactionUtil::CreateTable());
+
+  {
+    TransactionScheduler scheduler(5, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(1);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(2).Read(1);
+    scheduler.Txn(3).Update(0, 2);
+    scheduler.Txn(3).Commit();
+    // both snapshots are older than the tuple in the tuple slot
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Scan(0);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(2).Read(0);
+    scheduler.Txn(2).Scan(0);
+    scheduler.Txn(2).Commit();
+    scheduler.Txn(4).Read(0);
+    scheduler.Txn(4).Commit();
+
+    scheduler.Run();
+
+    for (auto &schedule : scheduler.schedules) {
+      EXPECT_EQ(ResultType::SUCCESS, schedule.txn_result);
+    }
+    // the read of key 1, the read of key 0 and the scan of all ten keys
+    EXPECT_EQ(12, scheduler.schedules[0].results.size());
+    EXPECT_EQ(12, scheduler.schedules[2].results.size());
+    for (auto result : scheduler.schedules[0].results) {
+      EXPECT_EQ(0, result);
+    }
+    EXPECT_EQ(1, scheduler.schedules[2].results[1]);
+    EXPECT_EQ(1, scheduler.schedules[2].results[2]);
+    EXPECT_EQ(2, scheduler.schedules[4].results[0]);
+  }
+
+  // the updates went into the tuple slot instead of new versions
+  auto tile_group_header = table->GetTileGroup(0)->GetHeader();
+  EXPECT_NE(nullptr, tile_group_header->GetUndoRecord(0));
+  EXPECT_TRUE(tile_group_header->GetPrevItemPointer(0).IsNull());
+
+  FLAGS_delta_versions = false;
+}
+
+TEST_F(TimestampOrderingTransactionManagerTests, DeltaVersionsAbortTest) {
+  FLAGS_delta_versions = true;
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TestingTransactionUtil::CreateTable());
+
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Update(0, 1);
+    scheduler.Txn(0).Update(0, 2);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Abort();
+    scheduler.Txn(1).Read(0);
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    // the txn reads its own update, and nobody else does
+    EXPECT_EQ(2, scheduler.schedules[0].results[0]);
+    EXPECT_EQ(0, scheduler.schedules[1].results[0]);
+  }
+
+  {
+    // a txn that updates a tuple in place and then deletes it
+    TransactionScheduler scheduler(3, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(1);
+    scheduler.Txn(1).Update(0, 3);
+    scheduler.Txn(1).Delete(0);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(2).Read(0);
+    scheduler.Txn(2).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[2].txn_result);
+    EXPECT_EQ(0, scheduler.schedules[0].results[1]);
+    EXPECT_EQ(-1, scheduler.schedules[2].results[0]);
+  }
+
+  FLAGS_delta_versions = false;
+}
+
+TEST_F(TimestampOrderingTransactionManagerTests, DeltaVersionsConflictTest) {
+  FLAGS_delta_versions = true;
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TestingTransactionUtil::CreateTable());
+
+  {
+    // a txn must not update a tuple that was updated in place after it began
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(1);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Update(0, 2);
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+  }
+
+  FLAGS_delta_versions = false;
+}
+
 }  // End test namespace
 }  // End peloton namespace
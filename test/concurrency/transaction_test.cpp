@@ -25,7 +25,10 @@ namespace test {
 class TransactionTests : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    ConcurrencyType::TIMESTAMP_ORDERING
+    ConcurrencyType::TIMESTAMP_ORDERING,
+    ConcurrencyType::OPTIMISTIC,
+    ConcurrencyType::SSI,
+    ConcurrencyType::PARTITIONED
 };
 
 void TransactionTest(concurrency::TransactionManager *txn_manager,
@@ -230,5 +233,145 @@ TEST_F(TransactionTests, AbortTest) {
   }
 }
 
+TEST_F(TransactionTests, WaitOnConflictTest) {
+  for (auto test_type : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(
+        test_type, IsolationLevelType::FULL, ConflictAvoidanceType::WAIT);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    std::unique_ptr<storage::DataTable> table(
+        TestingTransactionUtil::CreateTable());
+
+    // Increment a hot counter concurrently
+    const int num_txn = 8;
+    {
+      TransactionScheduler scheduler(num_txn, table.get(), &txn_manager);
+      scheduler.SetConcurrent(true);
+      for (int i = 0; i < num_txn; i++) {
+        scheduler.Txn(i).ReadStore(0, 1);
+        scheduler.Txn(i).Update(0, TXN_STORED_VALUE);
+        scheduler.Txn(i).Commit();
+      }
+
+      scheduler.Run();
+
+      int committed = 0;
+      for (auto &schedule : scheduler.schedules) {
+        if (schedule.txn_result == ResultType::SUCCESS) {
+          committed++;
+        }
+      }
+      EXPECT_LE(1, committed);
+
+      // Waiting must not lose any increment
+      TransactionScheduler reader(1, table.get(), &txn_manager);
+      reader.Txn(0).Read(0);
+      reader.Txn(0).Commit();
+
+      reader.Run();
+
+      EXPECT_EQ(ResultType::SUCCESS, reader.schedules[0].txn_result);
+      EXPECT_EQ(committed, reader.schedules[0].results[0]);
+    }
+  }
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
+TEST_F(TransactionTests, SinglePartitionTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::PARTITIONED);
+  auto &partitioned_manager =
+      concurrency::PartitionedTransactionManager::GetInstance();
+  partitioned_manager.SetPartitionCount(2);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TestingTransactionUtil::CreateTable());
+  table->SetPartitionColumn(0);
+
+  // A key that lives in the other partition than key 0
+  auto key = type::ValueFactory::GetIntegerValue(0);
+  int other_id = 1;
+  while (partitioned_manager.GetPartitionId(
+             type::ValueFactory::GetIntegerValue(other_id)) ==
+         partitioned_manager.GetPartitionId(key)) {
+    other_id++;
+  }
+
+  // Single-partition transactions on different partitions run side by side
+  auto txn = txn_manager.BeginSinglePartitionTransaction(key);
+  auto other_txn = txn_manager.BeginSinglePartitionTransaction(
+      type::ValueFactory::GetIntegerValue(other_id));
+  EXPECT_TRUE(txn->IsSinglePartition());
+  EXPECT_EQ(partitioned_manager.GetPartitionId(key), txn->GetPartitionId());
+
+  int result = -1;
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table.get(), 0, result));
+  EXPECT_EQ(0, result);
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table.get(), 0, 100));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(other_txn, table.get(),
+                                                    other_id, 100));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(other_txn));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // A multi-partition transaction sees both updates
+  auto multi_txn = txn_manager.BeginTransaction();
+  EXPECT_FALSE(multi_txn->IsSinglePartition());
+  EXPECT_TRUE(
+      TestingTransactionUtil::ExecuteRead(multi_txn, table.get(), 0, result));
+  EXPECT_EQ(100, result);
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(multi_txn, table.get(),
+                                                  other_id, result));
+  EXPECT_EQ(100, result);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(multi_txn));
+
+  partitioned_manager.SetPartitionCount(1);
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
+TEST_F(TransactionTests, UnpartitionedTableOwnershipTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::PARTITIONED);
+  auto &partitioned_manager =
+      concurrency::PartitionedTransactionManager::GetInstance();
+  partitioned_manager.SetPartitionCount(2);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TestingTransactionUtil::CreateTable());
+
+  auto key = type::ValueFactory::GetIntegerValue(0);
+  int other_id = 1;
+  while (partitioned_manager.GetPartitionId(
+             type::ValueFactory::GetIntegerValue(other_id)) ==
+         partitioned_manager.GetPartitionId(key)) {
+    other_id++;
+  }
+
+  auto txn = txn_manager.BeginSinglePartitionTransaction(key);
+  auto other_txn = txn_manager.BeginSinglePartitionTransaction(
+      type::ValueFactory::GetIntegerValue(other_id));
+
+  // Both transactions find the row of the unpartitioned table free ...
+  auto tile_group = table->GetTileGroup(0);
+  auto tile_group_header = tile_group->GetHeader();
+  EXPECT_TRUE(txn_manager.IsOwnable(txn, tile_group_header, 0));
+  EXPECT_TRUE(txn_manager.IsOwnable(other_txn, tile_group_header, 0));
+
+  // ... but only one of them gets to own it
+  bool owned = txn_manager.AcquireOwnership(txn, tile_group_header, 0);
+  bool other_owned =
+      txn_manager.AcquireOwnership(other_txn, tile_group_header, 0);
+  EXPECT_TRUE(owned != other_owned);
+
+  txn_manager.YieldOwnership(owned ? txn : other_txn,
+                             tile_group->GetTileGroupId(), 0);
+  txn_manager.AbortTransaction(other_txn);
+  txn_manager.AbortTransaction(txn);
+
+  partitioned_manager.SetPartitionCount(1);
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_bloom_filter_test.cpp
+//
+// Identification: test/executor/join_bloom_filter_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <set>
+
+#include "common/harness.h"
+#include "executor/testing_executor_util.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/join_bloom_filter.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Join Bloom Filter Tests
+//===--------------------------------------------------------------------===//
+
+class JoinBloomFilterTests : public PelotonTest {};
+
+// Hash a single column key the way the hash join does
+static size_t GetKeyHash(const type::Value &value) {
+  size_t seed = 0;
+  value.HashCombine(seed);
+  return seed;
+}
+
+TEST_F(JoinBloomFilterTests, FilterTest) {
+  const size_t key_count = 1000;
+  executor::JoinBloomFilter bloom_filter(key_count);
+
+  for (size_t key = 0; key < key_count; key++) {
+    bloom_filter.Insert(GetKeyHash(type::ValueFactory::GetBigIntValue(key)));
+  }
+
+  // No false negatives
+  for (size_t key = 0; key < key_count; key++) {
+    EXPECT_TRUE(bloom_filter.MayContain(
+        GetKeyHash(type::ValueFactory::GetBigIntValue(key))));
+  }
+
+  // Few false positives
+  size_t false_positive_count = 0;
+  for (size_t key = key_count; key < key_count * 2; key++) {
+    if (bloom_filter.MayContain(
+            GetKeyHash(type::ValueFactory::GetBigIntValue(key)))) {
+      false_positive_count++;
+    }
+  }
+  EXPECT_LT(false_positive_count, key_count / 10);
+}
+
+TEST_F(JoinBloomFilterTests, ScanPushDownTest) {
+  const size_t tuples_per_tile_group = 5;
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(tuples_per_tile_group, false));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table.get(), tuples_per_tile_group * 3,
+                                     false, false, false, txn);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // Build side with the keys 20 and 70 on the first column
+  executor::JoinBloomFilter bloom_filter(2);
+  bloom_filter.Insert(GetKeyHash(type::ValueFactory::GetIntegerValue(20)));
+  bloom_filter.Insert(GetKeyHash(type::ValueFactory::GetIntegerValue(70)));
+
+  // The key is the second output column of the scan
+  std::vector<oid_t> column_ids({1, 0});
+  planner::SeqScanPlan node(table.get(), nullptr, column_ids);
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+  executor.SetBloomFilter(&bloom_filter, {1});
+
+  std::set<int> result;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      result.insert(result_tile->GetValue(tuple_id, 1).GetAs<int32_t>());
+    }
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_EQ(1U, result.count(20));
+  EXPECT_EQ(1U, result.count(70));
+  EXPECT_LT(result.size(), tuples_per_tile_group * 3);
+}
+
+}  // End test namespace
+}  // End peloton namespace
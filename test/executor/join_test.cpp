@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <memory>
 
 #include "executor/testing_executor_util.h"
@@ -80,6 +81,7 @@ std::vector<JoinType> join_types = {JoinType::INNER, JoinType::LEFT,
 void ExecuteJoinTest(PlanNodeType join_algorithm, JoinType join_type,
                      oid_t join_test_type);
 void ExecuteNestedLoopJoinTest(JoinType join_type);
+void ExecuteBatchedNestedLoopJoinTest(oid_t right_index_offset);
 
 void PopulateTable(storage::DataTable *table, int num_rows, bool random,
                    concurrency::Transaction *current_txn);
@@ -219,6 +221,13 @@ TEST_F(JoinTests, BasicNestedLoopTest) {
   ExecuteNestedLoopJoinTest(JoinType::INNER);
 }
 
+TEST_F(JoinTests, BatchedNestedLoopTest) {
+  // The primary key index takes all the keys of a left tile at once
+  ExecuteBatchedNestedLoopJoinTest(0);
+  // The index on (A, B) is looked up key by key
+  ExecuteBatchedNestedLoopJoinTest(1);
+}
+
 void PopulateTable(storage::DataTable *table, int num_rows, bool random,
                    concurrency::Transaction *current_txn) {
   // Random values
@@ -422,6 +431,109 @@ void ExecuteNestedLoopJoinTest(JoinType join_type) {
   txn_manager.CommitTransaction(txn);
 }
 
+void ExecuteBatchedNestedLoopJoinTest(oid_t right_index_offset) {
+  size_t tile_group_size = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  // Left table has 1 tile group (5 tuples)
+  std::unique_ptr<storage::DataTable> left_table(
+      TestingExecutorUtil::CreateTable(tile_group_size));
+  TestingExecutorUtil::PopulateTable(left_table.get(), tile_group_size, false,
+                                     false, false, txn);
+
+  // Right table has 2 tile groups (10 tuples), A = 0, 10, ..., 90
+  std::unique_ptr<storage::DataTable> right_table(
+      TestingExecutorUtil::CreateTable(tile_group_size));
+  TestingExecutorUtil::PopulateTable(right_table.get(), tile_group_size * 2,
+                                     false, false, false, txn);
+
+  txn_manager.CommitTransaction(txn);
+
+  // Left A: a duplicate key, a key without a match and a null key
+  std::vector<type::Value> left_keys = {
+      type::ValueFactory::GetIntegerValue(10),
+      type::ValueFactory::GetIntegerValue(10),
+      type::ValueFactory::GetIntegerValue(55),
+      type::ValueFactory::GetNullValueByType(type::Type::INTEGER),
+      type::ValueFactory::GetIntegerValue(90)};
+  auto left_tile = left_table->GetTileGroup(0)->GetTile(0);
+  for (oid_t tuple_itr = 0; tuple_itr < left_keys.size(); tuple_itr++) {
+    left_tile->SetValue(left_keys[tuple_itr], tuple_itr, 0);
+  }
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  MockExecutor left_table_scan_executor;
+  std::vector<std::unique_ptr<executor::LogicalTile>>
+      left_table_logical_tile_ptrs;
+  left_table_logical_tile_ptrs.emplace_back(
+      executor::LogicalTileFactory::WrapTileGroup(
+          left_table->GetTileGroup(0)));
+  EXPECT_CALL(left_table_scan_executor, DInit()).WillOnce(Return(true));
+  ExpectNormalTileResults(1, &left_table_scan_executor,
+                          left_table_logical_tile_ptrs);
+
+  // Right ATTR 0 = ?
+  std::vector<oid_t> key_column_ids_right = {0};
+  std::vector<ExpressionType> expr_types_right = {
+      ExpressionType::COMPARE_EQUAL};
+  std::vector<type::Value> values_right = {
+      type::ValueFactory::GetParameterOffsetValue(0).Copy()};
+  std::vector<expression::AbstractExpression *> runtime_keys_right;
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc_right(
+      right_table->GetIndex(right_index_offset), key_column_ids_right,
+      expr_types_right, values_right, runtime_keys_right);
+
+  std::vector<oid_t> column_ids_right({0, 1});
+  planner::IndexScanPlan right_table_node(right_table.get(), nullptr,
+                                          column_ids_right,
+                                          index_scan_desc_right);
+  executor::IndexScanExecutor right_table_scan_executor(&right_table_node,
+                                                        context.get());
+
+  // LEFT.A = RIGHT.A
+  std::unique_ptr<const expression::AbstractExpression> predicate(
+      new expression::ComparisonExpression(
+          ExpressionType::COMPARE_EQUAL,
+          new expression::TupleValueExpression(type::Type::INTEGER, 0, 0),
+          new expression::TupleValueExpression(type::Type::INTEGER, 1, 0)));
+  std::vector<oid_t> join_column_ids_left = {0};
+  std::vector<oid_t> join_column_ids_right = {0};
+  auto schema = CreateJoinSchema();
+  planner::NestedLoopJoinPlan nested_loop_join_node(
+      JoinType::INNER, std::move(predicate),
+      TestingJoinUtil::CreateProjection(), schema, join_column_ids_left,
+      join_column_ids_right);
+
+  executor::NestedLoopJoinExecutor nested_loop_join_executor(
+      &nested_loop_join_node, context.get());
+  nested_loop_join_executor.AddChild(&left_table_scan_executor);
+  nested_loop_join_executor.AddChild(&right_table_scan_executor);
+
+  // Both left rows with A = 10 find their match, and so does A = 90
+  std::vector<int> result_keys;
+  EXPECT_TRUE(nested_loop_join_executor.Init());
+  while (nested_loop_join_executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> result_logical_tile(
+        nested_loop_join_executor.GetOutput());
+    for (auto tuple_id : *result_logical_tile) {
+      // Output column 2 is RIGHT.A and column 3 is LEFT.A
+      auto right_key = result_logical_tile->GetValue(tuple_id, 2);
+      auto left_key = result_logical_tile->GetValue(tuple_id, 3);
+      EXPECT_EQ(type::CMP_TRUE, left_key.CompareEquals(right_key));
+      result_keys.push_back(left_key.GetAs<int>());
+    }
+  }
+  std::sort(result_keys.begin(), result_keys.end());
+  EXPECT_EQ(std::vector<int>({10, 10, 90}), result_keys);
+
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+}
+
 void ExecuteJoinTest(PlanNodeType join_algorithm, JoinType join_type,
                      oid_t join_test_type) {
   //===--------------------------------------------------------------------===//
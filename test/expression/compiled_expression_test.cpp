@@ -0,0 +1,237 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression_test.cpp
+//
+// Identification: test/expression/compiled_expression_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/container_tuple.h"
+#include "expression/compiled_expression.h"
+#include "expression/expression_util.h"
+#include "type/value.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Compiled Expression Tests
+//===--------------------------------------------------------------------===//
+
+typedef std::unique_ptr<expression::AbstractExpression> ExpPtr;
+
+class CompiledExpressionTests : public PelotonTest {};
+
+// The compiled expression must give what the tree gives
+static void CheckSameResult(const expression::AbstractExpression *expr,
+                            const expression::CompiledExpression *compiled,
+                            std::vector<type::Value> &row) {
+  expression::ContainerTuple<std::vector<type::Value>> tuple(&row);
+  auto expected = expr->Evaluate(&tuple, nullptr, nullptr);
+  auto actual = compiled->Evaluate(&tuple, nullptr, nullptr);
+  EXPECT_EQ(expected.GetTypeId(), actual.GetTypeId());
+  EXPECT_EQ(expected.IsNull(), actual.IsNull());
+  if (expected.IsNull() == false && actual.IsNull() == false) {
+    EXPECT_EQ(type::CMP_TRUE, expected.CompareEquals(actual));
+  }
+  if (expected.GetTypeId() == type::Type::BOOLEAN) {
+    EXPECT_EQ(expected.IsTrue(),
+              compiled->EvaluatePredicate(&tuple, nullptr, nullptr));
+  }
+}
+
+TEST_F(CompiledExpressionTests, PredicateTest) {
+  // a + b * 2 > 10 AND (c / 2.0 < 4 OR NOT a = b)
+  ExpPtr expr(expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_AND,
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_GREATERTHAN,
+          expression::ExpressionUtil::OperatorFactory(
+              ExpressionType::OPERATOR_PLUS, type::Type::INTEGER,
+              expression::ExpressionUtil::TupleValueFactory(
+                  type::Type::INTEGER, 0, 0),
+              expression::ExpressionUtil::OperatorFactory(
+                  ExpressionType::OPERATOR_MULTIPLY, type::Type::INTEGER,
+                  expression::ExpressionUtil::TupleValueFactory(
+                      type::Type::INTEGER, 0, 1),
+                  expression::ExpressionUtil::ConstantValueFactory(
+                      type::ValueFactory::GetIntegerValue(2)))),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(10))),
+      expression::ExpressionUtil::ConjunctionFactory(
+          ExpressionType::CONJUNCTION_OR,
+          expression::ExpressionUtil::ComparisonFactory(
+              ExpressionType::COMPARE_LESSTHAN,
+              expression::ExpressionUtil::OperatorFactory(
+                  ExpressionType::OPERATOR_DIVIDE, type::Type::DECIMAL,
+                  expression::ExpressionUtil::TupleValueFactory(
+                      type::Type::BIGINT, 0, 2),
+                  expression::ExpressionUtil::ConstantValueFactory(
+                      type::ValueFactory::GetDecimalValue(2.0))),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  type::ValueFactory::GetIntegerValue(4))),
+          expression::ExpressionUtil::OperatorFactory(
+              ExpressionType::OPERATOR_NOT, type::Type::BOOLEAN,
+              expression::ExpressionUtil::ComparisonFactory(
+                  ExpressionType::COMPARE_EQUAL,
+                  expression::ExpressionUtil::TupleValueFactory(
+                      type::Type::INTEGER, 0, 0),
+                  expression::ExpressionUtil::TupleValueFactory(
+                      type::Type::INTEGER, 0, 1)),
+              nullptr))));
+
+  auto compiled = expression::CompiledExpression::Compile(expr.get());
+  ASSERT_TRUE(compiled != nullptr);
+  EXPECT_TRUE(compiled->IsCompiled());
+
+  auto null_integer =
+      type::ValueFactory::GetNullValueByType(type::Type::INTEGER);
+  auto null_bigint = type::ValueFactory::GetNullValueByType(type::Type::BIGINT);
+  std::vector<std::vector<type::Value>> rows;
+  for (int a = -2; a <= 12; a += 2) {
+    for (int b = 0; b <= 6; b += 3) {
+      for (int64_t c = 0; c <= 12; c += 6) {
+        rows.push_back({type::ValueFactory::GetIntegerValue(a),
+                        type::ValueFactory::GetIntegerValue(b),
+                        type::ValueFactory::GetBigIntValue(c)});
+      }
+    }
+  }
+  // Nulls on either side of the conjunctions
+  rows.push_back({null_integer, type::ValueFactory::GetIntegerValue(1),
+                  type::ValueFactory::GetBigIntValue(1)});
+  rows.push_back({type::ValueFactory::GetIntegerValue(20),
+                  type::ValueFactory::GetIntegerValue(1), null_bigint});
+  rows.push_back({type::ValueFactory::GetIntegerValue(20),
+                  type::ValueFactory::GetIntegerValue(20), null_bigint});
+  rows.push_back({type::ValueFactory::GetIntegerValue(0),
+                  type::ValueFactory::GetIntegerValue(0), null_bigint});
+
+  for (auto &row : rows) {
+    CheckSameResult(expr.get(), compiled.get(), row);
+  }
+}
+
+TEST_F(CompiledExpressionTests, ConstantFoldingTest) {
+  // (1 + 2) * 3 = a only loads a and compares
+  ExpPtr expr(expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_EQUAL,
+      expression::ExpressionUtil::OperatorFactory(
+          ExpressionType::OPERATOR_MULTIPLY, type::Type::INTEGER,
+          expression::ExpressionUtil::OperatorFactory(
+              ExpressionType::OPERATOR_PLUS, type::Type::INTEGER,
+              expression::ExpressionUtil::ConstantValueFactory(
+                  type::ValueFactory::GetIntegerValue(1)),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  type::ValueFactory::GetIntegerValue(2))),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(3))),
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0,
+                                                    0)));
+  auto compiled = expression::CompiledExpression::Compile(expr.get());
+  EXPECT_TRUE(compiled->IsCompiled());
+  EXPECT_EQ(2, compiled->GetInstructionCount());
+
+  std::vector<type::Value> row = {type::ValueFactory::GetIntegerValue(9)};
+  expression::ContainerTuple<std::vector<type::Value>> tuple(&row);
+  EXPECT_TRUE(compiled->EvaluatePredicate(&tuple, nullptr, nullptr));
+
+  // 1 > 2 AND a = 9 is false whatever a is
+  ExpPtr false_expr(expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_AND,
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_GREATERTHAN,
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(1)),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(2))),
+      expr->Copy()));
+  auto false_compiled =
+      expression::CompiledExpression::Compile(false_expr.get());
+  EXPECT_TRUE(false_compiled->IsCompiled());
+  EXPECT_EQ(0, false_compiled->GetInstructionCount());
+  EXPECT_FALSE(false_compiled->EvaluatePredicate(&tuple, nullptr, nullptr));
+}
+
+TEST_F(CompiledExpressionTests, ErrorTest) {
+  // a / b and a + b on integers
+  ExpPtr divide_expr(expression::ExpressionUtil::OperatorFactory(
+      ExpressionType::OPERATOR_DIVIDE, type::Type::INTEGER,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 0),
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0,
+                                                    1)));
+  ExpPtr add_expr(expression::ExpressionUtil::OperatorFactory(
+      ExpressionType::OPERATOR_PLUS, type::Type::INTEGER,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 0),
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0,
+                                                    1)));
+  auto divide_compiled =
+      expression::CompiledExpression::Compile(divide_expr.get());
+  auto add_compiled = expression::CompiledExpression::Compile(add_expr.get());
+
+  std::vector<type::Value> row = {
+      type::ValueFactory::GetIntegerValue(type::PELOTON_INT32_MAX),
+      type::ValueFactory::GetIntegerValue(0)};
+  expression::ContainerTuple<std::vector<type::Value>> tuple(&row);
+  EXPECT_THROW(divide_compiled->Evaluate(&tuple, nullptr, nullptr), Exception);
+  CheckSameResult(add_expr.get(), add_compiled.get(), row);
+
+  row[1] = type::ValueFactory::GetIntegerValue(1);
+  EXPECT_THROW(add_compiled->Evaluate(&tuple, nullptr, nullptr), Exception);
+  CheckSameResult(divide_expr.get(), divide_compiled.get(), row);
+
+  // A constant error is raised when there is a tuple, not when compiling
+  ExpPtr constant_expr(expression::ExpressionUtil::OperatorFactory(
+      ExpressionType::OPERATOR_DIVIDE, type::Type::INTEGER,
+      expression::ExpressionUtil::ConstantValueFactory(
+          type::ValueFactory::GetIntegerValue(1)),
+      expression::ExpressionUtil::ConstantValueFactory(
+          type::ValueFactory::GetIntegerValue(0))));
+  auto constant_compiled =
+      expression::CompiledExpression::Compile(constant_expr.get());
+  EXPECT_TRUE(constant_compiled->IsCompiled());
+  EXPECT_THROW(constant_compiled->Evaluate(&tuple, nullptr, nullptr),
+               Exception);
+}
+
+TEST_F(CompiledExpressionTests, FallbackTest) {
+  // Strings stay with the tree
+  ExpPtr string_expr(expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_EQUAL,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::VARCHAR, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          type::ValueFactory::GetVarcharValue("peloton"))));
+  auto string_compiled =
+      expression::CompiledExpression::Compile(string_expr.get());
+  EXPECT_FALSE(string_compiled->IsCompiled());
+
+  std::vector<type::Value> row = {
+      type::ValueFactory::GetVarcharValue("peloton")};
+  CheckSameResult(string_expr.get(), string_compiled.get(), row);
+
+  // So do the tuples whose column is not of the type compiled for
+  ExpPtr integer_expr(expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          type::ValueFactory::GetIntegerValue(10))));
+  auto integer_compiled =
+      expression::CompiledExpression::Compile(integer_expr.get());
+  EXPECT_TRUE(integer_compiled->IsCompiled());
+
+  row = {type::ValueFactory::GetBigIntValue(5)};
+  CheckSameResult(integer_expr.get(), integer_compiled.get(), row);
+}
+
+}  // End test namespace
+}  // End peloton namespace
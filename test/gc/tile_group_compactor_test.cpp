@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor_test.cpp
+//
+// Identification: test/gc/tile_group_compactor_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "concurrency/testing_transaction_util.h"
+#include "gc/tile_group_compactor.h"
+
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tile_group_iterator.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupCompactorTests : public PelotonTest {};
+
+// count the latest versions of tuples stored in a tile group
+static int LiveTupleCount(storage::TileGroup *tile_group) {
+  auto tile_group_header = tile_group->GetHeader();
+  int live_count = 0;
+  for (oid_t tuple_id = 0; tuple_id < tile_group->GetNextTupleSlot();
+       tuple_id++) {
+    if (tile_group_header->GetTransactionId(tuple_id) == INITIAL_TXN_ID &&
+        tile_group_header->GetEndCommitId(tuple_id) == MAX_CID) {
+      live_count++;
+    }
+  }
+  return live_count;
+}
+
+TEST_F(TileGroupCompactorTests, MoveTuplesTest) {
+  // 100 tuples per tile group, so that the keys [0, 100) fill the first one
+  const int num_key = 250;
+  std::unique_ptr<storage::DataTable> table(
+      TestingTransactionUtil::CreateTable(num_key));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto first_tile_group = table->GetTileGroup(0);
+  auto second_tile_group = table->GetTileGroup(1);
+  EXPECT_EQ(100, LiveTupleCount(first_tile_group.get()));
+
+  // Delete most of the first tile group
+  auto txn = txn_manager.BeginTransaction();
+  for (int id = 0; id < 90; id++) {
+    EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table.get(), id));
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  EXPECT_EQ(10, LiveTupleCount(first_tile_group.get()));
+
+  gc::TileGroupCompactor tile_group_compactor;
+  tile_group_compactor.SetOccupancyThreshold(0.2);
+
+  // Old versions are never reclaimed without the GC, so nothing is dropped
+  EXPECT_EQ(0U, tile_group_compactor.CompactTable(table.get()));
+
+  EXPECT_TRUE(first_tile_group->GetHeader()->IsCompacting());
+  EXPECT_FALSE(second_tile_group->GetHeader()->IsCompacting());
+  EXPECT_EQ(0, LiveTupleCount(first_tile_group.get()));
+  EXPECT_EQ(100, LiveTupleCount(second_tile_group.get()));
+
+  // Moved tuples are still reachable through the index
+  txn = txn_manager.BeginTransaction();
+  for (int id = 0; id < num_key; id++) {
+    int result;
+    TestingTransactionUtil::ExecuteRead(txn, table.get(), id, result);
+    EXPECT_EQ((id < 90) ? -1 : 0, result);
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+}
+
+TEST_F(TileGroupCompactorTests, DropTileGroupTest) {
+  const int num_key = 250;
+  std::unique_ptr<storage::DataTable> table(
+      TestingTransactionUtil::CreateTable(num_key));
+
+  auto tile_group_count = table->GetTileGroupCount();
+  auto tile_group_id = table->GetTileGroup(0)->GetTileGroupId();
+
+  EXPECT_TRUE(table->DropTileGroup(tile_group_id));
+  EXPECT_FALSE(table->DropTileGroup(tile_group_id));
+
+  // Offsets are stable, the dropped tile group leaves a hole
+  EXPECT_EQ(tile_group_count, table->GetTileGroupCount());
+  EXPECT_TRUE(table->GetTileGroup(0) == nullptr);
+  EXPECT_TRUE(table->GetTileGroupById(tile_group_id) == nullptr);
+  EXPECT_TRUE(table->GetTileGroup(1) != nullptr);
+
+  storage::TileGroupIterator tile_group_itr(table.get());
+  std::shared_ptr<storage::TileGroup> tile_group_ptr;
+  size_t visited_count = 0;
+  while (tile_group_itr.Next(tile_group_ptr)) {
+    EXPECT_NE(tile_group_id, tile_group_ptr->GetTileGroupId());
+    visited_count++;
+  }
+  EXPECT_EQ(tile_group_count - 1, visited_count);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -50,6 +50,10 @@ class TestingIndexUtil {
 
   static void NonUniqueKeyMultiThreadedStressTest2(const IndexType index_type);
 
+  static void ScanKeyBatchTest(const IndexType index_type);
+
+  static void UniqueLongStringKeyTest(const IndexType index_type);
+
   //===--------------------------------------------------------------------===//
   // Utility Methods
   //===--------------------------------------------------------------------===//
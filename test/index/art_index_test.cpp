@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// art_index_test.cpp
+//
+// Identification: test/index/art_index_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "gtest/gtest.h"
+
+#include "index/testing_index_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// ART Index Tests
+//===--------------------------------------------------------------------===//
+
+class ARTIndexTests : public PelotonTest {};
+
+TEST_F(ARTIndexTests, BasicTest) {
+  TestingIndexUtil::BasicTest(IndexType::ART);
+}
+
+TEST_F(ARTIndexTests, MultiMapInsertTest) {
+  TestingIndexUtil::MultiMapInsertTest(IndexType::ART);
+}
+
+TEST_F(ARTIndexTests, UniqueKeyInsertTest) {
+  TestingIndexUtil::UniqueKeyInsertTest(IndexType::ART);
+}
+
+TEST_F(ARTIndexTests, NonUniqueKeyDeleteTest) {
+  TestingIndexUtil::NonUniqueKeyDeleteTest(IndexType::ART);
+}
+
+TEST_F(ARTIndexTests, MultiThreadedInsertTest) {
+  TestingIndexUtil::MultiThreadedInsertTest(IndexType::ART);
+}
+
+TEST_F(ARTIndexTests, NonUniqueKeyMultiThreadedTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedTest(IndexType::ART);
+}
+
+TEST_F(ARTIndexTests, NonUniqueKeyMultiThreadedStressTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest(IndexType::ART);
+}
+
+TEST_F(ARTIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::ART);
+}
+
+TEST_F(ARTIndexTests, ScanKeyBatchTest) {
+  TestingIndexUtil::ScanKeyBatchTest(IndexType::ART);
+}
+
+TEST_F(ARTIndexTests, UniqueLongStringKeyTest) {
+  TestingIndexUtil::UniqueLongStringKeyTest(IndexType::ART);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -65,5 +65,13 @@ TEST_F(BwTreeIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
   TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::BWTREE);
 }
 
+TEST_F(BwTreeIndexTests, ScanKeyBatchTest) {
+  TestingIndexUtil::ScanKeyBatchTest(IndexType::BWTREE);
+}
+
+TEST_F(BwTreeIndexTests, UniqueLongStringKeyTest) {
+  TestingIndexUtil::UniqueLongStringKeyTest(IndexType::BWTREE);
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,155 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// normalized_key_test.cpp
+//
+// Identification: test/index/normalized_key_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "gtest/gtest.h"
+
+#include "catalog/schema.h"
+#include "index/normalized_key.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Normalized Key Tests
+//===--------------------------------------------------------------------===//
+
+class NormalizedKeyTests : public PelotonTest {};
+
+// The order of two key tuples, compared column by column
+static int CompareValues(const storage::Tuple &lhs,
+                         const storage::Tuple &rhs) {
+  for (oid_t column_id = 0; column_id < lhs.GetSchema()->GetColumnCount();
+       column_id++) {
+    type::Value lhs_value = lhs.GetValue(column_id);
+    type::Value rhs_value = rhs.GetValue(column_id);
+    if (lhs_value.CompareLessThan(rhs_value) == type::CMP_TRUE) return -1;
+    if (lhs_value.CompareGreaterThan(rhs_value) == type::CMP_TRUE) return 1;
+  }
+  return 0;
+}
+
+static int Sign(int value) { return (value > 0) - (value < 0); }
+
+TEST_F(NormalizedKeyTests, OrderTest) {
+  // (VARCHAR(32), INTEGER, DECIMAL)
+  std::unique_ptr<catalog::Schema> key_schema(new catalog::Schema(
+      {catalog::Column(type::Type::VARCHAR, 32, "A", false),
+       catalog::Column(type::Type::INTEGER,
+                       type::Type::GetTypeSize(type::Type::INTEGER), "B",
+                       true),
+       catalog::Column(type::Type::DECIMAL,
+                       type::Type::GetTypeSize(type::Type::DECIMAL), "C",
+                       true)}));
+  EXPECT_EQ(34 + 4 + 8, index::NormalizedKeyUtil::GetMaxKeySize(
+                            key_schema.get()));
+
+  std::vector<std::string> strings = {"", "a", "ab", "abc", "b", "ba", "z"};
+  std::vector<int32_t> integers = {type::PELOTON_INT32_MIN + 1, -7, -1, 0, 1,
+                                   255, 256, type::PELOTON_INT32_MAX};
+  std::vector<double> decimals = {-1e10, -2.5, -0.0, 0.0, 1e-10, 2.5, 1e10};
+
+  std::vector<std::unique_ptr<storage::Tuple>> tuples;
+  for (auto &string : strings) {
+    for (auto integer : integers) {
+      for (auto decimal : decimals) {
+        std::unique_ptr<storage::Tuple> tuple(
+            new storage::Tuple(key_schema.get(), true));
+        tuple->SetValue(0, type::ValueFactory::GetVarcharValue(string),
+                        nullptr);
+        tuple->SetValue(1, type::ValueFactory::GetIntegerValue(integer),
+                        nullptr);
+        tuple->SetValue(2, type::ValueFactory::GetDecimalValue(decimal),
+                        nullptr);
+        tuples.push_back(std::move(tuple));
+      }
+    }
+  }
+
+  std::vector<index::NormalizedKey<64>> keys(tuples.size());
+  for (size_t i = 0; i < tuples.size(); i++) {
+    keys[i].SetFromKey(tuples[i].get());
+  }
+
+  // memcmp() on the keys must agree with the values
+  for (size_t i = 0; i < tuples.size(); i++) {
+    for (size_t j = 0; j < tuples.size(); j++) {
+      EXPECT_EQ(CompareValues(*tuples[i], *tuples[j]),
+                Sign(index::NormalizedKey<64>::Compare(keys[i], keys[j])));
+    }
+  }
+}
+
+TEST_F(NormalizedKeyTests, NullTest) {
+  std::unique_ptr<catalog::Schema> key_schema(new catalog::Schema(
+      {catalog::Column(type::Type::INTEGER,
+                       type::Type::GetTypeSize(type::Type::INTEGER), "A",
+                       true),
+       catalog::Column(type::Type::VARCHAR, 32, "B", false)}));
+
+  storage::Tuple null_tuple(key_schema.get(), true);
+  null_tuple.SetValue(
+      0, type::ValueFactory::GetNullValueByType(type::Type::INTEGER), nullptr);
+  null_tuple.SetValue(
+      1, type::ValueFactory::GetNullValueByType(type::Type::VARCHAR), nullptr);
+
+  storage::Tuple tuple(key_schema.get(), true);
+  auto smallest_integer =
+      type::ValueFactory::GetIntegerValue(type::PELOTON_INT32_MIN + 1);
+  tuple.SetValue(0, smallest_integer, nullptr);
+  tuple.SetValue(1, type::ValueFactory::GetVarcharValue("zzz"), nullptr);
+
+  index::NormalizedKey<16> null_key;
+  index::NormalizedKey<16> key;
+  null_key.SetFromKey(&null_tuple);
+  key.SetFromKey(&tuple);
+
+  // A null integer sorts first
+  EXPECT_LT(index::NormalizedKey<16>::Compare(null_key, key), 0);
+
+  // And a null string last, as the largest VARCHAR of the scans
+  null_tuple.SetValue(0, smallest_integer, nullptr);
+  null_key.SetFromKey(&null_tuple);
+  EXPECT_GT(index::NormalizedKey<16>::Compare(null_key, key), 0);
+}
+
+TEST_F(NormalizedKeyTests, TruncationTest) {
+  std::unique_ptr<catalog::Schema> key_schema(new catalog::Schema(
+      {catalog::Column(type::Type::VARCHAR, 64, "A", false)}));
+
+  std::vector<std::string> strings = {"abcdefg", "abcdefgh", "abcdefghi",
+                                      "abcdefgz", "abcdeh"};
+  std::vector<index::NormalizedKey<8>> keys(strings.size());
+  for (size_t i = 0; i < strings.size(); i++) {
+    storage::Tuple tuple(key_schema.get(), true);
+    tuple.SetValue(0, type::ValueFactory::GetVarcharValue(strings[i]),
+                   nullptr);
+    keys[i].SetFromKey(&tuple);
+  }
+
+  // Cutting keeps the order, but the strings that share their first 7 bytes
+  // are now equal
+  for (size_t i = 0; i + 1 < keys.size(); i++) {
+    EXPECT_LE(index::NormalizedKey<8>::Compare(keys[i], keys[i + 1]), 0);
+  }
+  EXPECT_EQ(0, index::NormalizedKey<8>::Compare(keys[0], keys[3]));
+  EXPECT_LT(index::NormalizedKey<8>::Compare(keys[3], keys[4]), 0);
+
+  // Equal keys hash alike
+  index::NormalizedHasher<8> hasher;
+  EXPECT_EQ(hasher(keys[0]), hasher(keys[3]));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -653,6 +653,101 @@ void TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(const IndexType inde
 }
 
 
+void TestingIndexUtil::ScanKeyBatchTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // INDEX
+  std::unique_ptr<index::Index> index(
+      TestingIndexUtil::BuildIndex(index_type, false));
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  size_t scale_factor = 20;
+  LaunchParallelTest(1, TestingIndexUtil::InsertHelper, index.get(), pool,
+                     scale_factor);
+
+  // Out of order, with repeated and missing keys
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<const storage::Tuple *> key_ptrs;
+  for (size_t scale_itr = scale_factor + 2; scale_itr >= 1; scale_itr--) {
+    for (auto &suffix : {"b", "a", "f", "b"}) {
+      std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+      key->SetValue(0, type::ValueFactory::GetIntegerValue(100 * scale_itr),
+                    pool);
+      key->SetValue(1, type::ValueFactory::GetVarcharValue(suffix), pool);
+      key_ptrs.push_back(key.get());
+      keys.push_back(std::move(key));
+    }
+  }
+
+  std::vector<ItemPointer *> location_ptrs;
+  std::vector<size_t> offsets;
+  index->ScanKeyBatch(key_ptrs, location_ptrs, offsets);
+  ASSERT_EQ(key_ptrs.size() + 1, offsets.size());
+  EXPECT_EQ(location_ptrs.size(), offsets.back());
+
+  // Every key gets what a lookup of its own gets
+  for (size_t i = 0; i < key_ptrs.size(); i++) {
+    std::vector<ItemPointer *> expected_ptrs;
+    index->ScanKey(key_ptrs[i], expected_ptrs);
+
+    std::vector<ItemPointer *> batch_ptrs(
+        location_ptrs.begin() + offsets[i],
+        location_ptrs.begin() + offsets[i + 1]);
+    std::sort(expected_ptrs.begin(), expected_ptrs.end());
+    std::sort(batch_ptrs.begin(), batch_ptrs.end());
+    EXPECT_EQ(expected_ptrs, batch_ptrs);
+  }
+
+  delete index->GetMetadata()->GetTupleSchema();
+}
+
+void TestingIndexUtil::UniqueLongStringKeyTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // The declared length of a varchar is not enforced
+  std::vector<catalog::Column> column_list = {
+      catalog::Column(type::Type::VARCHAR, 8, "A", false)};
+  std::vector<oid_t> key_attrs = {0};
+  auto key_schema = new catalog::Schema(column_list);
+  key_schema->SetIndexedColumns(key_attrs);
+  auto tuple_schema = new catalog::Schema(column_list);
+
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "test_index", 126, INVALID_OID, INVALID_OID, index_type,
+      IndexConstraintType::UNIQUE, tuple_schema, key_schema, key_attrs, true);
+  std::unique_ptr<index::Index> index(
+      index::IndexFactory::GetIndex(index_metadata));
+
+  // Both keys are longer than declared and only differ after that
+  std::unique_ptr<storage::Tuple> key0(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key1(new storage::Tuple(key_schema, true));
+  key0->SetValue(0, type::ValueFactory::GetVarcharValue("abcdefghijkl0"),
+                 pool);
+  key1->SetValue(0, type::ValueFactory::GetVarcharValue("abcdefghijkl1"),
+                 pool);
+
+  // Any entry of the same key is a conflict
+  auto predicate = [](const void *) -> bool { return true; };
+  EXPECT_TRUE(index->CondInsertEntry(key0.get(), TestingIndexUtil::item0.get(),
+                                     predicate));
+  EXPECT_TRUE(index->CondInsertEntry(key1.get(), TestingIndexUtil::item1.get(),
+                                     predicate));
+  EXPECT_FALSE(index->CondInsertEntry(
+      key1.get(), TestingIndexUtil::item2.get(), predicate));
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanKey(key0.get(), location_ptrs);
+  ASSERT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(TestingIndexUtil::item0->offset, location_ptrs[0]->offset);
+  location_ptrs.clear();
+
+  index->ScanKey(key1.get(), location_ptrs);
+  ASSERT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(TestingIndexUtil::item1->offset, location_ptrs[0]->offset);
+
+  delete tuple_schema;
+}
+
 index::Index *TestingIndexUtil::BuildIndex(const IndexType index_type,
                                            const bool unique_keys) {
   LOG_DEBUG("Build index type: %s", IndexTypeToString(index_type).c_str());
@@ -28,6 +28,8 @@
 #include "executor/insert_executor.h"
 #include "executor/plan_executor.h"
 #include "executor/update_executor.h"
+#include "expression/expression_util.h"
+#include "expression/tuple_value_expression.h"
 #include "optimizer/simple_optimizer.h"
 #include "planner/create_plan.h"
 #include "planner/delete_plan.h"
@@ -64,7 +66,62 @@ TEST_F(OptimizerRuleTests, SimpleRuleApplyTest) {
   EXPECT_EQ(outputs.size(), 1);
 }
 
+// Equality between the first columns of two tables
+static std::shared_ptr<expression::AbstractExpression> MakeJoinPredicate(
+    oid_t left_table_oid, oid_t right_table_oid) {
+  std::vector<expression::TupleValueExpression *> columns;
+  for (auto table_oid : {left_table_oid, right_table_oid}) {
+    auto column =
+        new expression::TupleValueExpression(type::Type::INTEGER, 0, 0);
+    auto bound_oid = std::make_tuple(0U, table_oid, 0U);
+    column->SetBoundOid(bound_oid);
+    column->SetIsBound();
+    columns.push_back(column);
+  }
+  return std::shared_ptr<expression::AbstractExpression>(
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_EQUAL, columns[0], columns[1]));
+}
+
+TEST_F(OptimizerRuleTests, AssociativityRuleTest) {
+  // (A join B on a = b) join C on b = c
+  auto a = std::make_shared<OperatorExpression>(LeafOperator::make(0, {1}));
+  auto b = std::make_shared<OperatorExpression>(LeafOperator::make(1, {2}));
+  auto c = std::make_shared<OperatorExpression>(LeafOperator::make(2, {3}));
+  auto lower_join = std::make_shared<OperatorExpression>(
+      LogicalInnerJoin::make({MakeJoinPredicate(1, 2)}));
+  lower_join->PushChild(a);
+  lower_join->PushChild(b);
+  auto upper_join = std::make_shared<OperatorExpression>(
+      LogicalInnerJoin::make({MakeJoinPredicate(2, 3)}));
+  upper_join->PushChild(lower_join);
+  upper_join->PushChild(c);
 
+  InnerJoinAssociativity rule;
+  EXPECT_TRUE(rule.Check(upper_join));
+
+  std::vector<std::shared_ptr<OperatorExpression>> outputs;
+  rule.Transform(upper_join, outputs);
+  ASSERT_EQ(1U, outputs.size());
+
+  // A join (B join C on b = c) on a = b
+  auto output = outputs[0];
+  ASSERT_EQ(2U, output->Children().size());
+  EXPECT_EQ(a, output->Children()[0]);
+  auto output_join = output->Op().As<LogicalInnerJoin>();
+  ASSERT_EQ(1U, output_join->join_predicates.size());
+  EXPECT_EQ(lower_join->Op().As<LogicalInnerJoin>()->join_predicates[0],
+            output_join->join_predicates[0]);
+
+  auto output_child = output->Children()[1];
+  ASSERT_EQ(2U, output_child->Children().size());
+  EXPECT_EQ(b, output_child->Children()[0]);
+  EXPECT_EQ(c, output_child->Children()[1]);
+  auto output_child_join = output_child->Op().As<LogicalInnerJoin>();
+  ASSERT_EQ(1U, output_child_join->join_predicates.size());
+  EXPECT_EQ(upper_join->Op().As<LogicalInnerJoin>()->join_predicates[0],
+            output_child_join->join_predicates[0]);
+}
 
 } /* namespace test */
 } /* namespace peloton */
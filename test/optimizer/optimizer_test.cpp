@@ -8,9 +8,13 @@
 #include "executor/create_executor.h"
 #include "executor/insert_executor.h"
 #include "executor/plan_executor.h"
+#include "expression/tuple_value_expression.h"
 #include "optimizer/optimizer.h"
+#include "optimizer/properties.h"
+#include "optimizer/query_property_extractor.h"
 #include "optimizer/simple_optimizer.h"
 #include "parser/postgresparser.h"
+#include "binder/bind_node_visitor.h"
 #include "planner/create_plan.h"
 #include "planner/delete_plan.h"
 #include "planner/insert_plan.h"
@@ -166,5 +170,66 @@ TEST_F(OptimizerTests, HashJoinTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// The select list of a join is turned into the columns it outputs, and the
+// join condition into the predicate
+TEST_F(OptimizerTests, JoinSelectPropertiesTest) {
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  optimizer::SimpleOptimizer optimizer;
+  auto& traffic_cop = tcop::TrafficCop::GetInstance();
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto& peloton_parser = parser::PostgresParser::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+  for (auto sql : {"CREATE TABLE table_a(aid INT PRIMARY KEY,value INT);",
+                   "CREATE TABLE table_b(bid INT PRIMARY KEY,value INT);"}) {
+    std::unique_ptr<Statement> statement(new Statement("CREATE", sql));
+    auto create_stmt = peloton_parser.BuildParseTree(sql);
+    statement->SetPlanTree(optimizer.BuildPelotonPlanTree(create_stmt));
+
+    std::vector<type::Value> params;
+    std::vector<StatementResult> result;
+    std::vector<int> result_format;
+    traffic_cop.ExecuteStatementPlan(statement->GetPlanTree().get(), params,
+                                     result, result_format);
+  }
+  txn_manager.CommitTransaction(txn);
+
+  auto table_a = catalog::Catalog::GetInstance()->GetTableWithName(
+      DEFAULT_DB_NAME, "table_a");
+  auto table_b = catalog::Catalog::GetInstance()->GetTableWithName(
+      DEFAULT_DB_NAME, "table_b");
+
+  auto select_stmt = peloton_parser.BuildParseTree(
+      "SELECT table_a.value, bid FROM table_a INNER JOIN table_b "
+      "ON aid = bid;");
+  binder::BindNodeVisitor binder;
+  binder.BindNameToNode(select_stmt->GetStatements().at(0));
+
+  ColumnManager column_manager;
+  QueryPropertyExtractor extractor(column_manager);
+  auto properties =
+      extractor.GetProperties(select_stmt->GetStatements().at(0));
+
+  EXPECT_TRUE(properties.GetPropertyOfType(PropertyType::PREDICATE) !=
+              nullptr);
+
+  auto columns = properties.GetPropertyOfType(PropertyType::COLUMNS)
+                     ->As<PropertyColumns>();
+  ASSERT_TRUE(columns != nullptr);
+  EXPECT_FALSE(columns->IsStarExpressionInColumn());
+  ASSERT_EQ(2, columns->GetSize());
+  auto value_oid = columns->GetColumn(0)->GetBoundOid();
+  EXPECT_EQ(table_a->GetOid(), std::get<1>(value_oid));
+  EXPECT_EQ(1, std::get<2>(value_oid));
+  auto bid_oid = columns->GetColumn(1)->GetBoundOid();
+  EXPECT_EQ(table_b->GetOid(), std::get<1>(bid_oid));
+  EXPECT_EQ(0, std::get<2>(bid_oid));
+
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
 } /* namespace test */
 } /* namespace peloton */
@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_stats_test.cpp
+//
+// Identification: test/optimizer/table_stats_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "executor/testing_executor_util.h"
+
+#include "catalog/catalog.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "expression/expression_util.h"
+#include "optimizer/hyperloglog.h"
+#include "optimizer/stats_collector.h"
+#include "optimizer/table_stats.h"
+#include "storage/data_table.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Table Stats Tests
+//===--------------------------------------------------------------------===//
+
+class TableStatsTests : public PelotonTest {};
+
+TEST_F(TableStatsTests, HyperLogLogTest) {
+  optimizer::HyperLogLog sketch;
+  const size_t distinct_count = 10000;
+
+  // Every value is added twice
+  for (size_t round = 0; round < 2; round++) {
+    for (size_t value = 0; value < distinct_count; value++) {
+      sketch.Add(type::ValueFactory::GetBigIntValue(value).Hash());
+    }
+  }
+
+  EXPECT_NEAR(distinct_count, sketch.Estimate(), distinct_count * 0.05);
+
+  // Merging a sketch of the same values changes nothing
+  optimizer::HyperLogLog other_sketch;
+  for (size_t value = 0; value < distinct_count; value++) {
+    other_sketch.Add(type::ValueFactory::GetBigIntValue(value).Hash());
+  }
+  auto estimate = sketch.Estimate();
+  sketch.Merge(other_sketch);
+  EXPECT_EQ(estimate, sketch.Estimate());
+}
+
+TEST_F(TableStatsTests, SelectivityTest) {
+  optimizer::ColumnStats column_stats(type::Type::INTEGER);
+  column_stats.null_fraction = 0.1;
+  column_stats.distinct_count = 81;
+  column_stats.most_common_values.emplace_back(
+      type::ValueFactory::GetIntegerValue(1000), 0.2);
+  for (int bound = 0; bound <= 100; bound += 10) {
+    column_stats.histogram_bounds.push_back(bound);
+  }
+
+  // The common value and the other values sharing what is left
+  EXPECT_DOUBLE_EQ(0.2, column_stats.EstimateSelectivity(
+                            ExpressionType::COMPARE_EQUAL,
+                            type::ValueFactory::GetIntegerValue(1000)));
+  EXPECT_DOUBLE_EQ(0.7 / 80, column_stats.EstimateSelectivity(
+                                 ExpressionType::COMPARE_EQUAL,
+                                 type::ValueFactory::GetIntegerValue(42)));
+
+  // Half of the histogram is below 50, and the common value is above
+  EXPECT_DOUBLE_EQ(0.35, column_stats.EstimateSelectivity(
+                             ExpressionType::COMPARE_LESSTHAN,
+                             type::ValueFactory::GetIntegerValue(50)));
+  EXPECT_DOUBLE_EQ(0.55, column_stats.EstimateSelectivity(
+                             ExpressionType::COMPARE_GREATERTHAN,
+                             type::ValueFactory::GetIntegerValue(50)));
+  EXPECT_DOUBLE_EQ(0, column_stats.EstimateSelectivity(
+                          ExpressionType::COMPARE_LESSTHAN,
+                          type::ValueFactory::GetIntegerValue(-5)));
+
+  // Comparisons with null never hold
+  EXPECT_DOUBLE_EQ(0, column_stats.EstimateSelectivity(
+                          ExpressionType::COMPARE_EQUAL,
+                          type::ValueFactory::GetNullValueByType(
+                              type::Type::INTEGER)));
+}
+
+TEST_F(TableStatsTests, CollectTest) {
+  const size_t tuples_per_tile_group = 5;
+  const size_t tuple_count = 50;
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(tuples_per_tile_group, false));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                     false, txn);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  txn = txn_manager.BeginTransaction();
+  optimizer::StatsCollector::AnalyzeTable(table.get(), txn);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  auto table_stats = catalog::Catalog::GetInstance()->GetTableStats(
+      table->GetDatabaseOid(), table->GetOid());
+  ASSERT_TRUE(table_stats != nullptr);
+  EXPECT_EQ(tuple_count, table_stats->GetRowCount());
+
+  // The first column holds 0, 10, ..., 490
+  auto column_stats = table_stats->GetColumnStats(0);
+  ASSERT_TRUE(column_stats != nullptr);
+  EXPECT_EQ(0, column_stats->null_fraction);
+  EXPECT_NEAR(tuple_count, column_stats->distinct_count, 1);
+  EXPECT_TRUE(column_stats->most_common_values.empty());
+  EXPECT_EQ(0, column_stats->histogram_bounds.front());
+  EXPECT_EQ(490, column_stats->histogram_bounds.back());
+
+  // a < 250
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_LESSTHAN,
+          expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER,
+                                                        0, 0),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(250))));
+  EXPECT_NEAR(0.5, table_stats->EstimateSelectivity(predicate.get()), 0.05);
+
+  catalog::Catalog::GetInstance()->SetTableStats(table->GetDatabaseOid(),
+                                                 table->GetOid(), nullptr);
+  EXPECT_TRUE(catalog::Catalog::GetInstance()->GetTableStats(
+                  table->GetDatabaseOid(), table->GetOid()) == nullptr);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// explain_sql_test.cpp
+//
+// Identification: test/sql/explain_sql_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "sql/testing_sql_util.h"
+#include "catalog/catalog.h"
+#include "common/harness.h"
+
+namespace peloton {
+namespace test {
+
+class ExplainSQLTests : public PelotonTest {};
+
+TEST_F(ExplainSQLTests, ExplainAnalyzeTest) {
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE test(a INT PRIMARY KEY, b INT, c INT);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (1, 22, 333);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (2, 33, 111);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (3, 11, 222);");
+
+  std::vector<StatementResult> result;
+  std::vector<FieldInfo> tuple_descriptor;
+  std::string error_message;
+  int rows_changed;
+
+  // EXPLAIN only returns the plan, one line per plan node
+  EXPECT_EQ(ResultType::SUCCESS,
+            TestingSQLUtil::ExecuteSQLQuery(
+                "EXPLAIN SELECT a, b FROM test WHERE b > 15 ORDER BY b;",
+                result, tuple_descriptor, rows_changed, error_message));
+  EXPECT_EQ(1, tuple_descriptor.size());
+  EXPECT_EQ("QUERY PLAN", std::get<0>(tuple_descriptor[0]));
+  auto plan_lines = result.size();
+  ASSERT_LT(1, plan_lines);
+  auto scan_line =
+      TestingSQLUtil::GetResultValueAsString(result, plan_lines - 1);
+  EXPECT_NE(std::string::npos, scan_line.find("->  SeqScan on test"));
+
+  // EXPLAIN ANALYZE runs it, and adds the stats of each executor and a total
+  EXPECT_EQ(ResultType::SUCCESS,
+            TestingSQLUtil::ExecuteSQLQuery(
+                "EXPLAIN ANALYZE SELECT a, b FROM test WHERE b > 15 "
+                "ORDER BY b;",
+                result, tuple_descriptor, rows_changed, error_message));
+  EXPECT_EQ(1, tuple_descriptor.size());
+  ASSERT_EQ(plan_lines + 1, result.size());
+
+  bool found_order_by = false;
+  for (size_t i = 0; i < plan_lines - 1; i++) {
+    auto line = TestingSQLUtil::GetResultValueAsString(result, i);
+    if (line.find("OrderBy (time=") != std::string::npos) {
+      EXPECT_NE(std::string::npos, line.find("tuples=2"));
+      EXPECT_NE(std::string::npos, line.find("memory="));
+      found_order_by = true;
+    }
+  }
+  EXPECT_TRUE(found_order_by);
+
+  scan_line = TestingSQLUtil::GetResultValueAsString(result, plan_lines - 1);
+  EXPECT_NE(std::string::npos, scan_line.find("->  SeqScan on test (time="));
+  EXPECT_NE(std::string::npos, scan_line.find("tuples=2"));
+  EXPECT_NE(std::string::npos, scan_line.find("filtered=1"));
+
+  auto total_line = TestingSQLUtil::GetResultValueAsString(result, plan_lines);
+  EXPECT_EQ(0, total_line.find("Total: time="));
+
+  // free the database just created
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
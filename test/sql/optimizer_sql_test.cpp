@@ -493,5 +493,53 @@ TEST_F(OptimizerSQLTests, DDLSqlTest) {
 }
 
 
+TEST_F(OptimizerSQLTests, MergeJoinTest) {
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  CreateAndLoadTable();
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE test2(d INT PRIMARY KEY, e INT);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test2 VALUES (3, 30);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test2 VALUES (1, 10);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test2 VALUES (5, 50);");
+
+  std::vector<StatementResult> result;
+  std::vector<FieldInfo> tuple_descriptor;
+  std::string error_message;
+  int rows_changed;
+  std::unique_ptr<optimizer::AbstractOptimizer> optimizer(
+      new optimizer::Optimizer());
+
+  // Both primary key indexes give their table in join key order
+  std::string query("SELECT * FROM test INNER JOIN test2 ON a = d");
+  auto select_plan =
+      TestingSQLUtil::GeneratePlanWithOptimizer(optimizer, query);
+  EXPECT_EQ(select_plan->GetPlanNodeType(), PlanNodeType::MERGEJOIN);
+  EXPECT_EQ(select_plan->GetChildren()[0]->GetPlanNodeType(),
+            PlanNodeType::INDEXSCAN);
+  EXPECT_EQ(select_plan->GetChildren()[1]->GetPlanNodeType(),
+            PlanNodeType::INDEXSCAN);
+
+  TestingSQLUtil::ExecuteSQLQueryWithOptimizer(
+      optimizer, query, result, tuple_descriptor, rows_changed, error_message);
+  // Should be: 1, 22, 333, 1, 10 and 3, 33, 444, 3, 30
+  EXPECT_EQ(10, result.size());
+  EXPECT_EQ("1", TestingSQLUtil::GetResultValueAsString(result, 0));
+  EXPECT_EQ("10", TestingSQLUtil::GetResultValueAsString(result, 4));
+  EXPECT_EQ("3", TestingSQLUtil::GetResultValueAsString(result, 5));
+  EXPECT_EQ("30", TestingSQLUtil::GetResultValueAsString(result, 9));
+
+  // The index order also saves the sort of an order by
+  query = "SELECT a FROM test ORDER BY a";
+  select_plan = TestingSQLUtil::GeneratePlanWithOptimizer(optimizer, query);
+  EXPECT_EQ(select_plan->GetPlanNodeType(), PlanNodeType::INDEXSCAN);
+
+  // free the database just created
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
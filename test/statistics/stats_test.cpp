@@ -103,7 +103,7 @@ void TransactionTest(storage::Database *database, storage::DataTable *table,
 
     // Record database stat
     for (int i = 0; i < NUM_DB_COMMIT; i++) {
-      context->GetOnGoingQueryMetric()->GetQueryLatency().RecordLatency();
+      context->GetOnGoingQueryMetric()->RecordLatency();
       context->IncrementTxnCommitted(db_oid);
     }
     for (int i = 0; i < NUM_DB_ABORT; i++) {
@@ -112,6 +112,148 @@ void TransactionTest(storage::Database *database, storage::DataTable *table,
   }
 }
 
+TEST_F(StatsTests, LatencyMetricTest) {
+  stats::LatencyMetric latencies(LATENCY_METRIC);
+  stats::LatencyMetric other_latencies(LATENCY_METRIC);
+
+  // 1, 2, ..., 1000 ms, half of them from another thread's metric
+  for (int i = 1; i <= 1000; i++) {
+    if (i % 2 == 0) {
+      latencies.RecordLatency(i);
+    } else {
+      other_latencies.RecordLatency(i);
+    }
+  }
+  latencies.Aggregate(other_latencies);
+  latencies.ComputeLatencies();
+
+  // Every latency is counted within 1/32 of its value
+  auto &measurements = latencies.GetLatencyMeasurements();
+  EXPECT_DOUBLE_EQ(500.5, measurements.average_);
+  EXPECT_NEAR(1, measurements.min_, 1.0 / 32);
+  EXPECT_NEAR(500, measurements.median_, 500.0 / 32);
+  EXPECT_NEAR(950, measurements.perc_95th_, 950.0 / 32);
+  EXPECT_NEAR(990, measurements.perc_99th_, 990.0 / 32);
+  EXPECT_NEAR(999, measurements.perc_999th_, 999.0 / 32);
+  EXPECT_NEAR(1000, measurements.max_, 1000.0 / 32);
+  EXPECT_LE(measurements.perc_99th_, measurements.perc_999th_);
+
+  // The cumulative counts cover all latencies recorded so far
+  std::vector<uint64_t> bound_counts;
+  double sum_ms;
+  EXPECT_EQ(1000, latencies.GetCumulativeCounts({10, 100, 2000}, bound_counts,
+                                                sum_ms));
+  EXPECT_EQ(10, bound_counts[0]);
+  EXPECT_EQ(100, bound_counts[1]);
+  EXPECT_EQ(1000, bound_counts[2]);
+  EXPECT_DOUBLE_EQ(500500, sum_ms);
+
+  // The next interval only covers the latencies recorded since
+  for (int i = 0; i < 100; i++) {
+    latencies.RecordLatency(0.002);
+  }
+  latencies.ComputeLatencies();
+  EXPECT_DOUBLE_EQ(0.002, measurements.average_);
+  EXPECT_DOUBLE_EQ(0.002, measurements.max_);
+
+  latencies.ComputeLatencies();
+  EXPECT_DOUBLE_EQ(0, measurements.max_);
+}
+
+TEST_F(StatsTests, AbortMetricTest) {
+  stats::AbortMetric aborts(ABORT_METRIC);
+  stats::AbortMetric other_aborts(ABORT_METRIC);
+
+  // One hot tuple, and many more cold ones than there are slots
+  for (int i = 0; i < 100; i++) {
+    aborts.RecordAbort(AbortCauseType::OWNERSHIP_CONFLICT, 7,
+                       ItemPointer(1, 1));
+    other_aborts.RecordAbort(AbortCauseType::READ_TIMESTAMP, 7,
+                             ItemPointer(1, 1));
+    aborts.RecordAbort(AbortCauseType::VISIBILITY, 8, ItemPointer(2, i));
+  }
+  other_aborts.RecordAbort(AbortCauseType::INVALID, INVALID_OID,
+                           INVALID_ITEMPOINTER);
+
+  stats::AbortMetric aggregated(ABORT_METRIC);
+  aggregated.Aggregate(aborts);
+  aggregated.Aggregate(other_aborts);
+
+  EXPECT_EQ(100,
+            aggregated.GetAbortCount(AbortCauseType::OWNERSHIP_CONFLICT)
+                .GetCounter());
+  EXPECT_EQ(
+      100,
+      aggregated.GetAbortCount(AbortCauseType::READ_TIMESTAMP).GetCounter());
+  EXPECT_EQ(100,
+            aggregated.GetAbortCount(AbortCauseType::VISIBILITY).GetCounter());
+  EXPECT_EQ(1, aggregated.GetAbortCount(AbortCauseType::INVALID).GetCounter());
+  EXPECT_EQ(0,
+            aggregated.GetAbortCount(AbortCauseType::CONSTRAINT).GetCounter());
+
+  // The hot tuple comes first, with all of its aborts
+  auto hot_tuples = aggregated.GetHotTuples();
+  EXPECT_EQ(stats::AbortMetric::HOT_TUPLE_COUNT, hot_tuples.size());
+  EXPECT_EQ(7, hot_tuples[0].table_id_);
+  EXPECT_EQ(1, hot_tuples[0].location_.block);
+  EXPECT_EQ(1, hot_tuples[0].location_.offset);
+  EXPECT_LE(200, hot_tuples[0].count_);
+  EXPECT_GE(200 + hot_tuples[0].error_, hot_tuples[0].count_);
+
+  // The sources start a new interval, the counters go on
+  EXPECT_TRUE(aborts.GetHotTuples().empty());
+  EXPECT_TRUE(other_aborts.GetHotTuples().empty());
+  aggregated.Reset();
+  aggregated.Aggregate(aborts);
+  EXPECT_TRUE(aggregated.GetHotTuples().empty());
+  EXPECT_EQ(100,
+            aggregated.GetAbortCount(AbortCauseType::VISIBILITY).GetCounter());
+}
+
+TEST_F(StatsTests, PhaseMetricTest) {
+  stats::BackendStatsContext context(false);
+
+  // A select that is decoded, parsed and executed. Its type is only known
+  // once it is parsed.
+  for (int i = 0; i < 10; i++) {
+    context.StartPhase(QueryPhaseType::DECODE);
+    context.StartPhase(QueryPhaseType::PARSE);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    context.EndPhase(QueryPhaseType::DECODE);
+    context.EndPhase(QueryPhaseType::PARSE);
+    context.SetStatementType(StatementType::SELECT);
+    context.StartPhase(QueryPhaseType::EXECUTE);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    context.EndPhase(QueryPhaseType::EXECUTE);
+    context.CompleteStatementPhases();
+  }
+
+  // A statement that failed to parse is not recorded
+  context.StartPhase(QueryPhaseType::PARSE);
+  context.EndPhase(QueryPhaseType::PARSE);
+  context.CompleteStatementPhases();
+
+  EXPECT_EQ(nullptr, context.GetPhaseMetric(StatementType::INSERT));
+  ASSERT_NE(nullptr, context.GetPhaseMetric(StatementType::SELECT));
+
+  stats::BackendStatsContext aggregated(false);
+  aggregated.Aggregate(context);
+  auto phase_metric = aggregated.GetPhaseMetric(StatementType::SELECT);
+  ASSERT_NE(nullptr, phase_metric);
+  phase_metric->ComputeLatencies();
+
+  auto &parse = phase_metric->GetPhaseLatency(QueryPhaseType::PARSE)
+                    .GetLatencyMeasurements();
+  EXPECT_EQ(10, parse.count_);
+  EXPECT_LE(1.0 - 1.0 / 32, parse.min_);
+  auto &execute = phase_metric->GetPhaseLatency(QueryPhaseType::EXECUTE)
+                      .GetLatencyMeasurements();
+  EXPECT_EQ(10, execute.count_);
+  auto &log_flush = phase_metric->GetPhaseLatency(QueryPhaseType::LOG_FLUSH)
+                        .GetLatencyMeasurements();
+  EXPECT_EQ(0, log_flush.count_);
+}
+
 TEST_F(StatsTests, MultiThreadStatsTest) {
   auto catalog = catalog::Catalog::GetInstance();
 
@@ -162,6 +304,17 @@ TEST_F(StatsTests, MultiThreadStatsTest) {
   ASSERT_EQ(db_metric->GetTxnAborted().GetCounter(),
             num_threads * NUM_ITERATION * NUM_DB_ABORT);
 
+  // Check the exported metrics
+  auto exported_metrics = aggregator.GetExportedMetrics();
+  EXPECT_NE(std::string::npos,
+            exported_metrics.find(
+                "peloton_txn_committed_total{database_oid=\"" +
+                std::to_string(db_oid) + "\"} " +
+                std::to_string(num_threads * NUM_ITERATION * NUM_DB_COMMIT)));
+  EXPECT_NE(std::string::npos,
+            exported_metrics.find("# TYPE peloton_txn_latency_seconds "
+                                  "histogram"));
+
   // Check table metrics
   auto table_oid = table->GetOid();
   auto table_metric = aggregated_stats.GetTableMetric(db_oid, table_oid);
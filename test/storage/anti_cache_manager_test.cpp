@@ -0,0 +1,184 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// anti_cache_manager_test.cpp
+//
+// Identification: test/storage/anti_cache_manager_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "concurrency/testing_transaction_util.h"
+#include "executor/testing_executor_util.h"
+
+#include "catalog/manager.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "configuration/configuration.h"
+#include "storage/anti_cache_manager.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Anti-Cache Manager Tests
+//===--------------------------------------------------------------------===//
+
+class AntiCacheManagerTests : public PelotonTest {};
+
+// Let every transaction that has begun so far finish its epoch
+static void ReleaseEpochs() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+  auto epoch_id = txn->GetBeginCommitId() >> 32;
+  txn_manager.CommitTransaction(txn);
+
+  epoch_manager.Reset(epoch_id + 1);
+}
+
+TEST_F(AntiCacheManagerTests, EvictAndFetchTest) {
+  FLAGS_anti_caching = true;
+
+  // 100 tuples per tile group, the last one is still being filled
+  const int num_key = 250;
+  std::unique_ptr<storage::DataTable> table(
+      TestingTransactionUtil::CreateTable(num_key));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+
+  auto &anti_cache_manager = storage::AntiCacheManager::GetInstance();
+  anti_cache_manager.SetFile("/tmp/peloton_anti_cache_test.data");
+  anti_cache_manager.SetColdPasses(1);
+
+  auto first_tile_group_id = table->GetTileGroupId(0);
+  auto second_tile_group_id = table->GetTileGroupId(1);
+
+  // Everything was just touched by the inserts
+  EXPECT_EQ(0U, anti_cache_manager.EvictColdTileGroups(table.get()));
+
+  anti_cache_manager.Tick();
+  ReleaseEpochs();
+  EXPECT_EQ(2U, anti_cache_manager.EvictColdTileGroups(table.get()));
+  EXPECT_EQ(2U, anti_cache_manager.GetEvictedTileGroupCount());
+  EXPECT_TRUE(manager.GetResidentTileGroup(first_tile_group_id) == nullptr);
+  EXPECT_TRUE(manager.GetResidentTileGroup(second_tile_group_id) == nullptr);
+
+  // Evicted tuples are faulted back in through their indexes
+  auto txn = txn_manager.BeginTransaction();
+  for (int id = 0; id < num_key; id++) {
+    int result = -1;
+    TestingTransactionUtil::ExecuteRead(txn, table.get(), id, result);
+    EXPECT_EQ(0, result);
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_EQ(0U, anti_cache_manager.GetEvictedTileGroupCount());
+  EXPECT_TRUE(manager.GetResidentTileGroup(first_tile_group_id) != nullptr);
+  EXPECT_TRUE(manager.GetResidentTileGroup(second_tile_group_id) != nullptr);
+
+  // Fetched tile groups are hot again
+  EXPECT_EQ(0U, anti_cache_manager.EvictColdTileGroups(table.get()));
+
+  FLAGS_anti_caching = false;
+}
+
+TEST_F(AntiCacheManagerTests, RunningTransactionTest) {
+  FLAGS_anti_caching = true;
+
+  const int num_key = 250;
+  std::unique_ptr<storage::DataTable> table(
+      TestingTransactionUtil::CreateTable(num_key));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto &anti_cache_manager = storage::AntiCacheManager::GetInstance();
+  anti_cache_manager.SetFile("/tmp/peloton_anti_cache_test.data");
+  anti_cache_manager.SetColdPasses(1);
+
+  // The transaction may still use the header of the tile group it read from
+  auto txn = txn_manager.BeginTransaction();
+  int result = -1;
+  TestingTransactionUtil::ExecuteRead(txn, table.get(), 0, result);
+  EXPECT_EQ(0, result);
+
+  anti_cache_manager.Tick();
+  ReleaseEpochs();
+  EXPECT_EQ(0U, anti_cache_manager.EvictColdTileGroups(table.get()));
+
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  ReleaseEpochs();
+  EXPECT_EQ(2U, anti_cache_manager.EvictColdTileGroups(table.get()));
+
+  // Fault them back in for the table to clean up
+  txn = txn_manager.BeginTransaction();
+  for (int id = 0; id < num_key; id++) {
+    TestingTransactionUtil::ExecuteRead(txn, table.get(), id, result);
+    EXPECT_EQ(0, result);
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  EXPECT_EQ(0U, anti_cache_manager.GetEvictedTileGroupCount());
+
+  FLAGS_anti_caching = false;
+}
+
+TEST_F(AntiCacheManagerTests, VarlenRoundTripTest) {
+  FLAGS_anti_caching = true;
+
+  const int tuples_per_tile_group = 5;
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(tuples_per_tile_group, false));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table.get(), tuples_per_tile_group * 2,
+                                     false, false, false, txn);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // Remember what the first tile group looks like
+  auto tile_group = table->GetTileGroup(0);
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto column_count = table->GetSchema()->GetColumnCount();
+  std::vector<type::Value> values;
+  for (oid_t tuple_id = 0; tuple_id < tuples_per_tile_group; tuple_id++) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      values.push_back(tile_group->GetValue(tuple_id, column_itr));
+    }
+  }
+  tile_group.reset();
+
+  auto &anti_cache_manager = storage::AntiCacheManager::GetInstance();
+  anti_cache_manager.SetFile("/tmp/peloton_anti_cache_test.data");
+  anti_cache_manager.SetColdPasses(1);
+  anti_cache_manager.Tick();
+  ReleaseEpochs();
+
+  EXPECT_TRUE(anti_cache_manager.EvictTileGroup(tile_group_id));
+  EXPECT_FALSE(anti_cache_manager.EvictTileGroup(tile_group_id));
+
+  tile_group = table->GetTileGroup(0);
+  ASSERT_TRUE(tile_group != nullptr);
+  EXPECT_EQ(tile_group_id, tile_group->GetTileGroupId());
+  EXPECT_EQ(0U, anti_cache_manager.GetEvictedTileGroupCount());
+
+  auto tile_group_header = tile_group->GetHeader();
+  size_t value_itr = 0;
+  for (oid_t tuple_id = 0; tuple_id < tuples_per_tile_group; tuple_id++) {
+    EXPECT_EQ(INITIAL_TXN_ID, tile_group_header->GetTransactionId(tuple_id));
+    EXPECT_EQ(MAX_CID, tile_group_header->GetEndCommitId(tuple_id));
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      auto value = tile_group->GetValue(tuple_id, column_itr);
+      EXPECT_EQ(type::CMP_TRUE, value.CompareEquals(values[value_itr++]));
+    }
+  }
+
+  FLAGS_anti_caching = false;
+}
+
+}  // End test namespace
+}  // End peloton namespace
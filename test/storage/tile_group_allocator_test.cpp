@@ -0,0 +1,130 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_allocator_test.cpp
+//
+// Identification: test/storage/tile_group_allocator_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/harness.h"
+
+#include "configuration/configuration.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group_allocator.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Allocator Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupAllocatorTests : public PelotonTest {};
+
+TEST_F(TileGroupAllocatorTests, BasicTest) {
+  storage::TileGroupAllocator allocator;
+
+  size_t length = 4096;
+  size_t rounds = 1000;
+  std::vector<void *> locations;
+
+  for (size_t round_itr = 0; round_itr < rounds; round_itr++) {
+    auto location = allocator.Allocate(length, 0);
+    EXPECT_TRUE(location != nullptr);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(location) % CACHELINE_SIZE);
+
+    // Fill it up
+    PL_MEMSET(location, '-', length);
+    locations.push_back(location);
+  }
+
+  // Regions are carved out of huge pages
+  EXPECT_EQ(rounds * length / storage::TileGroupAllocator::kRegionSize + 1,
+            allocator.GetRegionCount());
+
+  for (auto location : locations) {
+    EXPECT_TRUE(allocator.Release(location));
+  }
+
+  // Only the active region is left around
+  EXPECT_EQ(1, allocator.GetRegionCount());
+
+  // Memory not owned by the allocator is rejected
+  int unowned = 0;
+  EXPECT_FALSE(allocator.Release(&unowned));
+}
+
+TEST_F(TileGroupAllocatorTests, LargeAllocationTest) {
+  storage::TileGroupAllocator allocator;
+
+  size_t length = 3 * storage::TileGroupAllocator::kRegionSize + 1;
+  auto location = allocator.Allocate(length, storage::NUMA_NODE_ANY);
+  EXPECT_TRUE(location != nullptr);
+  PL_MEMSET(location, '-', length);
+
+  EXPECT_EQ(1, allocator.GetRegionCount());
+  EXPECT_EQ(4 * storage::TileGroupAllocator::kRegionSize,
+            allocator.GetMappedBytes());
+
+  // The dedicated region is returned right away
+  EXPECT_TRUE(allocator.Release(location));
+  EXPECT_EQ(0, allocator.GetRegionCount());
+  EXPECT_EQ(0, allocator.GetMappedBytes());
+}
+
+TEST_F(TileGroupAllocatorTests, UnownedAddressTest) {
+  storage::TileGroupAllocator allocator;
+
+  // Nothing is mapped yet, so heap memory is turned away right away
+  std::unique_ptr<char[]> heap_memory(new char[64]);
+  EXPECT_FALSE(allocator.Release(heap_memory.get()));
+  EXPECT_EQ(0, allocator.GetRegionCount());
+
+  size_t length = 4096;
+  auto location = static_cast<char *>(allocator.Allocate(length, 0));
+  EXPECT_TRUE(location != nullptr);
+  EXPECT_FALSE(allocator.Release(heap_memory.get()));
+
+  // Addresses right before and after the region are not ours either
+  EXPECT_FALSE(allocator.Release(location - 1));
+  EXPECT_FALSE(
+      allocator.Release(location + storage::TileGroupAllocator::kRegionSize));
+
+  EXPECT_TRUE(allocator.Release(location));
+}
+
+TEST_F(TileGroupAllocatorTests, StorageManagerTest) {
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  auto &allocator = storage::TileGroupAllocator::GetInstance();
+  auto region_count = allocator.GetRegionCount();
+
+  // Large enough to get a dedicated region
+  size_t length = storage::TileGroupAllocator::kRegionSize;
+
+  FLAGS_tile_huge_pages = true;
+  auto location = storage_manager.Allocate(BackendType::MM, length, 0);
+  EXPECT_TRUE(location != nullptr);
+  PL_MEMSET(location, '-', length);
+  EXPECT_EQ(region_count + 1, allocator.GetRegionCount());
+
+  // Memory is handed back to the allocator even if the flag has been
+  // turned off in the meantime
+  FLAGS_tile_huge_pages = false;
+  storage_manager.Release(BackendType::MM, location);
+  EXPECT_EQ(region_count, allocator.GetRegionCount());
+
+  // Memory from the heap is still released as before
+  location = storage_manager.Allocate(BackendType::MM, length, 0);
+  EXPECT_TRUE(location != nullptr);
+  EXPECT_EQ(region_count, allocator.GetRegionCount());
+  storage_manager.Release(BackendType::MM, location);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,193 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer_test.cpp
+//
+// Identification: test/storage/tile_group_freezer_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <set>
+
+#include "common/harness.h"
+#include "executor/testing_executor_util.h"
+
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/compressed_column.h"
+#include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_freezer.h"
+#include "storage/tile_group_header.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Freezer Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupFreezerTests : public PelotonTest {};
+
+static const size_t tuples_per_tile_group = 5;
+
+// Create a table with two full tile groups whose tuples are visible to every
+// transaction that starts from now on
+static storage::DataTable *CreateFrozenTable(
+    storage::TileGroupFreezer &tile_group_freezer) {
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(tuples_per_tile_group, false));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+  auto epoch_id = txn->GetBeginCommitId() >> 32;
+  TestingExecutorUtil::PopulateTable(table.get(), tuples_per_tile_group * 2,
+                                     false, false, false, txn);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  epoch_manager.Reset(epoch_id + 2);
+  EXPECT_EQ(2U, tile_group_freezer.FreezeTable(table.get()));
+
+  return table.release();
+}
+
+static std::vector<type::Value> GetValues(storage::TileGroup *tile_group) {
+  std::vector<type::Value> values;
+  auto column_count = tile_group->GetColumnMap().size();
+  for (oid_t tuple_id = 0; tuple_id < tuples_per_tile_group; tuple_id++) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      // Varchars must outlive the uncompressed tiles
+      auto value = tile_group->GetValue(tuple_id, column_itr);
+      if (value.GetTypeId() == type::Type::VARCHAR) {
+        value = type::ValueFactory::GetVarcharValue(value.ToString());
+      }
+      values.push_back(value);
+    }
+  }
+  return values;
+}
+
+static void CheckValues(storage::TileGroup *tile_group,
+                        const std::vector<type::Value> &values) {
+  auto frozen_values = GetValues(tile_group);
+  ASSERT_EQ(values.size(), frozen_values.size());
+  for (size_t value_itr = 0; value_itr < values.size(); value_itr++) {
+    EXPECT_EQ(type::CMP_TRUE,
+              frozen_values[value_itr].CompareEquals(values[value_itr]));
+  }
+}
+
+TEST_F(TileGroupFreezerTests, FreezeTest) {
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(tuples_per_tile_group, false));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  storage::TileGroupFreezer tile_group_freezer;
+
+  auto txn = txn_manager.BeginTransaction();
+  auto epoch_id = txn->GetBeginCommitId() >> 32;
+  TestingExecutorUtil::PopulateTable(table.get(), tuples_per_tile_group * 2,
+                                     false, false, false, txn);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  auto first_tile_group = table->GetTileGroup(0);
+  auto second_tile_group = table->GetTileGroup(1);
+  auto first_values = GetValues(first_tile_group.get());
+  auto second_values = GetValues(second_tile_group.get());
+
+  // Not every transaction can see the tuples yet
+  EXPECT_EQ(0U, tile_group_freezer.FreezeTable(table.get()));
+
+  epoch_manager.Reset(epoch_id + 2);
+  EXPECT_EQ(2U, tile_group_freezer.FreezeTable(table.get()));
+  EXPECT_EQ(0U, tile_group_freezer.FreezeTable(table.get()));
+  EXPECT_EQ(2U, tile_group_freezer.GetFrozenTileGroupCount());
+
+  EXPECT_TRUE(first_tile_group->GetHeader()->IsFrozen());
+  EXPECT_TRUE(second_tile_group->GetHeader()->IsFrozen());
+
+  // Every varchar is distinct
+  auto tile = first_tile_group->GetTile(0);
+  EXPECT_TRUE(tile->IsCompressed());
+  auto varchar_column = tile->GetCompressedColumn(3);
+  EXPECT_TRUE(varchar_column->IsDictionaryEncoded());
+  EXPECT_EQ(tuples_per_tile_group, varchar_column->GetDictionarySize());
+
+  CheckValues(first_tile_group.get(), first_values);
+  CheckValues(second_tile_group.get(), second_values);
+
+  // Older transactions may still be reading the uncompressed tiles
+  EXPECT_EQ(0U, tile_group_freezer.ReleaseUncompressedData());
+
+  epoch_manager.Reset(epoch_id + 4);
+  EXPECT_EQ(2U, tile_group_freezer.ReleaseUncompressedData());
+  EXPECT_EQ(0U, tile_group_freezer.ReleaseUncompressedData());
+
+  CheckValues(first_tile_group.get(), first_values);
+  CheckValues(second_tile_group.get(), second_values);
+}
+
+TEST_F(TileGroupFreezerTests, CompressedScanTest) {
+  storage::TileGroupFreezer tile_group_freezer;
+  std::unique_ptr<storage::DataTable> table(
+      CreateFrozenTable(tile_group_freezer));
+
+  // 20 <= a AND a < 80 AND d != '43', where a = 10 * row and d = '10 * row + 3'
+  auto predicate = expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_AND,
+      expression::ExpressionUtil::ConjunctionFactory(
+          ExpressionType::CONJUNCTION_AND,
+          expression::ExpressionUtil::ComparisonFactory(
+              ExpressionType::COMPARE_LESSTHANOREQUALTO,
+              expression::ExpressionUtil::ConstantValueFactory(
+                  type::ValueFactory::GetIntegerValue(20)),
+              expression::ExpressionUtil::TupleValueFactory(
+                  type::Type::INTEGER, 0, 0)),
+          expression::ExpressionUtil::ComparisonFactory(
+              ExpressionType::COMPARE_LESSTHAN,
+              expression::ExpressionUtil::TupleValueFactory(
+                  type::Type::INTEGER, 0, 0),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  type::ValueFactory::GetIntegerValue(80)))),
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_NOTEQUAL,
+          expression::ExpressionUtil::TupleValueFactory(type::Type::VARCHAR,
+                                                        0, 3),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetVarcharValue("43"))));
+
+  std::vector<oid_t> column_ids({0, 3});
+  planner::SeqScanPlan node(table.get(), predicate, column_ids);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::set<int> result;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      result.insert(result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+    }
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_EQ(std::set<int>({20, 30, 50, 60, 70}), result);
+}
+
+}  // End test namespace
+}  // End peloton namespace
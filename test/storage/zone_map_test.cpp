@@ -0,0 +1,150 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map_test.cpp
+//
+// Identification: test/storage/zone_map_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <set>
+
+#include "common/harness.h"
+#include "executor/testing_executor_util.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/zone_map.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Zone Map Tests
+//===--------------------------------------------------------------------===//
+
+class ZoneMapTests : public PelotonTest {};
+
+static const size_t tuples_per_tile_group = 5;
+
+static storage::DataTable *CreatePopulatedTable() {
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(tuples_per_tile_group, false));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table.get(), tuples_per_tile_group * 3,
+                                     false, false, false, txn);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  return table.release();
+}
+
+TEST_F(ZoneMapTests, RangeTest) {
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable());
+
+  // The second tile group holds rows 5 to 9, i.e. a = 50 .. 90
+  auto tile_group = table->GetTileGroup(1);
+  auto zone_map = tile_group->GetZoneMap();
+
+  EXPECT_TRUE(zone_map->HasRange(0));
+  EXPECT_EQ(50, zone_map->GetMin(0).GetAs<int32_t>());
+  EXPECT_EQ(90, zone_map->GetMax(0).GetAs<int32_t>());
+  EXPECT_EQ(52.0, zone_map->GetMin(2).GetAs<double>());
+  EXPECT_EQ(92.0, zone_map->GetMax(2).GetAs<double>());
+  EXPECT_FALSE(zone_map->HasRange(3));
+  EXPECT_EQ(0U, zone_map->GetNullCount(3));
+
+  auto forty = type::ValueFactory::GetIntegerValue(40);
+  auto fifty = type::ValueFactory::GetIntegerValue(50);
+  auto seventy_five = type::ValueFactory::GetIntegerValue(75);
+  auto ninety = type::ValueFactory::GetIntegerValue(90);
+
+  EXPECT_FALSE(
+      zone_map->MayMatch(0, ExpressionType::COMPARE_LESSTHAN, fifty));
+  EXPECT_TRUE(zone_map->MayMatch(
+      0, ExpressionType::COMPARE_LESSTHANOREQUALTO, fifty));
+  EXPECT_FALSE(
+      zone_map->MayMatch(0, ExpressionType::COMPARE_GREATERTHAN, ninety));
+  EXPECT_TRUE(zone_map->MayMatch(
+      0, ExpressionType::COMPARE_GREATERTHANOREQUALTO, ninety));
+  EXPECT_FALSE(zone_map->MayMatch(0, ExpressionType::COMPARE_EQUAL, forty));
+  EXPECT_TRUE(
+      zone_map->MayMatch(0, ExpressionType::COMPARE_EQUAL, seventy_five));
+  EXPECT_TRUE(
+      zone_map->MayMatch(0, ExpressionType::COMPARE_NOTEQUAL, fifty));
+
+  // Decimal column against an integer constant
+  EXPECT_FALSE(zone_map->MayMatch(
+      2, ExpressionType::COMPARE_GREATERTHAN,
+      type::ValueFactory::GetIntegerValue(92)));
+  EXPECT_TRUE(zone_map->MayMatch(2, ExpressionType::COMPARE_LESSTHAN,
+                                 type::ValueFactory::GetIntegerValue(53)));
+
+  // Comparisons with null never hold, columns without a range always may
+  EXPECT_FALSE(zone_map->MayMatch(
+      0, ExpressionType::COMPARE_EQUAL,
+      type::ValueFactory::GetNullValueByType(type::Type::INTEGER)));
+  EXPECT_TRUE(zone_map->MayMatch(3, ExpressionType::COMPARE_EQUAL,
+                                 type::ValueFactory::GetVarcharValue("x")));
+
+  // Overwrites only widen the ranges
+  auto large = type::ValueFactory::GetIntegerValue(1000);
+  tile_group->SetValue(large, 0, 0);
+  EXPECT_EQ(50, zone_map->GetMin(0).GetAs<int32_t>());
+  EXPECT_EQ(1000, zone_map->GetMax(0).GetAs<int32_t>());
+
+  auto null_varchar =
+      type::ValueFactory::GetNullValueByType(type::Type::VARCHAR);
+  tile_group->SetValue(null_varchar, 0, 3);
+  EXPECT_EQ(1U, zone_map->GetNullCount(3));
+}
+
+TEST_F(ZoneMapTests, ScanPruningTest) {
+  std::unique_ptr<storage::DataTable> table(CreatePopulatedTable());
+
+  // 100 <= a, which only the last tile group can satisfy
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_LESSTHANOREQUALTO,
+      expression::ExpressionUtil::ConstantValueFactory(
+          type::ValueFactory::GetIntegerValue(100)),
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0,
+                                                    0));
+
+  std::vector<oid_t> column_ids({0});
+  planner::SeqScanPlan node(table.get(), predicate, column_ids);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  size_t result_tile_count = 0;
+  std::set<int> result;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    result_tile_count++;
+    for (oid_t tuple_id : *result_tile) {
+      result.insert(result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+    }
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_EQ(1U, result_tile_count);
+  EXPECT_EQ(std::set<int>({100, 110, 120, 130, 140}), result);
+}
+
+}  // End test namespace
+}  // End peloton namespace
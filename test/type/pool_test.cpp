@@ -13,6 +13,7 @@
 #include <limits.h>
 #include <pthread.h>
 
+#include "type/arena_pool.h"
 #include "type/ephemeral_pool.h"
 #include "gtest/gtest.h"
 #include "common/harness.h"
@@ -57,5 +58,35 @@ TEST_F(PoolTests, AllocateOnceTest) {
   delete pool;
 }
 
+// Allocate many chunks from the arena and reset it
+TEST_F(PoolTests, ArenaAllocateTest) {
+  type::ArenaPool pool(1024);
+  std::vector<char *> locations;
+
+  for (size_t i = 0; i < M; i++) {
+    size_t size = RANDOM(str_len) + 1;
+    char *p = reinterpret_cast<char *>(pool.Allocate(size));
+    EXPECT_TRUE(p != nullptr);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(p) % sizeof(void *));
+    memset(p, static_cast<int>(i % 128), size);
+    locations.push_back(p);
+  }
+
+  // Earlier allocations must not be clobbered by later ones
+  for (size_t i = 0; i < M; i++) {
+    EXPECT_EQ(static_cast<char>(i % 128), locations[i][0]);
+  }
+
+  // Free is a no-op on the arena
+  pool.Free(locations[0]);
+  EXPECT_TRUE(pool.GetAllocatedBytes() >= M);
+
+  pool.Reset();
+  EXPECT_EQ(0, pool.GetAllocatedBytes());
+
+  void *p = pool.Allocate(40);
+  EXPECT_TRUE(p != nullptr);
+}
+
 }
 }
@@ -136,7 +136,8 @@ TEST_F(TypesTests, StatementTypeTest) {
       StatementType::DROP,    StatementType::PREPARE,
       StatementType::EXECUTE, StatementType::RENAME,
       StatementType::ALTER,   StatementType::TRANSACTION,
-      StatementType::COPY};
+      StatementType::COPY,    StatementType::ANALYZE,
+      StatementType::EXPLAIN};
 
   // Make sure that ToString and FromString work
   for (auto val : list) {
@@ -159,6 +160,31 @@ TEST_F(TypesTests, StatementTypeTest) {
       peloton::Exception);
 }
 
+TEST_F(TypesTests, QueryPhaseTypeTest) {
+  std::vector<QueryPhaseType> list = {
+      QueryPhaseType::INVALID, QueryPhaseType::DECODE,
+      QueryPhaseType::PARSE,   QueryPhaseType::PLAN,
+      QueryPhaseType::BUILD,   QueryPhaseType::EXECUTE,
+      QueryPhaseType::COMMIT,  QueryPhaseType::LOG_FLUSH,
+      QueryPhaseType::ENCODE};
+
+  // Make sure that ToString and FromString work
+  for (auto val : list) {
+    std::string str = peloton::QueryPhaseTypeToString(val);
+    EXPECT_TRUE(str.size() > 0);
+
+    auto newVal = peloton::StringToQueryPhaseType(str);
+    EXPECT_EQ(val, newVal);
+  }
+
+  // Then make sure that we can't cast garbage
+  std::string invalid("WU TANG");
+  EXPECT_THROW(peloton::StringToQueryPhaseType(invalid), peloton::Exception);
+  EXPECT_THROW(
+      peloton::QueryPhaseTypeToString(static_cast<QueryPhaseType>(-99999)),
+      peloton::Exception);
+}
+
 TEST_F(TypesTests, ExpressionTypeTest) {
   std::vector<ExpressionType> list = {
       ExpressionType::INVALID,
@@ -251,7 +277,8 @@ TEST_F(TypesTests, ExpressionTypeTest) {
 
 TEST_F(TypesTests, IndexTypeTest) {
   std::vector<IndexType> list = {IndexType::INVALID, IndexType::BWTREE,
-                                 IndexType::HASH, IndexType::SKIPLIST};
+                                 IndexType::HASH, IndexType::SKIPLIST,
+                                 IndexType::ART};
 
   // Make sure that ToString and FromString work
   for (auto val : list) {
@@ -367,7 +394,8 @@ TEST_F(TypesTests, PlanNodeTypeTest) {
       PlanNodeType::DISTINCT,    PlanNodeType::SETOP,
       PlanNodeType::APPEND,      PlanNodeType::AGGREGATE_V2,
       PlanNodeType::HASH,        PlanNodeType::RESULT,
-      PlanNodeType::COPY,        PlanNodeType::MOCK};
+      PlanNodeType::COPY,        PlanNodeType::ANALYZE,
+      PlanNodeType::MOCK};
 
   // Make sure that ToString and FromString work
   for (auto val : list) {
@@ -571,5 +599,28 @@ TEST_F(TypesTests, LogRecordTypeTest) {
       peloton::Exception);
 }
 
+TEST_F(TypesTests, AbortCauseTypeTest) {
+  std::vector<AbortCauseType> list = {
+      AbortCauseType::INVALID,        AbortCauseType::OWNERSHIP_CONFLICT,
+      AbortCauseType::READ_TIMESTAMP, AbortCauseType::VISIBILITY,
+      AbortCauseType::CONSTRAINT,     AbortCauseType::VALIDATION};
+
+  // Make sure that ToString and FromString work
+  for (auto val : list) {
+    std::string str = peloton::AbortCauseTypeToString(val);
+    EXPECT_TRUE(str.size() > 0);
+
+    auto newVal = peloton::StringToAbortCauseType(str);
+    EXPECT_EQ(val, newVal);
+  }
+
+  // Then make sure that we can't cast garbage
+  std::string invalid("WU TANG");
+  EXPECT_THROW(peloton::StringToAbortCauseType(invalid), peloton::Exception);
+  EXPECT_THROW(
+      peloton::AbortCauseTypeToString(static_cast<AbortCauseType>(-99999)),
+      peloton::Exception);
+}
+
 }  // End test namespace
 }  // End peloton namespace